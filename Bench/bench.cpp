@@ -0,0 +1,374 @@
+#include "bench_harness.hpp"
+#include "ts_alloc.hpp"
+#include "ts_array.hpp"
+#include "ts_deque.hpp"
+#include "ts_forward_list.hpp"
+#include "ts_list.hpp"
+#include "ts_unrolled_list.hpp"
+#include "ts_vector.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <list>
+#include <vector>
+
+// TS 容器与分配器和对应 std:: 实现的并排对比
+// 用法: TinySTL_bench [--format=table|json|csv] [--filter=vector] [--repeat=N] [--out=file]
+
+namespace TS_Bench
+{
+const std::size_t N = 1 << 16;
+
+using ts_alloc = counting_alloc<TS::alloc>;
+
+template <typename T> using ts_vector = TS::vector<T, ts_alloc>;
+template <typename T> using ts_list = TS::list<T, ts_alloc>;
+template <typename T> using ts_deque = TS::deque<T, ts_alloc>;
+template <typename T> using ts_unrolled_list = TS::unrolled_list<T, ts_alloc>;
+template <typename T> using ts_forward_list = TS::forward_list<T, ts_alloc>;
+template <typename T> using std_vector = std::vector<T, counting_allocator<T>>;
+template <typename T> using std_list = std::list<T, counting_allocator<T>>;
+template <typename T> using std_deque = std::deque<T, counting_allocator<T>>;
+
+// 伪随机下标序列, 两种实现使用相同的访问顺序
+const std::vector<std::size_t> &random_indices()
+{
+    static std::vector<std::size_t> indices = [] {
+        std::vector<std::size_t> result(N);
+        unsigned state = 2463534242u;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            result[i] = state % N;
+        }
+        return result;
+    }();
+    return indices;
+}
+
+// 顺序容器的公共用例
+template <typename Container> void push_back(runner &r, const char *suite, const char *impl)
+{
+    r.run(suite, "push_back", impl, N, [] {
+        Container c;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            c.push_back(int(i));
+        }
+        do_not_optimize(c.back());
+    });
+}
+
+template <typename Container> void push_front(runner &r, const char *suite, const char *impl)
+{
+    r.run(suite, "push_front", impl, N, [] {
+        Container c;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            c.push_front(int(i));
+        }
+        do_not_optimize(c.front());
+    });
+}
+
+template <typename Container> void iterate(runner &r, const char *suite, const char *impl)
+{
+    Container c;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        c.push_back(int(i));
+    }
+    r.run(suite, "iterate", impl, N, [&c] {
+        long long sum = 0;
+        for (auto it = c.begin(); it != c.end(); ++it)
+        {
+            sum += *it;
+        }
+        do_not_optimize(sum);
+    });
+}
+
+template <typename Container> void random_access(runner &r, const char *suite, const char *impl)
+{
+    Container c;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        c.push_back(int(i));
+    }
+    const std::vector<std::size_t> &indices = random_indices();
+    r.run(suite, "random_index", impl, N, [&c, &indices] {
+        long long sum = 0;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            sum += c[indices[i]];
+        }
+        do_not_optimize(sum);
+    });
+}
+
+template <typename Container> void copy(runner &r, const char *suite, const char *impl)
+{
+    Container c;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        c.push_back(int(i));
+    }
+    r.run(suite, "copy", impl, N, [&c] {
+        Container copy(c);
+        do_not_optimize(copy.back());
+    });
+}
+
+template <typename Container> void pop_front(runner &r, const char *suite, const char *impl)
+{
+    Container c;
+    r.run(
+        suite, "pop_front", impl, N,
+        [&c] {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                c.push_back(int(i));
+            }
+        },
+        [&c] {
+            while (!c.empty())
+            {
+                c.pop_front();
+            }
+        });
+}
+
+template <typename Container> void insert_middle(runner &r, const char *suite, const char *impl)
+{
+    const std::size_t count = 4096;
+    r.run(suite, "insert_middle", impl, count, [] {
+        Container c;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            c.insert(c.begin() + c.size() / 2, int(i));
+        }
+        do_not_optimize(c.front());
+    });
+}
+
+// list 在保存的迭代器处插入, 不含定位开销; 沿用 insert 的返回值, 插入使迭代器失效的容器也适用
+template <typename Container> void list_splice_insert(runner &r, const char *impl)
+{
+    r.run("list", "insert_at_iterator", impl, N, [] {
+        Container c;
+        c.push_back(0);
+        c.push_back(1);
+        auto pos = ++c.begin();
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            pos = c.insert(pos, int(i));
+            ++pos;
+        }
+        do_not_optimize(c.back());
+    });
+}
+
+template <typename Container> void list_erase(runner &r, const char *impl)
+{
+    Container c;
+    r.run(
+        "list", "erase_all", impl, N,
+        [&c] {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                c.push_back(int(i));
+            }
+        },
+        [&c] { c.erase(c.begin(), c.end()); });
+}
+
+// 两个相同的大缓冲区做相等与字典序比较, 需扫描全部元素
+template <typename Container> void compare(runner &r, const char *suite, const char *impl)
+{
+    Container a;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        a.push_back(int(i));
+    }
+    Container b(a);
+    r.run(suite, "equal", impl, N, [&a, &b] { do_not_optimize(a == b); });
+    r.run(suite, "less", impl, N, [&a, &b] { do_not_optimize(a < b); });
+}
+
+void bench_vector(runner &r)
+{
+    push_back<ts_vector<int>>(r, "vector", "TS");
+    push_back<std_vector<int>>(r, "vector", "std");
+    iterate<ts_vector<int>>(r, "vector", "TS");
+    iterate<std_vector<int>>(r, "vector", "std");
+    random_access<ts_vector<int>>(r, "vector", "TS");
+    random_access<std_vector<int>>(r, "vector", "std");
+    copy<ts_vector<int>>(r, "vector", "TS");
+    copy<std_vector<int>>(r, "vector", "std");
+    insert_middle<ts_vector<int>>(r, "vector", "TS");
+    insert_middle<std_vector<int>>(r, "vector", "std");
+    compare<ts_vector<int>>(r, "vector", "TS");
+    compare<std_vector<int>>(r, "vector", "std");
+}
+
+// forward_list 没有 push_back, 用 push_front 与批量插入建表
+void forward_list_cases(runner &r)
+{
+    push_front<ts_forward_list<int>>(r, "list", "forward");
+    std::vector<int> source(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        source[i] = int(i);
+    }
+    r.run("list", "build_from_range", "forward", N, [&source] {
+        ts_forward_list<int> c(source.begin(), source.end());
+        do_not_optimize(c.front());
+    });
+    ts_forward_list<int> c(source.begin(), source.end());
+    r.run("list", "iterate", "forward", N, [&c] {
+        long long sum = 0;
+        for (auto it = c.begin(); it != c.end(); ++it)
+        {
+            sum += *it;
+        }
+        do_not_optimize(sum);
+    });
+    r.run("list", "copy", "forward", N, [&c] {
+        ts_forward_list<int> copy(c);
+        do_not_optimize(copy.front());
+    });
+}
+
+// unrolled 行为 TS::unrolled_list, 每个节点保存一段连续元素
+void bench_list(runner &r)
+{
+    push_back<ts_list<int>>(r, "list", "TS");
+    push_back<std_list<int>>(r, "list", "std");
+    push_back<ts_unrolled_list<int>>(r, "list", "unrolled");
+    push_front<ts_list<int>>(r, "list", "TS");
+    push_front<std_list<int>>(r, "list", "std");
+    push_front<ts_unrolled_list<int>>(r, "list", "unrolled");
+    iterate<ts_list<int>>(r, "list", "TS");
+    iterate<std_list<int>>(r, "list", "std");
+    iterate<ts_unrolled_list<int>>(r, "list", "unrolled");
+    copy<ts_list<int>>(r, "list", "TS");
+    copy<std_list<int>>(r, "list", "std");
+    copy<ts_unrolled_list<int>>(r, "list", "unrolled");
+    list_splice_insert<ts_list<int>>(r, "TS");
+    list_splice_insert<std_list<int>>(r, "std");
+    list_splice_insert<ts_unrolled_list<int>>(r, "unrolled");
+    list_erase<ts_list<int>>(r, "TS");
+    list_erase<std_list<int>>(r, "std");
+    list_erase<ts_unrolled_list<int>>(r, "unrolled");
+    forward_list_cases(r);
+}
+
+void bench_deque(runner &r)
+{
+    push_back<ts_deque<int>>(r, "deque", "TS");
+    push_back<std_deque<int>>(r, "deque", "std");
+    push_front<ts_deque<int>>(r, "deque", "TS");
+    push_front<std_deque<int>>(r, "deque", "std");
+    iterate<ts_deque<int>>(r, "deque", "TS");
+    iterate<std_deque<int>>(r, "deque", "std");
+    random_access<ts_deque<int>>(r, "deque", "TS");
+    random_access<std_deque<int>>(r, "deque", "std");
+    pop_front<ts_deque<int>>(r, "deque", "TS");
+    pop_front<std_deque<int>>(r, "deque", "std");
+    insert_middle<ts_deque<int>>(r, "deque", "TS");
+    insert_middle<std_deque<int>>(r, "deque", "std");
+}
+
+template <typename Array> void array_cases(runner &r, const char *impl)
+{
+    const std::size_t SIZE = 4096;
+    static Array a;
+    r.run("array", "fill", impl, SIZE, [] {
+        a.fill(7);
+        do_not_optimize(a[SIZE - 1]);
+    });
+    r.run("array", "iterate", impl, SIZE, [] {
+        long long sum = 0;
+        for (auto it = a.begin(); it != a.end(); ++it)
+        {
+            sum += *it;
+        }
+        do_not_optimize(sum);
+    });
+    r.run("array", "copy", impl, SIZE, [] {
+        static Array copy;
+        copy = a;
+        do_not_optimize(copy[0]);
+    });
+    r.run("array", "swap", impl, SIZE, [] {
+        static Array other;
+        a.swap(other);
+        do_not_optimize(a[0]);
+    });
+}
+
+// 分配器: 成批申请再全部释放固定大小的块
+template <typename Alloc> void alloc_cases(runner &r, const char *impl)
+{
+    const std::size_t COUNT = 4096;
+    static void *blocks[COUNT];
+    const std::size_t sizes[] = {16, 64, 256};
+    const char *names[] = {"alloc_free_16B", "alloc_free_64B", "alloc_free_256B"};
+    for (int s = 0; s < 3; ++s)
+    {
+        std::size_t size = sizes[s];
+        r.run("alloc", names[s], impl, COUNT, [size] {
+            for (std::size_t i = 0; i < COUNT; ++i)
+            {
+                blocks[i] = Alloc::allocate(size);
+            }
+            for (std::size_t i = 0; i < COUNT; ++i)
+            {
+                Alloc::deallocate(blocks[i], size);
+            }
+        });
+    }
+}
+
+// std::allocator 的同接口包装
+struct std_alloc
+{
+    static void *allocate(std::size_t size)
+    {
+        return counting_allocator<char>().allocate(size);
+    }
+
+    static void deallocate(void *p, std::size_t size)
+    {
+        counting_allocator<char>().deallocate(static_cast<char *>(p), size);
+    }
+};
+
+void bench_alloc(runner &r)
+{
+    alloc_cases<counting_alloc<TS::alloc>>(r, "TS");
+    alloc_cases<counting_alloc<TS::single_client_alloc>>(r, "TS_st");
+    alloc_cases<counting_alloc<TS::malloc_alloc>>(r, "malloc");
+    alloc_cases<std_alloc>(r, "std");
+}
+
+} // namespace TS_Bench
+
+int main(int argc, char **argv)
+{
+    using namespace TS_Bench;
+
+    runner r(argc, argv);
+    r.print_header();
+    bench_vector(r);
+    bench_list(r);
+    bench_deque(r);
+    array_cases<TS::array<int, 4096>>(r, "TS");
+    array_cases<std::array<int, 4096>>(r, "std");
+    bench_alloc(r);
+    r.report();
+    return 0;
+}
@@ -0,0 +1,324 @@
+#ifndef TS_BENCH_HARNESS_HPP
+#define TS_BENCH_HARNESS_HPP
+
+#include "ts_alloc_profile.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// 自包含的基准框架: 预热, 重复采样, 中位数/p99, ns/op, allocs/op, GB/s, 加速比, 表格/JSON/CSV 输出
+
+namespace TS_Bench
+{
+// 包装 TS 的分配策略 (alloc, malloc_alloc), 用作 TS 容器的 Alloc 参数;
+// 只向 alloc_scope 报告, 不像 profiled_alloc 那样加锁维护全局统计, 以免影响计时;
+// reallocate 总是接收旧大小, 再按 Base 的实际签名转发
+template <typename Base> struct counting_alloc
+{
+    static void *allocate(std::size_t size)
+    {
+        void *result = Base::allocate(size);
+        TS::alloc_scope::notify_allocate(size);
+        return result;
+    }
+
+    static void deallocate(void *p, std::size_t size)
+    {
+        Base::deallocate(p, size);
+        TS::alloc_scope::notify_deallocate(size);
+    }
+
+    static void *reallocate(void *p, std::size_t old_size, std::size_t new_size)
+    {
+        void *result = TS::reallocate_with_size<Base>(p, old_size, new_size);
+        TS::alloc_scope::notify_reallocate();
+        TS::alloc_scope::notify_deallocate(old_size);
+        TS::alloc_scope::notify_allocate(new_size);
+        return result;
+    }
+};
+
+// 向 alloc_scope 报告的 std 分配器, 用于 std:: 容器
+template <typename T> struct counting_allocator
+{
+    using value_type = T;
+
+    counting_allocator() = default;
+
+    template <typename U> counting_allocator(const counting_allocator<U> &)
+    {
+    }
+
+    T *allocate(std::size_t count)
+    {
+        T *result = std::allocator<T>().allocate(count);
+        TS::alloc_scope::notify_allocate(count * sizeof(T));
+        return result;
+    }
+
+    void deallocate(T *p, std::size_t count)
+    {
+        std::allocator<T>().deallocate(p, count);
+        TS::alloc_scope::notify_deallocate(count * sizeof(T));
+    }
+
+    template <typename U> bool operator==(const counting_allocator<U> &) const
+    {
+        return true;
+    }
+
+    template <typename U> bool operator!=(const counting_allocator<U> &) const
+    {
+        return false;
+    }
+};
+
+// 防止编译器删除被测代码
+template <typename T> inline void do_not_optimize(const T &val)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(val) : "memory");
+#else
+    static volatile const T *sink;
+    sink = &val;
+#endif
+}
+
+struct result
+{
+    std::string suite;
+    std::string name;
+    std::string impl;
+    std::size_t ops;
+    double median_ns; // 每次操作
+    double p99_ns;
+    double min_ns;
+    double allocs_per_op;
+    double bytes_per_op; // 0 表示不统计吞吐量
+    double speedup;      // 同一 suite/name 下首个已运行实现的中位数 / 本中位数
+};
+
+enum class output_format
+{
+    table,
+    json,
+    csv
+};
+
+class runner
+{
+  public:
+    // 命令行: --format=table|json|csv --filter=子串 --warmup=N --repeat=N --out=文件
+    runner(int argc, char **argv)
+        : _format(output_format::table), _warmup(2), _repeat(21), _bytes_per_op(0)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char *arg = argv[i];
+            if (std::strncmp(arg, "--format=", 9) == 0)
+            {
+                std::string fmt = arg + 9;
+                _format = fmt == "json"  ? output_format::json
+                          : fmt == "csv" ? output_format::csv
+                                         : output_format::table;
+            }
+            else if (std::strncmp(arg, "--filter=", 9) == 0)
+            {
+                _filter = arg + 9;
+            }
+            else if (std::strncmp(arg, "--warmup=", 9) == 0)
+            {
+                _warmup = std::atoi(arg + 9);
+            }
+            else if (std::strncmp(arg, "--repeat=", 9) == 0)
+            {
+                _repeat = std::max(1, std::atoi(arg + 9));
+            }
+            else if (std::strncmp(arg, "--out=", 6) == 0)
+            {
+                _out = arg + 6;
+            }
+        }
+    }
+
+    // 之后的 run 每次操作处理的字节数, 用于 GB/s 列; 0 表示不输出
+    void bytes_per_op(double bytes)
+    {
+        _bytes_per_op = bytes;
+    }
+
+    // func() 执行 ops 次被测操作; 每次采样前调用 setup() 准备输入 (不计时)
+    template <typename Setup, typename Func>
+    void run(const char *suite, const char *name, const char *impl, std::size_t ops, Setup setup,
+             Func func)
+    {
+        std::string full = std::string(suite) + "/" + name + "/" + impl;
+        if (!_filter.empty() && full.find(_filter) == std::string::npos)
+        {
+            return;
+        }
+
+        for (int i = 0; i < _warmup; ++i)
+        {
+            setup();
+            func();
+        }
+
+        std::vector<double> samples;
+        std::size_t allocations = 0;
+        for (int i = 0; i < _repeat; ++i)
+        {
+            setup();
+            TS::alloc_scope scope;
+            auto begin = std::chrono::steady_clock::now();
+            func();
+            auto end = std::chrono::steady_clock::now();
+            allocations += scope.stats().allocations;
+            samples.push_back(std::chrono::duration<double, std::nano>(end - begin).count() / ops);
+        }
+        std::sort(samples.begin(), samples.end());
+
+        result r;
+        r.suite = suite;
+        r.name = name;
+        r.impl = impl;
+        r.ops = ops;
+        r.median_ns = samples[samples.size() / 2];
+        r.p99_ns = samples[(samples.size() * 99 + 99) / 100 - 1]; // 最近秩
+        r.min_ns = samples.front();
+        r.allocs_per_op = double(allocations) / _repeat / ops;
+        r.bytes_per_op = _bytes_per_op;
+        r.speedup = 1.0;
+        for (const result &base : _results)
+        {
+            if (base.suite == r.suite && base.name == r.name)
+            {
+                r.speedup = base.median_ns / r.median_ns;
+                break;
+            }
+        }
+        _results.push_back(r);
+        if (_format == output_format::table)
+        {
+            print_row(stdout, r);
+        }
+    }
+
+    template <typename Func>
+    void run(const char *suite, const char *name, const char *impl, std::size_t ops, Func func)
+    {
+        run(suite, name, impl, ops, [] {}, func);
+    }
+
+    // 输出汇总; 表格格式已逐行打印
+    void report() const
+    {
+        FILE *file = _out.empty() ? stdout : std::fopen(_out.c_str(), "w");
+        if (file == nullptr)
+        {
+            std::fprintf(stderr, "cannot open %s\n", _out.c_str());
+            return;
+        }
+        if (_format == output_format::json)
+        {
+            print_json(file);
+        }
+        else if (_format == output_format::csv)
+        {
+            print_csv(file);
+        }
+        else if (file != stdout)
+        {
+            for (const result &r : _results)
+            {
+                print_row(file, r);
+            }
+        }
+        if (file != stdout)
+        {
+            std::fclose(file);
+        }
+    }
+
+    void print_header() const
+    {
+        if (_format == output_format::table)
+        {
+            std::printf("%-10s %-22s %-8s %10s %12s %12s %12s %10s %8s %8s\n", "suite", "benchmark",
+                        "impl", "ops", "median ns", "p99 ns", "min ns", "allocs/op", "GB/s",
+                        "speedup");
+        }
+    }
+
+  protected:
+    // 字节/纳秒即 GB/s
+    static double gb_per_s(const result &r)
+    {
+        return r.bytes_per_op / r.median_ns;
+    }
+
+    static void print_row(FILE *file, const result &r)
+    {
+        std::fprintf(file, "%-10s %-22s %-8s %10zu %12.3f %12.3f %12.3f %10.4f ", r.suite.c_str(),
+                     r.name.c_str(), r.impl.c_str(), r.ops, r.median_ns, r.p99_ns, r.min_ns,
+                     r.allocs_per_op);
+        if (r.bytes_per_op > 0)
+        {
+            std::fprintf(file, "%8.2f", gb_per_s(r));
+        }
+        else
+        {
+            std::fprintf(file, "%8s", "-");
+        }
+        std::fprintf(file, " %8.2f\n", r.speedup);
+    }
+
+    void print_json(FILE *file) const
+    {
+        std::fprintf(file, "[\n");
+        for (std::size_t i = 0; i < _results.size(); ++i)
+        {
+            const result &r = _results[i];
+            std::fprintf(file,
+                         "  {\"suite\": \"%s\", \"name\": \"%s\", \"impl\": \"%s\", \"ops\": %zu, "
+                         "\"median_ns\": %.3f, \"p99_ns\": %.3f, \"min_ns\": %.3f, "
+                         "\"allocs_per_op\": %.4f, \"gb_per_s\": %.3f, \"speedup\": %.3f}%s\n",
+                         r.suite.c_str(), r.name.c_str(), r.impl.c_str(), r.ops, r.median_ns,
+                         r.p99_ns, r.min_ns, r.allocs_per_op, gb_per_s(r), r.speedup,
+                         i + 1 == _results.size() ? "" : ",");
+        }
+        std::fprintf(file, "]\n");
+    }
+
+    void print_csv(FILE *file) const
+    {
+        std::fprintf(file, "suite,name,impl,ops,median_ns,p99_ns,min_ns,allocs_per_op,"
+                           "gb_per_s,speedup\n");
+        for (const result &r : _results)
+        {
+            std::fprintf(file, "%s,%s,%s,%zu,%.3f,%.3f,%.3f,%.4f,%.3f,%.3f\n", r.suite.c_str(),
+                         r.name.c_str(), r.impl.c_str(), r.ops, r.median_ns, r.p99_ns, r.min_ns,
+                         r.allocs_per_op, gb_per_s(r), r.speedup);
+        }
+    }
+
+  protected:
+    output_format _format;
+    int _warmup;
+    int _repeat;
+    std::string _filter;
+    std::string _out;
+    double _bytes_per_op;
+    std::vector<result> _results;
+};
+
+} // namespace TS_Bench
+
+#endif
@@ -0,0 +1,125 @@
+#include "bench_harness.hpp"
+#include "ts_bitset.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// 3200 万个 id 的成员标记, 对比 std::vector<bool> 与 TS::dynamic_bitset, 整图操作的 ops 为位数
+// count: 统计置位数; and/or/andnot: 两张位图逐位合并; iterate: 依次访问全部置位 (约 1/16 的密度)
+// select: 1000 次随机 select, ops 为 select 次数
+// 用法: TinySTL_bitset_bench [--format=table|json|csv] [--filter=count] [--repeat=N]
+// 设置环境变量 TS_FORCE_ISA=scalar/sse2/sse4/avx2/avx512 可对比各级别内核
+
+namespace TS_Bench
+{
+const std::size_t BITS = std::size_t(1) << 25;
+const std::size_t SELECTS = 1000;
+
+struct xorshift
+{
+    std::uint64_t state;
+
+    std::uint64_t operator()()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+} // namespace TS_Bench
+
+int main(int argc, char **argv)
+{
+    using namespace TS_Bench;
+
+    xorshift rng{88172645463325252ULL};
+    std::vector<bool> sa(BITS), sb(BITS);
+    TS::dynamic_bitset<> ta(BITS), tb(BITS);
+    for (std::size_t i = 0; i < BITS; ++i)
+    {
+        bool x = rng() % 16 == 0;
+        bool y = rng() % 2 == 0;
+        sa[i] = x;
+        sb[i] = y;
+        ta.set(i, x);
+        tb.set(i, y);
+    }
+    std::vector<bool> sr = sa;
+    TS::dynamic_bitset<> tr = ta;
+
+    // 输出到 stderr, 不混入 JSON/CSV
+    std::fprintf(stderr, "isa %s\n",
+                 TS::simd::isa_name(TS::simd::dispatch<TS::simd::bit_kernels>().level));
+
+    runner r(argc, argv);
+    r.print_header();
+
+    // 整图操作以位为 op, GB/s 按目标位图的字节数计算
+    r.bytes_per_op(1.0 / 8);
+    r.run("bitset", "count", "vector", BITS,
+          [&] { do_not_optimize(std::count(sa.begin(), sa.end(), true)); });
+    r.run("bitset", "count", "bitset", BITS, [&] { do_not_optimize(ta.count()); });
+
+    r.run("bitset", "and", "vector", BITS, [&] {
+        for (std::size_t i = 0; i < BITS; ++i)
+        {
+            sr[i] = sr[i] && sb[i];
+        }
+    });
+    r.run("bitset", "and", "bitset", BITS, [&] { tr &= tb; });
+
+    r.run("bitset", "or", "vector", BITS, [&] {
+        for (std::size_t i = 0; i < BITS; ++i)
+        {
+            sr[i] = sr[i] || sb[i];
+        }
+    });
+    r.run("bitset", "or", "bitset", BITS, [&] { tr |= tb; });
+
+    r.run("bitset", "andnot", "vector", BITS, [&] {
+        for (std::size_t i = 0; i < BITS; ++i)
+        {
+            sr[i] = sr[i] && !sb[i];
+        }
+    });
+    r.run("bitset", "andnot", "bitset", BITS, [&] { tr.and_not(tb); });
+
+    r.run("bitset", "iterate", "vector", BITS, [&] {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < BITS; ++i)
+        {
+            if (sa[i])
+            {
+                sum += i;
+            }
+        }
+        do_not_optimize(sum);
+    });
+    r.run("bitset", "iterate", "bitset", BITS, [&] {
+        std::size_t sum = 0;
+        for (std::size_t i = ta.find_first(); i != ta.npos; i = ta.find_next(i))
+        {
+            sum += i;
+        }
+        do_not_optimize(sum);
+    });
+
+    r.bytes_per_op(0);
+    std::size_t total = ta.count();
+    r.run("bitset", "select", "bitset", SELECTS, [&] {
+        xorshift pick{7};
+        std::size_t sum = 0;
+        for (std::size_t k = 0; k < SELECTS; ++k)
+        {
+            sum += ta.select(pick() % total);
+        }
+        do_not_optimize(sum);
+    });
+
+    r.report();
+    return 0;
+}
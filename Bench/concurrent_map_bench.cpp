@@ -0,0 +1,147 @@
+#include "bench_harness.hpp"
+#include "ts_concurrent_hash_map.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// 多线程访问同一张表的吞吐: concurrent_hash_map 与单个互斥锁保护的 std::unordered_map
+// read-heavy: 90% 查找, 5% 插入, 5% 删除; write-heavy: 50% 插入, 50% 删除
+// 键从 KEYS 个中均匀随机选取, 预先插入一半; speedup 列为 mutex 相对 striped
+// 用法: TinySTL_concurrent_map_bench [--format=table|json|csv] [--filter=read_heavy] [--repeat=N]
+
+namespace TS_Bench
+{
+const std::size_t OPS = 1 << 17;
+const std::uint64_t KEYS = 1 << 16;
+
+class locked_map
+{
+  public:
+    bool insert(std::uint64_t key, std::uint64_t val)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _map.emplace(key, val).second;
+    }
+
+    bool find(std::uint64_t key, std::uint64_t &result) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _map.find(key);
+        if (it == _map.end())
+        {
+            return false;
+        }
+        result = it->second;
+        return true;
+    }
+
+    bool erase(std::uint64_t key)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _map.erase(key) != 0;
+    }
+
+  protected:
+    mutable std::mutex _mutex;
+    std::unordered_map<std::uint64_t, std::uint64_t> _map;
+};
+
+using striped_map = TS::concurrent_hash_map<std::uint64_t, std::uint64_t>;
+
+struct xorshift
+{
+    std::uint64_t state;
+
+    std::uint64_t operator()()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// read_percent 之外的操作插入与删除各占一半
+template <typename Map> void worker(Map &map, std::size_t seed, unsigned read_percent)
+{
+    xorshift rng{0x9e3779b97f4a7c15ULL * (seed + 1)};
+    std::uint64_t sink = 0;
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < OPS; ++i)
+    {
+        std::uint64_t r = rng();
+        std::uint64_t key = (r >> 8) % KEYS;
+        unsigned op = unsigned(r % 100);
+        if (op < read_percent)
+        {
+            if (map.find(key, value))
+            {
+                sink += value;
+            }
+        }
+        else if ((op - read_percent) % 2 == 0)
+        {
+            map.insert(key, key);
+        }
+        else
+        {
+            map.erase(key);
+        }
+    }
+    do_not_optimize(sink);
+}
+
+// 每次采样前新建并预填充一张表 (不计时)
+template <typename Map>
+void run_threads(runner &r, const char *mix, const char *impl, std::size_t threads,
+                 unsigned read_percent)
+{
+    std::string name = std::string(mix) + "/" + std::to_string(threads) + "t";
+    std::unique_ptr<Map> map;
+    auto setup = [&map] {
+        map.reset(new Map);
+        for (std::uint64_t k = 0; k < KEYS; k += 2)
+        {
+            map->insert(k, k);
+        }
+    };
+    r.run("map", name.c_str(), impl, OPS * threads, setup, [&] {
+        std::vector<std::thread> pool;
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            pool.emplace_back([&map, t, read_percent] { worker(*map, t, read_percent); });
+        }
+        for (auto &t : pool)
+        {
+            t.join();
+        }
+    });
+}
+
+void run_mix(runner &r, const char *mix, unsigned read_percent)
+{
+    for (std::size_t threads = 1; threads <= 32; threads *= 2)
+    {
+        run_threads<striped_map>(r, mix, "striped", threads, read_percent);
+        run_threads<locked_map>(r, mix, "mutex", threads, read_percent);
+    }
+}
+
+} // namespace TS_Bench
+
+int main(int argc, char **argv)
+{
+    using namespace TS_Bench;
+
+    runner r(argc, argv);
+    r.print_header();
+    run_mix(r, "read_heavy", 90);
+    run_mix(r, "write_heavy", 0);
+    r.report();
+    return 0;
+}
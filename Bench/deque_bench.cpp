@@ -0,0 +1,104 @@
+#include "ts_algorithm.hpp"
+#include "ts_deque.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+// 比较不同缓冲区大小下 deque 的 push 与遍历吞吐
+
+namespace TS_Bench
+{
+const std::size_t N = 1 << 22;
+const int REPEAT = 7;
+
+volatile long long sink = 0;
+
+template <typename Func> double median_ns_per_op(Func func, std::size_t ops)
+{
+    std::vector<double> samples;
+    func(); // 预热
+    for (int i = 0; i < REPEAT; ++i)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - begin).count() / ops);
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+template <std::size_t BufBytes> void run()
+{
+    using deque_type = TS::deque<int, TS::alloc, BufBytes>;
+
+    double push_back = median_ns_per_op(
+        [] {
+            deque_type d;
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                d.push_back(int(i));
+            }
+            sink = sink + d.back();
+        },
+        N);
+
+    double push_front = median_ns_per_op(
+        [] {
+            deque_type d;
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                d.push_front(int(i));
+            }
+            sink = sink + d.front();
+        },
+        N);
+
+    deque_type d(N, 1);
+
+    double iterate = median_ns_per_op(
+        [&d] {
+            long long sum = 0;
+            for (auto it = d.begin(); it != d.end(); ++it)
+            {
+                sum += *it;
+            }
+            sink = sink + sum;
+        },
+        N);
+
+    double segmented = median_ns_per_op(
+        [&d] { sink = sink + TS::accumulate(d.begin(), d.end(), 0LL); }, N);
+
+    double index = median_ns_per_op(
+        [&d] {
+            long long sum = 0;
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                sum += d[(i * 7919) % N];
+            }
+            sink = sink + sum;
+        },
+        N);
+
+    std::printf("%8zu %8zu %12.3f %12.3f %12.3f %12.3f %12.3f\n", BufBytes,
+                deque_type::iterator::buffer_size(), push_back, push_front, iterate, segmented,
+                index);
+}
+
+} // namespace TS_Bench
+
+int main()
+{
+    std::printf("deque<int>, N = %zu, ns/op (median of %d)\n", TS_Bench::N, TS_Bench::REPEAT);
+    std::printf("%8s %8s %12s %12s %12s %12s %12s\n", "bytes", "elems", "push_back", "push_front",
+                "iterate", "accumulate", "index");
+    TS_Bench::run<512>();
+    TS_Bench::run<1024>();
+    TS_Bench::run<4096>();
+    TS_Bench::run<16384>();
+    TS_Bench::run<65536>();
+    return 0;
+}
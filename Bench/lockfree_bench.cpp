@@ -0,0 +1,104 @@
+#include "bench_harness.hpp"
+#include "ts_lockfree_stack.hpp"
+#include "ts_vector.hpp"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 多线程对同一个 LIFO 交替 push/pop 的吞吐: lockfree_stack 与互斥锁保护的 TS::vector
+// 每个线程执行 OPS 次 push 与 OPS 次 pop; speedup 列为 mutex 相对 lockfree
+// 用法: TinySTL_lockfree_bench [--format=table|json|csv] [--filter=push_pop/4t] [--repeat=N]
+
+namespace TS_Bench
+{
+const std::size_t OPS = 1 << 18;
+
+// 互斥锁保护的对照组
+class locked_stack
+{
+  public:
+    void push(std::size_t val)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _data.push_back(val);
+    }
+
+    bool pop(std::size_t &result)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_data.empty())
+        {
+            return false;
+        }
+        result = _data.back();
+        _data.pop_back();
+        return true;
+    }
+
+  protected:
+    std::mutex _mutex;
+    TS::vector<std::size_t> _data;
+};
+
+// 每个线程先压入一批再弹出一批, 模拟对象回收
+template <typename Stack> void worker(Stack &stack)
+{
+    const std::size_t batch = 64;
+    std::size_t sink = 0;
+    for (std::size_t i = 0; i < OPS; i += batch)
+    {
+        for (std::size_t k = 0; k < batch; ++k)
+        {
+            stack.push(i + k);
+        }
+        std::size_t value = 0;
+        for (std::size_t k = 0; k < batch; ++k)
+        {
+            if (stack.pop(value))
+            {
+                sink += value;
+            }
+        }
+    }
+    do_not_optimize(sink);
+}
+
+// 计时包含线程的创建与回收; 每次采样前新建一个空栈
+template <typename Stack> void run_threads(runner &r, const char *impl, std::size_t threads)
+{
+    std::string name = "push_pop/" + std::to_string(threads) + "t";
+    std::unique_ptr<Stack> stack;
+    r.run(
+        "stack", name.c_str(), impl, 2 * OPS * threads, [&] { stack.reset(new Stack); },
+        [&] {
+            std::vector<std::thread> pool;
+            for (std::size_t t = 0; t < threads; ++t)
+            {
+                pool.emplace_back([&stack] { worker(*stack); });
+            }
+            for (auto &t : pool)
+            {
+                t.join();
+            }
+        });
+}
+
+} // namespace TS_Bench
+
+int main(int argc, char **argv)
+{
+    using namespace TS_Bench;
+
+    runner r(argc, argv);
+    r.print_header();
+    for (std::size_t threads = 1; threads <= 32; threads *= 2)
+    {
+        run_threads<TS::lockfree_stack<std::size_t>>(r, "lockfree", threads);
+        run_threads<locked_stack>(r, "mutex", threads);
+    }
+    r.report();
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include "ts_parallel.hpp"
+#include "ts_vector.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// 比较 TS::parallel 算法在不同线程数下相对单线程循环的加速比
+
+namespace TS_Bench
+{
+const std::size_t N = 1 << 24;
+const int REPEAT = 5;
+
+volatile double sink = 0;
+
+template <typename Func> double median_ns_per_op(Func func, std::size_t ops)
+{
+    std::vector<double> samples;
+    func(); // 预热
+    for (int i = 0; i < REPEAT; ++i)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - begin).count() / ops);
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+void fill_random(TS::vector<double> &v)
+{
+    unsigned long long state = 88172645463325252ULL;
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        v[i] = double(state % 1000000) / 1000.0;
+    }
+}
+
+struct row
+{
+    double for_each;
+    double transform;
+    double reduce;
+    double transform_reduce;
+    double inclusive_scan;
+    double sort;
+    double stable_sort;
+};
+
+// 单线程基线: 普通循环与 std::sort / std::stable_sort
+row run_serial(const TS::vector<double> &input)
+{
+    TS::vector<double> v(input);
+    TS::vector<double> out(N, 0.0);
+    row r;
+    r.for_each = median_ns_per_op(
+        [&] {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                v[i] = std::sqrt(v[i]);
+            }
+        },
+        N);
+    r.transform = median_ns_per_op(
+        [&] {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                out[i] = v[i] * 2.0 + 1.0;
+            }
+        },
+        N);
+    r.reduce = median_ns_per_op(
+        [&] {
+            double sum = 0;
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                sum += v[i];
+            }
+            sink = sink + sum;
+        },
+        N);
+    r.transform_reduce = median_ns_per_op(
+        [&] {
+            double sum = 0;
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                sum += v[i] * out[i];
+            }
+            sink = sink + sum;
+        },
+        N);
+    r.inclusive_scan = median_ns_per_op(
+        [&] {
+            double sum = 0;
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                sum += v[i];
+                out[i] = sum;
+            }
+        },
+        N);
+    r.sort = median_ns_per_op(
+        [&] {
+            TS::vector<double> copy(input);
+            std::sort(copy.begin(), copy.end());
+        },
+        N);
+    r.stable_sort = median_ns_per_op(
+        [&] {
+            TS::vector<double> copy(input);
+            std::stable_sort(copy.begin(), copy.end());
+        },
+        N);
+    return r;
+}
+
+row run_parallel(const TS::vector<double> &input, const TS::parallel::policy &pol)
+{
+    TS::vector<double> v(input);
+    TS::vector<double> out(N, 0.0);
+    row r;
+    r.for_each = median_ns_per_op(
+        [&] {
+            TS::parallel::for_each(pol, v.begin(), v.end(), [](double &x) { x = std::sqrt(x); });
+        },
+        N);
+    r.transform = median_ns_per_op(
+        [&] {
+            TS::parallel::transform(pol, v.begin(), v.end(), out.begin(),
+                                    [](double x) { return x * 2.0 + 1.0; });
+        },
+        N);
+    r.reduce = median_ns_per_op(
+        [&] { sink = sink + TS::parallel::reduce(pol, v.begin(), v.end(), 0.0); }, N);
+    r.transform_reduce = median_ns_per_op(
+        [&] {
+            sink = sink + TS::parallel::transform_reduce(pol, v.begin(), v.end(), out.begin(), 0.0);
+        },
+        N);
+    r.inclusive_scan = median_ns_per_op(
+        [&] { TS::parallel::inclusive_scan(pol, v.begin(), v.end(), out.begin()); }, N);
+    r.sort = median_ns_per_op(
+        [&] {
+            TS::vector<double> copy(input);
+            TS::parallel::sort(pol, copy.begin(), copy.end());
+        },
+        N);
+    r.stable_sort = median_ns_per_op(
+        [&] {
+            TS::vector<double> copy(input);
+            TS::parallel::stable_sort(pol, copy.begin(), copy.end());
+        },
+        N);
+    return r;
+}
+
+void print_row(const char *label, const row &r, const row &base)
+{
+    std::printf("%-10s %9.3f (%5.2fx) %9.3f (%5.2fx) %9.3f (%5.2fx) %9.3f (%5.2fx) %9.3f (%5.2fx) "
+                "%9.3f (%5.2fx) %9.3f (%5.2fx)\n",
+                label, r.for_each, base.for_each / r.for_each, r.transform,
+                base.transform / r.transform, r.reduce, base.reduce / r.reduce,
+                r.transform_reduce, base.transform_reduce / r.transform_reduce, r.inclusive_scan,
+                base.inclusive_scan / r.inclusive_scan, r.sort, base.sort / r.sort,
+                r.stable_sort, base.stable_sort / r.stable_sort);
+}
+
+} // namespace TS_Bench
+
+int main()
+{
+    using namespace TS_Bench;
+
+    TS::vector<double> input(N, 0.0);
+    fill_random(input);
+
+    std::printf("vector<double>, N = %zu, ns/op (median of %d), speedup vs serial loop\n", N,
+                REPEAT);
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    std::printf("%-10s %17s %17s %17s %17s %17s %17s %17s\n", "threads", "for_each", "transform",
+                "reduce", "xform_reduce", "incl_scan", "sort", "stable_sort");
+
+    row base = run_serial(input);
+    print_row("serial", base, base);
+
+    std::size_t hardware = TS::parallel::policy().concurrency();
+    for (std::size_t threads = 1; threads <= 32; threads *= 2)
+    {
+        row r = run_parallel(input, TS::parallel::policy(1 << 16, threads));
+        char label[16];
+        std::snprintf(label, sizeof(label), "%zu%s", threads, threads > hardware ? "*" : "");
+        print_row(label, r, base);
+    }
+    std::printf("* more threads than hardware threads\n");
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "bench_harness.hpp"
+#include "ts_priority_queue.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+// 定时器调度类负载; 初始建堆不计时
+// hold: 队列中保持 N 个定时器, 每次取出最早到期的一个, 再以 "当前时间 + 随机延迟" 放回
+//       对比 std::priority_queue, 二叉/四叉堆的 pop + push, 以及四叉堆的 pop_push (4-fused)
+// reschedule: N 个任务的带索引堆, 每次随机修改一个任务的到期时间, 每 4 次处理一个到期任务
+// 用法: TinySTL_priority_queue_bench [--format=table|json|csv] [--filter=hold] [--repeat=N]
+
+namespace TS_Bench
+{
+const std::size_t OPS = 1 << 21;
+
+struct xorshift
+{
+    std::uint64_t state;
+
+    std::uint64_t operator()()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+using deadline = std::uint64_t;
+using later = std::greater<deadline>;
+
+using ts_alloc = counting_alloc<TS::alloc>;
+template <std::size_t Arity> using ts_queue = TS::priority_queue<deadline, later, Arity, ts_alloc>;
+template <std::size_t Arity>
+using ts_indexed_queue = TS::indexed_priority_queue<deadline, later, Arity, ts_alloc>;
+
+// std::priority_queue 没有 pop_push
+struct std_queue
+    : std::priority_queue<deadline, std::vector<deadline, counting_allocator<deadline>>, later>
+{
+    void pop_push(deadline d)
+    {
+        pop();
+        push(d);
+    }
+};
+
+// 预先放入 n 个定时器 (不计时), 之后每次操作取出最早的一个并重新排期
+template <typename PQ> void run_hold(runner &r, const char *impl, std::size_t n, bool fused)
+{
+    std::string name = "hold/" + std::to_string(n);
+    xorshift rng{0};
+    std::unique_ptr<PQ> pq;
+    auto setup = [&] {
+        rng.state = n * 0x9e3779b97f4a7c15ULL + 1;
+        pq.reset(new PQ);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            pq->push(rng() % (4 * n));
+        }
+    };
+    r.run("pqueue", name.c_str(), impl, OPS, setup, [&] {
+        std::uint64_t now = 0;
+        for (std::size_t i = 0; i < OPS; ++i)
+        {
+            now = pq->top();
+            deadline next = now + rng() % (4 * n);
+            if (fused)
+            {
+                pq->pop_push(next);
+            }
+            else
+            {
+                pq->pop();
+                pq->push(next);
+            }
+        }
+        do_not_optimize(now);
+    });
+}
+
+template <std::size_t Arity> void run_reschedule(runner &r, const char *impl, std::size_t n)
+{
+    std::string name = "reschedule/" + std::to_string(n);
+    xorshift rng{0};
+    std::unique_ptr<ts_indexed_queue<Arity>> pq;
+    auto setup = [&] {
+        rng.state = n * 0x9e3779b97f4a7c15ULL + 7;
+        pq.reset(new ts_indexed_queue<Arity>);
+        pq->reserve(n);
+        for (std::size_t id = 0; id < n; ++id)
+        {
+            pq->push(id, rng() % (4 * n));
+        }
+    };
+    r.run("pqueue", name.c_str(), impl, OPS, setup, [&] {
+        std::uint64_t now = 0;
+        for (std::size_t i = 0; i < OPS; ++i)
+        {
+            if (i % 4 == 3)
+            {
+                // 到期任务处理后重新排期
+                now = pq->top();
+                pq->update(pq->top_id(), now + rng() % (4 * n));
+            }
+            else
+            {
+                std::size_t id = rng() % n;
+                pq->update(id, now + rng() % (4 * n));
+            }
+        }
+        do_not_optimize(now);
+    });
+}
+
+} // namespace TS_Bench
+
+int main(int argc, char **argv)
+{
+    using namespace TS_Bench;
+
+    runner r(argc, argv);
+    r.print_header();
+    for (std::size_t n = 1 << 10; n <= (1 << 20); n <<= 5)
+    {
+        run_hold<std_queue>(r, "std", n, false);
+        run_hold<ts_queue<2>>(r, "binary", n, false);
+        run_hold<ts_queue<4>>(r, "4-ary", n, false);
+        run_hold<ts_queue<4>>(r, "4-fused", n, true);
+    }
+    for (std::size_t n = 1 << 10; n <= (1 << 20); n <<= 5)
+    {
+        run_reschedule<2>(r, "binary", n);
+        run_reschedule<4>(r, "4-ary", n);
+    }
+    r.report();
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include "bench_harness.hpp"
+#include "ts_radix_sort.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 比较 radix_sort 与 std::sort / std::stable_sort, ops 为元素个数; speedup 列相对 std
+// 整数与浮点: 均匀随机的 32/64 位键
+// 记录: 按 32 位键排序 24 字节的结构体, 与 std::stable_sort 比较 (两者都稳定)
+// 字符串: 带公共前缀的短字符串, MSD 基数排序
+// 并行: 使用全部硬件线程的 parallel::radix_sort
+// 用法: TinySTL_radix_sort_bench [--format=table|json|csv] [--filter=uint32] [--repeat=N]
+
+namespace TS_Bench
+{
+const std::size_t N = 1 << 22;
+
+struct xorshift
+{
+    std::uint64_t state;
+
+    std::uint64_t operator()()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+struct record
+{
+    std::uint32_t key;
+    std::uint32_t id;
+    double weight;
+    std::uint64_t extra;
+};
+
+// 每次采样前复制一份输入 (不计时) 再排序
+template <typename T, typename Sort>
+void run_sort(runner &r, const char *name, const char *impl, const std::vector<T> &input,
+              Sort sort)
+{
+    std::vector<T> data;
+    r.run(
+        "radix", name, impl, input.size(), [&] { data = input; },
+        [&] {
+            sort(data);
+            do_not_optimize(data.data());
+        });
+}
+
+template <typename T> std::vector<T> random_keys(std::size_t count)
+{
+    xorshift rng{88172645463325252ULL};
+    std::vector<T> values(count);
+    for (T &v : values)
+    {
+        v = static_cast<T>(rng());
+    }
+    return values;
+}
+
+std::vector<float> random_floats(std::size_t count)
+{
+    xorshift rng{1234567};
+    std::vector<float> values(count);
+    for (float &v : values)
+    {
+        v = float(std::int64_t(rng() % 2000001) - 1000000) / 7.0f;
+    }
+    return values;
+}
+
+std::vector<record> random_records(std::size_t count)
+{
+    xorshift rng{42};
+    std::vector<record> values(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        values[i] = record{std::uint32_t(rng()), std::uint32_t(i), double(i), rng()};
+    }
+    return values;
+}
+
+std::vector<std::string> random_strings(std::size_t count)
+{
+    xorshift rng{99};
+    const char *prefixes[] = {"", "user/", "user/profile/", "item:", "log-2024-"};
+    std::vector<std::string> values(count);
+    for (std::string &s : values)
+    {
+        s = prefixes[rng() % 5];
+        std::size_t len = 4 + rng() % 12;
+        for (std::size_t k = 0; k < len; ++k)
+        {
+            s.push_back(char('a' + rng() % 26));
+        }
+    }
+    return values;
+}
+
+template <typename T> void run_keys(runner &r, const char *name, const std::vector<T> &input)
+{
+    TS::parallel::policy pol(1 << 14, std::thread::hardware_concurrency());
+    run_sort(r, name, "std", input, [](std::vector<T> &v) { std::sort(v.begin(), v.end()); });
+    run_sort(r, name, "radix", input,
+             [](std::vector<T> &v) { TS::radix_sort(v.begin(), v.end()); });
+    run_sort(r, name, "parallel", input,
+             [&pol](std::vector<T> &v) { TS::parallel::radix_sort(pol, v.begin(), v.end()); });
+}
+
+} // namespace TS_Bench
+
+int main(int argc, char **argv)
+{
+    using namespace TS_Bench;
+
+    runner r(argc, argv);
+    r.print_header();
+    run_keys(r, "uint32", random_keys<std::uint32_t>(N));
+    run_keys(r, "uint64", random_keys<std::uint64_t>(N));
+    run_keys(r, "int32", random_keys<std::int32_t>(N));
+    run_keys(r, "float", random_floats(N));
+    run_keys(r, "string", random_strings(N / 4));
+
+    // 按键排序的记录, 与同样稳定的 std::stable_sort 比较
+    std::vector<record> records = random_records(N);
+    auto by_key = [](const record &a) { return a.key; };
+    TS::parallel::policy pol(1 << 14, std::thread::hardware_concurrency());
+    run_sort(r, "record", "std", records, [](std::vector<record> &v) {
+        std::stable_sort(v.begin(), v.end(),
+                         [](const record &a, const record &b) { return a.key < b.key; });
+    });
+    run_sort(r, "record", "radix", records,
+             [&](std::vector<record> &v) { TS::radix_sort(v.begin(), v.end(), by_key); });
+    run_sort(r, "record", "parallel", records, [&](std::vector<record> &v) {
+        TS::parallel::radix_sort(pol, v.begin(), v.end(), by_key);
+    });
+    r.report();
+    return 0;
+}
@@ -0,0 +1,200 @@
+#include "bench_harness.hpp"
+#include "ts_reclaim.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 读端开销: 多个读者反复读取一个共享对象, 同时一个写者不断替换并退休旧对象
+// raw 为不做保护的读取 (写者只替换不释放, 作为下界), 其余为每次读取进出一次保护
+// hz_reuse 在整个循环中持有同一个 hazard_guard, 只计 protect 的开销; speedup 列相对 raw
+// 用法: TinySTL_reclaim_bench [--format=table|json|csv] [--filter=epoch] [--repeat=N]
+
+namespace TS_Bench
+{
+const std::size_t READS = 1 << 20;
+
+struct payload
+{
+    std::size_t value;
+};
+
+payload *make_payload(std::size_t v)
+{
+    payload *p = TS::simple_alloc<payload, TS::alloc>::allocate();
+    p->value = v;
+    return p;
+}
+
+void free_payload(payload *p)
+{
+    TS::simple_alloc<payload, TS::alloc>::deallocate(p);
+}
+
+struct raw_policy
+{
+    // 旧对象先留着, 结束后统一释放
+    TS::vector<payload *> garbage;
+
+    std::size_t read_loop(std::atomic<payload *> &shared)
+    {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < READS; ++i)
+        {
+            sum += shared.load(std::memory_order_acquire)->value;
+        }
+        return sum;
+    }
+
+    void update(std::atomic<payload *> &shared, std::size_t v)
+    {
+        garbage.push_back(shared.exchange(make_payload(v)));
+    }
+
+    ~raw_policy()
+    {
+        for (payload *p : garbage)
+        {
+            free_payload(p);
+        }
+    }
+};
+
+struct epoch_policy
+{
+    TS::epoch_domain domain;
+
+    std::size_t read_loop(std::atomic<payload *> &shared)
+    {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < READS; ++i)
+        {
+            TS::epoch_guard guard(domain);
+            sum += shared.load(std::memory_order_acquire)->value;
+        }
+        return sum;
+    }
+
+    void update(std::atomic<payload *> &shared, std::size_t v)
+    {
+        TS::epoch_guard guard(domain);
+        guard.retire(shared.exchange(make_payload(v)));
+    }
+};
+
+struct hazard_policy
+{
+    TS::hazard_domain domain;
+
+    std::size_t read_loop(std::atomic<payload *> &shared)
+    {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < READS; ++i)
+        {
+            TS::hazard_guard guard(domain);
+            sum += guard.protect(0, shared)->value;
+        }
+        return sum;
+    }
+
+    void update(std::atomic<payload *> &shared, std::size_t v)
+    {
+        TS::hazard_guard guard(domain);
+        guard.retire(shared.exchange(make_payload(v)));
+    }
+};
+
+struct hazard_reuse_policy : hazard_policy
+{
+    std::size_t read_loop(std::atomic<payload *> &shared)
+    {
+        std::size_t sum = 0;
+        TS::hazard_guard guard(domain);
+        for (std::size_t i = 0; i < READS; ++i)
+        {
+            sum += guard.protect(0, shared)->value;
+        }
+        return sum;
+    }
+};
+
+// 每次采样使用新的 Policy 与共享对象; 上一次采样的清理放在下一次 setup 中, 不计时
+template <typename Policy> struct read_case
+{
+    std::unique_ptr<Policy> policy;
+    std::atomic<payload *> shared{nullptr};
+
+    void reset()
+    {
+        if (policy)
+        {
+            free_payload(shared.load());
+            policy.reset();
+        }
+    }
+
+    ~read_case()
+    {
+        reset();
+    }
+};
+
+template <typename Policy> void run_readers(runner &r, const char *impl, std::size_t readers)
+{
+    std::string name = "read/" + std::to_string(readers) + "r";
+    read_case<Policy> c;
+    auto setup = [&c] {
+        c.reset();
+        c.policy.reset(new Policy);
+        c.shared.store(make_payload(0));
+    };
+    r.run("reclaim", name.c_str(), impl, READS * readers, setup, [&c, readers] {
+        Policy &policy = *c.policy;
+        std::atomic<payload *> &shared = c.shared;
+        std::atomic<std::size_t> running(readers);
+        std::atomic<std::size_t> sink(0);
+
+        std::vector<std::thread> pool;
+        for (std::size_t t = 0; t < readers; ++t)
+        {
+            pool.emplace_back([&] {
+                sink.fetch_add(policy.read_loop(shared));
+                running.fetch_sub(1);
+            });
+        }
+        std::thread writer([&] {
+            for (std::size_t v = 1; running.load(std::memory_order_relaxed) != 0; ++v)
+            {
+                policy.update(shared, v);
+                std::this_thread::yield();
+            }
+        });
+        for (auto &t : pool)
+        {
+            t.join();
+        }
+        writer.join();
+        do_not_optimize(sink.load());
+    });
+}
+
+} // namespace TS_Bench
+
+int main(int argc, char **argv)
+{
+    using namespace TS_Bench;
+
+    runner r(argc, argv);
+    r.print_header();
+    for (std::size_t readers = 1; readers <= 8; readers *= 2)
+    {
+        run_readers<raw_policy>(r, "raw", readers);
+        run_readers<epoch_policy>(r, "epoch", readers);
+        run_readers<hazard_policy>(r, "hazard", readers);
+        run_readers<hazard_reuse_policy>(r, "hz_reuse", readers);
+    }
+    r.report();
+    return 0;
+}
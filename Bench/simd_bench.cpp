@@ -0,0 +1,100 @@
+#include "bench_harness.hpp"
+#include "ts_algorithm.hpp"
+#include "ts_simd.hpp"
+#include "ts_vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// find/count/min_element/minmax_element/fill 的向量内核与 std:: 的吞吐量对比 (GB/s 列)
+// 用法: TinySTL_simd_bench [--max-bytes=N] [--format=table|json|csv] [--filter=find] [--repeat=N]
+// 输入从 1 KB 起每次乘 4, 默认到 1 GB;
+// 设置环境变量 TS_FORCE_ISA=scalar|sse2|sse4|avx2|avx512 可比较各级别的内核
+
+namespace TS_Bench
+{
+const std::size_t MIN_BYTES = 1024;
+const std::size_t MAX_BYTES = std::size_t(1) << 40; // 上限, 保证 bytes *= 4 不会溢出
+const std::size_t SAMPLE_BYTES = std::size_t(1) << 24; // 小输入在一次采样内重复扫描到约 16 MB
+
+template <typename T> void run_type(runner &r, const char *type, std::size_t max_bytes)
+{
+    r.bytes_per_op(sizeof(T));
+    for (std::size_t bytes = MIN_BYTES; bytes <= max_bytes; bytes *= 4)
+    {
+        std::size_t n = bytes / sizeof(T);
+        std::size_t passes = std::max<std::size_t>(1, SAMPLE_BYTES / bytes);
+        std::size_t ops = n * passes;
+        TS::vector<T> v(n, T(0));
+        unsigned state = 2463534242u;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            v[i] = T(int(state % 1000000));
+        }
+        const T *first = v.begin();
+        const T *last = v.end();
+        TS::vector<T> out(n, T(0));
+        const T missing = T(-1); // 不存在的值, 需扫描全部元素
+
+        auto bench = [&](const char *kernel, const char *impl, auto pass) {
+            std::string name = std::string(kernel) + "/" + std::to_string(bytes);
+            r.run(type, name.c_str(), impl, ops, [&] {
+                for (std::size_t i = 0; i < passes; ++i)
+                {
+                    pass();
+                }
+            });
+        };
+        bench("find", "TS", [&] { do_not_optimize(TS::find(first, last, missing)); });
+        bench("find", "std", [&] { do_not_optimize(std::find(first, last, missing)); });
+        bench("count", "TS", [&] { do_not_optimize(TS::count(first, last, missing)); });
+        bench("count", "std", [&] { do_not_optimize(std::count(first, last, missing)); });
+        bench("min", "TS", [&] { do_not_optimize(TS::min_element(first, last)); });
+        bench("min", "std", [&] { do_not_optimize(std::min_element(first, last)); });
+        bench("minmax", "TS", [&] { do_not_optimize(TS::minmax_element(first, last).second); });
+        bench("minmax", "std", [&] { do_not_optimize(std::minmax_element(first, last).second); });
+        bench("fill", "TS", [&] {
+            TS::fill(out.begin(), out.end(), T(1));
+            do_not_optimize(out[n / 2]);
+        });
+        bench("fill", "std", [&] {
+            std::fill(out.begin(), out.end(), T(1));
+            do_not_optimize(out[n / 2]);
+        });
+    }
+}
+
+} // namespace TS_Bench
+
+int main(int argc, char **argv)
+{
+    using namespace TS_Bench;
+
+    std::size_t max_bytes = std::size_t(1) << 30;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strncmp(argv[i], "--max-bytes=", 12) == 0)
+        {
+            max_bytes = std::strtoull(argv[i] + 12, nullptr, 10);
+        }
+    }
+    max_bytes = std::min(max_bytes, MAX_BYTES);
+
+    // 输出到 stderr, 不混入 JSON/CSV
+    std::fprintf(stderr, "active isa: %s (cpu: %s)\n", TS::simd::isa_name(TS::simd::active_isa()),
+                 TS::simd::isa_name(TS::simd::cpu_isa()));
+
+    runner r(argc, argv);
+    r.print_header();
+    run_type<std::int32_t>(r, "int32_t", max_bytes);
+    run_type<float>(r, "float", max_bytes);
+    r.report();
+    return 0;
+}
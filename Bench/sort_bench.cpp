@@ -0,0 +1,111 @@
+#include "bench_harness.hpp"
+#include "ts_deque.hpp"
+#include "ts_sort.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 比较 TS::sort 与 std::sort, ops 为元素个数; speedup 列相对 std
+// 输入形态: 随机, 已有序, 逆序, 只有 16 种取值, 几乎有序 (0.1% 的元素被打乱)
+// std:    std::vector<int> 上的 libstdc++ introsort
+// block:  指针区间与默认比较, 走无分支的块划分
+// plain:  同样的数据, 以 lambda 比较, 走普通划分
+// deque:  TS::deque<int> 上的 TS::sort (std::sort 不接受 TS 的迭代器类别)
+// 用法: TinySTL_sort_bench [--format=table|json|csv] [--filter=random] [--repeat=N]
+
+namespace TS_Bench
+{
+const std::size_t N = 1 << 22;
+
+struct xorshift
+{
+    std::uint64_t state;
+
+    std::uint64_t operator()()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+std::vector<int> make_input(const std::string &shape)
+{
+    xorshift rng{88172645463325252ULL};
+    std::vector<int> values(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        if (shape == "random")
+        {
+            values[i] = int(rng() >> 33);
+        }
+        else if (shape == "reversed")
+        {
+            values[i] = int(N - i);
+        }
+        else if (shape == "few_unique")
+        {
+            values[i] = int(rng() % 16);
+        }
+        else
+        {
+            values[i] = int(i);
+        }
+    }
+    if (shape == "nearly")
+    {
+        for (std::size_t k = 0; k < N / 1000; ++k)
+        {
+            std::swap(values[rng() % N], values[rng() % N]);
+        }
+    }
+    return values;
+}
+
+// 每次采样前把输入复制进容器 (不计时) 再排序
+template <typename Container, typename Sort>
+void run_sort(runner &r, const char *shape, const char *impl, const std::vector<int> &input,
+              Sort sort)
+{
+    Container data(input.size());
+    auto setup = [&] {
+        for (std::size_t i = 0; i < input.size(); ++i)
+        {
+            data[i] = input[i];
+        }
+    };
+    r.run("sort", shape, impl, input.size(), setup, [&] {
+        sort(data);
+        do_not_optimize(data[0]);
+    });
+}
+
+} // namespace TS_Bench
+
+int main(int argc, char **argv)
+{
+    using namespace TS_Bench;
+    using deque_int = TS::deque<int>;
+
+    runner r(argc, argv);
+    r.print_header();
+    for (const char *shape : {"random", "sorted", "reversed", "few_unique", "nearly"})
+    {
+        std::vector<int> input = make_input(shape);
+        run_sort<std::vector<int>>(r, shape, "std", input,
+                                   [](std::vector<int> &v) { std::sort(v.begin(), v.end()); });
+        run_sort<std::vector<int>>(r, shape, "block", input, [](std::vector<int> &v) {
+            TS::sort(v.data(), v.data() + v.size());
+        });
+        run_sort<std::vector<int>>(r, shape, "plain", input, [](std::vector<int> &v) {
+            TS::sort(v.begin(), v.end(), [](int a, int b) { return a < b; });
+        });
+        run_sort<deque_int>(r, shape, "deque", input,
+                            [](deque_int &v) { TS::sort(v.begin(), v.end()); });
+    }
+    r.report();
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "bench_harness.hpp"
+#include "ts_thread_pool.hpp"
+#include "ts_vector.hpp"
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+// 不同线程数下 fib 与 parallel_for 的耗时; speedup 列相对单线程串行版本, 效率 = speedup / 线程数
+// 用法: TinySTL_thread_pool_bench [--format=table|json|csv] [--filter=fib] [--repeat=N]
+
+namespace TS_Bench
+{
+const int FIB_N = 32;
+const int FIB_CUTOFF = 16;
+const std::size_t N = 1 << 24;
+const std::size_t GRAIN = 1 << 14;
+
+long fib_serial(int n)
+{
+    return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+long fib(TS::thread_pool &pool, int n)
+{
+    if (n < FIB_CUTOFF)
+    {
+        return fib_serial(n);
+    }
+    long a = 0, b = 0;
+    TS::parallel_invoke(
+        pool, [&] { a = fib(pool, n - 1); }, [&] { b = fib(pool, n - 2); });
+    return a + b;
+}
+
+} // namespace TS_Bench
+
+int main(int argc, char **argv)
+{
+    using namespace TS_Bench;
+
+    runner r(argc, argv);
+    r.print_header();
+
+    TS::vector<double> data(N, 1.5);
+    TS::vector<double> out(N, 0.0);
+    auto body = [&](std::size_t i) { out[i] = std::sqrt(data[i]) * 2.0 + 1.0; };
+
+    // 串行版本先运行, 作为同名基准的 speedup 基线
+    r.run("pool", "fib", "serial", 1, [] { do_not_optimize(fib_serial(FIB_N)); });
+    r.run("pool", "parallel_for", "serial", N, [&] {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            body(i);
+        }
+        do_not_optimize(out[N - 1]);
+    });
+
+    // 调用线程在 wait 中参与执行, 总线程数为工作线程数加一
+    for (std::size_t threads = 1; threads <= 32; threads *= 2)
+    {
+        TS::thread_pool pool(threads - 1);
+        std::string impl = std::to_string(threads) + "t";
+        r.run("pool", "fib", impl.c_str(), 1, [&pool] { do_not_optimize(fib(pool, FIB_N)); });
+        r.run("pool", "parallel_for", impl.c_str(), N, [&] {
+            TS::parallel_for(pool, 0, N, GRAIN, body);
+            do_not_optimize(out[N - 1]);
+        });
+    }
+
+    r.report();
+    return 0;
+}
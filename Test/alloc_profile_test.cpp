@@ -0,0 +1,227 @@
+#include "ts_alloc_profile.hpp"
+#include "ts_deque.hpp"
+#include "ts_list.hpp"
+#include "ts_vector.hpp"
+#include <cassert>
+#include <iostream>
+
+using namespace TS;
+
+// 每个容器使用独立的 Tag, 统计互不干扰
+struct vector_tag
+{
+};
+struct list_tag
+{
+};
+struct deque_tag
+{
+};
+struct malloc_tag
+{
+};
+
+using vector_alloc = profiled_alloc<alloc, vector_tag>;
+using list_alloc = profiled_alloc<alloc, list_tag>;
+using deque_alloc = profiled_alloc<alloc, deque_tag>;
+using raw_alloc = profiled_alloc<malloc_alloc, malloc_tag>;
+
+void test_histogram_bucket()
+{
+    assert(alloc_histogram_bucket(0) == 0);
+    assert(alloc_histogram_bucket(1) == 0);
+    assert(alloc_histogram_bucket(2) == 1);
+    assert(alloc_histogram_bucket(3) == 2);
+    assert(alloc_histogram_bucket(4) == 2);
+    assert(alloc_histogram_bucket(4096) == 12);
+    assert(alloc_histogram_bucket(4097) == 13);
+    assert(alloc_histogram_bucket(std::size_t(1) << 40) == ALLOC_HISTOGRAM_BUCKETS - 1);
+}
+
+void test_policy_stats()
+{
+    raw_alloc::reset_stats();
+    void *p = raw_alloc::allocate(24);
+    void *q = raw_alloc::allocate(1000);
+    alloc_stats stats = raw_alloc::stats();
+    assert(stats.allocations == 2);
+    assert(stats.bytes_allocated == 1024);
+    assert(stats.live_blocks == 2);
+    assert(stats.live_bytes == 1024);
+    assert(stats.histogram[5] == 1);  // 24 字节落在 (16, 32]
+    assert(stats.histogram[10] == 1); // 1000 字节落在 (512, 1024]
+
+    raw_alloc::deallocate(q, 1000);
+    raw_alloc::deallocate(p, 24);
+    stats = raw_alloc::stats();
+    assert(stats.deallocations == 2);
+    assert(stats.live_blocks == 0);
+    assert(stats.live_bytes == 0);
+    assert(stats.peak_live_bytes == 1024);
+    assert(expect_no_leaks(stats));
+
+    raw_alloc::reset_stats();
+    assert(raw_alloc::stats().allocations == 0);
+}
+
+void test_reallocate()
+{
+    using realloc_policy = profiled_alloc<alloc, malloc_tag>;
+    realloc_policy::reset_stats();
+    alloc_scope scope;
+    void *p = realloc_policy::allocate(16);
+    p = realloc_policy::reallocate(p, 16, 64);
+    realloc_policy::deallocate(p, 64);
+    assert(scope.stats().reallocations == 1);
+    assert(scope.stats().allocations == 2);
+    assert(scope.stats().deallocations == 2);
+    assert(scope.stats().peak_live_bytes == 64);
+    assert(expect_no_leaks(scope.stats()));
+    assert(realloc_policy::stats().reallocations == 1);
+
+    // malloc_alloc::reallocate 不接收旧大小, 包装者按其签名转发
+    raw_alloc::reset_stats();
+    void *q = raw_alloc::allocate(16);
+    q = raw_alloc::reallocate(q, 16, 4096);
+    raw_alloc::deallocate(q, 4096);
+    assert(raw_alloc::stats().reallocations == 1);
+    assert(raw_alloc::stats().peak_live_bytes == 4096);
+    assert(expect_no_leaks(raw_alloc::stats()));
+}
+
+void test_scope()
+{
+    vector<int, vector_alloc> v(100, 1);
+
+    // 作用域只统计其生存期内的活动
+    {
+        alloc_scope scope;
+        assert(expect_no_allocations(scope.stats()));
+        int sum = 0;
+        for (int x : v)
+            sum += x;
+        assert(sum == 100);
+        assert(expect_no_allocations(scope.stats()));
+    }
+
+    // 嵌套作用域: 内层活动同时计入外层
+    alloc_scope outer;
+    {
+        list<int, list_alloc> l;
+        l.push_back(1);
+        alloc_scope inner;
+        l.push_back(2);
+        l.push_back(3);
+        assert(inner.stats().allocations == 2);
+    }
+    assert(outer.stats().allocations == 3); // 哨兵嵌在 list 中, 不分配
+    assert(expect_no_leaks(outer.stats()));
+
+    outer.reset();
+    assert(outer.stats().allocations == 0);
+
+    // 作用域开始前分配的块在作用域内释放, 净块数为负
+    {
+        alloc_scope scope;
+        v.clear();
+        v.shrink_to_fit();
+        assert(scope.stats().net_blocks() <= 0);
+        assert(expect_no_leaks(scope.stats()));
+    }
+
+    // 释放作用域外的块使净值为负, 不影响峰值
+    void *before = raw_alloc::allocate(256);
+    {
+        alloc_scope scope;
+        raw_alloc::deallocate(before, 256);
+        assert(scope.stats().live_blocks == -1 && scope.stats().live_bytes == -256);
+        assert(scope.stats().peak_live_bytes == 0);
+        void *inside = raw_alloc::allocate(100);
+        assert(scope.stats().peak_live_bytes == 0);
+        raw_alloc::deallocate(inside, 100);
+    }
+}
+
+void test_complexity()
+{
+    const std::size_t N = 10000;
+
+    // vector::push_back x N 只进行 O(log N) 次分配
+    {
+        alloc_scope scope;
+        {
+            vector<int, vector_alloc> v;
+            for (std::size_t i = 0; i < N; ++i)
+                v.push_back(int(i));
+            assert(expect_logarithmic_allocations(scope.stats(), N));
+        }
+        assert(expect_no_leaks(scope.stats()));
+    }
+
+    // reserve 之后不再分配
+    {
+        vector<int, vector_alloc> v;
+        v.reserve(N);
+        alloc_scope scope;
+        for (std::size_t i = 0; i < N; ++i)
+            v.push_back(int(i));
+        assert(expect_no_allocations(scope.stats()));
+    }
+
+    // list::push_back 每个元素一次分配
+    {
+        alloc_scope scope;
+        {
+            list<int, list_alloc> l;
+            std::size_t before = scope.stats().allocations;
+            for (std::size_t i = 0; i < N; ++i)
+                l.push_back(int(i));
+            assert(scope.stats().allocations - before == N);
+            assert(expect_linear_allocations(scope.stats(), N, 1, before));
+        }
+        assert(expect_no_leaks(scope.stats()));
+    }
+
+    // deque::push_back 按缓冲区分配, 远少于元素个数
+    {
+        alloc_scope scope;
+        {
+            deque<int, deque_alloc> d;
+            for (std::size_t i = 0; i < N; ++i)
+                d.push_back(int(i));
+            std::size_t per_buffer = deque<int, deque_alloc>::iterator::buffer_size();
+            assert(expect_allocations_at_most(scope.stats(), N / per_buffer + 16));
+        }
+        assert(expect_no_leaks(scope.stats()));
+    }
+}
+
+void test_tags()
+{
+    // 各 Tag 的全局统计互相独立
+    vector_alloc::reset_stats();
+    list_alloc::reset_stats();
+    {
+        vector<int, vector_alloc> v(8, 0);
+        list<int, list_alloc> l(3, 0);
+        assert(vector_alloc::stats().live_blocks == 1);
+        assert(list_alloc::stats().live_blocks == 3); // 只有 3 个值节点
+    }
+    assert(vector_alloc::stats().live_blocks == 0);
+    assert(list_alloc::stats().live_blocks == 0);
+    assert(vector_alloc::stats().allocations == 1);
+    assert(list_alloc::stats().allocations == 3);
+}
+
+int main()
+{
+    test_histogram_bucket();
+    test_policy_stats();
+    test_reallocate();
+    test_scope();
+    test_complexity();
+    test_tags();
+
+    std::cout << "All tests passed! TS::alloc_profile is working correctly." << std::endl;
+    return 0;
+}
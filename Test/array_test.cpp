@@ -1,5 +1,7 @@
 #include "ts_array.hpp"
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -83,6 +85,41 @@ std::ostream &operator<<(std::ostream &os, const TestType &tt)
     return os;
 }
 
+// 检测能否以 Args 花括号初始化 A
+template <typename A, typename = void, typename... Args>
+struct brace_constructible_impl : std::false_type
+{
+};
+
+template <typename A, typename... Args>
+struct brace_constructible_impl<A, decltype(void(A{std::declval<Args>()...})), Args...>
+    : std::true_type
+{
+};
+
+template <typename A, typename... Args>
+using brace_constructible = brace_constructible_impl<A, void, Args...>;
+
+// 编译期构造的查找表
+constexpr TS::array<int, 16> make_squares()
+{
+    TS::array<int, 16> result{};
+    for (std::size_t i = 0; i < result.size(); ++i)
+    {
+        result[i] = int(i * i);
+    }
+    return result;
+}
+
+constexpr TS::array<int, 4> swapped()
+{
+    TS::array<int, 4> a = {1, 2, 3, 4};
+    TS::array<int, 4> b{};
+    b.fill(9);
+    TS::swap(a, b);
+    return a;
+}
+
 // 测试用例函数
 void test_default_constructor()
 {
@@ -133,8 +170,9 @@ void test_initializer_list_constructor()
     TEST(arr3[1] == 0);
     TEST(arr3[2] == 0);
 
-    // 测试异常 - 初始化列表太大
-    TEST_THROW((TS::array<int, 2>{1, 2, 3}), std::out_of_range);
+    // 初始值过多在编译期即被拒绝
+    TEST((!brace_constructible<TS::array<int, 2>, int, int, int>::value));
+    TEST((brace_constructible<TS::array<int, 2>, int, int>::value));
 
     // 测试自定义类型
     TS::array<TestType, 4> custom_arr = {TestType(1), TestType(2), TestType(3)};
@@ -256,9 +294,11 @@ void test_move_assignment()
     // 这里我们只检查大小，因为元素状态可能不确定
     TEST(original.size() == 3);
 
-    // 自赋值测试
+    // 自移动赋值逐元素进行, 与 std::array 相同, 元素处于有效但未指定的状态
     moved = std::move(moved);
-    TEST(moved[0] == "one"); // 应该保持不变
+    TEST(moved.size() == 3);
+    moved[0] = "one";
+    TEST(moved[0] == "one");
 
     // 测试自定义类型
     TS::array<TestType, 2> orig_custom = {TestType(1), TestType(2)};
@@ -504,6 +544,42 @@ void test_equality_operator()
     TEST(!(custom1 == custom3));
 }
 
+void test_relational_operators()
+{
+    std::cout << "\n=== Testing relational operators ===" << std::endl;
+
+    TS::array<int, 3> arr1 = {1, 2, 3};
+    TS::array<int, 3> arr2 = {1, 2, 3};
+    TS::array<int, 3> arr3 = {1, 2, 4};
+    TS::array<int, 3> arr4 = {-1, 2, 3};
+
+    TEST(arr1 != arr3);
+    TEST(!(arr1 != arr2));
+    TEST(arr1 < arr3);
+    TEST(arr3 > arr1);
+    TEST(arr1 <= arr2);
+    TEST(arr1 >= arr2);
+    TEST(arr4 < arr1); // 按有符号值而非字节比较
+    TEST(TS::compare(arr1, arr2) == 0);
+    TEST(TS::compare(arr1, arr3) < 0);
+    TEST(TS::compare(arr3, arr4) > 0);
+
+    // 大数组: 差异位于中间块
+    static TS::array<unsigned char, 4096> bytes1, bytes2;
+    bytes1.fill(7);
+    bytes2.fill(7);
+    TEST(bytes1 == bytes2);
+    bytes2[3000] = 200;
+    TEST(bytes1 != bytes2);
+    TEST(bytes1 < bytes2);
+    TEST(TS::compare(bytes2, bytes1) > 0);
+
+    TS::array<std::string, 2> words1 = {"apple", "pear"};
+    TS::array<std::string, 2> words2 = {"apple", "plum"};
+    TEST(words1 < words2);
+    TEST(TS::compare(words2, words1) > 0);
+}
+
 void test_get_functions()
 {
     std::cout << "\n=== Testing get functions ===" << std::endl;
@@ -627,6 +703,101 @@ void test_type_traits()
     TEST((std::is_same<decltype(arr)::const_iterator, const int *>::value));
 }
 
+void test_constexpr()
+{
+    std::cout << "\n=== Testing constexpr and triviality ===" << std::endl;
+
+    constexpr TS::array<int, 16> squares = make_squares();
+    static_assert(squares[15] == 225, "lookup table built at compile time");
+    static_assert(TS::get<3>(squares) == 9, "get<I> in constant expression");
+    static_assert(squares.front() == 0 && squares.back() == 225, "front/back");
+    static_assert(squares.at(4) == 16 && *(squares.end() - 2) == 196, "at/end");
+    static_assert(swapped() == TS::array<int, 4>{9, 9, 9, 9}, "fill and swap");
+
+    constexpr TS::array<int, 3> a = {1, 2, 3};
+    constexpr TS::array<int, 3> b = {1, 2, 4};
+    static_assert(a != b && a < b && b > a && a <= a && b >= a, "relational operators");
+    static_assert(TS::compare(a, b) < 0 && TS::compare(b, a) > 0 && TS::compare(a, a) == 0,
+                  "three-way compare");
+
+    constexpr TS::array deduced = {1, 2, 3, 4, 5};
+    static_assert(std::is_same<decltype(deduced), const TS::array<int, 5>>::value, "deduction");
+
+    static_assert(std::is_aggregate<TS::array<int, 4>>::value, "aggregate");
+    static_assert(std::is_trivially_copyable<TS::array<int, 4>>::value, "trivially copyable");
+    static_assert(std::is_trivially_copyable<TS::array<TestType, 4>>::value, "trivially copyable");
+    static_assert(!std::is_trivially_copyable<TS::array<std::string, 2>>::value, "non-trivial");
+    static_assert(std::is_nothrow_swappable<TS::array<int, 4>>::value, "nothrow swap");
+
+    // 运行时结果与编译期一致, 可以整体 memcpy
+    TS::array<int, 16> copy;
+    std::memcpy(&copy, &squares, sizeof(copy));
+    TEST(copy == squares);
+    TEST(sizeof(TS::array<int, 16>) == 16 * sizeof(int));
+    TEST(make_squares() == squares);
+}
+
+void test_alignment_and_bulk_ops()
+{
+    std::cout << "\n=== Testing alignment and bulk operations ===" << std::endl;
+
+    static_assert(alignof(TS::array<float, 8, 32>) == 32, "aligned storage");
+    static_assert(sizeof(TS::array<float, 16, 64>) == 64, "no padding for full lines");
+    TS::array<float, 8, 32> v8;
+    TS::array<double, 3, 64> cache_line[2];
+    TEST(reinterpret_cast<std::uintptr_t>(v8.data()) % 32 == 0);
+    TEST(reinterpret_cast<std::uintptr_t>(cache_line[1].data()) % 64 == 0);
+
+    // 可平凡复制的元素按块交换, 含不足一块的尾部
+    TS::array<int, 1000> big1, big2;
+    for (std::size_t i = 0; i < big1.size(); ++i)
+    {
+        big1[i] = int(i);
+        big2[i] = -int(i);
+    }
+    big1.swap(big2);
+    TEST(big1[999] == -999 && big2[999] == 999 && big1[17] == -17 && big2[0] == 0);
+    TS::array<double, 7, 64> d1 = {1, 2, 3, 4, 5, 6, 7};
+    TS::array<double, 7, 64> d2{};
+    TS::swap(d1, d2);
+    TEST(d1[6] == 0.0 && d2[6] == 7.0);
+    TS::array<std::string, 2> s1 = {"a", "b"};
+    TS::array<std::string, 2> s2 = {"c", "d"};
+    s1.swap(s2);
+    TEST(s1[0] == "c" && s2[1] == "b");
+
+    TS::array<float, 20, 32> filled;
+    filled.fill(1.5f);
+    TEST(filled[0] == 1.5f && filled[19] == 1.5f);
+
+    // 逐元素算术
+    constexpr TS::array<int, 5> a = {1, 2, 3, 4, 5};
+    constexpr TS::array<int, 5> b = {10, 20, 30, 40, 50};
+    static_assert(TS::add(a, b) == TS::array<int, 5>{11, 22, 33, 44, 55}, "add");
+    static_assert(TS::mul(a, b) == TS::array<int, 5>{10, 40, 90, 160, 250}, "mul");
+    static_assert(TS::fma(a, b, a) == TS::array<int, 5>{11, 42, 93, 164, 255}, "fma");
+    static_assert(TS::dot(a, b) == 550, "dot");
+
+    TS::array<float, 19, 32> x, y;
+    float expected = 0;
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = float(i) * 0.5f;
+        y[i] = 2.0f;
+        expected += x[i] * y[i];
+    }
+    TEST(TS::dot(x, y) == expected); // 均为可精确表示的值
+    TS::array<float, 19, 32> z = TS::fma(x, y, TS::add(x, y));
+    TEST(z[4] == 2.0f * 2.0f + 2.0f + 2.0f);
+
+    TS::array<int, 5> squares;
+    TS::transform(a.begin(), a.end(), squares.begin(), [](int v) { return v * v; });
+    TEST(squares[4] == 25);
+    TS::transform(a.begin(), a.end(), b.begin(), squares.begin(),
+                  [](int l, int r) { return r - l; });
+    TEST(squares[0] == 9 && squares[4] == 45);
+}
+
 int main()
 {
     std::cout << "Starting TS::array tests..." << std::endl;
@@ -644,10 +815,13 @@ int main()
     test_fill();
     test_swap();
     test_equality_operator();
+    test_relational_operators();
     test_get_functions();
     test_zero_sized_array();
     test_const_correctness();
     test_type_traits();
+    test_constexpr();
+    test_alignment_and_bulk_ops();
 
     // 打印测试结果摘要
     print_test_summary();
@@ -0,0 +1,255 @@
+#include "ts_bitset.hpp"
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace TS_Test
+{
+
+// 与 std::vector<bool> 逐位对照 rank/select/find
+template <typename Bits> void check_queries(const Bits &bits, const std::vector<bool> &model)
+{
+    assert(bits.size() == model.size());
+    std::size_t ones = 0;
+    std::vector<std::size_t> positions;
+    for (std::size_t i = 0; i < model.size(); ++i)
+    {
+        assert(bits[i] == model[i]);
+        assert(bits.rank(i) == ones);
+        if (model[i])
+        {
+            positions.push_back(i);
+            ++ones;
+        }
+    }
+    assert(bits.rank(model.size()) == ones);
+    assert(bits.count() == ones);
+    assert(bits.any() == (ones > 0));
+    assert(bits.none() == (ones == 0));
+    assert(bits.all() == (ones == model.size()));
+
+    for (std::size_t k = 0; k < positions.size(); ++k)
+    {
+        assert(bits.select(k) == positions[k]);
+    }
+    assert(bits.select(positions.size()) == Bits::npos);
+
+    std::size_t k = 0;
+    for (std::size_t pos = bits.find_first(); pos != Bits::npos; pos = bits.find_next(pos))
+    {
+        assert(k < positions.size() && pos == positions[k]);
+        ++k;
+    }
+    assert(k == positions.size());
+}
+
+void test_bitset()
+{
+    std::cout << "=== Testing bitset ===" << std::endl;
+
+    TS::bitset<130> b;
+    assert(b.size() == 130 && b.word_count() == 3);
+    assert(b.none() && b.find_first() == b.npos);
+    b.set(0).set(64).set(129);
+    assert(b.count() == 3 && b.test(64) && !b.test(63));
+    assert(b.find_first() == 0 && b.find_next(0) == 64 && b.find_next(64) == 129);
+    assert(b.find_next(129) == b.npos);
+    assert(b.rank(65) == 2 && b.select(2) == 129);
+    b.flip();
+    assert(b.count() == 127 && !b[0] && b[1]);
+    b.set();
+    assert(b.all() && b.count() == 130);
+    b.reset(5);
+    assert(!b.all() && b.count() == 129);
+    assert((~b).count() == 1 && (~b).find_first() == 5);
+
+    // 与 std::bitset 对照按位运算
+    std::mt19937_64 rng(1);
+    std::bitset<1000> sa, sb;
+    TS::bitset<1000> ta, tb;
+    std::vector<bool> model(1000);
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        bool x = rng() % 3 == 0;
+        bool y = rng() % 2 == 0;
+        sa[i] = x;
+        sb[i] = y;
+        ta.set(i, x);
+        tb.set(i, y);
+        model[i] = x;
+    }
+    check_queries(ta, model);
+    auto same = [](const TS::bitset<1000> &t, const std::bitset<1000> &s) {
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            if (t[i] != s[i])
+            {
+                return false;
+            }
+        }
+        return t.count() == s.count();
+    };
+    assert(same(ta & tb, sa & sb));
+    assert(same(ta | tb, sa | sb));
+    assert(same(ta ^ tb, sa ^ sb));
+    assert(same(TS::bitset<1000>(ta).and_not(tb), sa & ~sb));
+    assert(same(~ta, ~sa));
+    assert(ta == ta && ta != tb);
+
+    // 构造时丢弃超出 N 的位
+    TS::bitset<10> small(0xffffull);
+    assert(small.count() == 10 && small.all());
+    TS::bitset<0> empty;
+    assert(empty.none() && empty.all() && empty.count() == 0 && empty.find_first() == empty.npos);
+
+    std::cout << "All bitset tests passed!" << std::endl;
+}
+
+void test_dynamic_bitset()
+{
+    std::cout << "=== Testing dynamic_bitset ===" << std::endl;
+
+    TS::dynamic_bitset<> d;
+    assert(d.empty() && d.find_first() == d.npos && d.all() && d.none());
+    std::vector<bool> model;
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+        d.push_back(i % 7 == 0);
+        model.push_back(i % 7 == 0);
+    }
+    check_queries(d, model);
+
+    // 扩大时新位取给定值, 原最后一个字中的空位同样被填充
+    d.resize(300, true);
+    model.resize(300, true);
+    check_queries(d, model);
+    d.resize(130);
+    model.resize(130);
+    check_queries(d, model);
+    d.resize(1000);
+    model.resize(1000);
+    check_queries(d, model);
+
+    TS::dynamic_bitset<> ones(77, true);
+    assert(ones.count() == 77 && ones.all() && ones.word_count() == 2);
+    assert((~ones).none());
+
+    // 大位图上的按位运算经过向量内核, 并覆盖不足一个向量的尾部
+    for (std::size_t size : {0, 1, 63, 64, 65, 1000, 20011})
+    {
+        std::mt19937_64 rng(size);
+        TS::dynamic_bitset<> a(size), b(size);
+        std::vector<bool> ma(size), mb(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            ma[i] = rng() % 4 == 0;
+            mb[i] = rng() % 2 == 0;
+            a.set(i, ma[i]);
+            b.set(i, mb[i]);
+        }
+        check_queries(a, ma);
+
+        std::vector<bool> m_and(size), m_or(size), m_xor(size), m_andnot(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            m_and[i] = ma[i] && mb[i];
+            m_or[i] = ma[i] || mb[i];
+            m_xor[i] = ma[i] != mb[i];
+            m_andnot[i] = ma[i] && !mb[i];
+        }
+        check_queries(a & b, m_and);
+        check_queries(a | b, m_or);
+        check_queries(a ^ b, m_xor);
+        check_queries(TS::dynamic_bitset<>(a).and_not(b), m_andnot);
+        assert((a ^ a).none());
+        assert(((a | b) == (b | a)));
+    }
+
+    // 移动后源对象为空位图, 仍可继续使用
+    TS::dynamic_bitset<> source(100, true);
+    TS::dynamic_bitset<> moved(std::move(source));
+    assert(moved.size() == 100 && moved.count() == 100);
+    assert(source.size() == 0 && source.word_count() == 0);
+    assert(!source.any() && source.count() == 0 && source.find_first() == source.npos);
+    source.set();
+    source.push_back(true);
+    assert(source.size() == 1 && source.count() == 1);
+    TS::dynamic_bitset<> target(7);
+    target = std::move(moved);
+    assert(target.size() == 100 && target.all());
+    assert(moved.empty() && moved.word_count() == 0 && moved.count() == 0);
+    moved.resize(70, true);
+    assert(moved.count() == 70);
+
+    TS::dynamic_bitset<> x(10), y(20);
+    x.swap(y);
+    assert(x.size() == 20 && y.size() == 10);
+    x.clear();
+    assert(x.empty() && x.word_count() == 0);
+
+    std::cout << "All dynamic_bitset tests passed!" << std::endl;
+}
+
+void test_exceptions()
+{
+    std::cout << "=== Testing exceptions ===" << std::endl;
+
+    TS::bitset<8> b;
+    bool caught = false;
+    try
+    {
+        b.test(8);
+    }
+    catch (const std::out_of_range &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    TS::dynamic_bitset<> d(8);
+    caught = false;
+    try
+    {
+        d.set(9);
+    }
+    catch (const std::out_of_range &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    caught = false;
+    try
+    {
+        d |= TS::dynamic_bitset<>(9);
+    }
+    catch (const std::invalid_argument &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    std::cout << "All exceptions tests passed!" << std::endl;
+}
+
+void run_all_tests()
+{
+    test_bitset();
+    test_dynamic_bitset();
+    test_exceptions();
+
+    std::cout << "\nAll tests passed! TS::bitset and TS::dynamic_bitset are correct." << std::endl;
+}
+
+} // namespace TS_Test
+
+int main()
+{
+    TS_Test::run_all_tests();
+    return 0;
+}
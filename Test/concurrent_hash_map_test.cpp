@@ -0,0 +1,195 @@
+#include "ts_concurrent_hash_map.hpp"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace TS_Test
+{
+
+void test_basic()
+{
+    std::cout << "=== Testing basic operations ===" << std::endl;
+
+    TS::concurrent_hash_map<std::string, std::string> map;
+    std::string out;
+    assert(map.empty());
+    assert(!map.find("a", out));
+
+    assert(map.insert("a", "1"));
+    assert(!map.insert("a", "2"));
+    assert(map.find("a", out) && out == "1");
+    assert(map.emplace("b", 3, 'x'));
+    assert(map.find("b", out) && out == "xxx");
+    assert(map.contains("b") && !map.contains("c"));
+
+    assert(!map.insert_or_assign("a", "4"));
+    assert(map.find("a", out) && out == "4");
+    assert(map.insert_or_assign("c", std::string("5")));
+    assert(map.size() == 3);
+
+    assert(map.update("c", [](std::string &v) { v += "!"; }));
+    assert(!map.update("d", [](std::string &v) { v += "!"; }));
+    assert(map.find("c", out) && out == "5!");
+
+    assert(map.erase("a"));
+    assert(!map.erase("a"));
+    assert(!map.contains("a"));
+    assert(map.size() == 2);
+
+    std::size_t visited = 0;
+    map.for_each([&visited](const std::string &key, const std::string &) {
+        assert(key == "b" || key == "c");
+        ++visited;
+    });
+    assert(visited == 2);
+
+    map.clear();
+    assert(map.empty() && !map.contains("b"));
+
+    std::cout << "All basic operations tests passed!" << std::endl;
+}
+
+void test_resize()
+{
+    std::cout << "=== Testing incremental resize ===" << std::endl;
+
+    TS::concurrent_hash_map<int, int> map;
+    std::size_t initial = map.bucket_count();
+    const int N = 20000;
+    for (int i = 0; i < N; ++i)
+    {
+        assert(map.insert(i, i * 2));
+    }
+    assert(map.size() == std::size_t(N));
+    assert(map.bucket_count() > initial);
+    // 迁移过程中或完成后都能找到全部元素
+    int out = 0;
+    for (int i = 0; i < N; ++i)
+    {
+        assert(map.find(i, out) && out == i * 2);
+    }
+
+    // 写操作推动迁移直至完成
+    for (int i = 0; i < N && map.resizing(); ++i)
+    {
+        assert(map.erase(i));
+        assert(map.insert(i, i * 2));
+    }
+    assert(!map.resizing());
+    std::size_t count = 0;
+    map.for_each([&count](int key, int value) {
+        assert(value == key * 2);
+        ++count;
+    });
+    assert(count == std::size_t(N));
+
+    std::cout << "All incremental resize tests passed!" << std::endl;
+}
+
+struct throw_on_copy
+{
+    explicit throw_on_copy(int v) : value(v)
+    {
+    }
+
+    throw_on_copy(const throw_on_copy &other) : value(other.value)
+    {
+        if (value < 0)
+        {
+            throw std::runtime_error("copy");
+        }
+    }
+
+    throw_on_copy &operator=(const throw_on_copy &) = default;
+
+    int value;
+};
+
+void test_exception()
+{
+    std::cout << "=== Testing exception safety ===" << std::endl;
+
+    TS::concurrent_hash_map<int, throw_on_copy> map;
+    assert(map.insert(1, throw_on_copy(1)));
+    bool caught = false;
+    try
+    {
+        map.insert(2, throw_on_copy(-1));
+    }
+    catch (const std::runtime_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+    assert(map.size() == 1 && !map.contains(2));
+
+    std::cout << "All exception safety tests passed!" << std::endl;
+}
+
+// 多线程插入各自的键, 同时读取并修改共享计数器, 期间会发生多次扩容
+void test_concurrent()
+{
+    std::cout << "=== Testing concurrent access ===" << std::endl;
+
+    const int THREADS = 8;
+    const int PER_THREAD = 20000;
+
+    TS::concurrent_hash_map<int, int> map;
+    map.insert(-1, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([&map, t] {
+            int base = t * PER_THREAD;
+            int out = 0;
+            for (int i = 0; i < PER_THREAD; ++i)
+            {
+                assert(map.insert(base + i, i));
+                assert(map.find(base + i, out) && out == i);
+                map.update(-1, [](int &v) { ++v; });
+                // 删除一半
+                if (i % 2 == 1)
+                {
+                    assert(map.erase(base + i - 1));
+                }
+            }
+        });
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    int counter = 0;
+    assert(map.find(-1, counter) && counter == THREADS * PER_THREAD);
+    assert(map.size() == std::size_t(THREADS * PER_THREAD / 2 + 1));
+    int out = 0;
+    for (int k = 0; k < THREADS * PER_THREAD; ++k)
+    {
+        assert(map.find(k, out) == (k % 2 == 1));
+    }
+
+    std::cout << "All concurrent access tests passed!" << std::endl;
+}
+
+void run_all_tests()
+{
+    test_basic();
+    test_resize();
+    test_exception();
+    test_concurrent();
+
+    std::cout << "\nAll tests passed! TS::concurrent_hash_map is correct." << std::endl;
+}
+
+} // namespace TS_Test
+
+int main()
+{
+    TS_Test::run_all_tests();
+    return 0;
+}
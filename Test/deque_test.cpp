@@ -0,0 +1,269 @@
+#include "ts_algorithm.hpp"
+#include "ts_deque.hpp"
+#include "ts_vector.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+using namespace TS;
+
+// 可平凡拷贝但不可赋值: 构造只能在未初始化内存上拷贝构造, 而不能赋值
+struct fixed_point
+{
+    const int x;
+    const int y;
+};
+
+void test_constructors()
+{
+    // 默认构造函数
+    deque<int> d1;
+    assert(d1.size() == 0);
+    assert(d1.empty());
+    assert(d1.begin() == d1.end());
+
+    // 数量和值构造函数 (跨越多个缓冲区)
+    const std::size_t n = deque<int>::iterator::buffer_size() * 3 + 7;
+    deque<int> d2(n, 42);
+    assert(d2.size() == n);
+    for (auto &x : d2)
+        assert(x == 42);
+
+    // 拷贝构造函数
+    deque<int> d3(d2);
+    assert(d3.size() == n);
+    assert(d3 == d2);
+
+    // 移动构造函数
+    deque<int> d4(std::move(d3));
+    assert(d4.size() == n);
+    assert(d3.size() == 0);
+
+    // 初始化列表构造函数
+    deque<int> d5{1, 2, 3, 4, 5};
+    assert(d5.size() == 5);
+    for (int i = 0; i < 5; ++i)
+        assert(d5[i] == i + 1);
+
+    deque<fixed_point> d6(n, fixed_point{3, 4});
+    deque<fixed_point> d7(d6);
+    assert(d7.size() == n && d7[n - 1].x == 3 && d7[0].y == 4);
+    deque<fixed_point> d8{{1, 2}, {5, 6}};
+    assert(d8.size() == 2 && d8[1].x == 5);
+
+    std::cout << "All constructor tests passed!\n";
+}
+
+void test_push_pop()
+{
+    deque<int> d;
+    const int n = 5000;
+    for (int i = 0; i < n; ++i)
+    {
+        d.push_back(i);
+        d.push_front(-i - 1);
+    }
+    assert(d.size() == 2 * n);
+    assert(d.front() == -n);
+    assert(d.back() == n - 1);
+    for (int i = 0; i < 2 * n; ++i)
+        assert(d[i] == i - n);
+
+    for (int i = 0; i < n; ++i)
+    {
+        d.pop_back();
+        d.pop_front();
+    }
+    assert(d.empty());
+
+    d.emplace_back(7);
+    d.emplace_front(6);
+    assert(d.size() == 2 && d.front() == 6 && d.back() == 7);
+
+    std::cout << "All push/pop tests passed!\n";
+}
+
+void test_iterators()
+{
+    deque<int> d;
+    for (int i = 0; i < 1000; ++i)
+        d.push_back(i);
+
+    auto it = d.begin();
+    it += 700;
+    assert(*it == 700);
+    it -= 650;
+    assert(*it == 50);
+    assert(d.end() - d.begin() == 1000);
+    assert((d.begin() + 999) - (d.begin() + 1) == 998);
+    assert(*(d.end() - 1) == 999);
+
+    deque<int>::const_iterator cit = d.begin();
+    assert(cit == d.begin());
+    assert(cit < d.end());
+
+    std::cout << "All iterator tests passed!\n";
+}
+
+void test_modifiers()
+{
+    deque<int> d;
+    for (int i = 0; i < 2000; ++i)
+        d.push_back(i);
+
+    // 靠近头部插入与删除
+    auto it = d.insert(d.begin() + 3, -1);
+    assert(*it == -1);
+    assert(d[3] == -1 && d[4] == 3 && d.size() == 2001);
+    d.erase(d.begin() + 3);
+    assert(d[3] == 3 && d.size() == 2000);
+
+    // 靠近尾部插入与删除
+    it = d.insert(d.end() - 3, -2);
+    assert(*it == -2);
+    assert(d[1997] == -2 && d[1998] == 1997);
+    d.erase(d.end() - 4);
+    assert(d[1997] == 1997);
+
+    // 区间删除
+    d.erase(d.begin() + 100, d.begin() + 1500);
+    assert(d.size() == 600);
+    assert(d[99] == 99 && d[100] == 1500);
+    d.erase(d.begin(), d.begin() + 50);
+    assert(d.front() == 50);
+
+    d.resize(10);
+    assert(d.size() == 10 && d.back() == 59);
+    d.resize(20, 5);
+    assert(d.size() == 20 && d.back() == 5);
+
+    d.assign(3000, 9);
+    assert(d.size() == 3000);
+    for (auto &x : d)
+        assert(x == 9);
+
+    d.clear();
+    assert(d.empty());
+    d.push_back(1);
+    assert(d.front() == 1);
+
+    std::cout << "All modifier tests passed!\n";
+}
+
+void test_segmented_algorithms()
+{
+    deque<int> d;
+    for (int i = 0; i < 3000; ++i)
+        d.push_back(i);
+    for (int i = 0; i < 100; ++i)
+        d.push_front(-1);
+
+    // find
+    auto it = TS::find(d.begin(), d.end(), 2000);
+    assert(it != d.end() && *it == 2000);
+    assert(TS::find(d.begin(), d.end(), 5000) == d.end());
+
+    // accumulate / for_each
+    long long sum = TS::accumulate(d.begin() + 100, d.end(), 0LL);
+    assert(sum == 2999LL * 3000 / 2);
+    int count = 0;
+    TS::for_each(d.begin(), d.end(), [&count](int) { ++count; });
+    assert(count == 3100);
+
+    // fill
+    TS::fill(d.begin() + 10, d.end() - 10, 3);
+    assert(d[9] == -1 && d[10] == 3 && d[3089] == 3 && d[3090] == 2990);
+
+    // copy: deque -> vector -> deque
+    vector<int> v(d.size());
+    TS::copy(d.begin(), d.end(), v.begin());
+    assert(TS::equal(d.begin(), d.end(), v.begin()));
+    assert(TS::equal(v.begin(), v.end(), d.begin()));
+
+    deque<int> d2(d.size(), 0);
+    TS::copy(v.begin(), v.end(), d2.begin() + 0);
+    assert(d2 == d);
+
+    // 未对齐的 deque -> deque 拷贝
+    deque<int> d3(d.size() + 37, 0);
+    auto last = TS::copy(d.begin(), d.end(), d3.begin() + 37);
+    assert(last == d3.end());
+    assert(TS::equal(d.begin(), d.end(), d3.begin() + 37));
+    d3[100] = 12345;
+    assert(!TS::equal(d.begin(), d.end(), d3.begin() + 37));
+
+    // 单字节类型走 memset
+    deque<char> dc(2000, 'a');
+    TS::fill(dc.begin() + 1, dc.end() - 1, 'b');
+    assert(dc.front() == 'a' && dc[1] == 'b' && dc[1998] == 'b' && dc.back() == 'a');
+
+    std::cout << "All segmented algorithm tests passed!\n";
+}
+
+void test_buffer_size()
+{
+    // 缓冲区大小为编译期常量
+    static_assert(deque<int>::iterator::buffer_size() == DEQUE_BUF_BYTES / sizeof(int), "");
+    static_assert(deque<int, alloc, 64>::iterator::buffer_size() == 16, "");
+    static_assert(deque<char[100], alloc, 64>::iterator::buffer_size() == 1, "");
+
+    // 小缓冲区: 大量跨段操作
+    deque<int, alloc, 64> d;
+    for (int i = 0; i < 1000; ++i)
+        d.push_back(i);
+    for (int i = 0; i < 1000; ++i)
+        d.push_front(-i - 1);
+    assert(d.size() == 2000);
+    assert(TS::accumulate(d.begin(), d.end(), 0) == -1000);
+    assert(*TS::find(d.begin(), d.end(), 500) == 500);
+
+    deque<int, alloc, 64> d2(d);
+    assert(d2 == d);
+    d2.erase(d2.begin() + 3, d2.begin() + 1990);
+    assert(d2.size() == 13 && d2[3] == 990);
+
+    deque<int, alloc, 64> d3(2005, 0);
+    TS::copy(d.begin(), d.end(), d3.begin() + 5);
+    assert(TS::equal(d.begin(), d.end(), d3.begin() + 5));
+
+    std::cout << "All buffer size tests passed!\n";
+}
+
+void test_strings()
+{
+    deque<std::string> d(3, "x");
+    d.push_back("hello");
+    d.push_front("world");
+    for (int i = 0; i < 100; ++i)
+        d.emplace_back(10, 'a');
+    assert(d.size() == 105);
+    assert(d.front() == "world");
+    assert(d[4] == "hello");
+    assert(d.back() == std::string(10, 'a'));
+
+    deque<std::string> copy(d);
+    assert(copy == d);
+    d.insert(d.begin() + 2, "mid");
+    assert(d[2] == "mid" && d[3] == "x");
+    d.erase(d.begin() + 2, d.begin() + 4);
+    assert(d[2] == "x" && d.size() == 104);
+
+    copy = d;
+    assert(copy == d);
+
+    std::cout << "All string tests passed!\n";
+}
+
+int main()
+{
+    test_constructors();
+    test_push_pop();
+    test_iterators();
+    test_modifiers();
+    test_segmented_algorithms();
+    test_buffer_size();
+    test_strings();
+
+    std::cout << "\nAll tests passed! Deque implementation is correct.\n";
+    return 0;
+}
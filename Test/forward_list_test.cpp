@@ -0,0 +1,282 @@
+#include "ts_alloc_profile.hpp"
+#include "ts_forward_list.hpp"
+#include "ts_list.hpp"
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace TS_Test
+{
+
+template <typename List> std::vector<typename List::value_type> to_vector(const List &list)
+{
+    std::vector<typename List::value_type> result;
+    for (const auto &value : list)
+    {
+        result.push_back(value);
+    }
+    return result;
+}
+
+void test_constructors_and_assignment()
+{
+    std::cout << "=== Testing constructors and assignment ===" << std::endl;
+
+    {
+        TS::forward_list<int> list;
+        assert(list.empty());
+        assert(list.begin() == list.end());
+    }
+
+    {
+        TS::forward_list<int> list(3, 42);
+        assert((to_vector(list) == std::vector<int>{42, 42, 42}));
+        TS::forward_list<int> zeros(2);
+        assert((to_vector(zeros) == std::vector<int>{0, 0}));
+    }
+
+    {
+        TS::forward_list<int> original{1, 2, 3};
+        TS::forward_list<int> copy(original);
+        assert(copy == original);
+        TS::forward_list<int> moved(std::move(original));
+        assert(moved == copy);
+        assert(original.empty());
+
+        std::vector<int> source{5, 6, 7};
+        TS::forward_list<int> ranged(source.begin(), source.end());
+        assert(to_vector(ranged) == source);
+    }
+
+    {
+        TS::forward_list<int> list1{1, 2, 3};
+        TS::forward_list<int> list2{9};
+        list2 = list1;
+        assert(list2 == list1);
+        list2 = list2;
+        assert(list2 == list1);
+        list1 = {4, 5};
+        assert((to_vector(list1) == std::vector<int>{4, 5}));
+        list2 = std::move(list1);
+        assert(list1.empty());
+        assert((to_vector(list2) == std::vector<int>{4, 5}));
+        list2.assign({7, 8, 9});
+        assert((to_vector(list2) == std::vector<int>{7, 8, 9}));
+        TS::swap(list1, list2);
+        assert(list2.empty() && list1.front() == 7);
+        assert(list2 < list1 && list1 != list2);
+    }
+
+    std::cout << "All constructor and assignment tests passed!" << std::endl;
+}
+
+void test_modifiers()
+{
+    std::cout << "=== Testing modifiers ===" << std::endl;
+
+    TS::forward_list<std::string> list;
+    list.push_front("c");
+    list.emplace_front(1, 'b');
+    std::string a = "a";
+    list.push_front(a);
+    assert((to_vector(list) == std::vector<std::string>{"a", "b", "c"}));
+
+    auto it = list.insert_after(list.begin(), "x");
+    assert(*it == "x");
+    it = list.emplace_after(it, 2, 'y');
+    assert(*it == "yy");
+    it = list.insert_after(list.before_begin(), 2, "z");
+    assert(*it == "z");
+    assert((to_vector(list) == std::vector<std::string>{"z", "z", "a", "x", "yy", "b", "c"}));
+
+    it = list.erase_after(list.begin());
+    assert(*it == "a");
+    it = list.erase_after(list.begin(), ++++list.begin());
+    assert(*it == "x");
+    assert((to_vector(list) == std::vector<std::string>{"z", "x", "yy", "b", "c"}));
+
+    // 批量插入返回最后一个元素, 空区间返回 pos
+    std::vector<std::string> more{"m", "n"};
+    it = list.insert_after(list.begin(), more.begin(), more.end());
+    assert(*it == "n");
+    assert(list.insert_after(list.begin(), more.end(), more.end()) == list.begin());
+    it = list.insert_after(it, {"o", "p"});
+    assert(*it == "p");
+    assert((to_vector(list) ==
+            std::vector<std::string>{"z", "m", "n", "o", "p", "x", "yy", "b", "c"}));
+
+    list.reverse();
+    assert(list.front() == "c");
+    list.pop_front();
+    assert(list.front() == "b");
+    list.erase_after(list.before_begin(), list.end());
+    assert(list.empty());
+
+    bool caught = false;
+    try
+    {
+        list.pop_front();
+    }
+    catch (const std::range_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    std::cout << "All modifier tests passed!" << std::endl;
+}
+
+void test_splice()
+{
+    std::cout << "=== Testing splice_after ===" << std::endl;
+
+    TS::forward_list<int> a{1, 2, 3};
+    TS::forward_list<int> b{10, 20, 30, 40};
+
+    // 单个元素: 20 移到 a 的 1 之后
+    a.splice_after(a.begin(), b, b.begin());
+    assert((to_vector(a) == std::vector<int>{1, 20, 2, 3}));
+    assert((to_vector(b) == std::vector<int>{10, 30, 40}));
+
+    // 区间 (10, end) 即 30, 40 移到 a 表头
+    b.splice_after(b.before_begin(), b, b.before_begin());
+    a.splice_after(a.before_begin(), b, b.begin(), b.end());
+    assert((to_vector(a) == std::vector<int>{30, 40, 1, 20, 2, 3}));
+    assert((to_vector(b) == std::vector<int>{10}));
+
+    // 全部元素
+    auto last = a.begin();
+    for (int i = 0; i < 5; ++i)
+    {
+        ++last;
+    }
+    a.splice_after(last, b);
+    assert(b.empty());
+    assert((to_vector(a) == std::vector<int>{30, 40, 1, 20, 2, 3, 10}));
+    a.splice_after(a.begin(), TS::forward_list<int>{7});
+    assert((to_vector(a) == std::vector<int>{30, 7, 40, 1, 20, 2, 3, 10}));
+
+    // 同一链表内移动
+    a.splice_after(a.before_begin(), a, a.begin());
+    assert(a.front() == 7);
+
+    std::cout << "All splice_after tests passed!" << std::endl;
+}
+
+struct throw_on_copy
+{
+    static int live;
+    int value;
+
+    throw_on_copy(int v) : value(v)
+    {
+        ++live;
+    }
+
+    throw_on_copy(const throw_on_copy &other) : value(other.value)
+    {
+        if (value < 0)
+        {
+            throw std::runtime_error("copy failed");
+        }
+        ++live;
+    }
+
+    ~throw_on_copy()
+    {
+        --live;
+    }
+};
+
+int throw_on_copy::live = 0;
+
+void test_exception_safety()
+{
+    std::cout << "=== Testing exception safety ===" << std::endl;
+
+    {
+        std::vector<throw_on_copy> source;
+        source.reserve(4);
+        for (int value : {1, 2, -3, 4})
+        {
+            source.emplace_back(value);
+        }
+        TS::forward_list<throw_on_copy> list;
+        list.emplace_front(0);
+        bool caught = false;
+        try
+        {
+            list.insert_after(list.begin(), source.begin(), source.end());
+        }
+        catch (const std::runtime_error &)
+        {
+            caught = true;
+        }
+        // 失败时已构造的链全部释放, 原链表不变
+        assert(caught);
+        assert(list.front().value == 0 && ++list.begin() == list.end());
+        assert(throw_on_copy::live == 5);
+    }
+    assert(throw_on_copy::live == 0);
+
+    std::cout << "All exception safety tests passed!" << std::endl;
+}
+
+struct list_tag
+{
+};
+struct forward_tag
+{
+};
+
+// 每个节点少一个指针; 两者的节点都从内存池分配
+void test_node_overhead()
+{
+    std::cout << "=== Testing node overhead ===" << std::endl;
+
+    using list_alloc = TS::profiled_alloc<TS::alloc, list_tag>;
+    using forward_alloc = TS::profiled_alloc<TS::alloc, forward_tag>;
+    static_assert(sizeof(TS::forward_list<void *>::Node) == 2 * sizeof(void *),
+                  "forward_list node is a link plus the value");
+    static_assert(sizeof(TS::forward_list<void *>::Node) < sizeof(TS::list<void *>::Node),
+                  "forward_list node must be smaller than list node");
+
+    std::vector<void *> values(1000, nullptr);
+    {
+        TS::list<void *, list_alloc> list;
+        for (void *value : values)
+        {
+            list.push_back(value);
+        }
+        TS::forward_list<void *, forward_alloc> forward(values.begin(), values.end());
+        TS::alloc_stats list_stats = list_alloc::stats();
+        TS::alloc_stats forward_stats = forward_alloc::stats();
+        assert(forward_stats.allocations == 1000);
+        assert(forward_stats.bytes_allocated == 1000 * 2 * sizeof(void *));
+        assert(list_stats.bytes_allocated >= 1000 * 3 * sizeof(void *));
+    }
+    assert(TS::expect_no_leaks(forward_alloc::stats()));
+
+    std::cout << "All node overhead tests passed!" << std::endl;
+}
+
+void run_all_tests()
+{
+    test_constructors_and_assignment();
+    test_modifiers();
+    test_splice();
+    test_exception_safety();
+    test_node_overhead();
+
+    std::cout << "\nAll tests passed! TS::forward_list is correct." << std::endl;
+}
+
+} // namespace TS_Test
+
+int main()
+{
+    TS_Test::run_all_tests();
+    return 0;
+}
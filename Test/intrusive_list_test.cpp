@@ -0,0 +1,282 @@
+#include "ts_intrusive_list.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace TS_Test
+{
+
+struct entry
+{
+    int key;
+    std::string value;
+    TS::Intrusive_hook lru_hook;
+    TS::Intrusive_hook timer_hook;
+
+    entry(int k = 0) : key(k), value(std::to_string(k))
+    {
+    }
+};
+
+using lru_list = TS::intrusive_list<entry, &entry::lru_hook>;
+using timer_list = TS::intrusive_list<entry, &entry::timer_hook>;
+
+void test_basic_operations()
+{
+    std::cout << "=== Testing basic operations ===" << std::endl;
+
+    std::vector<entry> entries;
+    for (int i = 0; i < 5; ++i)
+    {
+        entries.emplace_back(i);
+    }
+
+    lru_list list;
+    assert(list.empty() && list.begin() == list.end());
+    for (entry &e : entries)
+    {
+        list.push_back(e);
+        assert(e.lru_hook.is_linked());
+    }
+    assert(list.size() == 5);
+    assert(list.front().key == 0 && list.back().key == 4);
+
+    int expected = 0;
+    for (const entry &e : list)
+    {
+        assert(e.key == expected++);
+        assert(&e == &entries[e.key]);
+    }
+    auto it = list.end();
+    while (it != list.begin())
+    {
+        --it;
+        assert(it->key == --expected);
+    }
+
+    // 任意位置 O(1) 摘下
+    list.erase(entries[2]);
+    assert(!entries[2].lru_hook.is_linked());
+    assert(list.size() == 4);
+    list.insert(list.iterator_to(entries[1]), entries[2]);
+    int order[] = {0, 2, 1, 3, 4};
+    int i = 0;
+    for (const entry &e : list)
+    {
+        assert(e.key == order[i++]);
+    }
+
+    list.pop_front();
+    list.pop_back();
+    assert(list.size() == 3 && list.front().key == 2 && list.back().key == 3);
+    assert(!entries[0].lru_hook.is_linked() && !entries[4].lru_hook.is_linked());
+
+    // 复制对象不复制钩子
+    entry copy = entries[2];
+    assert(!copy.lru_hook.is_linked());
+    assert(entries[2].lru_hook.is_linked());
+
+    list.clear();
+    assert(list.empty());
+    for (const entry &e : entries)
+    {
+        assert(!e.lru_hook.is_linked());
+    }
+
+    bool caught = false;
+    try
+    {
+        list.pop_back();
+    }
+    catch (const std::range_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    std::cout << "All basic operation tests passed!" << std::endl;
+}
+
+void test_multiple_hooks()
+{
+    std::cout << "=== Testing multiple hooks ===" << std::endl;
+
+    std::vector<entry> entries;
+    for (int i = 0; i < 4; ++i)
+    {
+        entries.emplace_back(i);
+    }
+    lru_list lru;
+    timer_list timers;
+    for (entry &e : entries)
+    {
+        lru.push_back(e);
+        timers.push_front(e);
+    }
+    assert(lru.front().key == 0 && timers.front().key == 3);
+
+    // 同一对象同时在两个链表中, 各自独立摘下
+    timers.erase(entries[1]);
+    assert(entries[1].lru_hook.is_linked() && !entries[1].timer_hook.is_linked());
+    assert(lru.size() == 4 && timers.size() == 3);
+
+    std::cout << "All multiple hook tests passed!" << std::endl;
+}
+
+void test_splice_and_move()
+{
+    std::cout << "=== Testing splice and move ===" << std::endl;
+
+    std::vector<entry> entries;
+    for (int i = 0; i < 6; ++i)
+    {
+        entries.emplace_back(i);
+    }
+    lru_list a;
+    lru_list b;
+    for (int i = 0; i < 3; ++i)
+    {
+        a.push_back(entries[i]);
+        b.push_back(entries[i + 3]);
+    }
+
+    // 提到队首
+    a.splice(a.begin(), a, a.iterator_to(entries[2]));
+    assert(a.front().key == 2 && a.back().key == 1 && a.size() == 3);
+    a.splice(a.begin(), a, a.begin());
+    assert(a.front().key == 2);
+
+    // 跨链表移动单个元素与全部元素
+    a.splice(a.end(), b, b.begin());
+    assert(a.size() == 4 && b.size() == 2 && a.back().key == 3);
+    a.splice(a.begin(), b);
+    assert(a.size() == 6 && b.empty());
+    int order[] = {4, 5, 2, 0, 1, 3};
+    int i = 0;
+    for (const entry &e : a)
+    {
+        assert(e.key == order[i++]);
+    }
+
+    lru_list moved(std::move(a));
+    assert(a.empty() && moved.size() == 6);
+    assert(&*(--moved.end()) == &entries[3]);
+    a = std::move(moved);
+    assert(moved.empty() && a.size() == 6);
+    a.swap(b);
+    assert(a.empty() && b.size() == 6 && b.front().key == 4);
+    b.erase(b.begin(), b.end());
+    assert(b.empty());
+
+    std::cout << "All splice and move tests passed!" << std::endl;
+}
+
+// LRU 缓存: 命中时提到队首, 满时淘汰队尾; 元素始终留在 pool 中
+void test_lru()
+{
+    std::cout << "=== Testing LRU ===" << std::endl;
+
+    std::vector<entry> pool;
+    for (int i = 0; i < 64; ++i)
+    {
+        pool.emplace_back(i);
+    }
+    lru_list lru;
+    const std::size_t capacity = 16;
+    int evicted = 0;
+    int hits = 0;
+
+    for (int round = 0; round < 1000; ++round)
+    {
+        // 少量热点元素反复命中, 其余元素轮流进入并被淘汰
+        entry &e = pool[round % 5 == 0 ? round % 64 : round % 12];
+        if (e.lru_hook.is_linked())
+        {
+            ++hits;
+            lru.splice(lru.begin(), lru, lru.iterator_to(e));
+        }
+        else
+        {
+            if (lru.size() == capacity)
+            {
+                lru.pop_back();
+                ++evicted;
+            }
+            lru.push_front(e);
+        }
+        assert(&lru.front() == &e);
+    }
+    assert(lru.size() == capacity);
+    assert(evicted > 0 && hits > 0);
+
+    std::cout << "All LRU tests passed!" << std::endl;
+}
+
+// 带虚函数与虚基类, 不是标准布局类型
+struct shape_base
+{
+    int id = 0;
+};
+
+struct shape : virtual shape_base
+{
+    TS::Intrusive_hook hook;
+
+    virtual ~shape() = default;
+
+    virtual int sides() const
+    {
+        return 0;
+    }
+};
+
+struct square : shape
+{
+    int sides() const override
+    {
+        return 4;
+    }
+};
+
+void test_non_standard_layout()
+{
+    std::cout << "=== Testing non-standard-layout elements ===" << std::endl;
+
+    shape circle;
+    square box;
+    box.id = 7;
+    TS::intrusive_list<shape, &shape::hook> shapes;
+    shapes.push_back(circle);
+    shapes.push_back(box);
+    assert(&shapes.front() == &circle && &shapes.back() == &box);
+    assert(shapes.back().sides() == 4 && shapes.back().id == 7);
+
+    // 副本的钩子未链接, 也不指向原对象
+    shape copy = circle;
+    assert(!copy.hook.is_linked());
+    shapes.push_front(copy);
+    assert(&shapes.front() == &copy && &*++shapes.begin() == &circle);
+    shapes.clear();
+
+    std::cout << "All non-standard-layout tests passed!" << std::endl;
+}
+
+void run_all_tests()
+{
+    test_basic_operations();
+    test_multiple_hooks();
+    test_splice_and_move();
+    test_lru();
+    test_non_standard_layout();
+
+    std::cout << "\nAll tests passed! TS::intrusive_list is correct." << std::endl;
+}
+
+} // namespace TS_Test
+
+int main()
+{
+    TS_Test::run_all_tests();
+    return 0;
+}
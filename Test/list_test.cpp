@@ -589,6 +589,59 @@ void test_assign()
     std::cout << "All assign tests passed!" << std::endl;
 }
 
+// 不可默认构造, 不可移动的类型; 统计构造次数
+struct pinned
+{
+    static int constructions;
+    int a;
+    std::string b;
+
+    pinned(int x, const std::string &y) : a(x), b(y)
+    {
+        ++constructions;
+    }
+
+    pinned(const pinned &) = delete;
+    pinned &operator=(const pinned &) = delete;
+};
+
+int pinned::constructions = 0;
+
+void test_emplace_in_place()
+{
+    std::cout << "=== Testing in-place emplace ===" << std::endl;
+
+    {
+        // 空链表与哨兵都不构造 T
+        TS::list<pinned> list;
+        assert(pinned::constructions == 0);
+        assert(list.empty() && list.size() == 0);
+
+        list.emplace_back(1, "one");
+        list.emplace_front(0, "zero");
+        auto it = list.emplace(list.end(), 2, "two");
+        assert(pinned::constructions == 3);
+        assert(it->a == 2 && it->b == "two");
+        assert(list.size() == 3);
+        assert(list.front().a == 0 && list.back().b == "two");
+
+        list.erase(list.begin());
+        assert(list.size() == 2 && list.front().b == "one");
+
+        // 交换与移动只修改链接
+        TS::list<pinned> other;
+        other.swap(list);
+        assert(list.empty() && other.size() == 2);
+        TS::list<pinned> moved(std::move(other));
+        assert(other.empty() && moved.size() == 2 && moved.back().a == 2);
+        other = std::move(moved);
+        assert(moved.empty() && other.front().a == 1);
+        assert(pinned::constructions == 3);
+    }
+
+    std::cout << "In-place emplace test passed!" << std::endl;
+}
+
 void run_all_tests()
 {
     std::cout << "Starting comprehensive TS::list tests..." << std::endl;
@@ -607,6 +660,7 @@ void run_all_tests()
     test_performance();
     test_iterator_validity();
     test_assign();
+    test_emplace_in_place();
 
     std::cout << "\n🎉 All TS::list tests passed successfully! 🎉" << std::endl;
 }
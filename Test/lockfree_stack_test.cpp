@@ -0,0 +1,178 @@
+#include "ts_lockfree_stack.hpp"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace TS_Test
+{
+
+void test_tagged_ptr()
+{
+    std::cout << "=== Testing tagged_ptr ===" << std::endl;
+
+    int value = 0;
+    TS::tagged_ptr p(&value, 7);
+    assert(p.get<int>() == &value && p.tag() == 7);
+    TS::tagged_ptr q = p.next(nullptr);
+    assert(q.get<int>() == nullptr && q.tag() == 8);
+    // 版本号回绕时不影响地址
+    TS::tagged_ptr r = TS::tagged_ptr(&value, 0xffff).next(&value);
+    assert(r.get<int>() == &value && r.tag() == 0);
+    assert(std::atomic<TS::tagged_ptr>().is_lock_free());
+
+    std::cout << "All tagged_ptr tests passed!" << std::endl;
+}
+
+void test_single_thread()
+{
+    std::cout << "=== Testing single thread ===" << std::endl;
+
+    TS::lockfree_stack<std::string> stack;
+    std::string out;
+    assert(stack.empty());
+    assert(!stack.pop(out));
+
+    stack.push("a");
+    std::string b = "b";
+    stack.push(b);
+    stack.emplace(3, 'c');
+    assert(!stack.empty());
+    assert(stack.pop(out) && out == "ccc");
+    assert(stack.pop(out) && out == "b");
+
+    // 回收的节点被再次使用
+    stack.push("d");
+    stack.push("e");
+    std::vector<std::string> all;
+    std::size_t count = stack.pop_all([&all](std::string &&s) { all.push_back(std::move(s)); });
+    assert(count == 3);
+    assert((all == std::vector<std::string>{"e", "d", "a"}));
+    assert(stack.empty());
+    assert(stack.pop_all([](std::string &&) {}) == 0);
+
+    // 析构时释放剩余元素
+    stack.push(std::string(100, 'x'));
+
+    std::cout << "All single thread tests passed!" << std::endl;
+}
+
+void test_pop_all_exception()
+{
+    std::cout << "=== Testing pop_all exception ===" << std::endl;
+
+    TS::lockfree_stack<int> stack;
+    for (int i = 0; i < 5; ++i)
+    {
+        stack.push(i);
+    }
+    std::vector<int> seen;
+    bool caught = false;
+    try
+    {
+        stack.pop_all([&seen](int &&v) {
+            if (v == 2)
+            {
+                throw std::runtime_error("stop");
+            }
+            seen.push_back(v);
+        });
+    }
+    catch (const std::runtime_error &)
+    {
+        caught = true;
+    }
+    // 4, 3 已处理, 2 抛出异常后丢弃, 1, 0 放回栈中
+    assert(caught);
+    assert((seen == std::vector<int>{4, 3}));
+    int out = -1;
+    assert(stack.pop(out) && out == 1);
+    assert(stack.pop(out) && out == 0);
+    assert(!stack.pop(out));
+
+    std::cout << "All pop_all exception tests passed!" << std::endl;
+}
+
+// 多个生产者与消费者并发操作, 每个值恰好被取出一次
+void test_concurrent()
+{
+    std::cout << "=== Testing concurrent push/pop ===" << std::endl;
+
+    const int PRODUCERS = 4;
+    const int CONSUMERS = 4;
+    const int PER_PRODUCER = 50000;
+    const int TOTAL = PRODUCERS * PER_PRODUCER;
+
+    TS::lockfree_stack<int> stack;
+    std::vector<std::atomic<int>> seen(TOTAL);
+    for (auto &flag : seen)
+    {
+        flag.store(0);
+    }
+    std::atomic<int> consumed(0);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < PRODUCERS; ++p)
+    {
+        threads.emplace_back([&stack, p] {
+            for (int i = 0; i < PER_PRODUCER; ++i)
+            {
+                stack.push(p * PER_PRODUCER + i);
+            }
+        });
+    }
+    for (int c = 0; c < CONSUMERS; ++c)
+    {
+        threads.emplace_back([&, c] {
+            int value = 0;
+            while (consumed.load() < TOTAL)
+            {
+                if (c == 0)
+                {
+                    // 一个消费者用批量取出
+                    int n = int(stack.pop_all([&seen](int &&v) { seen[v].fetch_add(1); }));
+                    consumed.fetch_add(n);
+                }
+                else if (stack.pop(value))
+                {
+                    seen[value].fetch_add(1);
+                    consumed.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    assert(consumed.load() == TOTAL);
+    assert(stack.empty());
+    for (auto &flag : seen)
+    {
+        assert(flag.load() == 1);
+    }
+
+    std::cout << "All concurrent tests passed!" << std::endl;
+}
+
+void run_all_tests()
+{
+    test_tagged_ptr();
+    test_single_thread();
+    test_pop_all_exception();
+    test_concurrent();
+
+    std::cout << "\nAll tests passed! TS::lockfree_stack is correct." << std::endl;
+}
+
+} // namespace TS_Test
+
+int main()
+{
+    TS_Test::run_all_tests();
+    return 0;
+}
@@ -0,0 +1,252 @@
+#include "ts_array.hpp"
+#include "ts_deque.hpp"
+#include "ts_parallel.hpp"
+#include "ts_string.hpp"
+#include "ts_vector.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace TS;
+
+// 小粒度与固定线程数, 保证单核机器上也会切分为多个任务并启动多个线程
+const parallel::policy small(7, 4);
+
+void test_for_each_transform()
+{
+    vector<int> v(1000, 1);
+    parallel::for_each(small, v.begin(), v.end(), [](int &x) { x *= 3; });
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+        assert(v[i] == 3);
+    }
+
+    vector<double> out(1000, 0.0);
+    parallel::transform(small, v.begin(), v.end(), out.begin(), [](int x) { return x * 0.5; });
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        assert(out[i] == 1.5);
+    }
+
+    array<int, 100> a;
+    for (int i = 0; i < 100; ++i)
+    {
+        a[i] = i;
+    }
+    array<int, 100> b;
+    parallel::transform(small, a.begin(), a.end(), a.begin(), b.begin(),
+                        [](int x, int y) { return x * y; });
+    for (int i = 0; i < 100; ++i)
+    {
+        assert(b[i] == i * i);
+    }
+
+    // deque 迭代器同样是随机访问的
+    deque<int> d(500, 2);
+    parallel::for_each(small, d.begin(), d.end(), [](int &x) { ++x; });
+    assert(std::count(d.begin(), d.end(), 3) == 500);
+
+    // 空区间
+    parallel::for_each(small, v.begin(), v.begin(), [](int &) { assert(false); });
+
+    std::cout << "All for_each/transform tests passed!\n";
+}
+
+void test_reduce()
+{
+    vector<long long> v;
+    for (int i = 1; i <= 10000; ++i)
+    {
+        v.push_back(i);
+    }
+    assert(parallel::reduce(small, v.begin(), v.end(), 0LL) == 50005000LL);
+    assert(parallel::reduce(v.begin(), v.end(), 5LL) == 50005005LL);
+    assert(parallel::reduce(small, v.begin(), v.begin() + 1, 0LL) == 1);
+    assert(parallel::reduce(small, v.begin(), v.begin(), 42LL) == 42);
+
+    // 非交换运算: 结果保持区间顺序
+    vector<string> words;
+    for (int i = 0; i < 200; ++i)
+    {
+        words.push_back(string(1, char('a' + i % 26)));
+    }
+    string joined = parallel::reduce(small, words.begin(), words.end(), string(">"));
+    std::string expected = ">";
+    for (int i = 0; i < 200; ++i)
+    {
+        expected += char('a' + i % 26);
+    }
+    assert(joined == expected.c_str());
+
+    vector<double> x(1000, 2.0), y(1000, 0.5);
+    assert(parallel::transform_reduce(small, x.begin(), x.end(), y.begin(), 0.0) == 1000.0);
+    assert(parallel::transform_reduce(small, v.begin(), v.end(), 0LL, plus_op(),
+                                      [](long long n) { return n % 2; }) == 5000);
+
+    std::cout << "All reduce tests passed!\n";
+}
+
+void test_scan()
+{
+    for (std::size_t n : {0, 1, 6, 7, 8, 100, 1001})
+    {
+        vector<int> v;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            v.push_back(int(i % 13) - 6);
+        }
+        std::vector<int> expected(n);
+        std::partial_sum(v.begin(), v.end(), expected.begin());
+
+        vector<int> out(n, 0);
+        assert(parallel::inclusive_scan(small, v.begin(), v.end(), out.begin()) == out.end());
+        assert(std::equal(out.begin(), out.end(), expected.begin()));
+
+        parallel::inclusive_scan(small, v.begin(), v.end(), out.begin(), plus_op(), 10);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            assert(out[i] == expected[i] + 10);
+        }
+
+        parallel::exclusive_scan(small, v.begin(), v.end(), out.begin(), 0);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            assert(out[i] == (i == 0 ? 0 : expected[i - 1]));
+        }
+
+        // 原地扫描
+        parallel::exclusive_scan(small, v.begin(), v.end(), v.begin(), 1);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            assert(v[i] == (i == 0 ? 1 : expected[i - 1] + 1));
+        }
+    }
+
+    std::cout << "All scan tests passed!\n";
+}
+
+struct record
+{
+    int key;
+    int order;
+};
+
+void test_sort()
+{
+    std::srand(7);
+    for (std::size_t n : {0, 1, 5, 64, 1000, 5000})
+    {
+        vector<int> v;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            v.push_back(std::rand() % 1000);
+        }
+        std::vector<int> expected(v.begin(), v.end());
+        std::sort(expected.begin(), expected.end());
+
+        parallel::sort(small, v.begin(), v.end());
+        assert(std::equal(v.begin(), v.end(), expected.begin()));
+
+        parallel::sort(small, v.begin(), v.end(), [](int a, int b) { return a > b; });
+        assert(std::equal(v.begin(), v.end(), expected.rbegin()));
+
+        // 叶子排序为 TS::sort, deque 迭代器同样适用
+        deque<int> d;
+        for (int x : expected)
+        {
+            d.push_front(x);
+        }
+        parallel::sort(small, d.begin(), d.end());
+        assert(std::equal(expected.begin(), expected.end(), d.begin()));
+    }
+
+    // 稳定性: 相同 key 保持原始次序
+    vector<record> records;
+    for (int i = 0; i < 3000; ++i)
+    {
+        records.push_back(record{std::rand() % 10, i});
+    }
+    parallel::stable_sort(small, records.begin(), records.end(),
+                          [](const record &a, const record &b) { return a.key < b.key; });
+    for (std::size_t i = 1; i < records.size(); ++i)
+    {
+        assert(records[i - 1].key <= records[i].key);
+        if (records[i - 1].key == records[i].key)
+        {
+            assert(records[i - 1].order < records[i].order);
+        }
+    }
+
+    // 非平凡元素类型经由辅助缓冲区移动
+    vector<string> names;
+    for (int i = 0; i < 500; ++i)
+    {
+        names.push_back(string(30 + i % 7, char('a' + (i * 7) % 26)));
+    }
+    parallel::stable_sort(small, names.begin(), names.end());
+    for (std::size_t i = 1; i < names.size(); ++i)
+    {
+        assert(!(names[i] < names[i - 1]));
+    }
+
+    std::cout << "All sort tests passed!\n";
+}
+
+void test_concurrency_limit()
+{
+    // 同时执行的块数不超过 policy 的 concurrency
+    const parallel::policy two(1, 2);
+    std::atomic<int> active(0);
+    std::atomic<int> peak(0);
+    vector<int> v(200, 0);
+    parallel::for_each(two, v.begin(), v.end(), [&](int &x) {
+        int now = active.fetch_add(1) + 1;
+        for (int seen = peak.load(); now > seen && !peak.compare_exchange_weak(seen, now);)
+        {
+        }
+        std::this_thread::yield();
+        ++x;
+        active.fetch_sub(1);
+    });
+    assert(peak.load() <= 2);
+    assert(std::count(v.begin(), v.end(), 1) == 200);
+
+    std::cout << "All concurrency limit tests passed!\n";
+}
+
+void test_exceptions()
+{
+    vector<int> v(1000, 0);
+    bool thrown = false;
+    try
+    {
+        parallel::for_each(small, v.begin(), v.end(),
+                           [](int &) { throw std::runtime_error("task failed"); });
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "All exception tests passed!\n";
+}
+
+int main()
+{
+    test_for_each_transform();
+    test_reduce();
+    test_scan();
+    test_sort();
+    test_concurrency_limit();
+    test_exceptions();
+
+    std::cout << "\nAll tests passed! Parallel algorithms are correct.\n";
+    return 0;
+}
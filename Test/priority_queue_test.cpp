@@ -0,0 +1,293 @@
+#include "ts_priority_queue.hpp"
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace TS_Test
+{
+
+// 依次弹出全部元素
+template <typename PQ> std::vector<typename PQ::value_type> drain(PQ &pq)
+{
+    std::vector<typename PQ::value_type> result;
+    while (!pq.empty())
+    {
+        result.push_back(pq.top());
+        pq.pop();
+    }
+    return result;
+}
+
+template <std::size_t Arity> void check_random_order()
+{
+    std::mt19937 rng(Arity);
+    std::vector<int> values;
+    TS::priority_queue<int, std::less<int>, Arity> pq;
+    for (int i = 0; i < 1000; ++i)
+    {
+        int v = int(rng() % 500);
+        values.push_back(v);
+        pq.push(v);
+    }
+    assert(pq.size() == values.size());
+    std::sort(values.begin(), values.end(), std::greater<int>());
+    assert(drain(pq) == values);
+}
+
+void test_push_pop()
+{
+    std::cout << "=== Testing push/pop ===" << std::endl;
+
+    check_random_order<2>();
+    check_random_order<3>();
+    check_random_order<4>();
+    check_random_order<8>();
+
+    TS::priority_queue<std::string> pq;
+    pq.push("b");
+    std::string c = "c";
+    pq.push(c);
+    pq.emplace(3, 'a');
+    assert(pq.top() == "c");
+    assert(pq.take_top() == "c");
+    assert(pq.top() == "b");
+    pq.clear();
+    assert(pq.empty());
+
+    std::cout << "All push/pop tests passed!" << std::endl;
+}
+
+void test_heapify()
+{
+    std::cout << "=== Testing heapify and push_range ===" << std::endl;
+
+    std::vector<int> values;
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.push_back((i * 7919) % 1009);
+    }
+    std::vector<int> sorted = values;
+    std::sort(sorted.begin(), sorted.end(), std::greater<int>());
+
+    // 范围构造整体建堆
+    TS::priority_queue<int, std::less<int>, 4> from_range(values.begin(), values.end());
+    assert(drain(from_range) == sorted);
+
+    // 接管容器
+    TS::vector<int> cont;
+    for (int v : values)
+    {
+        cont.push_back(v);
+    }
+    TS::priority_queue<int> adopted(std::move(cont));
+    assert(adopted.size() == values.size());
+    assert(drain(adopted) == sorted);
+
+    // 大批追加时重新建堆, 小批追加时逐个上浮
+    TS::priority_queue<int, std::less<int>, 4> pq = {5, 1, 9};
+    pq.push_range(values.begin(), values.end());
+    pq.push_range(values.begin(), values.begin() + 10);
+    std::vector<int> expected = values;
+    expected.insert(expected.end(), {5, 1, 9});
+    expected.insert(expected.end(), values.begin(), values.begin() + 10);
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+    assert(drain(pq) == expected);
+
+    std::cout << "All heapify and push_range tests passed!" << std::endl;
+}
+
+void test_pop_push()
+{
+    std::cout << "=== Testing pop_push ===" << std::endl;
+
+    // 最小堆
+    TS::priority_queue<int, std::greater<int>, 4> pq;
+    pq.pop_push(10); // 空队列时等同于 push
+    assert(pq.size() == 1 && pq.top() == 10);
+    std::vector<int> more = {3, 7, 1};
+    pq.push_range(more.begin(), more.end());
+    assert(pq.top() == 1);
+    pq.pop_push(8);
+    assert(pq.size() == 4 && pq.top() == 3);
+    pq.pop_push(2);
+    assert((drain(pq) == std::vector<int>{2, 7, 8, 10}));
+
+    std::cout << "All pop_push tests passed!" << std::endl;
+}
+
+void test_exceptions()
+{
+    std::cout << "=== Testing exceptions ===" << std::endl;
+
+    TS::priority_queue<int> pq;
+    bool caught = false;
+    try
+    {
+        pq.top();
+    }
+    catch (const std::range_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+    caught = false;
+    try
+    {
+        pq.pop();
+    }
+    catch (const std::range_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    TS::indexed_priority_queue<int> ipq;
+    ipq.push(3, 1);
+    caught = false;
+    try
+    {
+        ipq.push(3, 2);
+    }
+    catch (const std::logic_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+    caught = false;
+    try
+    {
+        ipq.update(4, 2);
+    }
+    catch (const std::out_of_range &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    std::cout << "All exceptions tests passed!" << std::endl;
+}
+
+// 与逐个扫描的朴素实现对照随机操作
+template <std::size_t Arity> void check_indexed_random()
+{
+    const std::size_t IDS = 200;
+    std::mt19937 rng(42 + Arity);
+    TS::indexed_priority_queue<int, std::greater<int>, Arity> pq;
+    std::vector<int> keys(IDS);
+    std::vector<bool> present(IDS, false);
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        std::size_t id = rng() % IDS;
+        int key = int(rng() % 1000);
+        switch (rng() % 4)
+        {
+        case 0:
+            pq.push_or_update(id, key);
+            keys[id] = key;
+            present[id] = true;
+            break;
+        case 1:
+            if (present[id])
+            {
+                pq.update(id, key);
+                keys[id] = key;
+            }
+            break;
+        case 2:
+            assert(pq.erase(id) == present[id]);
+            present[id] = false;
+            break;
+        default:
+            if (!pq.empty())
+            {
+                std::size_t top = pq.top_id();
+                assert(present[top] && pq.top() == keys[top]);
+                pq.pop();
+                present[top] = false;
+            }
+            break;
+        }
+
+        std::size_t count = 0;
+        int best = 1 << 30;
+        for (std::size_t i = 0; i < IDS; ++i)
+        {
+            assert(pq.contains(i) == present[i]);
+            if (present[i])
+            {
+                assert(pq.key(i) == keys[i]);
+                best = std::min(best, keys[i]);
+                ++count;
+            }
+        }
+        assert(pq.size() == count);
+        assert(count == 0 || pq.top() == best);
+    }
+    pq.clear();
+    assert(pq.empty() && !pq.contains(0));
+}
+
+// 小图上的 Dijkstra, 键变小时 update 即 decrease-key
+void test_indexed()
+{
+    std::cout << "=== Testing indexed_priority_queue ===" << std::endl;
+
+    check_indexed_random<2>();
+    check_indexed_random<4>();
+
+    struct edge
+    {
+        std::size_t to;
+        int weight;
+    };
+    std::vector<std::vector<edge>> graph = {
+        {{1, 7}, {2, 9}, {5, 14}}, {{0, 7}, {2, 10}, {3, 15}}, {{0, 9}, {1, 10}, {3, 11}, {5, 2}},
+        {{1, 15}, {2, 11}, {4, 6}}, {{3, 6}, {5, 9}},           {{0, 14}, {2, 2}, {4, 9}},
+    };
+    std::vector<int> dist(graph.size(), 1 << 30);
+    TS::indexed_priority_queue<int, std::greater<int>, 4> pq;
+    pq.reserve(graph.size());
+    dist[0] = 0;
+    pq.push(0, 0);
+    while (!pq.empty())
+    {
+        std::size_t u = pq.top_id();
+        pq.pop();
+        for (const edge &e : graph[u])
+        {
+            if (dist[u] + e.weight < dist[e.to])
+            {
+                dist[e.to] = dist[u] + e.weight;
+                pq.push_or_update(e.to, dist[e.to]);
+            }
+        }
+    }
+    assert((dist == std::vector<int>{0, 7, 9, 20, 20, 11}));
+
+    std::cout << "All indexed_priority_queue tests passed!" << std::endl;
+}
+
+void run_all_tests()
+{
+    test_push_pop();
+    test_heapify();
+    test_pop_push();
+    test_exceptions();
+    test_indexed();
+
+    std::cout << "\nAll tests passed! TS::priority_queue is correct." << std::endl;
+}
+
+} // namespace TS_Test
+
+int main()
+{
+    TS_Test::run_all_tests();
+    return 0;
+}
@@ -0,0 +1,245 @@
+#include "ts_deque.hpp"
+#include "ts_radix_sort.hpp"
+#include "ts_string.hpp"
+#include "ts_vector.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace TS;
+
+// 小粒度与固定线程数, 保证单核机器上也会切分为多个任务并启动多个线程
+const parallel::policy small(7, 4);
+
+template <typename T> std::vector<T> random_values(std::size_t count, std::uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::vector<T> values;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        values.push_back(static_cast<T>(rng()));
+    }
+    return values;
+}
+
+// 与 std::sort 的结果逐个比较
+template <typename T> void check_integral(std::size_t count)
+{
+    std::vector<T> values = random_values<T>(count, count);
+    std::vector<T> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<T> serial = values;
+    radix_sort(serial.begin(), serial.end());
+    assert(serial == expected);
+
+    std::vector<T> par = values;
+    parallel::radix_sort(small, par.begin(), par.end());
+    assert(par == expected);
+}
+
+void test_integral()
+{
+    for (std::size_t count : {0, 1, 2, 63, 64, 65, 1000, 20000})
+    {
+        check_integral<std::uint32_t>(count);
+        check_integral<std::uint64_t>(count);
+        check_integral<std::int32_t>(count);
+        check_integral<std::int64_t>(count);
+        check_integral<std::uint8_t>(count);
+        check_integral<std::int16_t>(count);
+    }
+
+    // TS::vector 与 TS::deque 的迭代器
+    vector<std::uint32_t> v;
+    deque<std::uint32_t> d;
+    for (std::uint32_t x : random_values<std::uint32_t>(5000, 7))
+    {
+        v.push_back(x);
+        d.push_back(x);
+    }
+    radix_sort(v.begin(), v.end());
+    radix_sort(d.begin(), d.end());
+    assert(std::is_sorted(v.begin(), v.end()));
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+        assert(d[i] == v[i]);
+    }
+}
+
+// 只有低字节不同, 或全部相同时, 跳过的趟不影响结果
+void test_skip_passes()
+{
+    std::vector<std::uint64_t> values;
+    for (std::uint64_t i = 0; i < 5000; ++i)
+    {
+        values.push_back(0xabcd000000000000ULL | ((i * 7919) % 251));
+    }
+    std::vector<std::uint64_t> expected = values;
+    std::sort(expected.begin(), expected.end());
+    std::vector<std::uint64_t> par = values;
+    radix_sort(values.begin(), values.end());
+    assert(values == expected);
+    parallel::radix_sort(small, par.begin(), par.end());
+    assert(par == expected);
+
+    std::vector<std::int32_t> same(1000, -5);
+    radix_sort(same.begin(), same.end());
+    assert(same == std::vector<std::int32_t>(1000, -5));
+}
+
+template <typename F> void check_floating(std::size_t count)
+{
+    std::mt19937_64 rng(count + 3);
+    std::uniform_real_distribution<F> dist(-1e6, 1e6);
+    std::vector<F> values;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        values.push_back(dist(rng));
+    }
+    values.insert(values.end(), {F(0), -F(0), std::numeric_limits<F>::infinity(),
+                                 -std::numeric_limits<F>::infinity(),
+                                 std::numeric_limits<F>::denorm_min(), F(-1e-30)});
+    std::vector<F> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<F> serial = values;
+    radix_sort(serial.begin(), serial.end());
+    assert(serial == expected);
+    std::vector<F> par = values;
+    parallel::radix_sort(small, par.begin(), par.end());
+    assert(par == expected);
+}
+
+void test_floating()
+{
+    for (std::size_t count : {0, 10, 100, 20000})
+    {
+        check_floating<float>(count);
+        check_floating<double>(count);
+    }
+}
+
+struct record
+{
+    std::uint32_t key;
+    std::size_t seq;
+    std::string payload;
+};
+
+// 按键排序后, 键相同的记录保持原来的相对顺序
+void check_records(std::vector<record> &records)
+{
+    for (std::size_t i = 1; i < records.size(); ++i)
+    {
+        assert(records[i - 1].key <= records[i].key);
+        if (records[i - 1].key == records[i].key)
+        {
+            assert(records[i - 1].seq < records[i].seq);
+        }
+        assert(records[i].payload == std::to_string(records[i].seq));
+    }
+}
+
+void test_key_extractor()
+{
+    std::mt19937 rng(11);
+    std::vector<record> records;
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+        records.push_back(record{std::uint32_t(rng() % 1000), i, std::to_string(i)});
+    }
+    auto by_key = [](const record &r) { return r.key; };
+
+    std::vector<record> serial = records;
+    radix_sort(serial.begin(), serial.end(), by_key);
+    check_records(serial);
+
+    std::vector<record> par = records;
+    parallel::radix_sort(small, par.begin(), par.end(), by_key);
+    check_records(par);
+
+    // 有符号与浮点键
+    std::vector<record> by_negated = records;
+    radix_sort(by_negated.begin(), by_negated.end(),
+               [](const record &r) { return -double(r.key); });
+    for (std::size_t i = 1; i < by_negated.size(); ++i)
+    {
+        assert(by_negated[i - 1].key >= by_negated[i].key);
+    }
+}
+
+template <typename Str> std::vector<Str> random_strings(std::size_t count)
+{
+    std::mt19937 rng(static_cast<unsigned>(count));
+    const char *prefixes[] = {"", "a", "ab", "abc", "prefix/common/", "\xff\x80"};
+    std::vector<Str> strings;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::string s = prefixes[rng() % 6];
+        std::size_t len = rng() % 12;
+        for (std::size_t k = 0; k < len; ++k)
+        {
+            s.push_back(char(rng() % 4 == 0 ? 0x80 + rng() % 128 : 'a' + rng() % 4));
+        }
+        strings.push_back(Str(s.c_str(), s.size()));
+    }
+    return strings;
+}
+
+template <typename Str> void check_strings(std::size_t count)
+{
+    std::vector<Str> strings = random_strings<Str>(count);
+    std::vector<Str> expected = strings;
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<Str> serial = strings;
+    radix_sort(serial.begin(), serial.end());
+    assert(serial == expected);
+
+    std::vector<Str> par = strings;
+    parallel::radix_sort(small, par.begin(), par.end());
+    assert(par == expected);
+}
+
+void test_strings()
+{
+    for (std::size_t count : {0, 1, 50, 1000, 20000})
+    {
+        check_strings<std::string>(count);
+        check_strings<TS::string>(count);
+    }
+
+    // 很长的公共前缀不会导致递归过深
+    std::vector<std::string> deep;
+    for (int i = 0; i < 200; ++i)
+    {
+        deep.push_back(std::string(20000, 'x') + char('a' + i % 26));
+    }
+    std::vector<std::string> expected = deep;
+    std::sort(expected.begin(), expected.end());
+    radix_sort(deep.begin(), deep.end());
+    assert(deep == expected);
+}
+
+void run_all_tests()
+{
+    test_integral();
+    test_skip_passes();
+    test_floating();
+    test_key_extractor();
+    test_strings();
+
+    std::cout << "All tests passed! TS::radix_sort is correct." << std::endl;
+}
+
+int main()
+{
+    run_all_tests();
+    return 0;
+}
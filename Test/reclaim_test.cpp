@@ -0,0 +1,359 @@
+#include "ts_reclaim.hpp"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace TS_Test
+{
+
+// 记录存活数量; 析构时清除 magic, 回收后仍被读取会被断言或 ASan 发现
+struct tracked
+{
+    static const int MAGIC = 0x5eed;
+    static std::atomic<int> live;
+
+    explicit tracked(int v, std::atomic<bool> *f = nullptr) : value(v), magic(MAGIC), freed(f)
+    {
+        live.fetch_add(1);
+    }
+
+    ~tracked()
+    {
+        magic = 0;
+        if (freed != nullptr)
+        {
+            freed->store(true);
+        }
+        live.fetch_sub(1);
+    }
+
+    int value;
+    int magic;
+    std::atomic<bool> *freed;
+};
+
+std::atomic<int> tracked::live(0);
+
+template <typename T, typename... Args> T *make(Args &&...args)
+{
+    T *p = TS::simple_alloc<T, TS::alloc>::allocate();
+    TS::construct(p, std::forward<Args>(args)...);
+    return p;
+}
+
+void test_epoch_basic()
+{
+    std::cout << "=== Testing epoch_domain basic ===" << std::endl;
+
+    {
+        TS::epoch_domain domain;
+        std::uint64_t start = domain.epoch();
+        // 没有其他线程在临界区, 纪元持续推进, 对象分批回收
+        for (int i = 0; i < 1000; ++i)
+        {
+            TS::epoch_guard guard(domain);
+            guard.retire(make<tracked>(i));
+        }
+        assert(domain.epoch() > start);
+        assert(tracked::live.load() < 4 * int(TS::EPOCH_RETIRE_BATCH));
+        assert(tracked::live.load() > 0);
+    }
+    // 域析构时回收剩余对象
+    assert(tracked::live.load() == 0);
+
+    std::cout << "All epoch_domain basic tests passed!" << std::endl;
+}
+
+// 停留在旧纪元的临界区阻止回收
+void test_epoch_pinned()
+{
+    std::cout << "=== Testing epoch_domain pinned reader ===" << std::endl;
+
+    TS::epoch_domain domain;
+    std::atomic<bool> freed(false);
+    {
+        TS::epoch_guard reader(domain);
+        {
+            TS::epoch_guard writer(domain);
+            writer.retire(make<tracked>(-1, &freed));
+        }
+        for (int i = 0; i < 1000; ++i)
+        {
+            TS::epoch_guard writer(domain);
+            writer.retire(make<tracked>(i));
+        }
+        assert(!freed.load());
+        // 纪元最多比读者多推进一次
+        assert(domain.epoch() <= 3);
+    }
+    for (int i = 0; i < 1000 && !freed.load(); ++i)
+    {
+        TS::epoch_guard writer(domain);
+        writer.retire(make<tracked>(i));
+    }
+    assert(freed.load());
+
+    std::cout << "All epoch_domain pinned reader tests passed!" << std::endl;
+}
+
+void test_hazard_basic()
+{
+    std::cout << "=== Testing hazard_domain basic ===" << std::endl;
+
+    {
+        TS::hazard_domain domain;
+        std::atomic<bool> freed(false);
+        std::atomic<tracked *> shared(make<tracked>(7, &freed));
+
+        TS::hazard_guard reader(domain);
+        tracked *p = reader.protect(0, shared);
+        assert(p->value == 7);
+        {
+            // 摘下后立即退休, 受保护期间多次扫描都不会回收
+            TS::hazard_guard writer(domain);
+            shared.store(nullptr);
+            writer.retire(p);
+            for (int i = 0; i < 1000; ++i)
+            {
+                writer.retire(make<tracked>(i));
+            }
+            assert(!freed.load());
+            assert(p->magic == tracked::MAGIC);
+        }
+        assert(tracked::live.load() < 4 * int(TS::HAZARD_RETIRE_BATCH));
+
+        reader.clear(0);
+        {
+            TS::hazard_guard writer(domain);
+            for (int i = 0; i < 1000 && !freed.load(); ++i)
+            {
+                writer.retire(make<tracked>(i));
+            }
+        }
+        assert(freed.load());
+    }
+    assert(tracked::live.load() == 0);
+
+    std::cout << "All hazard_domain basic tests passed!" << std::endl;
+}
+
+// 读者反复读取共享配置, 写者不断替换并退休旧配置
+template <typename Domain, typename ReadFunc> void run_readers_writer(Domain &domain, ReadFunc read)
+{
+    const int READERS = 4;
+    const int UPDATES = 20000;
+
+    std::atomic<tracked *> shared(make<tracked>(0));
+    std::atomic<bool> done(false);
+    std::vector<std::thread> threads;
+    for (int r = 0; r < READERS; ++r)
+    {
+        threads.emplace_back([&] {
+            int last = 0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                int value = read(domain, shared);
+                // 值只增不减
+                assert(value >= last);
+                last = value;
+            }
+        });
+    }
+    threads.emplace_back([&] {
+        for (int i = 1; i <= UPDATES; ++i)
+        {
+            typename Domain::guard_type guard(domain);
+            tracked *old = shared.exchange(make<tracked>(i));
+            guard.retire(old);
+        }
+        done.store(true);
+    });
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+    TS::destroy(shared.load());
+    TS::simple_alloc<tracked, TS::alloc>::deallocate(shared.load());
+}
+
+struct epoch_reader
+{
+    int operator()(TS::epoch_domain &domain, std::atomic<tracked *> &shared) const
+    {
+        TS::epoch_guard guard(domain);
+        tracked *p = shared.load(std::memory_order_acquire);
+        assert(p->magic == tracked::MAGIC);
+        return p->value;
+    }
+};
+
+struct hazard_reader
+{
+    int operator()(TS::hazard_domain &domain, std::atomic<tracked *> &shared) const
+    {
+        TS::hazard_guard guard(domain);
+        tracked *p = guard.protect(0, shared);
+        assert(p->magic == tracked::MAGIC);
+        return p->value;
+    }
+};
+
+struct epoch_test_domain : TS::epoch_domain
+{
+    using guard_type = TS::epoch_guard;
+};
+
+struct hazard_test_domain : TS::hazard_domain
+{
+    using guard_type = TS::hazard_guard;
+};
+
+void test_concurrent_readers()
+{
+    std::cout << "=== Testing concurrent readers ===" << std::endl;
+
+    {
+        epoch_test_domain domain;
+        run_readers_writer(domain, epoch_reader());
+    }
+    assert(tracked::live.load() == 0);
+    {
+        hazard_test_domain domain;
+        run_readers_writer(domain, hazard_reader());
+    }
+    assert(tracked::live.load() == 0);
+
+    std::cout << "All concurrent readers tests passed!" << std::endl;
+}
+
+// 用风险指针保护的 Treiber 栈: 弹出的节点立即退休, 不需要版本号
+class hazard_stack
+{
+  public:
+    struct Node
+    {
+        Node(int v) : value(v), next(nullptr)
+        {
+        }
+
+        int value;
+        Node *next;
+    };
+
+    ~hazard_stack()
+    {
+        Node *node = _top.load();
+        while (node != nullptr)
+        {
+            Node *next = node->next;
+            TS::destroy(node);
+            TS::simple_alloc<Node, TS::alloc>::deallocate(node);
+            node = next;
+        }
+    }
+
+    void push(int v)
+    {
+        Node *node = make<Node>(v);
+        node->next = _top.load(std::memory_order_relaxed);
+        while (!_top.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                           std::memory_order_relaxed))
+        {
+        }
+    }
+
+    bool pop(int &result)
+    {
+        TS::hazard_guard guard(_domain);
+        Node *node = nullptr;
+        while (true)
+        {
+            node = guard.protect(0, _top);
+            if (node == nullptr)
+            {
+                return false;
+            }
+            Node *next = node->next;
+            if (_top.compare_exchange_strong(node, next, std::memory_order_acquire,
+                                             std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        guard.clear(0);
+        result = node->value;
+        guard.retire(node);
+        return true;
+    }
+
+  protected:
+    std::atomic<Node *> _top{nullptr};
+    TS::hazard_domain _domain;
+};
+
+void test_hazard_stack()
+{
+    std::cout << "=== Testing hazard pointer stack ===" << std::endl;
+
+    const int THREADS = 4;
+    const int PER_THREAD = 20000;
+
+    hazard_stack stack;
+    std::vector<std::atomic<int>> seen(THREADS * PER_THREAD);
+    for (auto &flag : seen)
+    {
+        flag.store(0);
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([&stack, &seen, t] {
+            int value = 0;
+            for (int i = 0; i < PER_THREAD; ++i)
+            {
+                stack.push(t * PER_THREAD + i);
+                if (stack.pop(value))
+                {
+                    seen[value].fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+    int value = 0;
+    while (stack.pop(value))
+    {
+        seen[value].fetch_add(1);
+    }
+    for (auto &flag : seen)
+    {
+        assert(flag.load() == 1);
+    }
+
+    std::cout << "All hazard pointer stack tests passed!" << std::endl;
+}
+
+void run_all_tests()
+{
+    test_epoch_basic();
+    test_epoch_pinned();
+    test_hazard_basic();
+    test_concurrent_readers();
+    test_hazard_stack();
+
+    std::cout << "\nAll tests passed! TS::epoch_domain and TS::hazard_domain are correct."
+              << std::endl;
+}
+
+} // namespace TS_Test
+
+int main()
+{
+    TS_Test::run_all_tests();
+    return 0;
+}
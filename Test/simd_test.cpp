@@ -0,0 +1,306 @@
+#include "ts_algorithm.hpp"
+#include "ts_array.hpp"
+#include "ts_deque.hpp"
+#include "ts_simd.hpp"
+#include "ts_vector.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace TS;
+
+// 小范围取值以制造大量重复, 检验并列时的下标规则
+template <typename T> vector<T> random_values(std::size_t n, unsigned seed, int range)
+{
+    vector<T> result(n, T());
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        result[i] = T(int((seed >> 8) % unsigned(range)) - range / 2);
+    }
+    return result;
+}
+
+// 所有长度 (含不足一个向量与跨越尾部的情况) 的结果与 std 一致
+template <typename T> void check_against_std(const vector<T> &v)
+{
+    const T *first = v.begin();
+    const T *last = v.end();
+    for (T val : {T(0), T(3), T(-7), T(1000)})
+    {
+        assert(TS::find(first, last, val) == std::find(first, last, val));
+        assert(TS::count(first, last, val) == std::size_t(std::count(first, last, val)));
+    }
+    assert(TS::min_element(first, last) == std::min_element(first, last));
+    assert(TS::max_element(first, last) == std::max_element(first, last));
+    assert(TS::minmax_element(first, last) == std::minmax_element(first, last));
+}
+
+template <typename T> void test_kernels()
+{
+    for (std::size_t n = 0; n < 80; ++n)
+    {
+        vector<T> v = random_values<T>(n, unsigned(n), 16);
+        check_against_std(v);
+    }
+    check_against_std(random_values<T>(100000, 7, 1000));
+    check_against_std(random_values<T>(100003, 9, 3));
+
+    // 极值位于末尾, 首部和向量尾部之后
+    vector<T> v = random_values<T>(1000, 11, 100);
+    v[999] = T(-5000);
+    v[0] = T(5000);
+    check_against_std(v);
+    v[998] = T(5000);
+    check_against_std(v);
+}
+
+// 按每个不超过 CPU 支持的级别构造内核表, 与标量结果对比
+template <typename T> void test_isa_variants()
+{
+    vector<T> v = random_values<T>(4099, 3, 50);
+    const T *p = v.begin();
+    std::size_t found = std::find(p, p + 4099, T(7)) - p;
+    std::size_t count = std::count(p, p + 4099, T(7));
+    std::size_t min = std::min_element(p, p + 4099) - p;
+    std::size_t max = std::max_element(p, p + 4099) - p;
+    std::size_t last_max = std::minmax_element(p, p + 4099).second - p;
+
+    for (int i = 0; i <= int(simd::cpu_isa()); ++i)
+    {
+        auto kernels = simd::search_kernels<T>::make(simd::isa(i));
+        assert(kernels.level == simd::isa(i));
+        for (std::size_t n : {std::size_t(1), std::size_t(5), std::size_t(31), std::size_t(4099)})
+        {
+            assert(kernels.find(p, n, T(7)) == std::size_t(std::find(p, p + n, T(7)) - p));
+            assert(kernels.count(p, n, T(7)) == std::size_t(std::count(p, p + n, T(7))));
+            assert(kernels.min(p, n).min == std::size_t(std::min_element(p, p + n) - p));
+            assert(kernels.max(p, n).max == std::size_t(std::max_element(p, p + n) - p));
+            auto mm = std::minmax_element(p, p + n);
+            simd::extrema both = kernels.minmax(p, n);
+            assert(both.min == std::size_t(mm.first - p) && both.max == std::size_t(mm.second - p));
+        }
+        assert(kernels.find(p, 4099, T(7)) == found);
+        assert(kernels.count(p, 4099, T(7)) == count);
+        assert(kernels.min(p, 4099).min == min && kernels.max(p, 4099).max == max);
+        assert(kernels.minmax(p, 4099).max == last_max);
+    }
+    (void)found;
+    (void)count;
+    (void)min;
+    (void)max;
+    (void)last_max;
+}
+
+void test_dispatch()
+{
+    simd::isa level = simd::isa::scalar;
+    assert(simd::parse_isa("avx2", level) && level == simd::isa::avx2);
+    assert(simd::parse_isa("scalar", level) && level == simd::isa::scalar);
+    assert(!simd::parse_isa("avx3", level) && level == simd::isa::scalar);
+    for (int i = 0; i <= int(simd::isa::avx512); ++i)
+    {
+        assert(simd::parse_isa(simd::isa_name(simd::isa(i)), level) && level == simd::isa(i));
+    }
+    assert(simd::active_isa() <= simd::cpu_isa());
+    assert(simd::dispatch<simd::search_kernels<float>>().level == simd::active_isa());
+    assert(&simd::dispatch<simd::fill_kernels<std::uint32_t>>() ==
+           &simd::dispatch<simd::fill_kernels<std::uint32_t>>());
+
+    // TS_FORCE_ISA 只能降低级别, 无法识别的值被忽略
+    const char *saved = std::getenv("TS_FORCE_ISA");
+    std::string restore = saved != nullptr ? saved : "";
+    setenv("TS_FORCE_ISA", "scalar", 1);
+    assert(simd::detect_isa() == simd::isa::scalar);
+    setenv("TS_FORCE_ISA", "sse2", 1);
+    assert(simd::detect_isa() == std::min(simd::isa::sse2, simd::cpu_isa()));
+    setenv("TS_FORCE_ISA", "avx512", 1);
+    assert(simd::detect_isa() == simd::cpu_isa());
+    setenv("TS_FORCE_ISA", "fastest", 1);
+    assert(simd::detect_isa() == simd::cpu_isa());
+    unsetenv("TS_FORCE_ISA");
+    assert(simd::detect_isa() == simd::cpu_isa());
+    if (saved != nullptr)
+    {
+        setenv("TS_FORCE_ISA", restore.c_str(), 1);
+    }
+}
+
+// 各级别的填充内核: 所有长度的结果正确, 且不写出界
+template <typename T> void test_fill_variants(T pattern)
+{
+    const std::size_t N = 300;
+    for (int i = 0; i <= int(simd::cpu_isa()); ++i)
+    {
+        auto kernels = simd::fill_kernels<T>::make(simd::isa(i));
+        for (std::size_t n = 0; n < N; n += n < 40 ? 1 : 37)
+        {
+            vector<T> buffer(N + 2, T(0));
+            kernels.fill(buffer.begin() + 1, n, pattern);
+            assert(buffer[0] == T(0) && buffer[n + 1] == T(0));
+            for (std::size_t k = 1; k <= n; ++k)
+            {
+                assert(buffer[k] == pattern);
+            }
+        }
+    }
+}
+
+void test_fill()
+{
+    test_fill_variants<std::uint32_t>(0xdeadbeefu);
+    test_fill_variants<std::uint64_t>(0x0123456789abcdefull);
+
+    // TS::fill 与未初始化填充对 4/8 字节标量使用向量内核
+    vector<int> ints(1000, 7);
+    assert(std::count(ints.begin(), ints.end(), 7) == 1000);
+    TS::fill(ints.begin() + 3, ints.end() - 5, -1);
+    assert(ints[2] == 7 && ints[3] == -1 && ints[994] == -1 && ints[995] == 7);
+
+    vector<double> doubles(333, -0.0);
+    assert(std::signbit(doubles[332]));
+    TS::fill(doubles.begin(), doubles.end(), 2); // int 先转换为 double
+    assert(std::count(doubles.begin(), doubles.end(), 2.0) == 333);
+
+    vector<float> floats(100, 1.0f);
+    TS::fill(floats.begin(), floats.end(), std::numeric_limits<float>::quiet_NaN());
+    assert(std::isnan(floats[0]) && std::isnan(floats[99]));
+
+    int x = 0;
+    vector<int *> pointers(50, &x);
+    assert(pointers[49] == &x);
+
+    deque<long long> d(5000, 3);
+    TS::fill(d.begin() + 1, d.end(), 9LL);
+    assert(d.front() == 3 && d.back() == 9);
+    assert(TS::count(d.begin(), d.end(), 9LL) == 4999);
+
+    vector<short> shorts(100, 5); // 2 字节元素不走向量内核
+    TS::fill(shorts.begin(), shorts.end(), short(6));
+    assert(shorts[99] == 6);
+}
+
+// 各级别的位图内核: 所有长度的结果与逐字计算一致, 且不写出界
+void test_bit_variants()
+{
+    const std::size_t N = 300;
+    vector<std::uint64_t> a(N + 2, 0), b(N + 2, 0);
+    std::uint64_t seed = 88172645463325252ULL;
+    for (std::size_t k = 0; k < N + 2; ++k)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        a[k] = seed;
+        b[k] = seed * 0x9e3779b97f4a7c15ULL;
+    }
+    for (int i = 0; i <= int(simd::cpu_isa()); ++i)
+    {
+        simd::bit_kernels::table kernels = simd::bit_kernels::make(simd::isa(i));
+        for (std::size_t n = 0; n < N; n += n < 40 ? 1 : 37)
+        {
+            std::size_t expected = 0;
+            for (std::size_t k = 1; k <= n; ++k)
+            {
+                expected += simd::popcount64(a[k]);
+            }
+            assert(kernels.popcount(a.begin() + 1, n) == expected);
+
+            vector<std::uint64_t> r(a);
+            kernels.and_(r.begin() + 1, b.begin() + 1, n);
+            kernels.xor_(r.begin() + 1, a.begin() + 1, n);
+            kernels.or_(r.begin() + 1, b.begin() + 1, n);
+            kernels.andnot(r.begin() + 1, a.begin() + 1, n);
+            assert(r[0] == a[0] && r[n + 1] == a[n + 1]);
+            for (std::size_t k = 1; k <= n; ++k)
+            {
+                assert(r[k] == ((((a[k] & b[k]) ^ a[k]) | b[k]) & ~a[k]));
+            }
+        }
+    }
+    assert(simd::ctz64(1) == 0 && simd::ctz64(0x8000000000000000ULL) == 63);
+    assert(simd::popcount64(~0ULL) == 64 && simd::popcount64(0) == 0);
+}
+
+void test_float_special_values()
+{
+    vector<float> v = random_values<float>(64, 5, 20);
+    v[10] = -0.0f;
+    assert(TS::find(v.begin(), v.end(), 0.0f) == std::find(v.begin(), v.end(), 0.0f));
+
+    // 含 NaN 时结果与逐元素比较一致
+    v[20] = std::numeric_limits<float>::quiet_NaN();
+    assert(TS::find(v.begin(), v.end(), v[20]) == v.end());
+    assert(TS::min_element(v.begin(), v.end()) == std::min_element(v.begin(), v.end()));
+    assert(TS::max_element(v.begin(), v.end()) == std::max_element(v.begin(), v.end()));
+    v[0] = std::numeric_limits<float>::quiet_NaN();
+    assert(TS::min_element(v.begin(), v.end()) == std::min_element(v.begin(), v.end()));
+
+    vector<float> inf(40, 1.0f);
+    inf[33] = std::numeric_limits<float>::infinity();
+    inf[3] = -std::numeric_limits<float>::infinity();
+    assert(TS::max_element(inf.begin(), inf.end()) == inf.begin() + 33);
+    assert(TS::min_element(inf.begin(), inf.end()) == inf.begin() + 3);
+}
+
+void test_containers()
+{
+    // array
+    array<std::int32_t, 37> a;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        a[i] = std::int32_t(i % 5);
+    assert(TS::find(a.begin(), a.end(), 4) == a.begin() + 4);
+    assert(TS::count(a.begin(), a.end(), 0) == 8);
+    assert(TS::max_element(a.begin(), a.end()) == a.begin() + 4);
+
+    // deque: 每个连续段分别使用向量内核, 再合并结果
+    vector<int> values = random_values<int>(5000, 13, 200);
+    deque<int> d;
+    for (int x : values)
+        d.push_back(x);
+    d.push_front(-1000);
+    d.push_back(1000);
+    d.push_back(1000);
+    assert(*TS::min_element(d.begin(), d.end()) == -1000);
+    assert(TS::min_element(d.begin(), d.end()) == d.begin());
+    assert(TS::max_element(d.begin(), d.end()) == d.end() - 2);
+    auto mm = TS::minmax_element(d.begin(), d.end());
+    assert(mm.first == d.begin() && mm.second == d.end() - 1);
+    assert(TS::count(d.begin(), d.end(), 1000) == 2);
+    std::size_t fives = std::count(values.begin(), values.end(), 5);
+    assert(TS::count(d.begin() + 1, d.end(), 5) == fives);
+    auto it = TS::find(d.begin() + 1, d.end(), values[4321]);
+    std::size_t index = std::find(values.begin(), values.end(), values[4321]) - values.begin();
+    assert(it == d.begin() + 1 + index);
+
+    // 其他类型走通用实现
+    deque<double> dd(100, 1.5);
+    dd[50] = 2.5;
+    assert(TS::max_element(dd.begin(), dd.end()) == dd.begin() + 50);
+    assert(TS::count(dd.begin(), dd.end(), 1.5) == 99);
+
+    deque<int> empty;
+    assert(TS::min_element(empty.begin(), empty.end()) == empty.end());
+    assert(TS::count(empty.begin(), empty.end(), 0) == 0);
+}
+
+int main()
+{
+    test_kernels<std::int32_t>();
+    test_kernels<float>();
+    test_isa_variants<std::int32_t>();
+    test_isa_variants<float>();
+    test_dispatch();
+    test_fill();
+    test_bit_variants();
+    test_float_special_values();
+    test_containers();
+
+    std::cout << "All tests passed! SIMD kernels and dispatch are correct." << std::endl;
+    return 0;
+}
@@ -0,0 +1,233 @@
+#include "ts_deque.hpp"
+#include "ts_sort.hpp"
+#include "ts_string.hpp"
+#include "ts_vector.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace TS_Test
+{
+
+// 各种输入形态, 覆盖插入排序阈值, ninther 阈值与块划分的边界
+std::vector<int> make_input(const std::string &shape, std::size_t count, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<int> values(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (shape == "random")
+        {
+            values[i] = int(rng());
+        }
+        else if (shape == "sorted")
+        {
+            values[i] = int(i);
+        }
+        else if (shape == "reversed")
+        {
+            values[i] = int(count - i);
+        }
+        else if (shape == "few_unique")
+        {
+            values[i] = int(rng() % 4);
+        }
+        else if (shape == "organ_pipe")
+        {
+            values[i] = int(i < count / 2 ? i : count - i);
+        }
+        else if (shape == "sawtooth")
+        {
+            values[i] = int(i % 37);
+        }
+        else
+        {
+            // 几乎有序: 少量随机交换
+            values[i] = int(i);
+        }
+    }
+    if (shape == "nearly_sorted")
+    {
+        for (std::size_t k = 0; count > 0 && k < 4; ++k)
+        {
+            std::swap(values[rng() % count], values[rng() % count]);
+        }
+    }
+    return values;
+}
+
+const char *shapes[] = {"random",     "sorted",   "reversed",     "few_unique",
+                        "organ_pipe", "sawtooth", "nearly_sorted"};
+const std::size_t sizes[] = {0, 1, 2, 3, 23, 24, 25, 127, 128, 129, 1000, 100000};
+
+void test_pointer()
+{
+    std::cout << "=== Testing sort on contiguous ranges ===" << std::endl;
+
+    for (const char *shape : shapes)
+    {
+        for (std::size_t count : sizes)
+        {
+            std::vector<int> values = make_input(shape, count, unsigned(count));
+            std::vector<int> expected = values;
+            std::sort(expected.begin(), expected.end());
+
+            // 原始指针与默认比较走块划分
+            std::vector<int> by_pointer = values;
+            TS::sort(by_pointer.data(), by_pointer.data() + count);
+            assert(by_pointer == expected);
+
+            // 自定义比较走普通划分
+            std::vector<int> by_lambda = values;
+            TS::sort(by_lambda.begin(), by_lambda.end(), [](int a, int b) { return a < b; });
+            assert(by_lambda == expected);
+
+            // 降序
+            std::vector<int> descending = values;
+            TS::sort(descending.data(), descending.data() + count, std::greater<int>());
+            std::reverse(descending.begin(), descending.end());
+            assert(descending == expected);
+        }
+    }
+
+    TS::vector<double> v;
+    for (int i = 0; i < 5000; ++i)
+    {
+        v.push_back(double((i * 7919) % 5003) / 3.0);
+    }
+    TS::sort(v.begin(), v.end());
+    assert(TS::is_sorted(v.begin(), v.end()));
+
+    std::cout << "All contiguous sort tests passed!" << std::endl;
+}
+
+void test_deque()
+{
+    std::cout << "=== Testing sort on deque iterators ===" << std::endl;
+
+    for (const char *shape : shapes)
+    {
+        for (std::size_t count : sizes)
+        {
+            std::vector<int> values = make_input(shape, count, unsigned(count) + 1);
+            TS::deque<int> d;
+            for (int x : values)
+            {
+                d.push_back(x);
+            }
+            std::sort(values.begin(), values.end());
+            TS::sort(d.begin(), d.end());
+            assert(TS::is_sorted(d.begin(), d.end()));
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                assert(d[i] == values[i]);
+            }
+        }
+    }
+
+    std::cout << "All deque sort tests passed!" << std::endl;
+}
+
+void test_non_trivial()
+{
+    std::cout << "=== Testing sort on non-trivial elements ===" << std::endl;
+
+    std::mt19937 rng(5);
+    std::vector<std::string> strings;
+    TS::vector<TS::string> ts_strings;
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string s = std::to_string(rng() % 5000);
+        strings.push_back(s);
+        ts_strings.push_back(TS::string(s.c_str()));
+    }
+    std::vector<std::string> expected = strings;
+    std::sort(expected.begin(), expected.end());
+    TS::sort(strings.begin(), strings.end());
+    assert(strings == expected);
+
+    TS::sort(ts_strings.begin(), ts_strings.end());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        assert(std::string(ts_strings[i].c_str()) == expected[i]);
+    }
+
+    // 按成员排序的结构体
+    struct item
+    {
+        std::uint32_t key;
+        std::string name;
+    };
+    std::vector<item> items;
+    for (std::uint32_t i = 0; i < 3000; ++i)
+    {
+        items.push_back(item{(i * 2654435761u) % 1024, std::to_string(i)});
+    }
+    TS::sort(items.begin(), items.end(),
+             [](const item &a, const item &b) { return a.key < b.key; });
+    for (std::size_t i = 1; i < items.size(); ++i)
+    {
+        assert(items[i - 1].key <= items[i].key);
+    }
+
+    std::cout << "All non-trivial sort tests passed!" << std::endl;
+}
+
+// 统计比较次数: 对构造的坏输入 (中值杀手) 仍为 O(n log n)
+void test_adversarial()
+{
+    std::cout << "=== Testing sort on adversarial input ===" << std::endl;
+
+    const std::size_t count = 1 << 16;
+    std::vector<int> values(count);
+    // 三数取中的杀手序列: 偶数位置放小值, 交错放大值
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        values[i] = int(i % 2 == 0 ? i / 2 : count / 2 + i / 2);
+    }
+    std::size_t comparisons = 0;
+    auto counted = [&comparisons](int a, int b) {
+        ++comparisons;
+        return a < b;
+    };
+    TS::sort(values.begin(), values.end(), counted);
+    assert(std::is_sorted(values.begin(), values.end()));
+    assert(comparisons < 4 * count * 16);
+
+    // 全部相等
+    std::vector<int> same(count, 7);
+    comparisons = 0;
+    TS::sort(same.begin(), same.end(), counted);
+    assert(comparisons < 4 * count);
+
+    // 已有序的输入为线性
+    std::vector<int> sorted = make_input("sorted", count, 0);
+    comparisons = 0;
+    TS::sort(sorted.begin(), sorted.end(), counted);
+    assert(comparisons < 4 * count);
+
+    std::cout << "All adversarial sort tests passed!" << std::endl;
+}
+
+void run_all_tests()
+{
+    test_pointer();
+    test_deque();
+    test_non_trivial();
+    test_adversarial();
+
+    std::cout << "\nAll tests passed! TS::sort is correct." << std::endl;
+}
+
+} // namespace TS_Test
+
+int main()
+{
+    TS_Test::run_all_tests();
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include "ts_array.hpp"
+#include "ts_span.hpp"
+#include "ts_string.hpp"
+#include "ts_string_view.hpp"
+#include "ts_vector.hpp"
+#include <cassert>
+#include <iostream>
+#include <type_traits>
+
+using namespace TS;
+
+// 流水线各阶段只接收视图, 不发生拷贝
+static int sum(span<const int> s)
+{
+    int result = 0;
+    for (int x : s)
+        result += x;
+    return result;
+}
+
+static std::size_t count_char(string_view sv, char ch)
+{
+    std::size_t result = 0;
+    for (std::size_t pos = sv.find(ch); pos != string_view::npos; pos = sv.find(ch, pos + 1))
+        ++result;
+    return result;
+}
+
+void test_span_constructors()
+{
+    // 静态长度只保存指针
+    static_assert(sizeof(span<int, 4>) == sizeof(int *), "");
+    static_assert(sizeof(span<int>) == sizeof(int *) + sizeof(std::size_t), "");
+
+    span<int> empty;
+    assert(empty.empty() && empty.data() == nullptr);
+
+    int raw[5] = {1, 2, 3, 4, 5};
+    span<int, 5> s1(raw);
+    assert(s1.size() == 5 && s1[4] == 5);
+    span s2 = raw;
+    static_assert(decltype(s2)::extent == 5, "");
+
+    // 从 TS::array 隐式构造
+    TS::array<int, 3> arr = {7, 8, 9};
+    span<int, 3> s3 = arr;
+    span<int> s4 = arr;
+    span s5 = arr;
+    static_assert(decltype(s5)::extent == 3, "");
+    assert(s3.data() == arr.data() && s4.size() == 3 && s5[1] == 8);
+    assert(sum(arr) == 24);
+
+    // 从 TS::vector 隐式构造
+    vector<int> v{1, 2, 3, 4};
+    span<int> s6 = v;
+    span s7 = v;
+    static_assert(decltype(s7)::extent == dynamic_extent, "");
+    assert(s6.data() == v.data() && s6.size() == 4);
+    assert(sum(v) == 10);
+    s6[0] = 100;
+    assert(v[0] == 100);
+
+    const vector<int> &cv = v;
+    span<const int> s8 = cv;
+    assert(s8.size() == 4 && s8.front() == 100 && s8.back() == 4);
+
+    // span<T> -> span<const T>
+    span<const int> s9 = s6;
+    assert(s9.data() == v.data());
+    span<const int> s10 = s1;
+    assert(s10.size() == 5);
+
+    // 指针区间
+    span<int> s11(v.begin() + 1, v.end());
+    assert(s11.size() == 3 && s11[0] == 2);
+
+    std::cout << "All span constructor tests passed!\n";
+}
+
+void test_span_subviews()
+{
+    vector<int> v;
+    for (int i = 0; i < 10; ++i)
+        v.push_back(i);
+    span<int> s = v;
+
+    assert(s.first(3).size() == 3 && s.first(3)[2] == 2);
+    assert(s.last(2)[0] == 8);
+    assert(s.subspan(4).size() == 6 && s.subspan(4)[0] == 4);
+    assert(s.subspan(4, 2).back() == 5);
+
+    auto f = s.first<4>();
+    static_assert(decltype(f)::extent == 4, "");
+    assert(f[3] == 3);
+    auto l = s.last<3>();
+    assert(l[0] == 7);
+    auto sub = f.subspan<1, 2>();
+    static_assert(decltype(sub)::extent == 2, "");
+    assert(sub[0] == 1 && sub[1] == 2);
+    auto rest = f.subspan<1>();
+    static_assert(decltype(rest)::extent == 3, "");
+
+    // 按窗口切分缓冲区
+    int total = 0;
+    for (std::size_t off = 0; off < s.size(); off += 3)
+    {
+        std::size_t count = s.size() - off < 3 ? s.size() - off : 3;
+        total += sum(s.subspan(off, count));
+    }
+    assert(total == 45);
+
+    auto bytes = as_bytes(s);
+    assert(bytes.size() == s.size() * sizeof(int));
+    auto wbytes = as_writable_bytes(s.first(1));
+    wbytes[0] = 42;
+    assert(v[0] == 42);
+
+    bool thrown = false;
+    try
+    {
+        s.at(10);
+    }
+    catch (const std::out_of_range &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "All span subview tests passed!\n";
+}
+
+void test_string_view()
+{
+    string_view empty;
+    assert(empty.empty() && empty.size() == 0);
+
+    string_view sv("key=value;other=thing");
+    assert(sv.size() == 21);
+    assert(sv.find('=') == 3);
+    assert(sv.find("other") == 10);
+    assert(sv.rfind('=') == 15);
+    assert(sv.rfind("=") == 15);
+    assert(sv.substr(0, 3) == "key");
+    assert(sv.starts_with("key") && sv.ends_with("thing"));
+    assert(count_char(sv, '=') == 2);
+
+    string_view rest = sv;
+    rest.remove_prefix(10);
+    rest.remove_suffix(6);
+    assert(rest == "other");
+
+    // TS::string 与 string_view 互通
+    string str("a heap allocated string with several words in it");
+    string_view view = str;
+    assert(view.data() == str.data() && view.size() == str.size());
+    assert(count_char(str, ' ') == 8);
+    assert(view == str && str == view);
+    string back(view.substr(2, 4));
+    assert(back == "heap");
+    str.append(string_view("!"));
+    assert(str.ends_with("!"));
+
+    assert(string_view("abc") < string_view("abd"));
+    assert(string_view("abc") != "abd");
+    assert(std::hash<string_view>()(string_view("key")) == std::hash<string>()(string("key")));
+
+    std::cout << "All string_view tests passed!\n";
+}
+
+int main()
+{
+    test_span_constructors();
+    test_span_subviews();
+    test_string_view();
+
+    std::cout << "\nAll tests passed! Span and string_view implementations are correct.\n";
+    return 0;
+}
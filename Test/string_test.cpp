@@ -0,0 +1,237 @@
+#include "ts_string.hpp"
+#include "ts_vector.hpp"
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace TS;
+
+void test_constructors()
+{
+    // 默认构造函数
+    string s1;
+    assert(s1.empty());
+    assert(s1.size() == 0);
+    assert(s1.c_str()[0] == '\0');
+
+    // 短字符串位于对象内部
+    string s2("hello");
+    assert(s2.size() == 5);
+    assert(s2 == "hello");
+    assert(s2.capacity() >= 22);
+
+    // 长字符串位于堆上
+    const char *text = "a string that is definitely longer than the inline buffer";
+    string s3(text);
+    assert(s3.size() == std::char_traits<char>::length(text));
+    assert(s3 == text);
+
+    // 数量和字符构造函数
+    string s4(30, 'x');
+    assert(s4.size() == 30);
+    assert(s4 == std::string(30, 'x').c_str());
+
+    // 拷贝与移动
+    string s5(s3);
+    assert(s5 == s3);
+    string s6(std::move(s5));
+    assert(s6 == s3);
+    assert(s5.empty());
+    string s7(std::move(s2));
+    assert(s7 == "hello");
+    assert(s2.empty());
+
+    // 迭代器区间与初始化列表
+    std::string src = "iterator";
+    string s8(src.begin(), src.end());
+    assert(s8 == "iterator");
+    string s9{'a', 'b', 'c'};
+    assert(s9 == "abc");
+
+    // 子串构造
+    string s10(s3, 2, 6);
+    assert(s10 == "string");
+
+    std::cout << "All constructor tests passed!\n";
+}
+
+void test_assignments()
+{
+    string s;
+    s = "short";
+    assert(s == "short");
+    s = "a much longer string that forces a heap allocation";
+    assert(s.size() == 50);
+    s = "tiny";
+    assert(s == "tiny");
+
+    string other("another fairly long string value for testing");
+    s = other;
+    assert(s == other);
+    s = std::move(other);
+    assert(s == "another fairly long string value for testing");
+    assert(other.empty());
+
+    s = 'c';
+    assert(s == "c");
+    s.assign(5, 'z');
+    assert(s == "zzzzz");
+
+    std::cout << "All assignment tests passed!\n";
+}
+
+void test_modifiers()
+{
+    string s;
+    for (int i = 0; i < 100; ++i)
+    {
+        s.push_back(char('a' + i % 26));
+    }
+    assert(s.size() == 100);
+    assert(s[26] == 'a');
+    assert(s.back() == 'v');
+    s.pop_back();
+    assert(s.back() == 'u');
+
+    string t("abc");
+    t.append("def");
+    t += "ghi";
+    t += 'j';
+    t.append(3, 'k');
+    assert(t == "abcdefghijkkk");
+
+    // 自身追加
+    t.append(t);
+    assert(t == "abcdefghijkkkabcdefghijkkk");
+    t.append(t.data(), 3);
+    assert(t.size() == 29);
+
+    string u("hello world");
+    u.insert(5, ",");
+    assert(u == "hello, world");
+    u.insert(0, 2, '>');
+    assert(u == ">>hello, world");
+    u.insert(u.size(), "!");
+    assert(u == ">>hello, world!");
+    u.insert(2, u.data() + 2, 5);
+    assert(u == ">>hellohello, world!");
+
+    u.erase(0, 2);
+    assert(u == "hellohello, world!");
+    u.erase(5, 5);
+    assert(u == "hello, world!");
+    u.erase(u.begin() + 5);
+    assert(u == "hello world!");
+    u.erase(5);
+    assert(u == "hello");
+
+    u.resize(8, '.');
+    assert(u == "hello...");
+    u.resize(2);
+    assert(u == "he");
+
+    string a("short"), b("a long string that lives on the heap");
+    a.swap(b);
+    assert(a == "a long string that lives on the heap");
+    assert(b == "short");
+
+    b.clear();
+    assert(b.empty() && b.c_str()[0] == '\0');
+
+    string c(40, 'q');
+    c.resize(5);
+    c.shrink_to_fit();
+    assert(c == "qqqqq");
+    assert(c.capacity() >= 22);
+
+    std::cout << "All modifier tests passed!\n";
+}
+
+void test_operations()
+{
+    string s("the quick brown fox jumps over the lazy dog");
+    assert(s.find("quick") == 4);
+    assert(s.find("the", 1) == 31);
+    assert(s.find("cat") == string::npos);
+    assert(s.find('q') == 4);
+    assert(s.find('z') == 37);
+    assert(s.find('!') == string::npos);
+    assert(s.find("") == 0);
+    assert(s.rfind('o') == 41);
+    assert(s.rfind('o', 40) == 26);
+    assert(s.substr(4, 5) == "quick");
+    assert(s.substr(40) == "dog");
+    assert(s.starts_with("the"));
+    assert(s.ends_with("dog"));
+
+    assert(string("abc").compare("abd") < 0);
+    assert(string("abc").compare("ab") > 0);
+    assert(string("abc").compare("abc") == 0);
+    assert(string("abc") < string("abd"));
+    assert(string("b") > string("abc"));
+    assert(string("abc") != "abd");
+
+    string joined = string("foo") + "bar" + '!' + string("baz");
+    assert(joined == "foobar!baz");
+    assert(("pre" + string("fix")) == "prefix");
+
+    std::ostringstream os;
+    os << joined;
+    assert(os.str() == "foobar!baz");
+
+    assert(std::hash<string>()(string("key")) == std::hash<string>()(string("key")));
+    assert(std::hash<string>()(string("key")) != std::hash<string>()(string("kez")));
+
+    bool thrown = false;
+    try
+    {
+        s.at(100);
+    }
+    catch (const std::out_of_range &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "All operation tests passed!\n";
+}
+
+void test_relocation()
+{
+    // 对象内不含自指针, 可平凡重定位
+    static_assert(is_trivially_relocatable<string>::value, "");
+    static_assert(!is_trivially_relocatable<std::string>::value, "");
+    static_assert(sizeof(string) == 4 * sizeof(void *), "");
+
+    vector<string> v;
+    for (int i = 0; i < 1000; ++i)
+    {
+        v.push_back(i % 2 ? string(5, char('a' + i % 26)) : string(40, char('a' + i % 26)));
+    }
+    for (int i = 0; i < 1000; ++i)
+    {
+        assert(v[i].size() == (i % 2 ? 5u : 40u));
+        assert(v[i][0] == char('a' + i % 26));
+    }
+
+    v.insert(v.begin(), string("front"));
+    assert(v[0] == "front");
+    v.reserve(5000);
+    v.shrink_to_fit();
+    assert(v[1].size() == 40 && v[1000][0] == char('a' + 999 % 26));
+
+    std::cout << "All relocation tests passed!\n";
+}
+
+int main()
+{
+    test_constructors();
+    test_assignments();
+    test_modifiers();
+    test_operations();
+    test_relocation();
+
+    std::cout << "\nAll tests passed! String implementation is correct.\n";
+    return 0;
+}
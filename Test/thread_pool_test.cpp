@@ -0,0 +1,240 @@
+#include "ts_thread_pool.hpp"
+#include "ts_vector.hpp"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace TS;
+
+void test_work_stealing_deque()
+{
+    // 所有者按后进先出弹出, 窃取者按先进先出取走
+    work_stealing_deque<int> q(4);
+    int val = 0;
+    assert(q.empty());
+    assert(!q.pop(val));
+    assert(!q.steal(val));
+    for (int i = 0; i < 100; ++i)
+    {
+        q.push(i); // 超过初始容量时扩容
+    }
+    assert(q.steal(val) && val == 0);
+    assert(q.pop(val) && val == 99);
+    assert(q.steal(val) && val == 1);
+    int count = 3;
+    while (q.pop(val))
+    {
+        ++count;
+    }
+    assert(count == 100);
+    assert(q.empty());
+
+    // 所有者与多个窃取者并发: 每个元素恰好被取走一次
+    const int N = 200000;
+    work_stealing_deque<int> shared;
+    std::vector<std::atomic<int>> seen(N);
+    std::atomic<bool> done(false);
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t)
+    {
+        thieves.emplace_back([&] {
+            int item = 0;
+            while (!done.load() || !shared.empty())
+            {
+                if (shared.steal(item))
+                {
+                    seen[item].fetch_add(1);
+                }
+            }
+        });
+    }
+    for (int i = 0; i < N; ++i)
+    {
+        shared.push(i);
+        if (i % 3 == 0 && shared.pop(val))
+        {
+            seen[val].fetch_add(1);
+        }
+    }
+    while (shared.pop(val))
+    {
+        seen[val].fetch_add(1);
+    }
+    done.store(true);
+    for (auto &t : thieves)
+    {
+        t.join();
+    }
+    for (int i = 0; i < N; ++i)
+    {
+        assert(seen[i].load() == 1);
+    }
+
+    std::cout << "All work_stealing_deque tests passed!\n";
+}
+
+long fib(thread_pool &pool, int n)
+{
+    if (n < 12)
+    {
+        return n < 2 ? n : fib(pool, n - 1) + fib(pool, n - 2);
+    }
+    long a = 0, b = 0;
+    parallel_invoke(
+        pool, [&] { a = fib(pool, n - 1); }, [&] { b = fib(pool, n - 2); });
+    return a + b;
+}
+
+void test_task_group()
+{
+    thread_pool pool(3);
+    assert(pool.size() == 3);
+
+    std::atomic<int> counter(0);
+    task_group group(pool);
+    for (int i = 0; i < 1000; ++i)
+    {
+        group.spawn([&counter] { counter.fetch_add(1); });
+    }
+    group.wait();
+    assert(counter.load() == 1000);
+
+    // 嵌套 fork/join, 工作线程在 wait 中协助执行
+    assert(fib(pool, 25) == 75025);
+
+    // 默认线程池
+    long sum = 0;
+    std::atomic<long> total(0);
+    task_group defaults;
+    for (long i = 1; i <= 100; ++i)
+    {
+        sum += i;
+        defaults.spawn([&total, i] { total.fetch_add(i); });
+    }
+    defaults.wait();
+    assert(total.load() == sum);
+
+    std::cout << "All task_group tests passed!\n";
+}
+
+void test_parallel_for()
+{
+    thread_pool pool(2);
+    vector<int> v(10000, 0);
+    auto body = [&v](std::size_t i) { v[i] = int(i) * 2; };
+    parallel_for(pool, 0, v.size(), 64, body);
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+        assert(v[i] == int(i) * 2);
+    }
+
+    // 空区间与单元素
+    auto never = [](std::size_t) { assert(false); };
+    parallel_for(pool, 5, 5, 1, never);
+    int hits = 0;
+    auto once = [&hits](std::size_t i) { hits += int(i); };
+    parallel_for(pool, 7, 8, 1, once);
+    assert(hits == 7);
+
+    std::cout << "All parallel_for tests passed!\n";
+}
+
+void test_exceptions()
+{
+    thread_pool pool(2);
+    task_group group(pool);
+    std::atomic<int> ran(0);
+    for (int i = 0; i < 100; ++i)
+    {
+        group.spawn([&ran, i] {
+            ran.fetch_add(1);
+            if (i == 10)
+            {
+                throw std::runtime_error("task failed");
+            }
+        });
+    }
+    bool thrown = false;
+    try
+    {
+        group.wait();
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(ran.load() <= 100);
+
+    // 重新抛出后可继续使用
+    group.spawn([&ran] { ran.store(-1); });
+    group.wait();
+    assert(ran.load() == -1);
+
+    thrown = false;
+    auto body = [](std::size_t i) {
+        if (i == 500)
+        {
+            throw std::logic_error("bad index");
+        }
+    };
+    try
+    {
+        parallel_for(pool, 0, 1000, 8, body);
+    }
+    catch (const std::logic_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "All exception tests passed!\n";
+}
+
+void test_allocator_threads()
+{
+    // 多线程同时分配释放小对象, 自由链表由互斥锁保护
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([t] {
+            vector<vector<int>> nested;
+            for (int i = 0; i < 2000; ++i)
+            {
+                nested.push_back(vector<int>(1 + i % 20, t));
+            }
+            for (int i = 0; i < 2000; ++i)
+            {
+                assert(nested[i].size() == std::size_t(1 + i % 20) && nested[i][0] == t);
+            }
+        });
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    // 生产者分配, 消费者释放: 释放的区块回到共享链表, 生产者再次分配时可复用
+    void *first = alloc::allocate(48);
+    std::thread consumer([first] { alloc::deallocate(first, 48); });
+    consumer.join();
+    assert(alloc::allocate(48) == first);
+    alloc::deallocate(first, 48);
+
+    std::cout << "All allocator thread tests passed!\n";
+}
+
+int main()
+{
+    test_work_stealing_deque();
+    test_task_group();
+    test_parallel_for();
+    test_exceptions();
+    test_allocator_threads();
+
+    std::cout << "\nAll tests passed! Thread pool implementation is correct.\n";
+    return 0;
+}
@@ -0,0 +1,353 @@
+#include "ts_unrolled_list.hpp"
+#include <cassert>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+
+namespace TS_Test
+{
+
+// 与 std::list 逐个比较, 同时检查反向遍历
+template <typename T, typename Alloc, std::size_t NodeBytes>
+bool same(const TS::unrolled_list<T, Alloc, NodeBytes> &lhs, const std::list<T> &rhs)
+{
+    if (lhs.size() != rhs.size())
+    {
+        return false;
+    }
+    auto it = lhs.begin();
+    for (const T &value : rhs)
+    {
+        if (!(*it == value))
+        {
+            return false;
+        }
+        ++it;
+    }
+    if (it != lhs.end())
+    {
+        return false;
+    }
+    auto rit = rhs.end();
+    while (it != lhs.begin())
+    {
+        --it;
+        --rit;
+        if (!(*it == *rit))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_constructors_and_assignment()
+{
+    std::cout << "=== Testing constructors and assignment ===" << std::endl;
+
+    {
+        TS::unrolled_list<int> list;
+        assert(list.empty());
+        assert(list.begin() == list.end());
+        assert(list.node_count() == 0);
+    }
+
+    {
+        TS::unrolled_list<int> list(100, 7);
+        assert(list.size() == 100);
+        assert(TS::count(list.begin(), list.end(), 7) == 100);
+        // 顺序追加时节点填满
+        std::size_t cap = TS::unrolled_list<int>::node_capacity;
+        assert(list.node_count() == (100 + cap - 1) / cap);
+    }
+
+    {
+        TS::unrolled_list<int> original{1, 2, 3, 4, 5};
+        TS::unrolled_list<int> copy(original);
+        assert(copy == original);
+        TS::unrolled_list<int> moved(std::move(original));
+        assert(moved == copy);
+        assert(original.empty());
+        original.push_back(9);
+        assert(original.front() == 9 && original.back() == 9);
+    }
+
+    {
+        TS::unrolled_list<int> list1{1, 2, 3};
+        TS::unrolled_list<int> list2{4, 5};
+        list2 = list1;
+        assert(list2 == list1);
+        list2 = list2;
+        assert(list2.size() == 3);
+        list1 = {10, 20, 30, 40};
+        list2 = std::move(list1);
+        assert(list2.size() == 4 && list2.front() == 10 && list2.back() == 40);
+        assert(list1.empty());
+        list1.swap(list2);
+        assert(list1.size() == 4 && list2.empty());
+        TS::swap(list1, list2);
+        assert(list2.size() == 4 && list1.empty());
+    }
+
+    std::cout << "All constructor and assignment tests passed!" << std::endl;
+}
+
+void test_push_pop()
+{
+    std::cout << "=== Testing push and pop ===" << std::endl;
+
+    TS::unrolled_list<int> list;
+    std::list<int> expected;
+    for (int i = 0; i < 200; ++i)
+    {
+        list.push_back(i);
+        expected.push_back(i);
+        list.push_front(-i);
+        expected.push_front(-i);
+    }
+    assert(same(list, expected));
+
+    while (!expected.empty())
+    {
+        assert(list.front() == expected.front());
+        assert(list.back() == expected.back());
+        list.pop_back();
+        expected.pop_back();
+        if (!expected.empty())
+        {
+            list.pop_front();
+            expected.pop_front();
+        }
+    }
+    assert(list.empty() && list.node_count() == 0);
+
+    bool caught = false;
+    try
+    {
+        list.pop_back();
+    }
+    catch (const std::range_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    std::cout << "All push and pop tests passed!" << std::endl;
+}
+
+void test_insert_erase()
+{
+    std::cout << "=== Testing insert and erase ===" << std::endl;
+
+    // 中间插入使满节点分裂
+    {
+        TS::unrolled_list<int> list;
+        std::size_t cap = TS::unrolled_list<int>::node_capacity;
+        for (std::size_t i = 0; i < cap; ++i)
+        {
+            list.push_back(static_cast<int>(i));
+        }
+        assert(list.node_count() == 1);
+        auto pos = list.begin();
+        for (std::size_t i = 0; i < cap / 2 + 1; ++i)
+        {
+            ++pos;
+        }
+        auto it = list.insert(pos, -1);
+        assert(*it == -1);
+        assert(list.node_count() == 2);
+        assert(*++it == static_cast<int>(cap / 2 + 1));
+
+        // 删除后两节点合计不超过容量的 3/4 时合并
+        while (list.size() > cap / 2)
+        {
+            list.erase(list.begin());
+        }
+        assert(list.node_count() == 1);
+    }
+
+    // 随机插入删除与 std::list 对照
+    {
+        TS::unrolled_list<int> list;
+        std::list<int> expected;
+        std::mt19937 gen(12345);
+        for (int round = 0; round < 4000; ++round)
+        {
+            std::size_t index = expected.empty() ? 0 : gen() % (expected.size() + 1);
+            auto it = list.begin();
+            auto eit = expected.begin();
+            for (std::size_t i = 0; i < index; ++i)
+            {
+                ++it;
+                ++eit;
+            }
+            if (gen() % 3 != 0 || eit == expected.end())
+            {
+                it = list.insert(it, round);
+                eit = expected.insert(eit, round);
+                assert(*it == round);
+            }
+            else
+            {
+                it = list.erase(it);
+                eit = expected.erase(eit);
+                assert(eit == expected.end() ? it == list.end() : *it == *eit);
+            }
+        }
+        assert(same(list, expected));
+
+        // 范围删除跨越多个节点
+        auto first = list.begin();
+        auto efirst = expected.begin();
+        for (int i = 0; i < 10; ++i)
+        {
+            ++first;
+            ++efirst;
+        }
+        auto last = first;
+        auto elast = efirst;
+        for (int i = 0; i < 300; ++i)
+        {
+            ++last;
+            ++elast;
+        }
+        auto it = list.erase(first, last);
+        auto eit = expected.erase(efirst, elast);
+        assert(*it == *eit);
+        assert(same(list, expected));
+        assert(list.erase(list.begin(), list.end()) == list.end());
+        assert(list.empty() && list.node_count() == 0);
+    }
+
+    // 非平凡元素的范围删除: 空区间, 以及终点恰为节点开头的区间
+    {
+        TS::unrolled_list<std::string> list;
+        std::list<std::string> expected;
+        for (int i = 0; i < 200; ++i)
+        {
+            std::string value(20 + i % 5, static_cast<char>('a' + i % 26));
+            list.push_back(value);
+            expected.push_back(value);
+        }
+        auto it = list.erase(list.begin(), list.begin());
+        assert(it == list.begin() && same(list, expected));
+
+        // 同一节点内元素地址连续, 地址不相邻处即为下一个节点的开头
+        auto boundary = list.begin();
+        std::size_t offset = 0;
+        for (auto prev = boundary++; &*boundary == &*prev + 1; prev = boundary++)
+        {
+            ++offset;
+        }
+        ++offset;
+        auto eboundary = expected.begin();
+        for (std::size_t i = 0; i < offset; ++i)
+        {
+            ++eboundary;
+        }
+        auto first = list.begin();
+        auto efirst = expected.begin();
+        for (int i = 0; i < 3; ++i)
+        {
+            ++first;
+            ++efirst;
+        }
+        it = list.erase(first, boundary);
+        auto eit = expected.erase(efirst, eboundary);
+        assert(*it == *eit && same(list, expected));
+
+        it = list.erase(list.begin(), ++list.begin());
+        expected.pop_front();
+        assert(*it == expected.front() && same(list, expected));
+    }
+
+    // 参数引用自身元素
+    {
+        TS::unrolled_list<std::string> list{"a", "b", "c"};
+        list.insert(list.begin(), list.back());
+        list.push_back(list.front());
+        assert(list.front() == "c" && list.back() == "c" && list.size() == 5);
+    }
+
+    std::cout << "All insert and erase tests passed!" << std::endl;
+}
+
+void test_small_nodes()
+{
+    std::cout << "=== Testing large elements ===" << std::endl;
+
+    // 元素过大时每个节点只放一个
+    using big_list = TS::unrolled_list<std::string, TS::alloc, 16>;
+    assert(big_list::node_capacity == 1);
+    big_list list;
+    std::list<std::string> expected;
+    for (int i = 0; i < 50; ++i)
+    {
+        std::string value(40, static_cast<char>('a' + i % 26));
+        auto it = list.begin();
+        auto eit = expected.begin();
+        for (int k = 0; k < i / 2; ++k)
+        {
+            ++it;
+            ++eit;
+        }
+        list.insert(it, value);
+        expected.insert(eit, value);
+    }
+    assert(same(list, expected));
+    assert(list.node_count() == 50);
+
+    std::cout << "All large element tests passed!" << std::endl;
+}
+
+void test_segmented_algorithms()
+{
+    std::cout << "=== Testing segmented algorithms ===" << std::endl;
+
+    TS::unrolled_list<int> list;
+    for (int i = 0; i < 1000; ++i)
+    {
+        list.push_back(i);
+    }
+    // 从中间删除一些元素, 使节点不满
+    auto it = list.begin();
+    for (int i = 0; i < 1000; ++i)
+    {
+        it = i % 3 == 0 ? list.erase(it) : ++it;
+    }
+    assert(list.size() == 666);
+
+    auto found = TS::find(list.begin(), list.end(), 500);
+    assert(found != list.end() && *found == 500);
+    assert(TS::find(list.begin(), list.end(), 501) == list.end());
+    assert(TS::count(list.begin(), list.end(), 998) == 1);
+
+    TS::fill(list.begin(), list.end(), 3);
+    assert(TS::count(list.begin(), list.end(), 3) == 666);
+
+    TS::unrolled_list<int> other(666, 0);
+    TS::copy(list.begin(), list.end(), other.begin());
+    assert(other == list);
+
+    std::cout << "All segmented algorithm tests passed!" << std::endl;
+}
+
+void run_all_tests()
+{
+    test_constructors_and_assignment();
+    test_push_pop();
+    test_insert_erase();
+    test_small_nodes();
+    test_segmented_algorithms();
+
+    std::cout << "\nAll tests passed! TS::unrolled_list is correct." << std::endl;
+}
+
+} // namespace TS_Test
+
+int main()
+{
+    TS_Test::run_all_tests();
+    return 0;
+}
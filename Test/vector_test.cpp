@@ -1,7 +1,12 @@
+#include "ts_alloc_profile.hpp"
 #include "ts_vector.hpp"
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
 
 using namespace TS;
 
@@ -304,6 +309,129 @@ void test_strings()
     std::cout << "All string tests passed!\n";
 }
 
+void test_ranges()
+{
+    // 区间构造: 指针, std 双向迭代器, 单趟输入迭代器
+    int arr[] = {1, 2, 3, 4, 5};
+    vector<int> v1(arr, arr + 5);
+    assert(v1.size() == 5 && v1.capacity() == 5);
+    std::list<int> l{1, 2, 3};
+    vector<int> v2(l.begin(), l.end());
+    assert(v2 == vector<int>({1, 2, 3}));
+    std::istringstream in("4 5 6 7");
+    vector<int> v3{std::istream_iterator<int>(in), std::istream_iterator<int>()};
+    assert(v3 == vector<int>({4, 5, 6, 7}));
+
+    // 两个整数实参仍是 (数量, 值)
+    vector<int> v4(3, 9);
+    assert(v4 == vector<int>({9, 9, 9}));
+
+    // 区间插入: 容量足够时原地后移, 否则重新分配
+    vector<int> v5{1, 5};
+    v5.reserve(10);
+    v5.insert(v5.begin() + 1, arr + 1, arr + 4);
+    assert(v5 == vector<int>({1, 2, 3, 4, 5}));
+    auto it = v5.insert(v5.end(), l.begin(), l.end());
+    assert(it == v5.begin() + 5);
+    assert(v5 == vector<int>({1, 2, 3, 4, 5, 1, 2, 3}));
+    it = v5.insert(v5.begin(), {7, 8, 9});
+    assert(it == v5.begin());
+    assert(v5.size() == 11 && v5[0] == 7 && v5[3] == 1 && v5[10] == 3);
+    std::istringstream in2("10 11");
+    v5.insert(v5.begin() + 3, std::istream_iterator<int>(in2), std::istream_iterator<int>());
+    assert(v5[3] == 10 && v5[4] == 11 && v5[5] == 1 && v5.size() == 13);
+
+    // 数量插入, 值引用容器自身元素
+    vector<int> v6{1, 2, 3};
+    v6.insert(v6.begin(), 2, v6[2]);
+    assert(v6 == vector<int>({3, 3, 1, 2, 3}));
+    v6.insert(v6.end(), 0, 4);
+    assert(v6.size() == 5);
+
+    // assign: 变长, 变短, 超出容量, 输入迭代器
+    vector<int> v7{1, 2, 3};
+    v7.assign(5, 8);
+    assert(v7 == vector<int>({8, 8, 8, 8, 8}));
+    v7.assign(arr, arr + 2);
+    assert(v7 == vector<int>({1, 2}));
+    v7.assign({6, 7, 8, 9});
+    assert(v7 == vector<int>({6, 7, 8, 9}));
+    std::istringstream in3("1 2");
+    v7.assign(std::istream_iterator<int>(in3), std::istream_iterator<int>());
+    assert(v7 == vector<int>({1, 2}));
+
+    // 非平凡类型: 插入与删除时元素被正确搬移和析构
+    vector<std::string> s{"a", "e"};
+    std::list<std::string> words{"b", "c", "d"};
+    s.insert(s.begin() + 1, words.begin(), words.end());
+    assert(s.size() == 5 && s[1] == "b" && s[3] == "d" && s[4] == "e");
+    s.insert(s.begin() + 2, 2, std::string(40, 'x'));
+    assert(s.size() == 7 && s[2].size() == 40 && s[4] == "c");
+    s.erase(s.begin() + 1, s.begin() + 4);
+    assert(s.size() == 4 && s[0] == "a" && s[1] == "c" && s[3] == "e");
+    s.assign(words.begin(), words.end());
+    assert(s.size() == 3 && s[0] == "b" && s[2] == "d");
+
+    // 前向区间插入至多重新分配一次
+    struct range_tag
+    {
+    };
+    using counted = vector<int, profiled_alloc<alloc, range_tag>>;
+    counted v8(4, 0);
+    std::list<int> big(1000, 1);
+    {
+        alloc_scope scope;
+        v8.insert(v8.begin() + 2, big.begin(), big.end());
+        assert(expect_allocations_at_most(scope.stats(), 1));
+    }
+    {
+        alloc_scope scope;
+        counted v9(big.begin(), big.end());
+        v9.assign(arr, arr + 5);
+        assert(expect_allocations_at_most(scope.stats(), 1));
+    }
+    assert(v8.size() == 1004 && v8[1] == 0 && v8[2] == 1 && v8[1002] == 0);
+
+    std::cout << "All range tests passed!\n";
+}
+
+void test_comparisons()
+{
+    vector<int> v1{1, 2, 3};
+    vector<int> v2{1, 2, 3};
+    vector<int> v3{1, 2, 3, 0};
+    vector<int> v4{1, -2, 3};
+    assert(v1 == v2 && !(v1 != v2));
+    assert(v1 != v3 && v1 < v3 && v3 > v1);
+    assert(v4 < v1 && v4 <= v1 && v1 >= v4);
+    assert(compare(v1, v2) == 0 && compare(v1, v3) < 0 && compare(v1, v4) > 0);
+
+    // 大缓冲区: 差异跨越 memcmp 分块边界
+    vector<long long> a(10000, 5);
+    vector<long long> b(a);
+    assert(a == b);
+    b[9999] = 4;
+    assert(a != b && b < a && compare(a, b) > 0);
+    auto diff = TS::mismatch(a.begin(), a.end(), b.begin());
+    assert(diff.first == a.begin() + 9999 && *diff.second == 4);
+    b[9999] = 5;
+    b[64] = -1;
+    diff = TS::mismatch(a.begin(), a.end(), b.begin());
+    assert(diff.first == a.begin() + 64);
+
+    // 字节类型直接按 memcmp 定序
+    vector<unsigned char> c1{1, 200, 3};
+    vector<unsigned char> c2{1, 20, 3, 4};
+    assert(c2 < c1 && compare(c1, c2) > 0);
+
+    // 非平凡类型走逐元素比较
+    vector<std::string> s1{"a", "b"};
+    vector<std::string> s2{"a", "c"};
+    assert(s1 < s2 && s1 != s2 && compare(s2, s1) > 0);
+
+    std::cout << "All comparison tests passed!\n";
+}
+
 void test_algorithms()
 {
     // 确保与标准算法兼容
@@ -329,6 +457,8 @@ int main()
     test_modifiers();
     test_exceptions();
     test_strings();
+    test_ranges();
+    test_comparisons();
     test_algorithms();
 
     std::cout << "\nAll tests passed! Vector implementation is correct.\n";
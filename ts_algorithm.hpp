@@ -0,0 +1,1002 @@
+#ifndef TS_ALGORITHM_HPP
+#define TS_ALGORITHM_HPP
+
+#include "ts_iterator.hpp"
+#include "ts_simd.hpp"
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// 是否处于常量求值中: constexpr 函数据此避开 memcmp/memmove 与向量内核;
+// 编译器不提供时一律按常量求值处理, 只使用逐元素循环
+#if defined(__GNUC__) || defined(__clang__)
+#define TS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define TS_CONSTANT_EVALUATED() true
+#endif
+
+namespace TS
+{
+template <typename Iter>
+using is_segmented_iterator = typename segmented_iterator_traits<Iter>::is_segmented_iterator;
+
+// 指针到指针且元素可平凡赋值时, 可直接 memmove
+template <typename InputIter, typename OutputIter> struct is_memmove_copyable : std::false_type
+{
+};
+
+template <typename T, typename U>
+struct is_memmove_copyable<T *, U *>
+    : std::integral_constant<bool, std::is_same<typename std::remove_const<T>::type, U>::value &&
+                                       std::is_trivially_copy_assignable<U>::value>
+{
+};
+
+// 单字节平凡类型的 fill 可直接 memset
+template <typename Iter, typename T> struct is_memset_fillable : std::false_type
+{
+};
+
+template <typename U, typename T>
+struct is_memset_fillable<U *, T>
+    : std::integral_constant<bool, sizeof(U) == 1 && std::is_integral<U>::value &&
+                                       !std::is_same<U, bool>::value && std::is_integral<T>::value>
+{
+};
+
+// 整数, 枚举, 指针等每个值只有一种对象表示的标量: 相等当且仅当逐字节相等
+// 不包括类类型, 其 operator== 可能只比较部分成员
+template <typename T>
+struct is_bytewise_comparable
+    : std::integral_constant<bool, (std::is_integral<T>::value || std::is_enum<T>::value ||
+                                    std::is_pointer<T>::value) &&
+                                       std::has_unique_object_representations<T>::value>
+{
+};
+
+template <typename Iter1, typename Iter2> struct is_memcmp_comparable : std::false_type
+{
+};
+
+template <typename T, typename U>
+struct is_memcmp_comparable<T *, U *>
+    : std::integral_constant<bool,
+                             std::is_same<std::remove_const_t<T>, std::remove_const_t<U>>::value &&
+                                 is_bytewise_comparable<std::remove_const_t<T>>::value>
+{
+};
+
+// 字节序即大小序的类型: memcmp 的结果可直接作为字典序比较结果
+template <typename T>
+struct is_memcmp_orderable
+    : std::integral_constant<bool, std::is_same<T, unsigned char>::value ||
+                                       (std::is_same<T, char>::value && CHAR_MIN == 0)>
+{
+};
+
+// copy
+
+template <typename InputIter, typename OutputIter>
+inline OutputIter copy_leaf(InputIter first, InputIter last, OutputIter result, std::false_type)
+{
+    for (; first != last; ++first, ++result)
+    {
+        *result = *first;
+    }
+    return result;
+}
+
+template <typename T, typename U> inline U *copy_leaf(T *first, T *last, U *result, std::true_type)
+{
+    std::ptrdiff_t count = last - first;
+    if (count > 0)
+    {
+        std::memmove(result, first, count * sizeof(U));
+    }
+    return result + count;
+}
+
+template <typename InputIter, typename OutputIter>
+inline OutputIter copy_out(InputIter first, InputIter last, OutputIter result, std::false_type)
+{
+    return copy_leaf(first, last, result, is_memmove_copyable<InputIter, OutputIter>());
+}
+
+// 输出为分段迭代器且输入为指针: 按输出段切块
+template <typename InputIter, typename OutputIter>
+inline OutputIter copy_out(InputIter first, InputIter last, OutputIter result, std::true_type)
+{
+    using traits = segmented_iterator_traits<OutputIter>;
+    using local_iterator = typename traits::local_iterator;
+    if (first == last)
+    {
+        return result;
+    }
+    auto seg = traits::segment(result);
+    local_iterator cur = traits::local(result);
+    while (true)
+    {
+        std::ptrdiff_t room = traits::end(seg) - cur;
+        std::ptrdiff_t left = last - first;
+        if (left <= room)
+        {
+            cur = copy_leaf(first, last, cur, is_memmove_copyable<InputIter, local_iterator>());
+            return traits::compose(seg, cur);
+        }
+        copy_leaf(first, first + room, cur, is_memmove_copyable<InputIter, local_iterator>());
+        first += room;
+        ++seg;
+        cur = traits::begin(seg);
+    }
+}
+
+template <typename InputIter, typename OutputIter>
+inline OutputIter copy_out(InputIter first, InputIter last, OutputIter result)
+{
+    using chunked = std::integral_constant<bool, is_segmented_iterator<OutputIter>::value &&
+                                                     std::is_pointer<InputIter>::value>;
+    return copy_out(first, last, result, chunked());
+}
+
+template <typename InputIter, typename OutputIter>
+inline OutputIter copy_in(InputIter first, InputIter last, OutputIter result, std::false_type)
+{
+    return copy_out(first, last, result);
+}
+
+// 输入为分段迭代器: 逐段转为连续区间
+template <typename InputIter, typename OutputIter>
+inline OutputIter copy_in(InputIter first, InputIter last, OutputIter result, std::true_type)
+{
+    using traits = segmented_iterator_traits<InputIter>;
+    auto sfirst = traits::segment(first);
+    auto slast = traits::segment(last);
+    if (sfirst == slast)
+    {
+        return copy_out(traits::local(first), traits::local(last), result);
+    }
+    result = copy_out(traits::local(first), traits::end(sfirst), result);
+    for (++sfirst; sfirst != slast; ++sfirst)
+    {
+        result = copy_out(traits::begin(sfirst), traits::end(sfirst), result);
+    }
+    return copy_out(traits::begin(slast), traits::local(last), result);
+}
+
+template <typename InputIter, typename OutputIter>
+inline OutputIter copy(InputIter first, InputIter last, OutputIter result)
+{
+    return copy_in(first, last, result, is_segmented_iterator<InputIter>());
+}
+
+template <typename BidirIter1, typename BidirIter2>
+inline BidirIter2 copy_backward(BidirIter1 first, BidirIter1 last, BidirIter2 result)
+{
+    while (first != last)
+    {
+        *--result = *--last;
+    }
+    return result;
+}
+
+// swap_ranges
+
+template <typename ForwardIter1, typename ForwardIter2>
+inline ForwardIter2 swap_ranges_aux(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2,
+                                    std::false_type)
+{
+    for (; first1 != last1; ++first1, ++first2)
+    {
+        using std::swap;
+        swap(*first1, *first2);
+    }
+    return first2;
+}
+
+// 交换缓冲区的字节数, 编译器将每块的 memcpy 展开为若干向量加载与存储
+const std::size_t SWAP_BLOCK_BYTES = 64;
+
+// 可平凡复制的同类型元素按块经栈上缓冲区交换字节
+template <typename T>
+inline T *swap_ranges_aux(T *first1, T *last1, T *first2, std::true_type)
+{
+    std::size_t bytes = (last1 - first1) * sizeof(T);
+    char *a = reinterpret_cast<char *>(first1);
+    char *b = reinterpret_cast<char *>(first2);
+    unsigned char buffer[SWAP_BLOCK_BYTES];
+    std::size_t i = 0;
+    for (; i + SWAP_BLOCK_BYTES <= bytes; i += SWAP_BLOCK_BYTES)
+    {
+        std::memcpy(buffer, a + i, SWAP_BLOCK_BYTES);
+        std::memcpy(a + i, b + i, SWAP_BLOCK_BYTES);
+        std::memcpy(b + i, buffer, SWAP_BLOCK_BYTES);
+    }
+    std::memcpy(buffer, a + i, bytes - i);
+    std::memcpy(a + i, b + i, bytes - i);
+    std::memcpy(b + i, buffer, bytes - i);
+    return first2 + (last1 - first1);
+}
+
+template <typename Iter1, typename Iter2> struct is_bytewise_swappable : std::false_type
+{
+};
+
+template <typename T>
+struct is_bytewise_swappable<T *, T *>
+    : std::integral_constant<bool, std::is_trivially_copyable<T>::value &&
+                                       !std::is_const<T>::value && !std::is_volatile<T>::value>
+{
+};
+
+// 两区间不得重叠
+template <typename ForwardIter1, typename ForwardIter2>
+inline ForwardIter2 swap_ranges(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2)
+{
+    return swap_ranges_aux(first1, last1, first2,
+                           is_bytewise_swappable<ForwardIter1, ForwardIter2>());
+}
+
+// fill
+
+template <typename ForwardIter, typename T>
+inline void fill_leaf(ForwardIter first, ForwardIter last, const T &val, std::false_type)
+{
+    for (; first != last; ++first)
+    {
+        *first = val;
+    }
+}
+
+template <typename U, typename T>
+inline void fill_pointer(U *first, U *last, const T &val, std::false_type)
+{
+    for (; first != last; ++first)
+    {
+        *first = val;
+    }
+}
+
+// 4 或 8 字节的标量按位模式经向量内核填充
+template <typename U, typename T>
+inline void fill_pointer(U *first, U *last, const T &val, std::true_type)
+{
+    const U pattern = val;
+    simd::fill(first, last, pattern);
+}
+
+template <typename U, typename T>
+inline void fill_leaf(U *first, U *last, const T &val, std::false_type)
+{
+    fill_pointer(first, last, val, simd::is_fill_vectorizable<U *>());
+}
+
+template <typename U, typename T>
+inline void fill_leaf(U *first, U *last, const T &val, std::true_type)
+{
+    if (first != last)
+    {
+        std::memset(first, static_cast<unsigned char>(val), last - first);
+    }
+}
+
+template <typename ForwardIter, typename T>
+inline void fill_aux(ForwardIter first, ForwardIter last, const T &val, std::false_type)
+{
+    fill_leaf(first, last, val, is_memset_fillable<ForwardIter, T>());
+}
+
+template <typename ForwardIter, typename T>
+inline void fill_aux(ForwardIter first, ForwardIter last, const T &val, std::true_type)
+{
+    using traits = segmented_iterator_traits<ForwardIter>;
+    using local_iterator = typename traits::local_iterator;
+    auto sfirst = traits::segment(first);
+    auto slast = traits::segment(last);
+    if (sfirst == slast)
+    {
+        fill_leaf(traits::local(first), traits::local(last), val,
+                  is_memset_fillable<local_iterator, T>());
+        return;
+    }
+    fill_leaf(traits::local(first), traits::end(sfirst), val,
+              is_memset_fillable<local_iterator, T>());
+    for (++sfirst; sfirst != slast; ++sfirst)
+    {
+        fill_leaf(traits::begin(sfirst), traits::end(sfirst), val,
+                  is_memset_fillable<local_iterator, T>());
+    }
+    fill_leaf(traits::begin(slast), traits::local(last), val,
+              is_memset_fillable<local_iterator, T>());
+}
+
+template <typename ForwardIter, typename T>
+inline void fill(ForwardIter first, ForwardIter last, const T &val)
+{
+    fill_aux(first, last, val, is_segmented_iterator<ForwardIter>());
+}
+
+// find
+
+template <typename InputIter, typename T>
+inline InputIter find_leaf(InputIter first, InputIter last, const T &val)
+{
+    for (; first != last; ++first)
+    {
+        if (*first == val)
+        {
+            break;
+        }
+    }
+    return first;
+}
+
+template <typename T, typename U>
+inline T *find_pointer(T *first, T *last, const U &val, std::false_type)
+{
+    for (; first != last; ++first)
+    {
+        if (*first == val)
+        {
+            break;
+        }
+    }
+    return first;
+}
+
+template <typename T, typename U>
+inline T *find_pointer(T *first, T *last, const U &val, std::true_type)
+{
+    return const_cast<T *>(simd::find<U>(first, last, val));
+}
+
+// 元素类型与查找值同为 int32_t 或 float 时使用向量内核
+template <typename T, typename U>
+struct is_simd_searchable
+    : std::integral_constant<bool, std::is_same<std::remove_const_t<T>, U>::value &&
+                                       simd::is_vectorizable<U>::value>
+{
+};
+
+template <typename T, typename U> inline T *find_leaf(T *first, T *last, const U &val)
+{
+    return find_pointer(first, last, val, is_simd_searchable<T, U>());
+}
+
+template <typename InputIter, typename T>
+inline InputIter find_aux(InputIter first, InputIter last, const T &val, std::false_type)
+{
+    return find_leaf(first, last, val);
+}
+
+template <typename InputIter, typename T>
+inline InputIter find_aux(InputIter first, InputIter last, const T &val, std::true_type)
+{
+    using traits = segmented_iterator_traits<InputIter>;
+    auto sfirst = traits::segment(first);
+    auto slast = traits::segment(last);
+    if (sfirst == slast)
+    {
+        return traits::compose(sfirst, find_leaf(traits::local(first), traits::local(last), val));
+    }
+    auto seg_end = traits::end(sfirst);
+    auto found = find_leaf(traits::local(first), seg_end, val);
+    if (found != seg_end)
+    {
+        return traits::compose(sfirst, found);
+    }
+    for (++sfirst; sfirst != slast; ++sfirst)
+    {
+        seg_end = traits::end(sfirst);
+        found = find_leaf(traits::begin(sfirst), seg_end, val);
+        if (found != seg_end)
+        {
+            return traits::compose(sfirst, found);
+        }
+    }
+    return traits::compose(slast, find_leaf(traits::begin(slast), traits::local(last), val));
+}
+
+template <typename InputIter, typename T>
+inline InputIter find(InputIter first, InputIter last, const T &val)
+{
+    return find_aux(first, last, val, is_segmented_iterator<InputIter>());
+}
+
+// count
+
+template <typename InputIter, typename T>
+inline std::size_t count_leaf(InputIter first, InputIter last, const T &val)
+{
+    std::size_t result = 0;
+    for (; first != last; ++first)
+    {
+        if (*first == val)
+        {
+            ++result;
+        }
+    }
+    return result;
+}
+
+template <typename T, typename U>
+inline std::size_t count_pointer(T *first, T *last, const U &val, std::false_type)
+{
+    return count_leaf<T *, U>(first, last, val);
+}
+
+template <typename T, typename U>
+inline std::size_t count_pointer(T *first, T *last, const U &val, std::true_type)
+{
+    return simd::count<U>(first, last, val);
+}
+
+template <typename T, typename U> inline std::size_t count_leaf(T *first, T *last, const U &val)
+{
+    return count_pointer(first, last, val, is_simd_searchable<T, U>());
+}
+
+template <typename InputIter, typename T>
+inline std::size_t count_aux(InputIter first, InputIter last, const T &val, std::false_type)
+{
+    return count_leaf(first, last, val);
+}
+
+template <typename InputIter, typename T>
+inline std::size_t count_aux(InputIter first, InputIter last, const T &val, std::true_type)
+{
+    using traits = segmented_iterator_traits<InputIter>;
+    auto sfirst = traits::segment(first);
+    auto slast = traits::segment(last);
+    if (sfirst == slast)
+    {
+        return count_leaf(traits::local(first), traits::local(last), val);
+    }
+    std::size_t result = count_leaf(traits::local(first), traits::end(sfirst), val);
+    for (++sfirst; sfirst != slast; ++sfirst)
+    {
+        result += count_leaf(traits::begin(sfirst), traits::end(sfirst), val);
+    }
+    return result + count_leaf(traits::begin(slast), traits::local(last), val);
+}
+
+template <typename InputIter, typename T>
+inline std::size_t count(InputIter first, InputIter last, const T &val)
+{
+    return count_aux(first, last, val, is_segmented_iterator<InputIter>());
+}
+
+// for_each
+
+template <typename InputIter, typename Function>
+inline void for_each_leaf(InputIter first, InputIter last, Function &f)
+{
+    for (; first != last; ++first)
+    {
+        f(*first);
+    }
+}
+
+template <typename InputIter, typename Function>
+inline void for_each_aux(InputIter first, InputIter last, Function &f, std::false_type)
+{
+    for_each_leaf(first, last, f);
+}
+
+template <typename InputIter, typename Function>
+inline void for_each_aux(InputIter first, InputIter last, Function &f, std::true_type)
+{
+    using traits = segmented_iterator_traits<InputIter>;
+    auto sfirst = traits::segment(first);
+    auto slast = traits::segment(last);
+    if (sfirst == slast)
+    {
+        for_each_leaf(traits::local(first), traits::local(last), f);
+        return;
+    }
+    for_each_leaf(traits::local(first), traits::end(sfirst), f);
+    for (++sfirst; sfirst != slast; ++sfirst)
+    {
+        for_each_leaf(traits::begin(sfirst), traits::end(sfirst), f);
+    }
+    for_each_leaf(traits::begin(slast), traits::local(last), f);
+}
+
+template <typename InputIter, typename Function>
+inline Function for_each(InputIter first, InputIter last, Function f)
+{
+    for_each_aux(first, last, f, is_segmented_iterator<InputIter>());
+    return f;
+}
+
+// transform
+// 指针区间上的简单循环可由编译器直接向量化
+
+template <typename InputIter, typename OutputIter, typename UnaryOp>
+inline OutputIter transform(InputIter first, InputIter last, OutputIter result, UnaryOp op)
+{
+    for (; first != last; ++first, ++result)
+    {
+        *result = op(*first);
+    }
+    return result;
+}
+
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename BinaryOp>
+inline OutputIter transform(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                            OutputIter result, BinaryOp op)
+{
+    for (; first1 != last1; ++first1, ++first2, ++result)
+    {
+        *result = op(*first1, *first2);
+    }
+    return result;
+}
+
+// accumulate
+
+struct plus_op
+{
+    template <typename T, typename U> auto operator()(T &&lhs, U &&rhs) const -> decltype(lhs + rhs)
+    {
+        return std::forward<T>(lhs) + std::forward<U>(rhs);
+    }
+};
+
+struct multiplies_op
+{
+    template <typename T, typename U> auto operator()(T &&lhs, U &&rhs) const -> decltype(lhs * rhs)
+    {
+        return std::forward<T>(lhs) * std::forward<U>(rhs);
+    }
+};
+
+template <typename InputIter, typename T, typename BinaryOp>
+inline T accumulate_leaf(InputIter first, InputIter last, T init, BinaryOp &op)
+{
+    for (; first != last; ++first)
+    {
+        init = op(std::move(init), *first);
+    }
+    return init;
+}
+
+template <typename InputIter, typename T, typename BinaryOp>
+inline T accumulate_aux(InputIter first, InputIter last, T init, BinaryOp &op, std::false_type)
+{
+    return accumulate_leaf(first, last, std::move(init), op);
+}
+
+template <typename InputIter, typename T, typename BinaryOp>
+inline T accumulate_aux(InputIter first, InputIter last, T init, BinaryOp &op, std::true_type)
+{
+    using traits = segmented_iterator_traits<InputIter>;
+    auto sfirst = traits::segment(first);
+    auto slast = traits::segment(last);
+    if (sfirst == slast)
+    {
+        return accumulate_leaf(traits::local(first), traits::local(last), std::move(init), op);
+    }
+    init = accumulate_leaf(traits::local(first), traits::end(sfirst), std::move(init), op);
+    for (++sfirst; sfirst != slast; ++sfirst)
+    {
+        init = accumulate_leaf(traits::begin(sfirst), traits::end(sfirst), std::move(init), op);
+    }
+    return accumulate_leaf(traits::begin(slast), traits::local(last), std::move(init), op);
+}
+
+template <typename InputIter, typename T, typename BinaryOp>
+inline T accumulate(InputIter first, InputIter last, T init, BinaryOp op)
+{
+    return accumulate_aux(first, last, std::move(init), op, is_segmented_iterator<InputIter>());
+}
+
+template <typename InputIter, typename T>
+inline T accumulate(InputIter first, InputIter last, T init)
+{
+    return TS::accumulate(first, last, std::move(init), plus_op());
+}
+
+// equal
+
+struct equal_to_op
+{
+    template <typename T, typename U> bool operator()(const T &lhs, const U &rhs) const
+    {
+        return lhs == rhs;
+    }
+};
+
+struct less_op
+{
+    template <typename T, typename U> bool operator()(const T &lhs, const U &rhs) const
+    {
+        return lhs < rhs;
+    }
+};
+
+// 比较 [first1, last1) 与 first2 起的区间, 并推进 first2
+template <typename InputIter1, typename InputIter2, typename BinaryPred>
+inline bool equal_leaf(InputIter1 first1, InputIter1 last1, InputIter2 &first2, BinaryPred &pred)
+{
+    for (; first1 != last1; ++first1, ++first2)
+    {
+        if (!pred(*first1, *first2))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, typename U>
+inline bool equal_memcmp(T *first1, T *last1, U *&first2, equal_to_op &pred, std::false_type)
+{
+    for (; first1 != last1; ++first1, ++first2)
+    {
+        if (!pred(*first1, *first2))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, typename U>
+inline bool equal_memcmp(T *first1, T *last1, U *&first2, equal_to_op &, std::true_type)
+{
+    std::ptrdiff_t count = last1 - first1;
+    bool result = count == 0 || std::memcmp(first1, first2, count * sizeof(T)) == 0;
+    first2 += count;
+    return result;
+}
+
+// 指针区间的默认相等比较交给 memcmp (libc 中已按 CPU 选用向量化实现)
+template <typename T, typename U>
+inline bool equal_leaf(T *first1, T *last1, U *&first2, equal_to_op &pred)
+{
+    return equal_memcmp(first1, last1, first2, pred, is_memcmp_comparable<T *, U *>());
+}
+
+template <typename InputIter1, typename InputIter2, typename BinaryPred>
+inline bool equal_out(InputIter1 first1, InputIter1 last1, InputIter2 &first2, BinaryPred &pred,
+                      std::false_type)
+{
+    return equal_leaf(first1, last1, first2, pred);
+}
+
+// 第二区间为分段迭代器且第一区间为指针: 按第二区间的段切块
+template <typename InputIter1, typename InputIter2, typename BinaryPred>
+inline bool equal_out(InputIter1 first1, InputIter1 last1, InputIter2 &first2, BinaryPred &pred,
+                      std::true_type)
+{
+    using traits = segmented_iterator_traits<InputIter2>;
+    if (first1 == last1)
+    {
+        return true;
+    }
+    auto seg = traits::segment(first2);
+    auto cur = traits::local(first2);
+    while (true)
+    {
+        std::ptrdiff_t room = traits::end(seg) - cur;
+        std::ptrdiff_t left = last1 - first1;
+        if (left <= room)
+        {
+            bool result = equal_leaf(first1, last1, cur, pred);
+            first2 = traits::compose(seg, cur);
+            return result;
+        }
+        if (!equal_leaf(first1, first1 + room, cur, pred))
+        {
+            return false;
+        }
+        first1 += room;
+        ++seg;
+        cur = traits::begin(seg);
+    }
+}
+
+template <typename InputIter1, typename InputIter2, typename BinaryPred>
+inline bool equal_out(InputIter1 first1, InputIter1 last1, InputIter2 &first2, BinaryPred &pred)
+{
+    using chunked = std::integral_constant<bool, is_segmented_iterator<InputIter2>::value &&
+                                                     std::is_pointer<InputIter1>::value>;
+    return equal_out(first1, last1, first2, pred, chunked());
+}
+
+template <typename InputIter1, typename InputIter2, typename BinaryPred>
+inline bool equal_in(InputIter1 first1, InputIter1 last1, InputIter2 first2, BinaryPred &pred,
+                     std::false_type)
+{
+    return equal_out(first1, last1, first2, pred);
+}
+
+template <typename InputIter1, typename InputIter2, typename BinaryPred>
+inline bool equal_in(InputIter1 first1, InputIter1 last1, InputIter2 first2, BinaryPred &pred,
+                     std::true_type)
+{
+    using traits = segmented_iterator_traits<InputIter1>;
+    auto sfirst = traits::segment(first1);
+    auto slast = traits::segment(last1);
+    if (sfirst == slast)
+    {
+        return equal_out(traits::local(first1), traits::local(last1), first2, pred);
+    }
+    if (!equal_out(traits::local(first1), traits::end(sfirst), first2, pred))
+    {
+        return false;
+    }
+    for (++sfirst; sfirst != slast; ++sfirst)
+    {
+        if (!equal_out(traits::begin(sfirst), traits::end(sfirst), first2, pred))
+        {
+            return false;
+        }
+    }
+    return equal_out(traits::begin(slast), traits::local(last1), first2, pred);
+}
+
+template <typename InputIter1, typename InputIter2, typename BinaryPred>
+inline bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, BinaryPred pred)
+{
+    return equal_in(first1, last1, first2, pred, is_segmented_iterator<InputIter1>());
+}
+
+template <typename InputIter1, typename InputIter2>
+inline bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2)
+{
+    return TS::equal(first1, last1, first2, equal_to_op());
+}
+
+// mismatch
+
+const std::size_t MISMATCH_BLOCK_BYTES = 256;
+
+template <typename InputIter1, typename InputIter2>
+inline std::pair<InputIter1, InputIter2> mismatch_aux(InputIter1 first1, InputIter1 last1,
+                                                      InputIter2 first2, std::false_type)
+{
+    for (; first1 != last1 && *first1 == *first2; ++first1, ++first2)
+    {
+    }
+    return std::pair<InputIter1, InputIter2>(first1, first2);
+}
+
+// 按块 memcmp 跳过相同的前缀, 只在第一个不同的块内逐个比较
+template <typename T, typename U>
+inline std::pair<T *, U *> mismatch_aux(T *first1, T *last1, U *first2, std::true_type)
+{
+    const std::ptrdiff_t block = MISMATCH_BLOCK_BYTES / sizeof(T) > 0
+                                     ? std::ptrdiff_t(MISMATCH_BLOCK_BYTES / sizeof(T))
+                                     : 1;
+    while (last1 - first1 >= block && std::memcmp(first1, first2, block * sizeof(T)) == 0)
+    {
+        first1 += block;
+        first2 += block;
+    }
+    return mismatch_aux(first1, last1, first2, std::false_type());
+}
+
+template <typename InputIter1, typename InputIter2>
+inline std::pair<InputIter1, InputIter2> mismatch(InputIter1 first1, InputIter1 last1,
+                                                  InputIter2 first2)
+{
+    return mismatch_aux(first1, last1, first2, is_memcmp_comparable<InputIter1, InputIter2>());
+}
+
+// lexicographical_compare
+
+template <typename InputIter1, typename InputIter2, typename Compare>
+inline bool lexicographical_compare(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                                    InputIter2 last2, Compare comp)
+{
+    for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+    {
+        if (comp(*first1, *first2))
+        {
+            return true;
+        }
+        if (comp(*first2, *first1))
+        {
+            return false;
+        }
+    }
+    return first1 == last1 && first2 != last2;
+}
+
+// 返回负数, 0, 正数分别表示第一区间小于, 等于, 大于第二区间
+template <typename InputIter1, typename InputIter2>
+inline int lexicographical_compare_3way_aux(InputIter1 first1, InputIter1 last1,
+                                            InputIter2 first2, InputIter2 last2, std::false_type)
+{
+    for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+    {
+        if (*first1 < *first2)
+        {
+            return -1;
+        }
+        if (*first2 < *first1)
+        {
+            return 1;
+        }
+    }
+    if (first1 != last1)
+    {
+        return 1;
+    }
+    return first2 == last2 ? 0 : -1;
+}
+
+template <typename T, typename U>
+inline int lexicographical_compare_3way_aux(T *first1, T *last1, U *first2, U *last2,
+                                            std::true_type)
+{
+    std::ptrdiff_t len1 = last1 - first1;
+    std::ptrdiff_t len2 = last2 - first2;
+    std::ptrdiff_t count = len1 < len2 ? len1 : len2;
+    if (is_memcmp_orderable<std::remove_const_t<T>>::value)
+    {
+        int result = count == 0 ? 0 : std::memcmp(first1, first2, count);
+        if (result != 0)
+        {
+            return result < 0 ? -1 : 1;
+        }
+    }
+    else
+    {
+        std::pair<T *, U *> diff = mismatch_aux(first1, first1 + count, first2, std::true_type());
+        if (diff.first != first1 + count)
+        {
+            return *diff.first < *diff.second ? -1 : 1;
+        }
+    }
+    return len1 < len2 ? -1 : len1 > len2 ? 1 : 0;
+}
+
+template <typename InputIter1, typename InputIter2>
+inline int lexicographical_compare_3way(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                                        InputIter2 last2)
+{
+    return lexicographical_compare_3way_aux(first1, last1, first2, last2,
+                                            is_memcmp_comparable<InputIter1, InputIter2>());
+}
+
+template <typename InputIter1, typename InputIter2>
+inline bool lexicographical_compare_aux(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                                        InputIter2 last2, std::false_type)
+{
+    return TS::lexicographical_compare(first1, last1, first2, last2, less_op());
+}
+
+template <typename InputIter1, typename InputIter2>
+inline bool lexicographical_compare_aux(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                                        InputIter2 last2, std::true_type)
+{
+    return lexicographical_compare_3way_aux(first1, last1, first2, last2, std::true_type()) < 0;
+}
+
+template <typename InputIter1, typename InputIter2>
+inline bool lexicographical_compare(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                                    InputIter2 last2)
+{
+    return lexicographical_compare_aux(first1, last1, first2, last2,
+                                       is_memcmp_comparable<InputIter1, InputIter2>());
+}
+
+// min_element, max_element, minmax_element
+// 最小值取最先出现者; LastMax 为 false 时最大值取最先出现者 (max_element),
+// 为 true 时取最后出现者 (minmax_element); Min/Max 指明需要哪一侧, 向量内核只计算所需的一侧
+
+template <bool LastMax, typename ForwardIter>
+inline void merge_extrema(std::pair<ForwardIter, ForwardIter> &result, ForwardIter min,
+                          ForwardIter max)
+{
+    if (*min < *result.first)
+    {
+        result.first = min;
+    }
+    if (LastMax ? !(*max < *result.second) : *result.second < *max)
+    {
+        result.second = max;
+    }
+}
+
+template <bool Min, bool Max, bool LastMax, typename ForwardIter>
+inline std::pair<ForwardIter, ForwardIter> extrema_pointer(ForwardIter first, ForwardIter last,
+                                                           std::false_type)
+{
+    std::pair<ForwardIter, ForwardIter> result(first, first);
+    for (++first; first != last; ++first)
+    {
+        merge_extrema<LastMax>(result, first, first);
+    }
+    return result;
+}
+
+template <bool Min, bool Max, bool LastMax, typename T>
+inline std::pair<T *, T *> extrema_pointer(T *first, T *last, std::true_type)
+{
+    using value_type = std::remove_const_t<T>;
+    simd::extrema found = simd::find_extrema<Min, Max, LastMax, value_type>(first, last - first);
+    return std::pair<T *, T *>(first + found.min, first + found.max);
+}
+
+// 非空区间
+template <bool Min, bool Max, bool LastMax, typename ForwardIter>
+inline std::pair<ForwardIter, ForwardIter> extrema_leaf(ForwardIter first, ForwardIter last)
+{
+    using value_type = std::remove_const_t<typename iterator_traits<ForwardIter>::value_type>;
+    using vectorized = std::integral_constant<bool, std::is_pointer<ForwardIter>::value &&
+                                                        simd::is_vectorizable<value_type>::value>;
+    return extrema_pointer<Min, Max, LastMax>(first, last, vectorized());
+}
+
+template <bool Min, bool Max, bool LastMax, typename ForwardIter>
+inline std::pair<ForwardIter, ForwardIter> extrema_aux(ForwardIter first, ForwardIter last,
+                                                       std::false_type)
+{
+    return extrema_leaf<Min, Max, LastMax>(first, last);
+}
+
+template <bool Min, bool Max, bool LastMax, typename ForwardIter>
+inline std::pair<ForwardIter, ForwardIter> extrema_aux(ForwardIter first, ForwardIter last,
+                                                       std::true_type)
+{
+    using traits = segmented_iterator_traits<ForwardIter>;
+    auto sfirst = traits::segment(first);
+    auto slast = traits::segment(last);
+    if (sfirst == slast)
+    {
+        auto local = extrema_leaf<Min, Max, LastMax>(traits::local(first), traits::local(last));
+        return std::pair<ForwardIter, ForwardIter>(traits::compose(sfirst, local.first),
+                                                   traits::compose(sfirst, local.second));
+    }
+    auto local = extrema_leaf<Min, Max, LastMax>(traits::local(first), traits::end(sfirst));
+    std::pair<ForwardIter, ForwardIter> result(traits::compose(sfirst, local.first),
+                                               traits::compose(sfirst, local.second));
+    for (++sfirst; sfirst != slast; ++sfirst)
+    {
+        local = extrema_leaf<Min, Max, LastMax>(traits::begin(sfirst), traits::end(sfirst));
+        merge_extrema<LastMax>(result, traits::compose(sfirst, local.first),
+                               traits::compose(sfirst, local.second));
+    }
+    if (traits::begin(slast) != traits::local(last))
+    {
+        local = extrema_leaf<Min, Max, LastMax>(traits::begin(slast), traits::local(last));
+        merge_extrema<LastMax>(result, traits::compose(slast, local.first),
+                               traits::compose(slast, local.second));
+    }
+    return result;
+}
+
+template <bool Min, bool Max, bool LastMax, typename ForwardIter>
+inline std::pair<ForwardIter, ForwardIter> extrema(ForwardIter first, ForwardIter last)
+{
+    if (first == last)
+    {
+        return std::pair<ForwardIter, ForwardIter>(last, last);
+    }
+    return extrema_aux<Min, Max, LastMax>(first, last, is_segmented_iterator<ForwardIter>());
+}
+
+template <typename ForwardIter> inline ForwardIter min_element(ForwardIter first, ForwardIter last)
+{
+    return TS::extrema<true, false, false>(first, last).first;
+}
+
+template <typename ForwardIter> inline ForwardIter max_element(ForwardIter first, ForwardIter last)
+{
+    return TS::extrema<false, true, false>(first, last).second;
+}
+
+template <typename ForwardIter>
+inline std::pair<ForwardIter, ForwardIter> minmax_element(ForwardIter first, ForwardIter last)
+{
+    return TS::extrema<true, true, true>(first, last);
+}
+
+} // namespace TS
+
+#endif
@@ -5,6 +5,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <mutex>
+#include <type_traits>
 #include <utility>
 
 namespace TS
@@ -13,19 +15,9 @@ namespace TS
     std::cout << "out of memory" << std::endl;                                                     \
     throw std::bad_alloc()
 
-template <typename T> inline void construct(T *p)
+template <typename T, typename... Args> inline void construct(T *p, Args &&...args)
 {
-    new (p) T();
-}
-
-template <typename T, typename U> inline void construct(T *p, const U &val)
-{
-    new (p) T(val);
-}
-
-template <typename T, typename U> inline void construct(T *p, U &&val)
-{
-    new (p) T(std::move(val));
+    new (p) T(std::forward<Args>(args)...);
 }
 
 // template <typename T, typename U> inline void reconstruct(T *p, const U &val)
@@ -47,12 +39,6 @@ template <typename T, typename U> inline void construct(T *p, U &&val)
 //     new (p) T(il);
 // }
 
-// template <typename T, typename... Args> inline void construct(T *p, Args &&...args)
-// {
-//     std::cerr << "Constructing at " << p << " with " << sizeof...(args) << " arguments\n";
-//     new (p) T(std::forward<Args>(args)...);
-// }
-
 template <typename T> inline void destroy(T *p)
 {
     p->~T();
@@ -207,12 +193,18 @@ template <bool threads, int inst> class deafault_alloc_template
     static pointer allocate(size_type size)
     {
         void *result = nullptr;
+        // 0 字节没有对应的自由链表 (free_list_index(0) 为 -1)
+        if (0 == size)
+        {
+            return result;
+        }
         if (size > MAX_BYTES)
         {
             result = malloc_alloc::allocate(size);
         }
         else
         {
+            lock guard;
             Obj *free_space = free_list[free_list_index(size)];
             if (nullptr == free_space)
             {
@@ -235,6 +227,7 @@ template <bool threads, int inst> class deafault_alloc_template
         }
         else
         {
+            lock guard;
             Obj *q = (Obj *)p;
             q->free_list_link = free_list[free_list_index(size)];
             free_list[free_list_index(size)] = q;
@@ -244,6 +237,27 @@ template <bool threads, int inst> class deafault_alloc_template
     static pointer reallocate(pointer p, size_type old_size, size_type new_size);
 
   protected:
+    // threads 为 true 时用互斥锁保护共享的自由链表与内存池, 为 false 时不加锁
+    class lock
+    {
+      public:
+        lock()
+        {
+            if (threads)
+            {
+                pool_mutex.lock();
+            }
+        }
+
+        ~lock()
+        {
+            if (threads)
+            {
+                pool_mutex.unlock();
+            }
+        }
+    };
+
     static size_type round_up(size_type bytes)
     {
         return (bytes + ALIGN - 1) & (~(ALIGN - 1)); // key function
@@ -264,10 +278,11 @@ template <bool threads, int inst> class deafault_alloc_template
     static char *chunk_alloc(size_type size, size_type &count);
 
   protected:
-    static Obj *free_list[]; // 二级指针
+    static Obj *free_list[NFREELISTS]; // 二级指针
     static char *start_free;
     static char *end_free;
     static size_type heap_size;
+    static std::mutex pool_mutex;
 };
 
 template <bool threads, int inst>
@@ -279,6 +294,7 @@ template <bool threads, int inst> char *deafault_alloc_template<threads, inst>::
 // 统计从系统申请的空间
 template <bool threads, int inst> std::size_t deafault_alloc_template<threads, inst>::heap_size = 0;
 // 初始化为0->nullptr
+template <bool threads, int inst> std::mutex deafault_alloc_template<threads, inst>::pool_mutex;
 
 template <bool threads, int inst>
 inline bool operator==(const deafault_alloc_template<threads, inst> &,
@@ -313,6 +329,7 @@ template <bool threads, int inst>
 void *deafault_alloc_template<threads, inst>::refiil(size_type size)
 {
     size_type count = 20; // 默认创建为每种空间二十块区
+    // 调用者已持有锁
     char *chunk = chunk_alloc(size, count);
     // chunk_alloc有可能更改count
     if (1 == count)
@@ -388,7 +405,42 @@ char *deafault_alloc_template<threads, inst>::chunk_alloc(size_type size, size_t
     }
 }
 
-using alloc = deafault_alloc_template<false, 0>;
+// 两级分配器的 reallocate 签名不同: malloc_alloc 为 (p, new_size),
+// deafault_alloc_template 还需要旧大小; 包装者按被包装者的实际签名转发
+template <typename Alloc, typename = void> struct reallocate_takes_old_size : std::false_type
+{
+};
+
+template <typename Alloc>
+struct reallocate_takes_old_size<
+    Alloc, std::void_t<decltype(Alloc::reallocate(std::declval<void *>(), std::size_t(0),
+                                                  std::size_t(0)))>> : std::true_type
+{
+};
+
+template <typename Alloc>
+inline void *reallocate_with_size(void *p, std::size_t old_size, std::size_t new_size,
+                                  std::true_type)
+{
+    return Alloc::reallocate(p, old_size, new_size);
+}
+
+template <typename Alloc>
+inline void *reallocate_with_size(void *p, std::size_t, std::size_t new_size, std::false_type)
+{
+    return Alloc::reallocate(p, new_size);
+}
+
+template <typename Alloc>
+inline void *reallocate_with_size(void *p, std::size_t old_size, std::size_t new_size)
+{
+    return reallocate_with_size<Alloc>(p, old_size, new_size,
+                                       reallocate_takes_old_size<Alloc>());
+}
+
+using alloc = deafault_alloc_template<true, 0>;
+// 仅供单线程使用, 补充内存池时不加锁
+using single_client_alloc = deafault_alloc_template<false, 0>;
 
 } // namespace TS
 
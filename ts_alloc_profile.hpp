@@ -0,0 +1,278 @@
+#ifndef TS_ALLOC_PROFILE_HPP
+#define TS_ALLOC_PROFILE_HPP
+
+#include "ts_alloc.hpp"
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+
+namespace TS
+{
+// 请求大小直方图: 第 i 桶统计 (2^(i-1), 2^i] 字节的请求, 最后一桶收纳更大的请求
+const std::size_t ALLOC_HISTOGRAM_BUCKETS = 24;
+
+inline std::size_t alloc_histogram_bucket(std::size_t size)
+{
+    std::size_t bucket = 0;
+    while (bucket + 1 < ALLOC_HISTOGRAM_BUCKETS && (std::size_t(1) << bucket) < size)
+    {
+        ++bucket;
+    }
+    return bucket;
+}
+
+struct alloc_stats
+{
+    std::size_t allocations = 0; // 含 reallocate 产生的新块
+    std::size_t deallocations = 0;
+    std::size_t reallocations = 0;
+    std::size_t bytes_allocated = 0;
+    std::size_t bytes_freed = 0;
+    // 相对作用域开始时的净值; 释放作用域开始前分配的块会使其为负
+    std::ptrdiff_t live_blocks = 0;
+    std::ptrdiff_t live_bytes = 0;
+    std::size_t peak_live_bytes = 0; // live_bytes 的最大正值
+
+    std::size_t histogram[ALLOC_HISTOGRAM_BUCKETS] = {};
+
+    void record_allocate(std::size_t size)
+    {
+        ++allocations;
+        bytes_allocated += size;
+        ++live_blocks;
+        live_bytes += std::ptrdiff_t(size);
+        if (live_bytes > 0 && std::size_t(live_bytes) > peak_live_bytes)
+        {
+            peak_live_bytes = std::size_t(live_bytes);
+        }
+        ++histogram[alloc_histogram_bucket(size)];
+    }
+
+    void record_deallocate(std::size_t size)
+    {
+        ++deallocations;
+        bytes_freed += size;
+        --live_blocks;
+        live_bytes -= std::ptrdiff_t(size);
+    }
+
+    std::ptrdiff_t net_blocks() const
+    {
+        return live_blocks;
+    }
+
+    std::ptrdiff_t net_bytes() const
+    {
+        return live_bytes;
+    }
+
+    void print(std::ostream &os) const
+    {
+        os << "allocations " << allocations << ", deallocations " << deallocations
+           << ", reallocations " << reallocations << ", bytes " << bytes_allocated << '/'
+           << bytes_freed << ", net blocks " << net_blocks() << ", peak bytes "
+           << peak_live_bytes << '\n';
+        for (std::size_t i = 0; i < ALLOC_HISTOGRAM_BUCKETS; ++i)
+        {
+            if (histogram[i] != 0)
+            {
+                os << "  <= " << (std::size_t(1) << i) << " bytes: " << histogram[i] << '\n';
+            }
+        }
+    }
+};
+
+// 记录当前线程上所有 profiled_alloc 活动的 RAII 作用域, 可以嵌套
+class alloc_scope
+{
+  public:
+    alloc_scope() : _outer(innermost())
+    {
+        innermost() = this;
+    }
+
+    alloc_scope(const alloc_scope &) = delete;
+    alloc_scope &operator=(const alloc_scope &) = delete;
+
+    ~alloc_scope()
+    {
+        innermost() = _outer;
+    }
+
+    const alloc_stats &stats() const
+    {
+        return _stats;
+    }
+
+    void reset()
+    {
+        _stats = alloc_stats();
+    }
+
+    // 由分配策略调用, 通知当前线程上所有活动的作用域
+    static void notify_allocate(std::size_t size)
+    {
+        for (alloc_scope *scope = innermost(); scope != nullptr; scope = scope->_outer)
+        {
+            scope->_stats.record_allocate(size);
+        }
+    }
+
+    static void notify_deallocate(std::size_t size)
+    {
+        for (alloc_scope *scope = innermost(); scope != nullptr; scope = scope->_outer)
+        {
+            scope->_stats.record_deallocate(size);
+        }
+    }
+
+    static void notify_reallocate()
+    {
+        for (alloc_scope *scope = innermost(); scope != nullptr; scope = scope->_outer)
+        {
+            ++scope->_stats.reallocations;
+        }
+    }
+
+  protected:
+    static alloc_scope *&innermost()
+    {
+        static thread_local alloc_scope *scope = nullptr;
+        return scope;
+    }
+
+  protected:
+    alloc_scope *_outer;
+    alloc_stats _stats;
+};
+
+// 包装 alloc 或 malloc_alloc 的分配策略, 接口与被包装者相同, 但 reallocate 总是接收旧大小;
+// 每个 (Base, Tag) 组合累计一份全局统计, 用不同 Tag 区分各个容器
+template <typename Base, typename Tag = void> class profiled_alloc
+{
+  public:
+    using pointer = void *;
+    using size_type = std::size_t;
+
+  public:
+    static pointer allocate(size_type size)
+    {
+        pointer result = Base::allocate(size);
+        record_allocate(size);
+        return result;
+    }
+
+    static void deallocate(pointer p, size_type size)
+    {
+        Base::deallocate(p, size);
+        record_deallocate(size);
+    }
+
+    static pointer reallocate(pointer p, size_type old_size, size_type new_size)
+    {
+        pointer result = reallocate_with_size<Base>(p, old_size, new_size);
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex());
+            ++total().reallocations;
+            total().record_deallocate(old_size);
+            total().record_allocate(new_size);
+        }
+        alloc_scope::notify_reallocate();
+        alloc_scope::notify_deallocate(old_size);
+        alloc_scope::notify_allocate(new_size);
+        return result;
+    }
+
+    // 返回累计统计的快照
+    static alloc_stats stats()
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex());
+        return total();
+    }
+
+    static void reset_stats()
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex());
+        total() = alloc_stats();
+    }
+
+  protected:
+    static void record_allocate(size_type size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex());
+            total().record_allocate(size);
+        }
+        alloc_scope::notify_allocate(size);
+    }
+
+    static void record_deallocate(size_type size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex());
+            total().record_deallocate(size);
+        }
+        alloc_scope::notify_deallocate(size);
+    }
+
+    static alloc_stats &total()
+    {
+        static alloc_stats result;
+        return result;
+    }
+
+    static std::mutex &stats_mutex()
+    {
+        static std::mutex result;
+        return result;
+    }
+};
+
+// 测试断言辅助: 不满足时打印统计并返回 false, 配合 assert 使用
+inline bool report_alloc_failure(const alloc_stats &stats, const char *what)
+{
+    std::cerr << "allocation check failed: " << what << '\n';
+    stats.print(std::cerr);
+    return false;
+}
+
+inline bool expect_allocations_at_most(const alloc_stats &stats, std::size_t bound)
+{
+    return stats.allocations <= bound || report_alloc_failure(stats, "too many allocations");
+}
+
+inline bool expect_no_allocations(const alloc_stats &stats)
+{
+    return stats.allocations == 0 || report_alloc_failure(stats, "unexpected allocation");
+}
+
+// 所有在作用域内分配的块都已释放
+inline bool expect_no_leaks(const alloc_stats &stats)
+{
+    return stats.net_blocks() <= 0 || report_alloc_failure(stats, "blocks still live");
+}
+
+// n 次操作的分配次数不超过 factor * ceil(log2(n)) + slack, 即 O(log n)
+inline bool expect_logarithmic_allocations(const alloc_stats &stats, std::size_t n,
+                                           std::size_t factor = 1, std::size_t slack = 2)
+{
+    std::size_t log_n = 0;
+    while ((std::size_t(1) << log_n) < n)
+    {
+        ++log_n;
+    }
+    return stats.allocations <= factor * log_n + slack ||
+           report_alloc_failure(stats, "allocations grow faster than O(log n)");
+}
+
+// n 次操作的分配次数不超过 per_op * n + slack, 即 O(n)
+inline bool expect_linear_allocations(const alloc_stats &stats, std::size_t n,
+                                      std::size_t per_op = 1, std::size_t slack = 0)
+{
+    return stats.allocations <= per_op * n + slack ||
+           report_alloc_failure(stats, "allocations grow faster than O(n)");
+}
+
+} // namespace TS
+
+#endif
@@ -1,22 +1,22 @@
 #ifndef TS_ARRAY_HPP
 #define TS_ARRAY_HPP
 
-#include "ts_uninitialized.hpp"
-#include <algorithm>
+#include "ts_algorithm.hpp"
 #include <cstddef>
-#include <initializer_list>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 namespace TS
 {
-template <typename T, std::size_t N> class array;
-
-template <typename T, std::size_t N>
-bool operator==(const array<T, N> &lhs, const array<T, N> &rhs);
-
-template <typename T, std::size_t N> class array
+// 聚合类型: 可用花括号直接初始化并用于常量表达式; T 可平凡复制时 array 也可平凡复制,
+// 拷贝由编译器按 memcpy 完成
+// Align 为存储的对齐字节数, 可取 16/32/64 使其与向量寄存器或缓存行对齐
+template <typename T, std::size_t N, std::size_t Align = alignof(T)> class array
 {
+    static_assert((Align & (Align - 1)) == 0 && Align >= alignof(T),
+                  "Align must be a power of two no less than alignof(T)");
+
   public:
     using value_type = T;
     using size_type = std::size_t;
@@ -29,90 +29,39 @@ template <typename T, std::size_t N> class array
     using const_iterator = const value_type *;
 
   protected:
-    using self = array<T, N>;
+    using self = array<T, N, Align>;
 
   public:
-    ~array() = default;
-
-    array() : _data{}
-    {
-    }
-
-    array(const self &other)
-    {
-        uninitialized_copy_n(other._data, other.size(), _data);
-    }
-
-    array(self &&other) noexcept
-    {
-        for (size_type i = 0; i < N; i++)
-        {
-            _data[i] = std::move(other._data[i]);
-        }
-    }
-
-    array(std::initializer_list<T> init)
-    {
-        if (init.size() > N)
-        {
-            throw std::out_of_range("Too many elements in initializer list");
-        }
-
-        uninitialized_copy_n(init.begin(), init.size(), _data);
-        uninitialized_fill_n(_data + init.size(), N - init.size(), T());
-    }
-
-    self &operator=(const self &other)
-    {
-        if (this != &other)
-        {
-            uninitialized_copy_n(other._data, other.size(), _data);
-        }
-        return *this;
-    }
-
-    self &operator=(self &&other) noexcept
-    {
-        if (this != &other)
-        {
-            for (size_type i = 0; i < N; ++i)
-            {
-                _data[i] = std::move(other._data[i]);
-            }
-        }
-        return *this;
-    }
-
-    reference at(size_type pos)
+    constexpr reference at(size_type pos)
     {
         return const_cast<reference>(static_cast<const self *>(this)->at(pos));
     }
 
-    const_reference at(size_type pos) const
+    constexpr const_reference at(size_type pos) const
     {
-        if (pos < 0 || pos >= N)
+        if (pos >= N)
         {
             throw std::out_of_range("out of range");
         }
         return operator[](pos);
     }
 
-    reference operator[](size_type pos)
+    constexpr reference operator[](size_type pos)
     {
         return const_cast<reference>(static_cast<const self *>(this)->operator[](pos));
     }
 
-    const_reference operator[](size_type pos) const
+    constexpr const_reference operator[](size_type pos) const
     {
         return _data[pos];
     }
 
-    reference front()
+    constexpr reference front()
     {
         return const_cast<reference>(static_cast<const self *>(this)->front());
     }
 
-    const_reference front() const
+    constexpr const_reference front() const
     {
         if (empty())
         {
@@ -121,12 +70,12 @@ template <typename T, std::size_t N> class array
         return *_data;
     }
 
-    reference back()
+    constexpr reference back()
     {
         return const_cast<reference>(static_cast<const self *>(this)->back());
     }
 
-    const_reference back() const
+    constexpr const_reference back() const
     {
         if (empty())
         {
@@ -135,42 +84,42 @@ template <typename T, std::size_t N> class array
         return _data[N - 1];
     }
 
-    pointer data() noexcept
+    constexpr pointer data() noexcept
     {
         return const_cast<pointer>(static_cast<const self *>(this)->data());
     }
 
-    const_pointer data() const noexcept
+    constexpr const_pointer data() const noexcept
     {
         return _data;
     }
 
-    iterator begin() noexcept
+    constexpr iterator begin() noexcept
     {
         return const_cast<iterator>(static_cast<const self *>(this)->begin());
     }
 
-    const_iterator begin() const noexcept
+    constexpr const_iterator begin() const noexcept
     {
         return _data;
     }
 
-    const_iterator cbegin() const noexcept
+    constexpr const_iterator cbegin() const noexcept
     {
         return _data;
     }
 
-    iterator end() noexcept
+    constexpr iterator end() noexcept
     {
         return const_cast<iterator>(static_cast<const self *>(this)->end());
     }
 
-    const_iterator end() const noexcept
+    constexpr const_iterator end() const noexcept
     {
         return _data + N;
     }
 
-    const_iterator cend() const noexcept
+    constexpr const_iterator cend() const noexcept
     {
         return _data + N;
     }
@@ -190,75 +139,222 @@ template <typename T, std::size_t N> class array
         return N;
     }
 
-    void fill(const T &val)
+    constexpr void fill(const T &val)
     {
-        uninitialized_fill_n(_data, N, val);
+        if (!TS_CONSTANT_EVALUATED())
+        {
+            TS::fill(_data, _data + N, val);
+            return;
+        }
+        for (size_type i = 0; i < N; ++i)
+        {
+            _data[i] = val;
+        }
     }
 
-    void swap(self &other) noexcept
+    constexpr void swap(self &other) noexcept(std::is_nothrow_move_constructible<T>::value &&
+                                              std::is_nothrow_move_assignable<T>::value)
     {
         if (this == &other)
         {
             return;
         }
+        if (!TS_CONSTANT_EVALUATED())
+        {
+            TS::swap_ranges(_data, _data + N, other._data);
+            return;
+        }
         for (size_type i = 0; i < N; ++i)
         {
-            std::swap(_data[i], other._data[i]);
+            T tmp = std::move(_data[i]);
+            _data[i] = std::move(other._data[i]);
+            other._data[i] = std::move(tmp);
         }
     }
 
-    friend bool operator== <T, N>(const array<T, N> &lhs, const array<T, N> &rhs);
-
-  protected:
-    T _data[N];
+    // 聚合初始化要求成员公开, 不应直接访问; 默认初始化时元素被值初始化
+    alignas(Align) T _data[N] = {};
 };
 
-template <typename T, std::size_t N> bool operator==(const array<T, N> &lhs, const array<T, N> &rhs)
+// 由初始值推导: array a = {1, 2, 3} 得到 array<int, 3>
+template <typename T, typename... U> array(T, U...) -> array<T, 1 + sizeof...(U)>;
+
+// 常量求值时逐个比较, 运行时使用 memcmp 等快速路径
+template <typename T, std::size_t N, std::size_t A>
+constexpr bool operator==(const array<T, N, A> &lhs, const array<T, N, A> &rhs)
 {
-    if (lhs.size() != rhs.size())
+    if (!TS_CONSTANT_EVALUATED())
     {
-        return false;
+        return TS::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
-
     for (std::size_t i = 0; i < N; ++i)
     {
-        if (lhs[i] != rhs[i])
+        if (!(lhs[i] == rhs[i]))
         {
             return false;
         }
     }
-
     return true;
 }
 
-template <std::size_t I, typename T, std::size_t N> T &get(array<T, N> &a) noexcept
+template <typename T, std::size_t N, std::size_t A>
+constexpr bool operator!=(const array<T, N, A> &lhs, const array<T, N, A> &rhs)
 {
-    return const_cast<T &>(get<I>(static_cast<const array<T, N> &>(a)));
+    return !(lhs == rhs);
 }
 
-template <std::size_t I, typename T, std::size_t N> T &&get(array<T, N> &&a) noexcept
+// 三路比较: 返回负数, 0, 正数
+template <typename T, std::size_t N, std::size_t A>
+constexpr int compare(const array<T, N, A> &lhs, const array<T, N, A> &rhs)
 {
-    static_assert(I >= 0 && I < N);
+    if (!TS_CONSTANT_EVALUATED())
+    {
+        return TS::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        if (lhs[i] < rhs[i])
+        {
+            return -1;
+        }
+        if (rhs[i] < lhs[i])
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+template <typename T, std::size_t N, std::size_t A>
+constexpr bool operator<(const array<T, N, A> &lhs, const array<T, N, A> &rhs)
+{
+    if (!TS_CONSTANT_EVALUATED())
+    {
+        return TS::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    return compare(lhs, rhs) < 0;
+}
+
+template <typename T, std::size_t N, std::size_t A>
+constexpr bool operator>(const array<T, N, A> &lhs, const array<T, N, A> &rhs)
+{
+    return rhs < lhs;
+}
+
+template <typename T, std::size_t N, std::size_t A>
+constexpr bool operator<=(const array<T, N, A> &lhs, const array<T, N, A> &rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <typename T, std::size_t N, std::size_t A>
+constexpr bool operator>=(const array<T, N, A> &lhs, const array<T, N, A> &rhs)
+{
+    return !(lhs < rhs);
+}
+
+template <std::size_t I, typename T, std::size_t N, std::size_t A>
+constexpr T &get(array<T, N, A> &a) noexcept
+{
+    return const_cast<T &>(get<I>(static_cast<const array<T, N, A> &>(a)));
+}
+
+template <std::size_t I, typename T, std::size_t N, std::size_t A>
+constexpr T &&get(array<T, N, A> &&a) noexcept
+{
+    static_assert(I < N, "index out of range");
     return std::move(a[I]);
 }
 
-template <std::size_t I, typename T, std::size_t N> const T &get(const array<T, N> &a) noexcept
+template <std::size_t I, typename T, std::size_t N, std::size_t A>
+constexpr const T &get(const array<T, N, A> &a) noexcept
 {
-    static_assert(I >= 0 && I < N);
+    static_assert(I < N, "index out of range");
     return a[I];
 }
 
-template <std::size_t I, typename T, std::size_t N> const T &&get(const array<T, N> &&a) noexcept
+template <std::size_t I, typename T, std::size_t N, std::size_t A>
+constexpr const T &&get(const array<T, N, A> &&a) noexcept
 {
-    static_assert(I >= 0 && I < N);
+    static_assert(I < N, "index out of range");
     return std::move(a[I]);
 }
 
-template <typename T, std::size_t N> void swap(array<T, N> &lhs, array<T, N> &rhs)
+template <typename T, std::size_t N, std::size_t A>
+constexpr void swap(array<T, N, A> &lhs, array<T, N, A> &rhs) noexcept(noexcept(lhs.swap(rhs)))
 {
     lhs.swap(rhs);
 }
 
+// 逐元素算术, 用于热路径上的小型定长向量; 循环次数在编译期已知, 编译器可完全展开并向量化
+
+template <typename T, std::size_t N, std::size_t A>
+constexpr array<T, N, A> add(const array<T, N, A> &lhs, const array<T, N, A> &rhs)
+{
+    array<T, N, A> result{};
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        result[i] = lhs[i] + rhs[i];
+    }
+    return result;
+}
+
+template <typename T, std::size_t N, std::size_t A>
+constexpr array<T, N, A> mul(const array<T, N, A> &lhs, const array<T, N, A> &rhs)
+{
+    array<T, N, A> result{};
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        result[i] = lhs[i] * rhs[i];
+    }
+    return result;
+}
+
+// a * b + c; 浮点数不保证只舍入一次, 是否合并为 FMA 指令取决于编译选项
+template <typename T, std::size_t N, std::size_t A>
+constexpr array<T, N, A> fma(const array<T, N, A> &a, const array<T, N, A> &b,
+                             const array<T, N, A> &c)
+{
+    array<T, N, A> result{};
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        result[i] = a[i] * b[i] + c[i];
+    }
+    return result;
+}
+
+// dot 的独立累加路数
+const std::size_t ARRAY_DOT_LANES = 8;
+
+// 分 ARRAY_DOT_LANES 路独立累加后两两合并: 各路互不依赖, 可映射到向量通道;
+// 浮点数的求和顺序因此不同于逐个累加, 结果可能有舍入差异
+template <typename T, std::size_t N, std::size_t A>
+constexpr T dot(const array<T, N, A> &lhs, const array<T, N, A> &rhs)
+{
+    T lanes[ARRAY_DOT_LANES] = {};
+    std::size_t i = 0;
+    for (; i + ARRAY_DOT_LANES <= N; i += ARRAY_DOT_LANES)
+    {
+        for (std::size_t k = 0; k < ARRAY_DOT_LANES; ++k)
+        {
+            lanes[k] += lhs[i + k] * rhs[i + k];
+        }
+    }
+    for (std::size_t width = ARRAY_DOT_LANES / 2; width > 0; width /= 2)
+    {
+        for (std::size_t k = 0; k < width; ++k)
+        {
+            lanes[k] += lanes[k + width];
+        }
+    }
+    T result = lanes[0];
+    for (; i < N; ++i)
+    {
+        result += lhs[i] * rhs[i];
+    }
+    return result;
+}
+
 } // namespace TS
 
-#endif
\ No newline at end of file
+#endif
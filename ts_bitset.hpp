@@ -0,0 +1,715 @@
+#ifndef TS_BITSET_HPP
+#define TS_BITSET_HPP
+
+#include "ts_alloc.hpp"
+#include "ts_simd.hpp"
+#include "ts_vector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+// 定长位集 bitset<N> 与变长位向量 dynamic_bitset<Alloc>, 以 64 位字存储
+// 第 i 位位于第 i / 64 个字的第 i % 64 位; 最后一个字中超出 size() 的位始终为 0,
+// 计数, 比较与查找因此无需屏蔽尾部
+// 整个位图的与, 或, 异或, 与非以及计数经 simd 内核按字并行处理
+// rank(pos): [0, pos) 中置位的个数; select(k): 第 k 个 (从 0 起) 置位的位置
+// find_first/find_next 跳过全 0 的字, 在字内以 ctz 定位
+
+namespace TS
+{
+const std::size_t BITSET_WORD_BITS = 64;
+// select 先按块计数跳过, 每块的字数
+const std::size_t BITSET_SELECT_BLOCK = 64;
+
+// bitset 与 dynamic_bitset 共用的字数组操作, bits 为有效位数
+struct Bitset_words
+{
+    static constexpr std::size_t npos = std::size_t(-1);
+
+    static constexpr std::size_t word_count(std::size_t bits)
+    {
+        return (bits + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS;
+    }
+
+    static std::uint64_t bit_mask(std::size_t pos)
+    {
+        return std::uint64_t(1) << (pos % BITSET_WORD_BITS);
+    }
+
+    // 最后一个字中有效位的掩码
+    static std::uint64_t tail_mask(std::size_t bits)
+    {
+        std::size_t rest = bits % BITSET_WORD_BITS;
+        return rest == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << rest) - 1;
+    }
+
+    // 清除最后一个字中超出 bits 的位
+    static void trim(std::uint64_t *w, std::size_t bits)
+    {
+        if (bits % BITSET_WORD_BITS != 0)
+        {
+            w[bits / BITSET_WORD_BITS] &= tail_mask(bits);
+        }
+    }
+
+    static void fill(std::uint64_t *w, std::size_t bits, bool value)
+    {
+        simd::fill(w, w + word_count(bits), value ? ~std::uint64_t(0) : std::uint64_t(0));
+        trim(w, bits);
+    }
+
+    static void flip(std::uint64_t *w, std::size_t bits)
+    {
+        std::size_t n = word_count(bits);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            w[i] = ~w[i];
+        }
+        trim(w, bits);
+    }
+
+    static bool any(const std::uint64_t *w, std::size_t bits)
+    {
+        std::size_t n = word_count(bits);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (w[i] != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool all(const std::uint64_t *w, std::size_t bits)
+    {
+        std::size_t full = bits / BITSET_WORD_BITS;
+        for (std::size_t i = 0; i < full; ++i)
+        {
+            if (w[i] != ~std::uint64_t(0))
+            {
+                return false;
+            }
+        }
+        return bits % BITSET_WORD_BITS == 0 || w[full] == tail_mask(bits);
+    }
+
+    static bool equal(const std::uint64_t *a, const std::uint64_t *b, std::size_t bits)
+    {
+        std::size_t n = word_count(bits);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (a[i] != b[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static std::size_t count(const std::uint64_t *w, std::size_t bits)
+    {
+        return simd::popcount(w, word_count(bits));
+    }
+
+    // [0, pos) 中置位的个数, pos 不超过 bits
+    static std::size_t rank(const std::uint64_t *w, std::size_t pos)
+    {
+        std::size_t full = pos / BITSET_WORD_BITS;
+        std::size_t result = simd::popcount(w, full);
+        if (pos % BITSET_WORD_BITS != 0)
+        {
+            result += simd::popcount64(w[full] & (bit_mask(pos) - 1));
+        }
+        return result;
+    }
+
+    // 字内第 k 个置位的位置, k 小于该字的置位数; 先逐字节缩小范围, 再逐位清除
+    static std::size_t select_in_word(std::uint64_t word, std::size_t k)
+    {
+        std::size_t base = 0;
+        for (;;)
+        {
+            std::size_t c = simd::popcount64(word & 0xff);
+            if (k < c)
+            {
+                break;
+            }
+            k -= c;
+            word >>= 8;
+            base += 8;
+        }
+        for (; k > 0; --k)
+        {
+            word &= word - 1;
+        }
+        return base + simd::ctz64(word);
+    }
+
+    // 第 k 个置位的位置; 置位不足 k + 1 个时返回 npos
+    static std::size_t select(const std::uint64_t *w, std::size_t bits, std::size_t k)
+    {
+        std::size_t n = word_count(bits);
+        std::size_t i = 0;
+        for (; i + BITSET_SELECT_BLOCK <= n; i += BITSET_SELECT_BLOCK)
+        {
+            std::size_t c = simd::popcount(w + i, BITSET_SELECT_BLOCK);
+            if (k < c)
+            {
+                break;
+            }
+            k -= c;
+        }
+        for (; i < n; ++i)
+        {
+            std::size_t c = simd::popcount64(w[i]);
+            if (k < c)
+            {
+                return i * BITSET_WORD_BITS + select_in_word(w[i], k);
+            }
+            k -= c;
+        }
+        return npos;
+    }
+
+    // 不小于 pos 的第一个置位的位置; 没有时返回 npos
+    static std::size_t find_from(const std::uint64_t *w, std::size_t bits, std::size_t pos)
+    {
+        if (pos >= bits)
+        {
+            return npos;
+        }
+        std::size_t n = word_count(bits);
+        std::size_t i = pos / BITSET_WORD_BITS;
+        std::uint64_t word = w[i] & ~(bit_mask(pos) - 1);
+        while (word == 0)
+        {
+            if (++i == n)
+            {
+                return npos;
+            }
+            word = w[i];
+        }
+        return i * BITSET_WORD_BITS + simd::ctz64(word);
+    }
+};
+
+template <std::size_t N> class bitset
+{
+  public:
+    using size_type = std::size_t;
+    using self = bitset<N>;
+
+    static constexpr size_type npos = Bitset_words::npos;
+
+  protected:
+    static constexpr size_type WORDS = Bitset_words::word_count(N);
+
+  public:
+    bitset() noexcept : _words()
+    {
+    }
+
+    // 低位取自 value, 超出 N 的位被丢弃
+    bitset(unsigned long long value) noexcept : _words()
+    {
+        _words[0] = value;
+        Bitset_words::trim(_words, N);
+    }
+
+    constexpr size_type size() const noexcept
+    {
+        return N;
+    }
+
+    constexpr size_type word_count() const noexcept
+    {
+        return WORDS;
+    }
+
+    std::uint64_t *data() noexcept
+    {
+        return _words;
+    }
+
+    const std::uint64_t *data() const noexcept
+    {
+        return _words;
+    }
+
+    bool operator[](size_type pos) const
+    {
+        return (_words[pos / BITSET_WORD_BITS] & Bitset_words::bit_mask(pos)) != 0;
+    }
+
+    bool test(size_type pos) const
+    {
+        check_pos(pos, "bitset::test - position out of range");
+        return (*this)[pos];
+    }
+
+    self &set() noexcept
+    {
+        Bitset_words::fill(_words, N, true);
+        return *this;
+    }
+
+    self &set(size_type pos, bool value = true)
+    {
+        check_pos(pos, "bitset::set - position out of range");
+        if (value)
+        {
+            _words[pos / BITSET_WORD_BITS] |= Bitset_words::bit_mask(pos);
+        }
+        else
+        {
+            _words[pos / BITSET_WORD_BITS] &= ~Bitset_words::bit_mask(pos);
+        }
+        return *this;
+    }
+
+    self &reset() noexcept
+    {
+        Bitset_words::fill(_words, N, false);
+        return *this;
+    }
+
+    self &reset(size_type pos)
+    {
+        return set(pos, false);
+    }
+
+    self &flip() noexcept
+    {
+        Bitset_words::flip(_words, N);
+        return *this;
+    }
+
+    self &flip(size_type pos)
+    {
+        check_pos(pos, "bitset::flip - position out of range");
+        _words[pos / BITSET_WORD_BITS] ^= Bitset_words::bit_mask(pos);
+        return *this;
+    }
+
+    size_type count() const noexcept
+    {
+        return Bitset_words::count(_words, N);
+    }
+
+    bool any() const noexcept
+    {
+        return Bitset_words::any(_words, N);
+    }
+
+    bool none() const noexcept
+    {
+        return !any();
+    }
+
+    bool all() const noexcept
+    {
+        return Bitset_words::all(_words, N);
+    }
+
+    // [0, pos) 中置位的个数, pos 可以等于 size()
+    size_type rank(size_type pos) const
+    {
+        if (pos > N)
+        {
+            throw std::out_of_range("bitset::rank - position out of range");
+        }
+        return Bitset_words::rank(_words, pos);
+    }
+
+    // 第 k 个 (从 0 起) 置位的位置, 不存在时返回 npos
+    size_type select(size_type k) const noexcept
+    {
+        return Bitset_words::select(_words, N, k);
+    }
+
+    size_type find_first() const noexcept
+    {
+        return Bitset_words::find_from(_words, N, 0);
+    }
+
+    // pos 之后的第一个置位
+    size_type find_next(size_type pos) const noexcept
+    {
+        return pos + 1 >= N ? npos : Bitset_words::find_from(_words, N, pos + 1);
+    }
+
+    self &operator&=(const self &other) noexcept
+    {
+        simd::bit_and(_words, other._words, WORDS);
+        return *this;
+    }
+
+    self &operator|=(const self &other) noexcept
+    {
+        simd::bit_or(_words, other._words, WORDS);
+        return *this;
+    }
+
+    self &operator^=(const self &other) noexcept
+    {
+        simd::bit_xor(_words, other._words, WORDS);
+        return *this;
+    }
+
+    // 清除 other 中置位的位: *this &= ~other
+    self &and_not(const self &other) noexcept
+    {
+        simd::bit_andnot(_words, other._words, WORDS);
+        return *this;
+    }
+
+    self operator~() const noexcept
+    {
+        return self(*this).flip();
+    }
+
+    bool operator==(const self &other) const noexcept
+    {
+        return Bitset_words::equal(_words, other._words, N);
+    }
+
+    bool operator!=(const self &other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+  protected:
+    static void check_pos(size_type pos, const char *what)
+    {
+        if (pos >= N)
+        {
+            throw std::out_of_range(what);
+        }
+    }
+
+  protected:
+    std::uint64_t _words[WORDS > 0 ? WORDS : 1];
+};
+
+template <std::size_t N> inline bitset<N> operator&(const bitset<N> &lhs, const bitset<N> &rhs)
+{
+    return bitset<N>(lhs) &= rhs;
+}
+
+template <std::size_t N> inline bitset<N> operator|(const bitset<N> &lhs, const bitset<N> &rhs)
+{
+    return bitset<N>(lhs) |= rhs;
+}
+
+template <std::size_t N> inline bitset<N> operator^(const bitset<N> &lhs, const bitset<N> &rhs)
+{
+    return bitset<N>(lhs) ^= rhs;
+}
+
+template <typename Alloc = alloc> class dynamic_bitset
+{
+  public:
+    using size_type = std::size_t;
+    using self = dynamic_bitset<Alloc>;
+
+    static constexpr size_type npos = Bitset_words::npos;
+
+    dynamic_bitset() : _bits(0)
+    {
+    }
+
+    explicit dynamic_bitset(size_type bits, bool value = false)
+        : _words(Bitset_words::word_count(bits), value ? ~std::uint64_t(0) : std::uint64_t(0)),
+          _bits(bits)
+    {
+        Bitset_words::trim(_words.data(), _bits);
+    }
+
+    dynamic_bitset(const self &) = default;
+    self &operator=(const self &) = default;
+
+    // 字数组移走后源对象须同时清空位数, 成为空位图
+    dynamic_bitset(self &&other) noexcept : _words(std::move(other._words)), _bits(other._bits)
+    {
+        other._bits = 0;
+    }
+
+    self &operator=(self &&other) noexcept
+    {
+        if (this != &other)
+        {
+            self tmp(std::move(other));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    size_type size() const noexcept
+    {
+        return _bits;
+    }
+
+    bool empty() const noexcept
+    {
+        return _bits == 0;
+    }
+
+    size_type word_count() const noexcept
+    {
+        return _words.size();
+    }
+
+    std::uint64_t *data() noexcept
+    {
+        return _words.data();
+    }
+
+    const std::uint64_t *data() const noexcept
+    {
+        return _words.data();
+    }
+
+    // 新增的位取 value
+    void resize(size_type bits, bool value = false)
+    {
+        if (value && bits > _bits && _bits % BITSET_WORD_BITS != 0)
+        {
+            _words[_bits / BITSET_WORD_BITS] |= ~Bitset_words::tail_mask(_bits);
+        }
+        _words.resize(Bitset_words::word_count(bits),
+                      value ? ~std::uint64_t(0) : std::uint64_t(0));
+        _bits = bits;
+        Bitset_words::trim(_words.data(), _bits);
+    }
+
+    void reserve(size_type bits)
+    {
+        _words.reserve(Bitset_words::word_count(bits));
+    }
+
+    void push_back(bool value)
+    {
+        if (_bits % BITSET_WORD_BITS == 0)
+        {
+            _words.push_back(0);
+        }
+        if (value)
+        {
+            _words.back() |= Bitset_words::bit_mask(_bits);
+        }
+        ++_bits;
+    }
+
+    void clear() noexcept
+    {
+        _words.clear();
+        _bits = 0;
+    }
+
+    void swap(self &other) noexcept
+    {
+        _words.swap(other._words);
+        std::swap(_bits, other._bits);
+    }
+
+    bool operator[](size_type pos) const
+    {
+        return (_words[pos / BITSET_WORD_BITS] & Bitset_words::bit_mask(pos)) != 0;
+    }
+
+    bool test(size_type pos) const
+    {
+        check_pos(pos, "dynamic_bitset::test - position out of range");
+        return (*this)[pos];
+    }
+
+    self &set() noexcept
+    {
+        Bitset_words::fill(_words.data(), _bits, true);
+        return *this;
+    }
+
+    self &set(size_type pos, bool value = true)
+    {
+        check_pos(pos, "dynamic_bitset::set - position out of range");
+        if (value)
+        {
+            _words[pos / BITSET_WORD_BITS] |= Bitset_words::bit_mask(pos);
+        }
+        else
+        {
+            _words[pos / BITSET_WORD_BITS] &= ~Bitset_words::bit_mask(pos);
+        }
+        return *this;
+    }
+
+    self &reset() noexcept
+    {
+        Bitset_words::fill(_words.data(), _bits, false);
+        return *this;
+    }
+
+    self &reset(size_type pos)
+    {
+        return set(pos, false);
+    }
+
+    self &flip() noexcept
+    {
+        Bitset_words::flip(_words.data(), _bits);
+        return *this;
+    }
+
+    self &flip(size_type pos)
+    {
+        check_pos(pos, "dynamic_bitset::flip - position out of range");
+        _words[pos / BITSET_WORD_BITS] ^= Bitset_words::bit_mask(pos);
+        return *this;
+    }
+
+    size_type count() const noexcept
+    {
+        return Bitset_words::count(_words.data(), _bits);
+    }
+
+    bool any() const noexcept
+    {
+        return Bitset_words::any(_words.data(), _bits);
+    }
+
+    bool none() const noexcept
+    {
+        return !any();
+    }
+
+    bool all() const noexcept
+    {
+        return Bitset_words::all(_words.data(), _bits);
+    }
+
+    // [0, pos) 中置位的个数, pos 可以等于 size()
+    size_type rank(size_type pos) const
+    {
+        if (pos > _bits)
+        {
+            throw std::out_of_range("dynamic_bitset::rank - position out of range");
+        }
+        return Bitset_words::rank(_words.data(), pos);
+    }
+
+    // 第 k 个 (从 0 起) 置位的位置, 不存在时返回 npos
+    size_type select(size_type k) const noexcept
+    {
+        return Bitset_words::select(_words.data(), _bits, k);
+    }
+
+    size_type find_first() const noexcept
+    {
+        return Bitset_words::find_from(_words.data(), _bits, 0);
+    }
+
+    // pos 之后的第一个置位
+    size_type find_next(size_type pos) const noexcept
+    {
+        return pos + 1 >= _bits ? npos : Bitset_words::find_from(_words.data(), _bits, pos + 1);
+    }
+
+    // 以下按位运算要求两者长度相同, 否则抛出 std::invalid_argument
+
+    self &operator&=(const self &other)
+    {
+        check_size(other);
+        simd::bit_and(_words.data(), other._words.data(), _words.size());
+        return *this;
+    }
+
+    self &operator|=(const self &other)
+    {
+        check_size(other);
+        simd::bit_or(_words.data(), other._words.data(), _words.size());
+        return *this;
+    }
+
+    self &operator^=(const self &other)
+    {
+        check_size(other);
+        simd::bit_xor(_words.data(), other._words.data(), _words.size());
+        return *this;
+    }
+
+    // 清除 other 中置位的位: *this &= ~other
+    self &and_not(const self &other)
+    {
+        check_size(other);
+        simd::bit_andnot(_words.data(), other._words.data(), _words.size());
+        return *this;
+    }
+
+    self operator~() const
+    {
+        return self(*this).flip();
+    }
+
+    bool operator==(const self &other) const noexcept
+    {
+        return _bits == other._bits && Bitset_words::equal(data(), other.data(), _bits);
+    }
+
+    bool operator!=(const self &other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+  protected:
+    void check_pos(size_type pos, const char *what) const
+    {
+        if (pos >= _bits)
+        {
+            throw std::out_of_range(what);
+        }
+    }
+
+    void check_size(const self &other) const
+    {
+        if (_bits != other._bits)
+        {
+            throw std::invalid_argument("dynamic_bitset - size mismatch");
+        }
+    }
+
+  protected:
+    vector<std::uint64_t, Alloc> _words;
+    size_type _bits;
+};
+
+template <typename Alloc>
+inline dynamic_bitset<Alloc> operator&(const dynamic_bitset<Alloc> &lhs,
+                                       const dynamic_bitset<Alloc> &rhs)
+{
+    return dynamic_bitset<Alloc>(lhs) &= rhs;
+}
+
+template <typename Alloc>
+inline dynamic_bitset<Alloc> operator|(const dynamic_bitset<Alloc> &lhs,
+                                       const dynamic_bitset<Alloc> &rhs)
+{
+    return dynamic_bitset<Alloc>(lhs) |= rhs;
+}
+
+template <typename Alloc>
+inline dynamic_bitset<Alloc> operator^(const dynamic_bitset<Alloc> &lhs,
+                                       const dynamic_bitset<Alloc> &rhs)
+{
+    return dynamic_bitset<Alloc>(lhs) ^= rhs;
+}
+
+template <typename Alloc> inline void swap(dynamic_bitset<Alloc> &lhs, dynamic_bitset<Alloc> &rhs)
+{
+    lhs.swap(rhs);
+}
+
+} // namespace TS
+
+#endif
@@ -0,0 +1,544 @@
+#ifndef TS_CONCURRENT_HASH_MAP_HPP
+#define TS_CONCURRENT_HASH_MAP_HPP
+
+#include "ts_alloc.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace TS
+{
+// 锁分段数, 桶数始终是它的倍数
+const std::size_t CONCURRENT_MAP_STRIPES = 64;
+// 每次写操作在扩容期间顺带迁移的旧桶数
+const std::size_t CONCURRENT_MAP_MIGRATE_BATCH = 4;
+
+template <typename Key, typename T> struct Concurrent_map_node
+{
+    template <typename K, typename... Args>
+    Concurrent_map_node(std::size_t hash, K &&key, Args &&...args)
+        : _next(nullptr), _hash(hash), _key(std::forward<K>(key)),
+          _value(std::forward<Args>(args)...)
+    {
+    }
+
+    Concurrent_map_node *_next;
+    std::size_t _hash;
+    Key _key;
+    T _value;
+};
+
+// 多线程共享的哈希表: 链地址法, 节点来自 Alloc
+// 桶 i 由第 i % STRIPES 个互斥锁保护; 扩容时哈希值低位不变, 同一键在新旧两张表中属于同一分段
+// 每个分段保存自己看到的新旧表, 扩容时逐个分段加锁换表, 任一时刻至多持有一个分段锁;
+// 旧桶随后由写操作分批迁移, 迁移期间查找依次检查旧桶与新桶
+// 接口按值复制结果而不返回引用或迭代器, 因为锁释放后元素可能已被其他线程删除
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>, typename Alloc = alloc>
+class concurrent_hash_map
+{
+  public:
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+  protected:
+    using Node = Concurrent_map_node<Key, T>;
+    using node_allocator = simple_alloc<Node, Alloc>;
+    using bucket_allocator = simple_alloc<Node *, Alloc>;
+    using lock_type = std::lock_guard<std::mutex>;
+
+    static const size_type STRIPES = CONCURRENT_MAP_STRIPES;
+
+    // 每个分段独占缓存行, 计数与表指针只在持有锁时修改
+    // 临界区只有几次指针跳转, 读写锁的额外开销超过读者并行的收益, 因此读写都用普通互斥锁
+    // 桶数是分段数的倍数, 分段只访问两张表中下标属于自己的桶, 因此各分段可以先后换表
+    struct alignas(64) stripe
+    {
+        mutable std::mutex _mutex;
+        std::atomic<size_type> _count{0};
+        Node **_buckets = nullptr;
+        size_type _bucket_count = 0;
+        Node **_old_buckets = nullptr;
+        size_type _old_count = 0;
+    };
+
+  public:
+    explicit concurrent_hash_map(size_type bucket_count = STRIPES,
+                                 const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+        : _hash(hash), _equal(equal), _bucket_count_hint(round_up(bucket_count)),
+          _resizing(false), _migrate_next(0), _migrated(0)
+    {
+        size_type count = _bucket_count_hint.load(std::memory_order_relaxed);
+        Node **buckets = allocate_buckets(count);
+        for (stripe &st : _stripes)
+        {
+            st._buckets = buckets;
+            st._bucket_count = count;
+        }
+    }
+
+    concurrent_hash_map(const concurrent_hash_map &) = delete;
+    concurrent_hash_map &operator=(const concurrent_hash_map &) = delete;
+
+    // 析构时不能有其他线程访问
+    ~concurrent_hash_map()
+    {
+        for (size_type s = 0; s < STRIPES; ++s)
+        {
+            clear_stripe(s);
+        }
+        bucket_allocator::deallocate(_stripes[0]._old_buckets, _stripes[0]._old_count);
+        bucket_allocator::deallocate(_stripes[0]._buckets, _stripes[0]._bucket_count);
+    }
+
+    // 键已存在时不修改, 返回 false
+    bool insert(const Key &key, const T &val)
+    {
+        return emplace(key, val);
+    }
+
+    bool insert(Key &&key, T &&val)
+    {
+        return emplace(std::move(key), std::move(val));
+    }
+
+    template <typename K, typename... Args> bool emplace(K &&key, Args &&...args)
+    {
+        size_type h = hash_of(key);
+        bool inserted = false;
+        {
+            lock_type lock(stripe_of(h)._mutex);
+            if (find_node(h, key) == nullptr)
+            {
+                link_node(create_node(h, std::forward<K>(key), std::forward<Args>(args)...));
+                inserted = true;
+            }
+        }
+        after_write(h);
+        return inserted;
+    }
+
+    // 键已存在时赋值; 插入新元素返回 true
+    template <typename V> bool insert_or_assign(const Key &key, V &&val)
+    {
+        size_type h = hash_of(key);
+        bool inserted = false;
+        {
+            lock_type lock(stripe_of(h)._mutex);
+            Node *node = find_node(h, key);
+            if (node != nullptr)
+            {
+                node->_value = std::forward<V>(val);
+            }
+            else
+            {
+                link_node(create_node(h, key, std::forward<V>(val)));
+                inserted = true;
+            }
+        }
+        after_write(h);
+        return inserted;
+    }
+
+    // 找到时把值复制到 result
+    bool find(const Key &key, T &result) const
+    {
+        size_type h = hash_of(key);
+        lock_type lock(stripe_of(h)._mutex);
+        Node *node = find_node(h, key);
+        if (node == nullptr)
+        {
+            return false;
+        }
+        result = node->_value;
+        return true;
+    }
+
+    bool contains(const Key &key) const
+    {
+        size_type h = hash_of(key);
+        lock_type lock(stripe_of(h)._mutex);
+        return find_node(h, key) != nullptr;
+    }
+
+    // 持有锁时对值调用 func(T&), 用于原子的读-改-写; 键不存在返回 false
+    template <typename Func> bool update(const Key &key, Func func)
+    {
+        size_type h = hash_of(key);
+        lock_type lock(stripe_of(h)._mutex);
+        Node *node = find_node(h, key);
+        if (node == nullptr)
+        {
+            return false;
+        }
+        func(node->_value);
+        return true;
+    }
+
+    bool erase(const Key &key)
+    {
+        size_type h = hash_of(key);
+        Node *victim = nullptr;
+        {
+            lock_type lock(stripe_of(h)._mutex);
+            victim = unlink_node(h, key);
+        }
+        if (victim == nullptr)
+        {
+            return false;
+        }
+        destroy_node(victim);
+        after_write(h);
+        return true;
+    }
+
+    // 逐个分段加锁遍历, 不是整个表的快照; func 中不能访问本表
+    template <typename Func> void for_each(Func func) const
+    {
+        for (size_type s = 0; s < STRIPES; ++s)
+        {
+            const stripe &st = _stripes[s];
+            lock_type lock(st._mutex);
+            for_each_in_stripe(st._old_buckets, st._old_count, s, func);
+            for_each_in_stripe(st._buckets, st._bucket_count, s, func);
+        }
+    }
+
+    // 逐个分段清空
+    void clear()
+    {
+        for (size_type s = 0; s < STRIPES; ++s)
+        {
+            lock_type lock(_stripes[s]._mutex);
+            clear_stripe(s);
+        }
+    }
+
+    // 并发修改时结果仅供参考
+    size_type size() const noexcept
+    {
+        size_type count = 0;
+        for (const stripe &s : _stripes)
+        {
+            count += s._count.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    size_type bucket_count() const
+    {
+        lock_type lock(_stripes[0]._mutex);
+        return _stripes[0]._bucket_count;
+    }
+
+    // 是否有旧表尚未迁移完
+    bool resizing() const noexcept
+    {
+        return _resizing.load(std::memory_order_acquire);
+    }
+
+  protected:
+    static size_type round_up(size_type count) noexcept
+    {
+        size_type n = STRIPES;
+        while (n < count)
+        {
+            n <<= 1;
+        }
+        return n;
+    }
+
+    // std::hash 对整数通常是恒等映射, 先混合再取低位
+    size_type hash_of(const Key &key) const
+    {
+        std::uint64_t h = _hash(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return size_type(h);
+    }
+
+    stripe &stripe_of(size_type h) const noexcept
+    {
+        return _stripes[h & (STRIPES - 1)];
+    }
+
+    // 已迁移的旧桶指向该标记, 只比较地址
+    static Node *moved() noexcept
+    {
+        static char marker;
+        return reinterpret_cast<Node *>(&marker);
+    }
+
+    static Node **allocate_buckets(size_type count)
+    {
+        Node **buckets = bucket_allocator::allocate(count);
+        for (size_type i = 0; i < count; ++i)
+        {
+            buckets[i] = nullptr;
+        }
+        return buckets;
+    }
+
+    template <typename... Args> Node *create_node(Args &&...args)
+    {
+        Node *node = node_allocator::allocate();
+        try
+        {
+            construct(node, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            node_allocator::deallocate(node);
+            throw;
+        }
+        return node;
+    }
+
+    static void destroy_node(Node *node) noexcept
+    {
+        destroy(node);
+        node_allocator::deallocate(node);
+    }
+
+    // 以下函数须持有 h 所在分段的锁
+    Node *find_node(size_type h, const Key &key) const
+    {
+        const stripe &st = stripe_of(h);
+        if (st._old_buckets != nullptr)
+        {
+            Node *node = st._old_buckets[h & (st._old_count - 1)];
+            if (node != moved())
+            {
+                for (; node != nullptr; node = node->_next)
+                {
+                    if (node->_hash == h && _equal(node->_key, key))
+                    {
+                        return node;
+                    }
+                }
+            }
+        }
+        for (Node *node = st._buckets[h & (st._bucket_count - 1)]; node != nullptr;
+             node = node->_next)
+        {
+            if (node->_hash == h && _equal(node->_key, key))
+            {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    // 新节点总是进入新表
+    void link_node(Node *node) noexcept
+    {
+        stripe &st = stripe_of(node->_hash);
+        Node *&head = st._buckets[node->_hash & (st._bucket_count - 1)];
+        node->_next = head;
+        head = node;
+        st._count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Node *unlink_from(Node **link, size_type h, const Key &key)
+    {
+        for (; *link != nullptr; link = &(*link)->_next)
+        {
+            Node *node = *link;
+            if (node->_hash == h && _equal(node->_key, key))
+            {
+                *link = node->_next;
+                stripe_of(h)._count.fetch_sub(1, std::memory_order_relaxed);
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    Node *unlink_node(size_type h, const Key &key)
+    {
+        stripe &st = stripe_of(h);
+        if (st._old_buckets != nullptr)
+        {
+            Node **link = &st._old_buckets[h & (st._old_count - 1)];
+            if (*link != moved())
+            {
+                Node *node = unlink_from(link, h, key);
+                if (node != nullptr)
+                {
+                    return node;
+                }
+            }
+        }
+        return unlink_from(&st._buckets[h & (st._bucket_count - 1)], h, key);
+    }
+
+    template <typename Func>
+    static void for_each_in_stripe(Node **buckets, size_type count, size_type s, Func &func)
+    {
+        for (size_type i = s; buckets != nullptr && i < count; i += STRIPES)
+        {
+            if (buckets[i] == moved())
+            {
+                continue;
+            }
+            for (const Node *node = buckets[i]; node != nullptr; node = node->_next)
+            {
+                func(static_cast<const Key &>(node->_key), static_cast<const T &>(node->_value));
+            }
+        }
+    }
+
+    static void clear_stripe(Node **buckets, size_type count, size_type s) noexcept
+    {
+        for (size_type i = s; buckets != nullptr && i < count; i += STRIPES)
+        {
+            if (buckets[i] == moved())
+            {
+                continue;
+            }
+            Node *node = buckets[i];
+            while (node != nullptr)
+            {
+                Node *next = node->_next;
+                destroy_node(node);
+                node = next;
+            }
+            buckets[i] = nullptr;
+        }
+    }
+
+    // 须持有第 s 个分段的锁
+    void clear_stripe(size_type s) noexcept
+    {
+        stripe &st = _stripes[s];
+        clear_stripe(st._old_buckets, st._old_count, s);
+        clear_stripe(st._buckets, st._bucket_count, s);
+        st._count.store(0, std::memory_order_relaxed);
+    }
+
+    // 写操作结束 (已释放分段锁) 后: 扩容期间协助迁移, 否则按负载检查是否需要扩容
+    void after_write(size_type h)
+    {
+        if (_resizing.load(std::memory_order_acquire))
+        {
+            migrate_some();
+            return;
+        }
+        // 各分段的负载近似整体负载, 避免共享计数器
+        size_type per_stripe = _bucket_count_hint.load(std::memory_order_relaxed) / STRIPES;
+        if (stripe_of(h)._count.load(std::memory_order_relaxed) > per_stripe)
+        {
+            start_resize();
+        }
+    }
+
+    // 逐个分段加锁换表, 只交换指针; 未换表的分段继续使用旧表作为当前表, 两种状态都自洽
+    // 迁移计数在换表前设定, 领取编号在全部分段换表后才清零; 此前领到的编号若落在未换表的分段上
+    // 就被放弃, 清零后会重新发放
+    void start_resize()
+    {
+        std::unique_lock<std::mutex> guard(_resize_mutex, std::try_to_lock);
+        if (!guard.owns_lock() || _resizing.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        size_type old_count = _bucket_count_hint.load(std::memory_order_relaxed);
+        size_type new_count = old_count * 2;
+        Node **new_buckets = allocate_buckets(new_count);
+        _migrated.store(0, std::memory_order_relaxed);
+        _migrate_total.store(old_count, std::memory_order_relaxed);
+        for (stripe &st : _stripes)
+        {
+            lock_type lock(st._mutex);
+            st._old_buckets = st._buckets;
+            st._old_count = st._bucket_count;
+            st._buckets = new_buckets;
+            st._bucket_count = new_count;
+        }
+        _bucket_count_hint.store(new_count, std::memory_order_relaxed);
+        _migrate_next.store(0, std::memory_order_relaxed);
+        _resizing.store(true, std::memory_order_release);
+    }
+
+    // 领取若干旧桶迁移到新表; 完成最后一个桶的线程负责释放旧表
+    void migrate_some()
+    {
+        bool finished = false;
+        for (size_type k = 0; k < CONCURRENT_MAP_MIGRATE_BATCH && !finished; ++k)
+        {
+            size_type i = _migrate_next.fetch_add(1, std::memory_order_relaxed);
+            stripe &st = _stripes[i & (STRIPES - 1)];
+            lock_type lock(st._mutex);
+            // 领取的编号可能来自已结束或尚未完成换表的扩容, 以加锁后看到的旧表为准
+            if (st._old_buckets == nullptr || i >= st._old_count || st._old_buckets[i] == moved())
+            {
+                break;
+            }
+            Node *node = st._old_buckets[i];
+            while (node != nullptr)
+            {
+                Node *next = node->_next;
+                Node *&head = st._buckets[node->_hash & (st._bucket_count - 1)];
+                node->_next = head;
+                head = node;
+                node = next;
+            }
+            st._old_buckets[i] = moved();
+            size_type done = _migrated.fetch_add(1, std::memory_order_acq_rel) + 1;
+            finished = done == _migrate_total.load(std::memory_order_relaxed);
+        }
+        if (finished)
+        {
+            finish_resize();
+        }
+    }
+
+    // 旧桶已全部迁移, 查找仍会读到旧表中的迁移标记; 逐个分段摘下旧表后再释放
+    // 可能在 start_resize 换表期间被调用, 由 _resize_mutex 等待其完成
+    void finish_resize()
+    {
+        std::lock_guard<std::mutex> guard(_resize_mutex);
+        Node **old_buckets = nullptr;
+        for (stripe &st : _stripes)
+        {
+            lock_type lock(st._mutex);
+            old_buckets = st._old_buckets;
+            st._old_buckets = nullptr;
+            st._old_count = 0;
+        }
+        size_type old_count = _migrate_total.load(std::memory_order_relaxed);
+        _resizing.store(false, std::memory_order_release);
+        bucket_allocator::deallocate(old_buckets, old_count);
+    }
+
+  protected:
+    mutable stripe _stripes[STRIPES];
+    Hash _hash;
+    KeyEqual _equal;
+
+    // 供无锁路径判断负载的桶数副本, 以及正在迁移的旧表桶数; 只在持有 _resize_mutex 时修改
+    std::atomic<size_type> _bucket_count_hint;
+    std::atomic<size_type> _migrate_total{0};
+    std::atomic<bool> _resizing;
+    alignas(64) std::atomic<size_type> _migrate_next;
+    std::atomic<size_type> _migrated;
+    std::mutex _resize_mutex;
+};
+
+} // namespace TS
+
+#endif
@@ -1,24 +1,36 @@
 #ifndef TS_DEQUE_HPP
 #define TS_DEQUE_HPP
 
+#include "ts_algorithm.hpp"
 #include "ts_alloc.hpp"
 #include "ts_iterator.hpp"
+#include "ts_uninitialized.hpp"
 #include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
 namespace TS
 {
-inline std::size_t deque_buf_size(std::size_t size)
+const std::size_t DEQUE_INIT_MAP_SIZE = 8;
+const std::size_t DEQUE_BUF_BYTES = 4096;
+
+// 每个缓冲区容纳的元素个数, 元素大于 bytes 时每个缓冲区只放一个
+constexpr std::size_t deque_buf_size(std::size_t bytes, std::size_t size)
 {
-    return size < 512 ? 512 / size : 1;
+    return size < bytes ? bytes / size : 1;
 }
 
-template <typename T, typename Ref, typename Ptr>
-struct Deque_iterator : public _iterator<random_access_iterator_tag, T>
+template <typename T, typename Ref, typename Ptr, std::size_t BufBytes = DEQUE_BUF_BYTES>
+struct Deque_iterator : public _iterator<random_access_iterator_tag, T, std::ptrdiff_t, Ptr, Ref>
 {
   public:
-    using base_iterator = _iterator<random_access_iterator_tag, T>;
-    using iterator = Deque_iterator<T, T &, T *>;
-    using const_iterator = Deque_iterator<T, const T &, const T *>;
-    using self = Deque_iterator<T, Ref, Ptr>;
+    using base_iterator = _iterator<random_access_iterator_tag, T, std::ptrdiff_t, Ptr, Ref>;
+    using iterator = Deque_iterator<T, T &, T *, BufBytes>;
+    using const_iterator = Deque_iterator<T, const T &, const T *, BufBytes>;
+    using self = Deque_iterator<T, Ref, Ptr, BufBytes>;
     using size_type = std::size_t;
 
     using typename base_iterator::difference_type;
@@ -27,12 +39,12 @@ struct Deque_iterator : public _iterator<random_access_iterator_tag, T>
     using typename base_iterator::reference;
     using typename base_iterator::value_type;
 
-    using map_pointer = pointer *;
+    using map_pointer = T **;
 
   public:
-    static size_type buffer_size()
+    static constexpr size_type buffer_size()
     {
-        return deque_buf_size(sizeof(T));
+        return deque_buf_size(BufBytes, sizeof(T));
     }
 
     Deque_iterator() : _cur(nullptr), _first(nullptr), _last(nullptr), _mapp(nullptr)
@@ -49,6 +61,15 @@ struct Deque_iterator : public _iterator<random_access_iterator_tag, T>
     {
     }
 
+    self &operator=(const iterator &other)
+    {
+        _cur = other._cur;
+        _first = other._first;
+        _last = other._last;
+        _mapp = other._mapp;
+        return *this;
+    }
+
     reference operator*() const
     {
         return *_cur;
@@ -59,9 +80,10 @@ struct Deque_iterator : public _iterator<random_access_iterator_tag, T>
         return _cur;
     }
 
-    difference_type operator-(const self &other) const
+    template <typename OtherRef, typename OtherPtr>
+    difference_type operator-(const Deque_iterator<T, OtherRef, OtherPtr, BufBytes> &other) const
     {
-        return buffer_size() * (_mapp - other._mapp - 1) + (_cur - _first) +
+        return difference_type(buffer_size()) * (_mapp - other._mapp - 1) + (_cur - _first) +
                (other._last - other._cur);
     }
 
@@ -104,16 +126,17 @@ struct Deque_iterator : public _iterator<random_access_iterator_tag, T>
     self &operator+=(difference_type n)
     {
         difference_type offset = n + (_cur - _first);
-        if (offset >= 0 && offset < buffer_size())
+        difference_type buf_size = difference_type(buffer_size());
+        if (offset >= 0 && offset < buf_size)
         {
             _cur += n;
         }
         else
         {
             difference_type map_offset =
-                offset > 0 ? offset / buffer_size() : (offset + 1) / buffer_size() + 1;
+                offset > 0 ? offset / buf_size : -difference_type((-offset - 1) / buf_size) - 1;
             set_map(_mapp + map_offset);
-            _cur = _first + (offset - map_offset * buffer_size());
+            _cur = _first + (offset - map_offset * buf_size);
         }
         return *this;
     }
@@ -143,16 +166,42 @@ struct Deque_iterator : public _iterator<random_access_iterator_tag, T>
         return *(*this + __n);
     }
 
-    bool operator==(const self &other) const
+    template <typename OtherRef, typename OtherPtr>
+    bool operator==(const Deque_iterator<T, OtherRef, OtherPtr, BufBytes> &other) const
     {
         return _cur == other._cur;
     }
 
-    bool operator<(const self &other) const
+    template <typename OtherRef, typename OtherPtr>
+    bool operator!=(const Deque_iterator<T, OtherRef, OtherPtr, BufBytes> &other) const
+    {
+        return _cur != other._cur;
+    }
+
+    template <typename OtherRef, typename OtherPtr>
+    bool operator<(const Deque_iterator<T, OtherRef, OtherPtr, BufBytes> &other) const
     {
         return (_mapp == other._mapp) ? (_cur < other._cur) : (_mapp < other._mapp);
     }
 
+    template <typename OtherRef, typename OtherPtr>
+    bool operator>(const Deque_iterator<T, OtherRef, OtherPtr, BufBytes> &other) const
+    {
+        return other < *this;
+    }
+
+    template <typename OtherRef, typename OtherPtr>
+    bool operator<=(const Deque_iterator<T, OtherRef, OtherPtr, BufBytes> &other) const
+    {
+        return !(other < *this);
+    }
+
+    template <typename OtherRef, typename OtherPtr>
+    bool operator>=(const Deque_iterator<T, OtherRef, OtherPtr, BufBytes> &other) const
+    {
+        return !(*this < other);
+    }
+
     void set_map(map_pointer new_map)
     {
         _mapp = new_map;
@@ -161,37 +210,726 @@ struct Deque_iterator : public _iterator<random_access_iterator_tag, T>
     }
 
   public:
-    pointer _cur;
-    pointer _first;
-    pointer _last;
+    T *_cur;
+    T *_first;
+    T *_last;
     map_pointer _mapp;
 };
 
-template <typename T, typename Alloc = alloc> class deque
+// 每个缓冲区为一段连续存储
+template <typename T, typename Ref, typename Ptr, std::size_t BufBytes>
+struct segmented_iterator_traits<Deque_iterator<T, Ref, Ptr, BufBytes>>
+{
+    using is_segmented_iterator = std::true_type;
+    using iterator = Deque_iterator<T, Ref, Ptr, BufBytes>;
+    using segment_iterator = typename iterator::map_pointer;
+    using local_iterator = Ptr;
+
+    static segment_iterator segment(const iterator &it)
+    {
+        return it._mapp;
+    }
+
+    static local_iterator local(const iterator &it)
+    {
+        return it._cur;
+    }
+
+    static local_iterator begin(segment_iterator seg)
+    {
+        return *seg;
+    }
+
+    static local_iterator end(segment_iterator seg)
+    {
+        return *seg + iterator::buffer_size();
+    }
+
+    // 落在段尾时转到下一段段首, 保持 _cur != _last
+    static iterator compose(segment_iterator seg, local_iterator cur)
+    {
+        if (cur == end(seg))
+        {
+            ++seg;
+            cur = *seg;
+        }
+        return iterator(const_cast<T *>(cur), seg);
+    }
+};
+
+template <typename T, typename Alloc = alloc, std::size_t BufBytes = DEQUE_BUF_BYTES>
+class deque;
+
+template <typename T, typename Alloc, std::size_t BufBytes>
+bool operator==(const deque<T, Alloc, BufBytes> &lhs, const deque<T, Alloc, BufBytes> &rhs);
+
+template <typename T, typename Alloc, std::size_t BufBytes> class deque
 {
   public:
     using value_type = T;
     using size_type = std::size_t;
-    using difference = std::ptrdiff_t;
+    using difference_type = std::ptrdiff_t;
     using reference = value_type &;
     using const_reference = const value_type &;
     using pointer = value_type *;
     using const_pointer = const value_type *;
-    using iterator = Deque_iterator<T, T &, T *>;
-    using const_iterator = Deque_iterator<T, const T &, const T *>;
+    using iterator = Deque_iterator<T, T &, T *, BufBytes>;
+    using const_iterator = Deque_iterator<T, const T &, const T *, BufBytes>;
 
   protected:
     using data_allocator = simple_alloc<T, Alloc>;
     using map_allocator = simple_alloc<T *, Alloc>;
-    using typename iterator::map_pointer;
+    using map_pointer = typename iterator::map_pointer;
+    using self = deque<T, Alloc, BufBytes>;
+
+  public:
+    ~deque()
+    {
+        if (_map)
+        {
+            destroy_range(_start, _finish);
+            destroy_map_and_nodes();
+        }
+    }
+
+    deque() : _map(nullptr), _map_size(0)
+    {
+        create_map_and_nodes(0);
+    }
+
+    deque(size_type count) : deque(count, T())
+    {
+    }
+
+    deque(size_type count, const T &val) : _map(nullptr), _map_size(0)
+    {
+        create_map_and_nodes(count);
+        fill_initialize(val);
+    }
+
+    deque(const self &other) : _map(nullptr), _map_size(0)
+    {
+        create_map_and_nodes(other.size());
+        copy_initialize(other.begin(), other.end());
+    }
+
+    // 源对象须保留一个可用的空 map, 因此移动构造会分配, 不标记 noexcept
+    deque(self &&other) : deque()
+    {
+        swap(other);
+    }
+
+    deque(std::initializer_list<T> init) : _map(nullptr), _map_size(0)
+    {
+        create_map_and_nodes(init.size());
+        copy_initialize(init.begin(), init.end());
+    }
+
+    deque &operator=(const self &other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+        size_type count = size();
+        if (count >= other.size())
+        {
+            erase(TS::copy(other.begin(), other.end(), _start), _finish);
+        }
+        else
+        {
+            const_iterator mid = other.begin() + difference_type(count);
+            TS::copy(other.begin(), mid, _start);
+            for (; mid != other.end(); ++mid)
+            {
+                push_back(*mid);
+            }
+        }
+        return *this;
+    }
+
+    deque &operator=(self &&other) noexcept
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+        swap(other);
+        return *this;
+    }
+
+    void assign(size_type count, const T &val)
+    {
+        if (count > size())
+        {
+            TS::fill(_start, _finish, val);
+            for (size_type i = size(); i < count; ++i)
+            {
+                push_back(val);
+            }
+        }
+        else
+        {
+            erase(_start + difference_type(count), _finish);
+            TS::fill(_start, _finish, val);
+        }
+    }
+
+    // element access
+
+    reference at(size_type pos)
+    {
+        return const_cast<reference>(static_cast<const self *>(this)->at(pos));
+    }
+
+    const_reference at(size_type pos) const
+    {
+        if (pos >= size())
+        {
+            throw std::out_of_range("deque::at - index out of range");
+        }
+        return operator[](pos);
+    }
+
+    reference operator[](size_type pos)
+    {
+        return const_cast<reference>(static_cast<const self *>(this)->operator[](pos));
+    }
+
+    const_reference operator[](size_type pos) const
+    {
+        return _start[difference_type(pos)];
+    }
+
+    reference front()
+    {
+        return const_cast<reference>(static_cast<const self *>(this)->front());
+    }
+
+    const_reference front() const
+    {
+        if (empty())
+        {
+            throw std::logic_error("empty deque");
+        }
+        return *_start;
+    }
+
+    reference back()
+    {
+        return const_cast<reference>(static_cast<const self *>(this)->back());
+    }
+
+    const_reference back() const
+    {
+        if (empty())
+        {
+            throw std::logic_error("empty deque");
+        }
+        return *(_finish - 1);
+    }
+
+    // iterators
+
+    iterator begin()
+    {
+        return _start;
+    }
+
+    const_iterator begin() const
+    {
+        return _start;
+    }
+
+    const_iterator cbegin() const
+    {
+        return _start;
+    }
+
+    iterator end()
+    {
+        return _finish;
+    }
+
+    const_iterator end() const
+    {
+        return _finish;
+    }
+
+    const_iterator cend() const
+    {
+        return _finish;
+    }
+
+    // capacity
+
+    bool empty() const
+    {
+        return _start == _finish;
+    }
+
+    size_type size() const
+    {
+        return _finish - _start;
+    }
+
+    constexpr size_type max_size() const
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(T);
+    }
+
+    // modifier
+
+    void clear()
+    {
+        for (map_pointer node = _start._mapp + 1; node < _finish._mapp; ++node)
+        {
+            destroy_range(*node, *node + buffer_size());
+            data_allocator::deallocate(*node, buffer_size());
+        }
+        if (_start._mapp != _finish._mapp)
+        {
+            destroy_range(_start._cur, _start._last);
+            destroy_range(_finish._first, _finish._cur);
+            data_allocator::deallocate(_finish._first, buffer_size());
+        }
+        else
+        {
+            destroy_range(_start._cur, _finish._cur);
+        }
+        _finish = _start;
+    }
+
+    void push_back(const T &val)
+    {
+        emplace_back(val);
+    }
+
+    void push_back(T &&val)
+    {
+        emplace_back(std::move(val));
+    }
+
+    template <typename... Args> void emplace_back(Args &&...args)
+    {
+        if (_finish._cur != _finish._last - 1)
+        {
+            construct(_finish._cur, std::forward<Args>(args)...);
+            ++_finish._cur;
+        }
+        else
+        {
+            reserve_map_at_back();
+            *(_finish._mapp + 1) = data_allocator::allocate(buffer_size());
+            try
+            {
+                construct(_finish._cur, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                data_allocator::deallocate(*(_finish._mapp + 1), buffer_size());
+                throw;
+            }
+            _finish.set_map(_finish._mapp + 1);
+            _finish._cur = _finish._first;
+        }
+    }
+
+    void push_front(const T &val)
+    {
+        emplace_front(val);
+    }
+
+    void push_front(T &&val)
+    {
+        emplace_front(std::move(val));
+    }
+
+    template <typename... Args> void emplace_front(Args &&...args)
+    {
+        if (_start._cur != _start._first)
+        {
+            construct(_start._cur - 1, std::forward<Args>(args)...);
+            --_start._cur;
+        }
+        else
+        {
+            reserve_map_at_front();
+            *(_start._mapp - 1) = data_allocator::allocate(buffer_size());
+            try
+            {
+                construct(*(_start._mapp - 1) + buffer_size() - 1, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                data_allocator::deallocate(*(_start._mapp - 1), buffer_size());
+                throw;
+            }
+            _start.set_map(_start._mapp - 1);
+            _start._cur = _start._last - 1;
+        }
+    }
+
+    void pop_back()
+    {
+        if (empty())
+        {
+            throw std::logic_error("empty deque");
+        }
+        if (_finish._cur != _finish._first)
+        {
+            --_finish._cur;
+            destroy(_finish._cur);
+        }
+        else
+        {
+            data_allocator::deallocate(_finish._first, buffer_size());
+            _finish.set_map(_finish._mapp - 1);
+            _finish._cur = _finish._last - 1;
+            destroy(_finish._cur);
+        }
+    }
+
+    void pop_front()
+    {
+        if (empty())
+        {
+            throw std::logic_error("empty deque");
+        }
+        if (_start._cur != _start._last - 1)
+        {
+            destroy(_start._cur);
+            ++_start._cur;
+        }
+        else
+        {
+            destroy(_start._cur);
+            data_allocator::deallocate(_start._first, buffer_size());
+            _start.set_map(_start._mapp + 1);
+            _start._cur = _start._first;
+        }
+    }
+
+    iterator insert(const_iterator pos, const T &val)
+    {
+        return emplace(pos, val);
+    }
+
+    iterator insert(const_iterator pos, T &&val)
+    {
+        return emplace(pos, std::move(val));
+    }
+
+    template <typename... Args> iterator emplace(const_iterator pos, Args &&...args)
+    {
+        if (pos < _start || _finish < pos)
+        {
+            throw std::range_error("out of range");
+        }
+        difference_type index = pos - _start;
+        if (pos == _start)
+        {
+            emplace_front(std::forward<Args>(args)...);
+            return _start;
+        }
+        if (pos == _finish)
+        {
+            emplace_back(std::forward<Args>(args)...);
+            return _finish - 1;
+        }
+
+        T tmp(std::forward<Args>(args)...);
+        if (size_type(index) < size() / 2)
+        {
+            push_front(std::move(front()));
+            iterator cur = _start + 1;
+            iterator last = _start + (index + 1);
+            for (; cur + 1 != last; ++cur)
+            {
+                *cur = std::move(*(cur + 1));
+            }
+            *cur = std::move(tmp);
+            return cur;
+        }
+        push_back(std::move(back()));
+        iterator target = _start + index;
+        iterator cur = _finish - 2;
+        for (; cur != target; --cur)
+        {
+            *cur = std::move(*(cur - 1));
+        }
+        *target = std::move(tmp);
+        return target;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        if (first == last)
+        {
+            return to_iterator(last);
+        }
+        if (last < first || first < _start || _finish < last)
+        {
+            throw std::range_error("out of range");
+        }
+        if (first == _start && last == _finish)
+        {
+            clear();
+            return _finish;
+        }
+
+        difference_type count = last - first;
+        difference_type elems_before = first - _start;
+        if (size_type(elems_before) < (size() - count) / 2)
+        {
+            // 前段较短: 后移前段, 释放前端缓冲区
+            TS::copy_backward(_start, to_iterator(first), to_iterator(last));
+            iterator new_start = _start + count;
+            destroy_range(_start, new_start);
+            for (map_pointer node = _start._mapp; node < new_start._mapp; ++node)
+            {
+                data_allocator::deallocate(*node, buffer_size());
+            }
+            _start = new_start;
+        }
+        else
+        {
+            // 后段较短: 用 copy 前移后段, 释放尾端缓冲区
+            TS::copy(to_iterator(last), _finish, to_iterator(first));
+            iterator new_finish = _finish - count;
+            destroy_range(new_finish, _finish);
+            for (map_pointer node = new_finish._mapp + 1; node <= _finish._mapp; ++node)
+            {
+                data_allocator::deallocate(*node, buffer_size());
+            }
+            _finish = new_finish;
+        }
+        return _start + elems_before;
+    }
+
+    void resize(size_type count)
+    {
+        resize(count, T());
+    }
+
+    void resize(size_type count, const value_type &val)
+    {
+        size_type old_size = size();
+        if (count < old_size)
+        {
+            erase(_start + difference_type(count), _finish);
+        }
+        else
+        {
+            for (; old_size < count; ++old_size)
+            {
+                push_back(val);
+            }
+        }
+    }
+
+    void swap(self &other) noexcept
+    {
+        std::swap(_map, other._map);
+        std::swap(_map_size, other._map_size);
+        std::swap(_start, other._start);
+        std::swap(_finish, other._finish);
+    }
+
+  protected:
+    static constexpr size_type buffer_size()
+    {
+        return iterator::buffer_size();
+    }
+
+    static iterator to_iterator(const_iterator cit)
+    {
+        return iterator(const_cast<T *>(cit._cur), cit._mapp);
+    }
+
+    void create_map_and_nodes(size_type count)
+    {
+        size_type num_nodes = count / buffer_size() + 1;
+        _map_size = num_nodes + 2 > DEQUE_INIT_MAP_SIZE ? num_nodes + 2 : DEQUE_INIT_MAP_SIZE;
+        _map = map_allocator::allocate(_map_size);
+
+        map_pointer nstart = _map + (_map_size - num_nodes) / 2;
+        map_pointer nfinish = nstart + num_nodes - 1;
+        map_pointer cur = nstart;
+        try
+        {
+            for (; cur <= nfinish; ++cur)
+            {
+                *cur = data_allocator::allocate(buffer_size());
+            }
+        }
+        catch (...)
+        {
+            for (map_pointer node = nstart; node < cur; ++node)
+            {
+                data_allocator::deallocate(*node, buffer_size());
+            }
+            map_allocator::deallocate(_map, _map_size);
+            _map = nullptr;
+            _map_size = 0;
+            throw;
+        }
+
+        _start.set_map(nstart);
+        _finish.set_map(nfinish);
+        _start._cur = _start._first;
+        _finish._cur = _finish._first + count % buffer_size();
+    }
+
+    void destroy_map_and_nodes()
+    {
+        for (map_pointer node = _start._mapp; node <= _finish._mapp; ++node)
+        {
+            data_allocator::deallocate(*node, buffer_size());
+        }
+        map_allocator::deallocate(_map, _map_size);
+    }
+
+    // 节点内存尚未构造, 逐段在原始指针区间上构造; 失败时析构已构造的元素并释放节点
+    void fill_initialize(const T &val)
+    {
+        map_pointer cur = _start._mapp;
+        try
+        {
+            for (; cur < _finish._mapp; ++cur)
+            {
+                uninitialized_fill(*cur, *cur + buffer_size(), val);
+            }
+            uninitialized_fill(_finish._first, _finish._cur, val);
+        }
+        catch (...)
+        {
+            destroy_range(_start, iterator(*cur, cur));
+            destroy_map_and_nodes();
+            _map = nullptr;
+            throw;
+        }
+    }
+
+    template <typename RandomIter> void copy_initialize(RandomIter first, RandomIter last)
+    {
+        map_pointer cur = _start._mapp;
+        try
+        {
+            for (; cur < _finish._mapp; ++cur)
+            {
+                RandomIter mid = first + difference_type(buffer_size());
+                uninitialized_copy(first, mid, *cur);
+                first = mid;
+            }
+            uninitialized_copy(first, last, _finish._first);
+        }
+        catch (...)
+        {
+            destroy_range(_start, iterator(*cur, cur));
+            destroy_map_and_nodes();
+            _map = nullptr;
+            throw;
+        }
+    }
+
+    void destroy_range(T *first, T *last)
+    {
+        destroy_range(first, last, std::is_trivially_destructible<T>());
+    }
+
+    void destroy_range(T *, T *, std::true_type)
+    {
+    }
+
+    void destroy_range(T *first, T *last, std::false_type)
+    {
+        for (; first != last; ++first)
+        {
+            destroy(first);
+        }
+    }
+
+    void destroy_range(iterator first, iterator last)
+    {
+        if (first._mapp == last._mapp)
+        {
+            destroy_range(first._cur, last._cur);
+            return;
+        }
+        destroy_range(first._cur, first._last);
+        for (map_pointer node = first._mapp + 1; node < last._mapp; ++node)
+        {
+            destroy_range(*node, *node + buffer_size());
+        }
+        destroy_range(last._first, last._cur);
+    }
+
+    void reserve_map_at_back(size_type nodes_to_add = 1)
+    {
+        if (nodes_to_add + 1 > _map_size - (_finish._mapp - _map))
+        {
+            reallocate_map(nodes_to_add, false);
+        }
+    }
+
+    void reserve_map_at_front(size_type nodes_to_add = 1)
+    {
+        if (nodes_to_add > size_type(_start._mapp - _map))
+        {
+            reallocate_map(nodes_to_add, true);
+        }
+    }
+
+    void reallocate_map(size_type nodes_to_add, bool add_at_front)
+    {
+        size_type old_num_nodes = _finish._mapp - _start._mapp + 1;
+        size_type new_num_nodes = old_num_nodes + nodes_to_add;
+
+        map_pointer new_nstart;
+        if (_map_size > 2 * new_num_nodes)
+        {
+            // 空间足够, 仅将节点指针居中
+            new_nstart = _map + (_map_size - new_num_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+            std::memmove(new_nstart, _start._mapp, old_num_nodes * sizeof(T *));
+        }
+        else
+        {
+            size_type new_map_size =
+                _map_size + (_map_size > nodes_to_add ? _map_size : nodes_to_add) + 2;
+            map_pointer new_map = map_allocator::allocate(new_map_size);
+            new_nstart =
+                new_map + (new_map_size - new_num_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+            std::memcpy(new_nstart, _start._mapp, old_num_nodes * sizeof(T *));
+            map_allocator::deallocate(_map, _map_size);
+            _map = new_map;
+            _map_size = new_map_size;
+        }
+
+        _start.set_map(new_nstart);
+        _finish.set_map(new_nstart + old_num_nodes - 1);
+    }
+
+    friend bool operator== <T, Alloc, BufBytes>(const self &lhs, const self &rhs);
 
   protected:
     map_pointer _map;
+    size_type _map_size;
     iterator _start;
     iterator _finish;
-    size_type _size;
 };
 
+template <typename T, typename Alloc, std::size_t BufBytes>
+bool operator==(const deque<T, Alloc, BufBytes> &lhs, const deque<T, Alloc, BufBytes> &rhs)
+{
+    return lhs.size() == rhs.size() && TS::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
 } // namespace TS
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,549 @@
+#ifndef TS_FORWARD_LIST_HPP
+#define TS_FORWARD_LIST_HPP
+
+#include "ts_algorithm.hpp"
+#include "ts_alloc.hpp"
+#include "ts_iterator.hpp"
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace TS
+{
+// 只有后继链接, 用作 before_begin 哨兵
+struct Slist_link
+{
+    Slist_link *_next;
+};
+
+// 比 List_node 少一个指针; 由 simple_alloc 从内存池分配, 只构造 _data
+template <typename T> struct Slist_node : public Slist_link
+{
+    T _data;
+};
+
+template <typename T, typename Ref, typename Ptr>
+struct Slist_iterator : public _iterator<forward_iterator_tag, T, std::ptrdiff_t, Ptr, Ref>
+{
+  public:
+    using base_iterator = _iterator<forward_iterator_tag, T, std::ptrdiff_t, Ptr, Ref>;
+    using iterator = Slist_iterator<T, T &, T *>;
+    using const_iterator = Slist_iterator<T, const T &, const T *>;
+    using self = Slist_iterator<T, Ref, Ptr>;
+
+    using typename base_iterator::difference_type;
+    using typename base_iterator::iterator_category;
+    using typename base_iterator::pointer;
+    using typename base_iterator::reference;
+    using typename base_iterator::value_type;
+
+    using Node = Slist_node<T>;
+
+  public:
+    Slist_iterator() noexcept : _node(nullptr)
+    {
+    }
+
+    Slist_iterator(Slist_link *node) : _node(node)
+    {
+    }
+
+    Slist_iterator(const iterator &other) : _node(other._node)
+    {
+    }
+
+    self &operator=(const iterator &other)
+    {
+        _node = other._node;
+        return *this;
+    }
+
+    reference operator*() const
+    {
+        return static_cast<Node *>(_node)->_data;
+    }
+
+    pointer operator->() const
+    {
+        return &(operator*());
+    }
+
+    self &operator++()
+    {
+        _node = _node->_next;
+        return *this;
+    }
+
+    self operator++(int)
+    {
+        self tmp = *this;
+        _node = _node->_next;
+        return tmp;
+    }
+
+    template <typename OtherRef, typename OtherPtr>
+    bool operator==(const Slist_iterator<T, OtherRef, OtherPtr> &other) const
+    {
+        return _node == other._node;
+    }
+
+    template <typename OtherRef, typename OtherPtr>
+    bool operator!=(const Slist_iterator<T, OtherRef, OtherPtr> &other) const
+    {
+        return _node != other._node;
+    }
+
+  public:
+    Slist_link *_node;
+};
+
+// 单向链表: 末尾节点的 _next 为 nullptr, end() 即空迭代器; 不保存长度
+template <typename T, typename Alloc = alloc> class forward_list
+{
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using iterator = Slist_iterator<T, T &, T *>;
+    using const_iterator = Slist_iterator<T, const T &, const T *>;
+    using Node = Slist_node<T>;
+
+  protected:
+    using node_allocator = simple_alloc<Node, Alloc>;
+    using self = forward_list<T, Alloc>;
+
+  public:
+    ~forward_list()
+    {
+        clear();
+    }
+
+    forward_list() noexcept
+    {
+        _head._next = nullptr;
+    }
+
+    explicit forward_list(size_type count) : forward_list()
+    {
+        insert_after(before_begin(), count, T());
+    }
+
+    forward_list(size_type count, const T &val) : forward_list()
+    {
+        insert_after(before_begin(), count, val);
+    }
+
+    template <typename InputIter, typename = enable_if_not_integral<InputIter>>
+    forward_list(InputIter first, InputIter last) : forward_list()
+    {
+        insert_after(before_begin(), first, last);
+    }
+
+    forward_list(std::initializer_list<T> init) : forward_list(init.begin(), init.end())
+    {
+    }
+
+    forward_list(const self &other) : forward_list(other.begin(), other.end())
+    {
+    }
+
+    forward_list(self &&other) noexcept
+    {
+        _head._next = other._head._next;
+        other._head._next = nullptr;
+    }
+
+    self &operator=(const self &other)
+    {
+        if (this != &other)
+        {
+            self tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    self &operator=(self &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            _head._next = other._head._next;
+            other._head._next = nullptr;
+        }
+        return *this;
+    }
+
+    self &operator=(std::initializer_list<T> init)
+    {
+        self tmp(init);
+        swap(tmp);
+        return *this;
+    }
+
+    template <typename InputIter, typename = enable_if_not_integral<InputIter>>
+    void assign(InputIter first, InputIter last)
+    {
+        self tmp(first, last);
+        swap(tmp);
+    }
+
+    void assign(std::initializer_list<T> init)
+    {
+        assign(init.begin(), init.end());
+    }
+
+    reference front()
+    {
+        return const_cast<reference>(static_cast<const self *>(this)->front());
+    }
+
+    const_reference front() const
+    {
+        if (empty())
+        {
+            throw std::range_error("empty forward_list");
+        }
+        return static_cast<Node *>(_head._next)->_data;
+    }
+
+    // 首元素之前的位置, 供 insert_after/erase_after 在表头操作
+    iterator before_begin() noexcept
+    {
+        return iterator(&_head);
+    }
+
+    const_iterator before_begin() const noexcept
+    {
+        return const_iterator(const_cast<Slist_link *>(&_head));
+    }
+
+    const_iterator cbefore_begin() const noexcept
+    {
+        return before_begin();
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator(_head._next);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(_head._next);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(nullptr);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(nullptr);
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    bool empty() const noexcept
+    {
+        return _head._next == nullptr;
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(Node);
+    }
+
+    void clear() noexcept
+    {
+        free_chain(_head._next);
+        _head._next = nullptr;
+    }
+
+    template <typename... Args> iterator emplace_after(const_iterator pos, Args &&...args)
+    {
+        Node *node = create_node(std::forward<Args>(args)...);
+        node->_next = pos._node->_next;
+        pos._node->_next = node;
+        return iterator(node);
+    }
+
+    iterator insert_after(const_iterator pos, const T &val)
+    {
+        return emplace_after(pos, val);
+    }
+
+    iterator insert_after(const_iterator pos, T &&val)
+    {
+        return emplace_after(pos, std::move(val));
+    }
+
+    // 批量插入: 先在表外串好整条链, 全部构造成功后一次接入; 返回最后插入的元素
+    template <typename InputIter, typename = enable_if_not_integral<InputIter>>
+    iterator insert_after(const_iterator pos, InputIter first, InputIter last)
+    {
+        Slist_link chain{nullptr};
+        Slist_link *tail = &chain;
+        try
+        {
+            for (; first != last; ++first)
+            {
+                tail->_next = create_node(*first);
+                tail = tail->_next;
+            }
+        }
+        catch (...)
+        {
+            tail->_next = nullptr;
+            free_chain(chain._next);
+            throw;
+        }
+        return link_chain(pos, chain._next, tail);
+    }
+
+    iterator insert_after(const_iterator pos, size_type count, const T &val)
+    {
+        Slist_link chain{nullptr};
+        Slist_link *tail = &chain;
+        try
+        {
+            for (; count > 0; --count)
+            {
+                tail->_next = create_node(val);
+                tail = tail->_next;
+            }
+        }
+        catch (...)
+        {
+            tail->_next = nullptr;
+            free_chain(chain._next);
+            throw;
+        }
+        return link_chain(pos, chain._next, tail);
+    }
+
+    iterator insert_after(const_iterator pos, std::initializer_list<T> init)
+    {
+        return insert_after(pos, init.begin(), init.end());
+    }
+
+    // 删除 pos 之后的元素, 返回其后继
+    iterator erase_after(const_iterator pos)
+    {
+        Slist_link *node = pos._node->_next;
+        pos._node->_next = node->_next;
+        destroy_node(static_cast<Node *>(node));
+        return iterator(pos._node->_next);
+    }
+
+    // 删除 (first, last) 之间的元素
+    iterator erase_after(const_iterator first, const_iterator last)
+    {
+        Slist_link *node = first._node->_next;
+        first._node->_next = last._node;
+        while (node != last._node)
+        {
+            Slist_link *next = node->_next;
+            destroy_node(static_cast<Node *>(node));
+            node = next;
+        }
+        return iterator(last._node);
+    }
+
+    void push_front(const T &val)
+    {
+        emplace_after(before_begin(), val);
+    }
+
+    void push_front(T &&val)
+    {
+        emplace_after(before_begin(), std::move(val));
+    }
+
+    template <typename... Args> reference emplace_front(Args &&...args)
+    {
+        return *emplace_after(before_begin(), std::forward<Args>(args)...);
+    }
+
+    void pop_front()
+    {
+        if (empty())
+        {
+            throw std::range_error("empty forward_list");
+        }
+        erase_after(before_begin());
+    }
+
+    // 把 other 的全部元素移到 pos 之后, 需要找到 other 的末尾
+    void splice_after(const_iterator pos, self &other) noexcept
+    {
+        if (this == &other || other.empty())
+        {
+            return;
+        }
+        Slist_link *first = other._head._next;
+        Slist_link *last = first;
+        while (last->_next != nullptr)
+        {
+            last = last->_next;
+        }
+        other._head._next = nullptr;
+        link_chain(pos, first, last);
+    }
+
+    void splice_after(const_iterator pos, self &&other) noexcept
+    {
+        splice_after(pos, other);
+    }
+
+    // 把 it 之后的一个元素移到 pos 之后
+    void splice_after(const_iterator pos, self &, const_iterator it) noexcept
+    {
+        Slist_link *node = it._node->_next;
+        if (pos == it || pos._node == node)
+        {
+            return;
+        }
+        it._node->_next = node->_next;
+        link_chain(pos, node, node);
+    }
+
+    // 把 (first, last) 之间的元素移到 pos 之后, pos 不能在该区间内
+    void splice_after(const_iterator pos, self &, const_iterator first,
+                      const_iterator last) noexcept
+    {
+        if (first == last || first._node->_next == last._node)
+        {
+            return;
+        }
+        Slist_link *head = first._node->_next;
+        Slist_link *tail = head;
+        while (tail->_next != last._node)
+        {
+            tail = tail->_next;
+        }
+        first._node->_next = last._node;
+        link_chain(pos, head, tail);
+    }
+
+    void reverse() noexcept
+    {
+        Slist_link *result = nullptr;
+        Slist_link *node = _head._next;
+        while (node != nullptr)
+        {
+            Slist_link *next = node->_next;
+            node->_next = result;
+            result = node;
+            node = next;
+        }
+        _head._next = result;
+    }
+
+    void swap(self &other) noexcept
+    {
+        Slist_link *tmp = _head._next;
+        _head._next = other._head._next;
+        other._head._next = tmp;
+    }
+
+  protected:
+    template <typename... Args> Node *create_node(Args &&...args)
+    {
+        Node *node = node_allocator::allocate();
+        try
+        {
+            construct(&node->_data, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            node_allocator::deallocate(node);
+            throw;
+        }
+        node->_next = nullptr;
+        return node;
+    }
+
+    static void destroy_node(Node *node) noexcept
+    {
+        destroy(&node->_data);
+        node_allocator::deallocate(node);
+    }
+
+    static void free_chain(Slist_link *node) noexcept
+    {
+        while (node != nullptr)
+        {
+            Slist_link *next = node->_next;
+            destroy_node(static_cast<Node *>(node));
+            node = next;
+        }
+    }
+
+    // 把 [first, last] 这条链接到 pos 之后; first 为空时不做任何事, 返回 pos
+    static iterator link_chain(const_iterator pos, Slist_link *first, Slist_link *last) noexcept
+    {
+        if (first == nullptr)
+        {
+            return iterator(pos._node);
+        }
+        last->_next = pos._node->_next;
+        pos._node->_next = first;
+        return iterator(last);
+    }
+
+  protected:
+    Slist_link _head;
+};
+
+template <typename T, typename Alloc>
+bool operator==(const forward_list<T, Alloc> &lhs, const forward_list<T, Alloc> &rhs)
+{
+    auto it1 = lhs.begin();
+    auto it2 = rhs.begin();
+    for (; it1 != lhs.end() && it2 != rhs.end(); ++it1, ++it2)
+    {
+        if (!(*it1 == *it2))
+        {
+            return false;
+        }
+    }
+    return it1 == lhs.end() && it2 == rhs.end();
+}
+
+template <typename T, typename Alloc>
+bool operator!=(const forward_list<T, Alloc> &lhs, const forward_list<T, Alloc> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Alloc>
+bool operator<(const forward_list<T, Alloc> &lhs, const forward_list<T, Alloc> &rhs)
+{
+    return TS::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, typename Alloc>
+void swap(forward_list<T, Alloc> &lhs, forward_list<T, Alloc> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace TS
+
+#endif
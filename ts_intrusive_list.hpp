@@ -0,0 +1,420 @@
+#ifndef TS_INTRUSIVE_LIST_HPP
+#define TS_INTRUSIVE_LIST_HPP
+
+#include "ts_iterator.hpp"
+#include "ts_list.hpp"
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+namespace TS
+{
+// 嵌入对象的钩子: 在 List_hook 的链接之外记录所在对象的地址, 由 intrusive_list 链入时设置
+// 复制对象时链接与地址都不随之复制
+struct Intrusive_hook : public List_hook
+{
+    Intrusive_hook() noexcept = default;
+
+    Intrusive_hook(const Intrusive_hook &) noexcept : List_hook()
+    {
+    }
+
+    Intrusive_hook &operator=(const Intrusive_hook &) noexcept
+    {
+        return *this;
+    }
+
+    void *_owner = nullptr;
+};
+
+// 由链表中的值节点求所在对象; 哨兵不是 Intrusive_hook, 不能传入
+template <typename T> T *hook_to_value(const List_hook *hook) noexcept
+{
+    return static_cast<T *>(static_cast<const Intrusive_hook *>(hook)->_owner);
+}
+
+template <typename T, Intrusive_hook T::*Hook, typename Ref, typename Ptr>
+struct Intrusive_iterator
+    : public _iterator<bidirectional_iterator_tag, T, std::ptrdiff_t, Ptr, Ref>
+{
+  public:
+    using base_iterator = _iterator<bidirectional_iterator_tag, T, std::ptrdiff_t, Ptr, Ref>;
+    using iterator = Intrusive_iterator<T, Hook, T &, T *>;
+    using const_iterator = Intrusive_iterator<T, Hook, const T &, const T *>;
+    using self = Intrusive_iterator<T, Hook, Ref, Ptr>;
+
+    using typename base_iterator::difference_type;
+    using typename base_iterator::iterator_category;
+    using typename base_iterator::pointer;
+    using typename base_iterator::reference;
+    using typename base_iterator::value_type;
+
+  public:
+    Intrusive_iterator() noexcept : _node(nullptr)
+    {
+    }
+
+    Intrusive_iterator(List_hook *node) : _node(node)
+    {
+    }
+
+    Intrusive_iterator(const iterator &other) : _node(other._node)
+    {
+    }
+
+    self &operator=(const iterator &other)
+    {
+        _node = other._node;
+        return *this;
+    }
+
+    reference operator*() const
+    {
+        return *hook_to_value<T>(_node);
+    }
+
+    pointer operator->() const
+    {
+        return &(operator*());
+    }
+
+    self &operator++()
+    {
+        _node = _node->_next;
+        return *this;
+    }
+
+    self operator++(int)
+    {
+        self tmp = *this;
+        _node = _node->_next;
+        return tmp;
+    }
+
+    self &operator--()
+    {
+        _node = _node->_prev;
+        return *this;
+    }
+
+    self operator--(int)
+    {
+        self tmp = *this;
+        _node = _node->_prev;
+        return tmp;
+    }
+
+    template <typename OtherRef, typename OtherPtr>
+    bool operator==(const Intrusive_iterator<T, Hook, OtherRef, OtherPtr> &other) const
+    {
+        return _node == other._node;
+    }
+
+    template <typename OtherRef, typename OtherPtr>
+    bool operator!=(const Intrusive_iterator<T, Hook, OtherRef, OtherPtr> &other) const
+    {
+        return _node != other._node;
+    }
+
+  public:
+    List_hook *_node;
+};
+
+// 侵入式双向链表: 元素通过成员钩子 Hook 链接, 链表不分配内存, 也不拥有元素
+// 元素须在链表析构或 erase 之前保持存活; 一个钩子同一时刻只能挂在一个链表上
+// 用法: struct entry { int key; TS::Intrusive_hook hook; };
+//       TS::intrusive_list<entry, &entry::hook> lru;
+template <typename T, Intrusive_hook T::*Hook> class intrusive_list
+{
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using iterator = Intrusive_iterator<T, Hook, T &, T *>;
+    using const_iterator = Intrusive_iterator<T, Hook, const T &, const T *>;
+
+  protected:
+    using self = intrusive_list<T, Hook>;
+
+  public:
+    // 析构时只解除链接
+    ~intrusive_list()
+    {
+        clear();
+    }
+
+    intrusive_list() noexcept : _size(0)
+    {
+        reset();
+    }
+
+    intrusive_list(const self &) = delete;
+    self &operator=(const self &) = delete;
+
+    intrusive_list(self &&other) noexcept : intrusive_list()
+    {
+        steal(other);
+    }
+
+    self &operator=(self &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            steal(other);
+        }
+        return *this;
+    }
+
+    reference front()
+    {
+        return const_cast<reference>(static_cast<const self *>(this)->front());
+    }
+
+    const_reference front() const
+    {
+        if (empty())
+        {
+            throw std::range_error("empty intrusive_list");
+        }
+        return *hook_to_value<T>(_head._next);
+    }
+
+    reference back()
+    {
+        return const_cast<reference>(static_cast<const self *>(this)->back());
+    }
+
+    const_reference back() const
+    {
+        if (empty())
+        {
+            throw std::range_error("empty intrusive_list");
+        }
+        return *hook_to_value<T>(_head._prev);
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator(_head._next);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(_head._next);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(&_head);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(const_cast<List_hook *>(&_head));
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    // 由元素得到其迭代器, 元素须在本链表中
+    iterator iterator_to(reference value) noexcept
+    {
+        return iterator(&(value.*Hook));
+    }
+
+    const_iterator iterator_to(const_reference value) const noexcept
+    {
+        return const_iterator(const_cast<List_hook *>(&(value.*Hook)));
+    }
+
+    // 在 pos 之前链入 value, value 须未链接
+    iterator insert(const_iterator pos, reference value) noexcept
+    {
+        Intrusive_hook *node = &(value.*Hook);
+        assert(!node->is_linked());
+        node->_owner = &value;
+        node->_prev = pos._node->_prev;
+        node->_next = pos._node;
+        pos._node->_prev->_next = node;
+        pos._node->_prev = node;
+        ++_size;
+        return iterator(node);
+    }
+
+    // 解除链接, 不析构元素
+    iterator erase(const_iterator pos) noexcept
+    {
+        List_hook *node = pos._node;
+        List_hook *next = node->_next;
+        node->_prev->_next = next;
+        next->_prev = node->_prev;
+        node->_prev = nullptr;
+        node->_next = nullptr;
+        --_size;
+        return iterator(next);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept
+    {
+        while (first != last)
+        {
+            first = erase(first);
+        }
+        return iterator(last._node);
+    }
+
+    // 从本链表中任意位置摘下 value
+    void erase(reference value) noexcept
+    {
+        erase(iterator_to(value));
+    }
+
+    void push_back(reference value) noexcept
+    {
+        insert(end(), value);
+    }
+
+    void push_front(reference value) noexcept
+    {
+        insert(begin(), value);
+    }
+
+    void pop_back()
+    {
+        if (empty())
+        {
+            throw std::range_error("empty intrusive_list");
+        }
+        erase(--end());
+    }
+
+    void pop_front()
+    {
+        if (empty())
+        {
+            throw std::range_error("empty intrusive_list");
+        }
+        erase(begin());
+    }
+
+    // 把 other 中 it 所指元素移到 pos 之前, other 可以是 *this; 用于 LRU 的提到队首
+    void splice(const_iterator pos, self &other, const_iterator it) noexcept
+    {
+        if (pos == it || pos._node == it._node->_next)
+        {
+            return;
+        }
+        List_hook *node = it._node;
+        node->_prev->_next = node->_next;
+        node->_next->_prev = node->_prev;
+        node->_prev = pos._node->_prev;
+        node->_next = pos._node;
+        pos._node->_prev->_next = node;
+        pos._node->_prev = node;
+        --other._size;
+        ++_size;
+    }
+
+    // 把 other 的全部元素移到 pos 之前
+    void splice(const_iterator pos, self &other) noexcept
+    {
+        if (this == &other || other.empty())
+        {
+            return;
+        }
+        List_hook *first = other._head._next;
+        List_hook *last = other._head._prev;
+        first->_prev = pos._node->_prev;
+        last->_next = pos._node;
+        pos._node->_prev->_next = first;
+        pos._node->_prev = last;
+        _size += other._size;
+        other.reset();
+    }
+
+    // 解除全部元素的链接
+    void clear() noexcept
+    {
+        List_hook *node = _head._next;
+        while (node != &_head)
+        {
+            List_hook *next = node->_next;
+            node->_prev = nullptr;
+            node->_next = nullptr;
+            node = next;
+        }
+        reset();
+    }
+
+    void swap(self &other) noexcept
+    {
+        self tmp(std::move(other));
+        other.steal(*this);
+        steal(tmp);
+    }
+
+  protected:
+    void reset() noexcept
+    {
+        _head._prev = &_head;
+        _head._next = &_head;
+        _size = 0;
+    }
+
+    // 接管 other 的全部元素, *this 须为空
+    void steal(self &other) noexcept
+    {
+        if (other.empty())
+        {
+            return;
+        }
+        _head._next = other._head._next;
+        _head._prev = other._head._prev;
+        _head._next->_prev = &_head;
+        _head._prev->_next = &_head;
+        _size = other._size;
+        other.reset();
+    }
+
+  protected:
+    List_hook _head;
+    size_type _size;
+};
+
+template <typename T, Intrusive_hook T::*Hook>
+void swap(intrusive_list<T, Hook> &lhs, intrusive_list<T, Hook> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace TS
+
+#endif
@@ -3,6 +3,8 @@
 
 #include <cstddef>
 #include <ctime>
+#include <iterator>
+#include <type_traits>
 
 namespace TS
 {
@@ -38,6 +40,37 @@ struct random_access_iterator_tag : public bidirectional_iterator_tag
 {
 };
 
+// 将 std 迭代器的类别标签映射为 TS 标签, 使 std 容器的迭代器也能参与 TS 的标签分派
+template <typename Category> struct ts_iterator_category
+{
+    using type = Category;
+};
+
+template <> struct ts_iterator_category<std::input_iterator_tag>
+{
+    using type = input_iterator_tag;
+};
+
+template <> struct ts_iterator_category<std::output_iterator_tag>
+{
+    using type = output_iterator_tag;
+};
+
+template <> struct ts_iterator_category<std::forward_iterator_tag>
+{
+    using type = forward_iterator_tag;
+};
+
+template <> struct ts_iterator_category<std::bidirectional_iterator_tag>
+{
+    using type = bidirectional_iterator_tag;
+};
+
+template <> struct ts_iterator_category<std::random_access_iterator_tag>
+{
+    using type = random_access_iterator_tag;
+};
+
 template <typename Iter> struct iterator_traits
 {
   public:
@@ -45,7 +78,7 @@ template <typename Iter> struct iterator_traits
     using value_type = typename Iter::value_type;
     using pointer = typename Iter::pointer;
     using reference = typename Iter::reference;
-    using iterator_category = typename Iter::iterator_category;
+    using iterator_category = typename ts_iterator_category<typename Iter::iterator_category>::type;
 };
 
 template <typename T> struct iterator_traits<T *>
@@ -86,6 +119,79 @@ template <typename Iter> inline typename iterator_traits<Iter>::value_type *valu
     return nullptr;
 }
 
+// 区分迭代器区间与 (count, value) 形式的重载: 整数类型不作为迭代器
+template <typename Iter>
+using enable_if_not_integral = typename std::enable_if<!std::is_integral<Iter>::value>::type;
+
+// distance
+template <typename InputIter>
+inline typename iterator_traits<InputIter>::difference_type distance_aux(InputIter first,
+                                                                         InputIter last,
+                                                                         input_iterator_tag)
+{
+    typename iterator_traits<InputIter>::difference_type count = 0;
+    for (; first != last; ++first)
+    {
+        ++count;
+    }
+    return count;
+}
+
+template <typename RandomAccessIter>
+inline typename iterator_traits<RandomAccessIter>::difference_type distance_aux(
+    RandomAccessIter first, RandomAccessIter last, random_access_iterator_tag)
+{
+    return last - first;
+}
+
+template <typename InputIter>
+inline typename iterator_traits<InputIter>::difference_type distance(InputIter first,
+                                                                     InputIter last)
+{
+    return distance_aux(first, last, iterator_category(first));
+}
+
+// advance
+template <typename InputIter, typename Distance>
+inline void advance_aux(InputIter &it, Distance count, input_iterator_tag)
+{
+    for (; count > 0; --count)
+    {
+        ++it;
+    }
+}
+
+template <typename BidirectionalIter, typename Distance>
+inline void advance_aux(BidirectionalIter &it, Distance count, bidirectional_iterator_tag)
+{
+    for (; count > 0; --count)
+    {
+        ++it;
+    }
+    for (; count < 0; ++count)
+    {
+        --it;
+    }
+}
+
+template <typename RandomAccessIter, typename Distance>
+inline void advance_aux(RandomAccessIter &it, Distance count, random_access_iterator_tag)
+{
+    it += count;
+}
+
+template <typename InputIter, typename Distance> inline void advance(InputIter &it, Distance count)
+{
+    advance_aux(it, count, iterator_category(it));
+}
+
+// 分段迭代器: 由若干段连续存储组成 (如 Deque_iterator)
+// 特化需提供 segment/local/begin/end/compose, 算法据此逐段处理连续区间
+template <typename Iter> struct segmented_iterator_traits
+{
+    using is_segmented_iterator = std::false_type;
+};
+
 } // namespace TS
 
 #endif
\ No newline at end of file
@@ -12,35 +12,35 @@
 
 namespace TS
 {
-template <typename T> struct List_node
+// 只有前后链接的钩子, 即 List_node 的链接部分; 嵌入对象后可挂到 intrusive_list
+// 复制对象时钩子不随之复制, 副本处于未链接状态
+struct List_hook
 {
-  protected:
-    using self = List_node<T>;
+    List_hook() noexcept = default;
 
-  public:
-    List_node() : _data(T{}), _prev(nullptr), _next(nullptr)
+    List_hook(const List_hook &) noexcept
     {
     }
 
-    List_node(const T &data) : _data(data), _prev(nullptr), _next(nullptr)
+    List_hook &operator=(const List_hook &) noexcept
     {
-        // std::cout << "-------------" << std::endl;
+        return *this;
     }
 
-    List_node(T &&data) : _data(std::move(data)), _prev(nullptr), _next(nullptr)
+    // 是否已挂在某个链表上
+    bool is_linked() const noexcept
     {
-        // std::cout << "&&&&&&&&&&&&&" << std::endl;
+        return _next != nullptr;
     }
 
-    // template <typename... Args>
-    // List_node(Args &&...args) : _data(std::forward<Args>(args)...), _prev(nullptr),
-    // _next(nullptr)
-    // {
-    // }
+    List_hook *_prev = nullptr;
+    List_hook *_next = nullptr;
+};
 
-  public:
-    List_node *_prev;
-    List_node *_next;
+// 值节点: 链接部分即 List_hook, 哨兵只有链接而不含 T
+// 节点由 list 分配原始内存后只就地构造 _data, 因此 T 无需可默认构造, 插入时恰好构造一次
+template <typename T> struct List_node : public List_hook
+{
     T _data;
 };
 
@@ -66,7 +66,7 @@ struct List_iterator : public _iterator<bidirectional_iterator_tag, T>
     {
     }
 
-    List_iterator(Node *node) : _node(node)
+    List_iterator(List_hook *node) : _node(node)
     {
     }
 
@@ -76,7 +76,7 @@ struct List_iterator : public _iterator<bidirectional_iterator_tag, T>
 
     reference operator*() const
     {
-        return _node->_data;
+        return static_cast<Node *>(_node)->_data;
     }
 
     pointer operator->() const
@@ -123,7 +123,7 @@ struct List_iterator : public _iterator<bidirectional_iterator_tag, T>
     }
 
   public:
-    Node *_node;
+    List_hook *_node;
 };
 
 template <typename T, typename Alloc = alloc> class list
@@ -147,16 +147,13 @@ template <typename T, typename Alloc = alloc> class list
   public:
     ~list()
     {
-
         clear();
-        put_node(_node);
     }
 
-    list()
+    // 哨兵嵌在 list 中, 空链表不分配内存
+    list() noexcept
     {
-        _node = get_node();
-        _node->_prev = _node;
-        _node->_next = _node;
+        reset();
     }
 
     list(size_type count) : list()
@@ -183,12 +180,9 @@ template <typename T, typename Alloc = alloc> class list
         }
     }
 
-    list(self &&other) noexcept : _node(other._node), _size(other._size)
+    list(self &&other) noexcept : list()
     {
-        other._size = 0;
-        other._node = other.get_node();
-        other._node->_next = other._node;
-        other._node->_prev = other._node;
+        steal(other);
     }
 
     list(std::initializer_list<T> init) : list()
@@ -219,13 +213,8 @@ template <typename T, typename Alloc = alloc> class list
         {
             return *this;
         }
-        _node = other._node;
-        _size = other._size;
-
-        other._size = 0;
-        other._node = other.get_node();
-        other._node->_next = other._node;
-        other._node->_prev = other._node;
+        clear();
+        steal(other);
 
         return *this;
     }
@@ -260,7 +249,7 @@ template <typename T, typename Alloc = alloc> class list
         {
             throw std::range_error("empty list");
         }
-        return _node->_next->_data;
+        return static_cast<const Node *>(_head._next)->_data;
     }
 
     reference back()
@@ -274,47 +263,47 @@ template <typename T, typename Alloc = alloc> class list
         {
             throw std::range_error("empty list");
         }
-        return _node->_prev->_data;
+        return static_cast<const Node *>(_head._prev)->_data;
     }
 
     iterator begin()
     {
-        return iterator(_node->_next);
+        return iterator(_head._next);
     }
 
     const_iterator begin() const
     {
-        return const_iterator(_node->_next);
+        return const_iterator(_head._next);
     }
 
     const_iterator cbegin() const noexcept
     {
-        return const_iterator(_node->_next);
+        return const_iterator(_head._next);
     }
 
     iterator end()
     {
-        return iterator(_node);
+        return iterator(&_head);
     }
 
     const_iterator end() const
     {
-        return iterator(_node);
+        return const_iterator(const_cast<List_hook *>(&_head));
     }
 
     const_iterator cend() const noexcept
     {
-        return const_iterator(_node);
+        return end();
     }
 
     bool empty() const
     {
-        return _node->_next == _node;
+        return _head._next == &_head;
     }
 
     size_type size() const
     {
-        return _size - 1;
+        return _size;
     }
     size_type max_size() const
     {
@@ -323,42 +312,24 @@ template <typename T, typename Alloc = alloc> class list
 
     void clear()
     {
-        Node *cur = _node->_next;
-        while (cur != _node)
+        List_hook *cur = _head._next;
+        while (cur != &_head)
         {
-            Node *tmp = cur;
+            List_hook *tmp = cur;
             cur = cur->_next;
-            destroy(tmp);
-            put_node(tmp);
+            destroy_node(static_cast<Node *>(tmp));
         }
-        _node->_next = _node;
-        _node->_prev = _node;
+        reset();
     }
 
     iterator insert(const_iterator pos, const T &val)
     {
-        Node *new_node = get_node();
-        construct(new_node, val);
-        new_node->_prev = pos._node->_prev;
-        new_node->_next = pos._node,
-
-        new_node->_prev->_next = new_node;
-        pos._node->_prev = new_node;
-
-        return iterator(new_node);
+        return emplace(pos, val);
     }
 
     iterator insert(const_iterator pos, T &&val)
     {
-        Node *new_node = get_node();
-        construct(new_node, std::move(val));
-        new_node->_prev = pos._node->_prev;
-        new_node->_next = pos._node,
-
-        pos._node->_prev = new_node;
-        new_node->_prev->_next = new_node;
-
-        return iterator(new_node);
+        return emplace(pos, std::move(val));
     }
 
     iterator insert(const_iterator pos, size_type count, const T &val)
@@ -395,15 +366,16 @@ template <typename T, typename Alloc = alloc> class list
         return iterator(result._node->_next);
     }
 
+    // 参数直接转发给 T 的构造函数, 在节点内就地构造
     template <typename... Args> iterator emplace(const_iterator pos, Args &&...args)
     {
-        Node *new_node = get_node();
-        construct(new_node, std::forward<Args>(args)...);
+        Node *new_node = create_node(std::forward<Args>(args)...);
         new_node->_prev = pos._node->_prev;
         new_node->_next = pos._node,
 
         pos._node->_prev = new_node;
         new_node->_prev->_next = new_node;
+        ++_size;
 
         return iterator(new_node);
     }
@@ -414,8 +386,8 @@ template <typename T, typename Alloc = alloc> class list
         pos._node->_prev->_next = pos._node->_next;
         pos._node->_next->_prev = pos._node->_prev;
 
-        destroy(pos._node);
-        put_node(pos._node);
+        destroy_node(static_cast<Node *>(pos._node));
+        --_size;
 
         return result;
     }
@@ -533,28 +505,57 @@ template <typename T, typename Alloc = alloc> class list
         }
     }
 
-    void swap(self &other)
+    // 哨兵不能交换地址, 改为交换两条链并修正首尾节点的指向
+    void swap(self &other) noexcept
     {
-        Node *tmp_node = other._node;
-        size_type tmp_size = other._size;
+        self tmp(std::move(other));
+        other.steal(*this);
+        steal(tmp);
+    }
 
-        other._node = _node;
-        other._size = _size;
+  protected:
+    // 只分配节点内存并构造 _data, 链接由调用者设置
+    template <typename... Args> Node *create_node(Args &&...args)
+    {
+        Node *node = data_allocator::allocate();
+        try
+        {
+            construct(&node->_data, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            data_allocator::deallocate(node);
+            throw;
+        }
+        return node;
+    }
 
-        _node = tmp_node;
-        _size = tmp_size;
+    void destroy_node(Node *node) noexcept
+    {
+        destroy(&node->_data);
+        data_allocator::deallocate(node);
     }
 
-  protected:
-    Node *get_node()
+    void reset() noexcept
     {
-        _size++;
-        return data_allocator::allocate();
+        _head._prev = &_head;
+        _head._next = &_head;
+        _size = 0;
     }
-    void put_node(Node *p)
+
+    // 接管 other 的全部节点, *this 须为空
+    void steal(self &other) noexcept
     {
-        _size--;
-        data_allocator::deallocate(p);
+        if (other.empty())
+        {
+            return;
+        }
+        _head._next = other._head._next;
+        _head._prev = other._head._prev;
+        _head._next->_prev = &_head;
+        _head._prev->_next = &_head;
+        _size = other._size;
+        other.reset();
     }
 
     iterator const_iterator_to_iterator(const_iterator cit)
@@ -563,7 +564,7 @@ template <typename T, typename Alloc = alloc> class list
     }
 
   protected:
-    Node *_node;
+    List_hook _head;
     size_type _size = 0;
 };
 
@@ -0,0 +1,243 @@
+#ifndef TS_LOCKFREE_STACK_HPP
+#define TS_LOCKFREE_STACK_HPP
+
+#include "ts_alloc.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace TS
+{
+// 带版本号的指针: 低 48 位为地址, 高 16 位为每次修改递增的版本号, 可用单字 CAS 更新
+// 要求用户态地址不超过 48 位 (x86-64 与 AArch64 的常见配置)
+class tagged_ptr
+{
+  public:
+    static const int ADDRESS_BITS = 48;
+    static const std::uint64_t ADDRESS_MASK = (std::uint64_t(1) << ADDRESS_BITS) - 1;
+
+    static_assert(sizeof(void *) == sizeof(std::uint64_t), "tagged_ptr needs 64-bit pointers");
+
+    tagged_ptr() noexcept : _bits(0)
+    {
+    }
+
+    tagged_ptr(void *ptr, std::uint64_t tag) noexcept
+        : _bits((reinterpret_cast<std::uint64_t>(ptr) & ADDRESS_MASK) | (tag << ADDRESS_BITS))
+    {
+    }
+
+    template <typename T> T *get() const noexcept
+    {
+        return reinterpret_cast<T *>(_bits & ADDRESS_MASK);
+    }
+
+    std::uint64_t tag() const noexcept
+    {
+        return _bits >> ADDRESS_BITS;
+    }
+
+    // 指向 ptr 且版本号加一
+    tagged_ptr next(void *ptr) const noexcept
+    {
+        return tagged_ptr(ptr, tag() + 1);
+    }
+
+  protected:
+    std::uint64_t _bits;
+};
+
+// Treiber 无锁栈: 多个线程可同时 push/pop
+// ABA 由 tagged_ptr 的版本号防止; 弹出的节点进入栈内部的无锁空闲链表循环使用,
+// 直到析构才还给 Alloc, 因此并发线程读取已弹出节点的 _next 时内存始终有效
+template <typename T, typename Alloc = alloc> class lockfree_stack
+{
+  protected:
+    struct Node
+    {
+        std::atomic<Node *> _next; // 可能被读取旧栈顶的线程并发读取
+        T _data;
+    };
+
+    using node_allocator = simple_alloc<Node, Alloc>;
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+  public:
+    lockfree_stack() noexcept : _top(tagged_ptr()), _free(tagged_ptr())
+    {
+    }
+
+    lockfree_stack(const lockfree_stack &) = delete;
+    lockfree_stack &operator=(const lockfree_stack &) = delete;
+
+    // 析构时不能有其他线程访问
+    ~lockfree_stack()
+    {
+        Node *node = _top.load(std::memory_order_relaxed).get<Node>();
+        while (node != nullptr)
+        {
+            Node *next = node->_next.load(std::memory_order_relaxed);
+            destroy(&node->_data);
+            node_allocator::deallocate(node);
+            node = next;
+        }
+        node = _free.load(std::memory_order_relaxed).get<Node>();
+        while (node != nullptr)
+        {
+            Node *next = node->_next.load(std::memory_order_relaxed);
+            node_allocator::deallocate(node);
+            node = next;
+        }
+    }
+
+    void push(const T &val)
+    {
+        emplace(val);
+    }
+
+    void push(T &&val)
+    {
+        emplace(std::move(val));
+    }
+
+    template <typename... Args> void emplace(Args &&...args)
+    {
+        Node *node = acquire_node();
+        try
+        {
+            construct(&node->_data, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            push_chain(_free, node, node);
+            throw;
+        }
+        push_chain(_top, node, node);
+    }
+
+    // 栈空时返回 false
+    bool pop(T &result)
+    {
+        Node *node = pop_node(_top);
+        if (node == nullptr)
+        {
+            return false;
+        }
+        try
+        {
+            result = std::move(node->_data);
+        }
+        catch (...)
+        {
+            push_chain(_top, node, node);
+            throw;
+        }
+        destroy(&node->_data);
+        push_chain(_free, node, node);
+        return true;
+    }
+
+    // 一次取走当前全部元素, 按出栈顺序 (后进先出) 交给 func; 返回元素个数
+    template <typename Func> size_type pop_all(Func func)
+    {
+        tagged_ptr top = _top.load(std::memory_order_acquire);
+        while (top.get<Node>() != nullptr &&
+               !_top.compare_exchange_weak(top, top.next(nullptr), std::memory_order_acquire,
+                                           std::memory_order_acquire))
+        {
+        }
+        Node *first = top.get<Node>();
+        if (first == nullptr)
+        {
+            return 0;
+        }
+        size_type count = 0;
+        Node *node = first;
+        Node *last = first;
+        while (node != nullptr)
+        {
+            try
+            {
+                func(std::move(node->_data));
+            }
+            catch (...)
+            {
+                // 未处理的元素放回栈中, 已处理的节点回收
+                Node *rest = node->_next.load(std::memory_order_relaxed);
+                destroy(&node->_data);
+                if (rest != nullptr)
+                {
+                    Node *tail = rest;
+                    while (tail->_next.load(std::memory_order_relaxed) != nullptr)
+                    {
+                        tail = tail->_next.load(std::memory_order_relaxed);
+                    }
+                    push_chain(_top, rest, tail);
+                }
+                node->_next.store(nullptr, std::memory_order_relaxed);
+                push_chain(_free, first, node);
+                throw;
+            }
+            destroy(&node->_data);
+            ++count;
+            last = node;
+            node = node->_next.load(std::memory_order_relaxed);
+        }
+        push_chain(_free, first, last);
+        return count;
+    }
+
+    // 并发修改时结果仅供参考
+    bool empty() const noexcept
+    {
+        return _top.load(std::memory_order_acquire).get<Node>() == nullptr;
+    }
+
+  protected:
+    Node *acquire_node()
+    {
+        Node *node = pop_node(_free);
+        return node != nullptr ? node : node_allocator::allocate();
+    }
+
+    // 把已串好的 [first, last] 整段压入 head
+    static void push_chain(std::atomic<tagged_ptr> &head, Node *first, Node *last) noexcept
+    {
+        tagged_ptr top = head.load(std::memory_order_relaxed);
+        do
+        {
+            last->_next.store(top.get<Node>(), std::memory_order_relaxed);
+        } while (!head.compare_exchange_weak(top, top.next(first), std::memory_order_release,
+                                             std::memory_order_relaxed));
+    }
+
+    static Node *pop_node(std::atomic<tagged_ptr> &head) noexcept
+    {
+        tagged_ptr top = head.load(std::memory_order_acquire);
+        Node *node = top.get<Node>();
+        while (node != nullptr)
+        {
+            // node 可能已被其他线程弹出并重用, 此时读到的 next 无意义, 但版本号使下面的 CAS 失败
+            Node *next = node->_next.load(std::memory_order_relaxed);
+            if (head.compare_exchange_weak(top, top.next(next), std::memory_order_acquire,
+                                           std::memory_order_acquire))
+            {
+                break;
+            }
+            node = top.get<Node>();
+        }
+        return node;
+    }
+
+  protected:
+    alignas(64) std::atomic<tagged_ptr> _top;
+    alignas(64) std::atomic<tagged_ptr> _free;
+};
+
+} // namespace TS
+
+#endif
@@ -0,0 +1,712 @@
+#ifndef TS_PARALLEL_HPP
+#define TS_PARALLEL_HPP
+
+#include "ts_algorithm.hpp"
+#include "ts_iterator.hpp"
+#include "ts_sort.hpp"
+#include "ts_thread_pool.hpp"
+#include "ts_uninitialized.hpp"
+#include "ts_vector.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace TS
+{
+namespace parallel
+{
+const std::size_t PARALLEL_DEFAULT_GRAIN = 4096;
+
+// 并行执行参数: grain 为单个任务至少处理的元素数, concurrency 为同时执行任务的线程数上限,
+// 为 0 时取硬件线程数, 为 1 时在调用线程串行执行
+class policy
+{
+  public:
+    explicit policy(std::size_t grain = PARALLEL_DEFAULT_GRAIN, std::size_t concurrency = 0)
+        : _grain(grain == 0 ? 1 : grain), _concurrency(concurrency)
+    {
+    }
+
+    std::size_t grain() const
+    {
+        return _grain;
+    }
+
+    std::size_t concurrency() const
+    {
+        if (_concurrency != 0)
+        {
+            return _concurrency;
+        }
+        std::size_t hardware = std::thread::hardware_concurrency();
+        return hardware == 0 ? 1 : hardware;
+    }
+
+    // 将 count 个元素按 grain 划分后的块数
+    std::size_t chunk_count(std::size_t count) const
+    {
+        return (count + _grain - 1) / _grain;
+    }
+
+  protected:
+    std::size_t _grain;
+    std::size_t _concurrency;
+};
+
+template <typename Iter> inline void require_random_access()
+{
+    static_assert(std::is_base_of<random_access_iterator_tag,
+                                  typename iterator_traits<Iter>::iterator_category>::value,
+                  "TS::parallel algorithms require random access iterators");
+}
+
+// 把 [0, count) 均分为 chunks 块, 返回第 index 块的起点
+inline std::size_t chunk_begin(std::size_t count, std::size_t chunks, std::size_t index)
+{
+    return index * (count / chunks) + (index < count % chunks ? index : count % chunks);
+}
+
+// 执行 task(0) ... task(count - 1); 调用线程与默认线程池中的至多 concurrency - 1 个任务
+// 从共享计数器领取下标, 首个异常在全部已开始的任务结束后重新抛出
+template <typename Task> void run_tasks(const policy &pol, std::size_t count, Task &task)
+{
+    std::size_t workers = std::min(pol.concurrency(), count);
+    if (workers <= 1)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;)
+        {
+            try
+            {
+                task(i);
+            }
+            catch (...)
+            {
+                next.store(count, std::memory_order_relaxed);
+                throw;
+            }
+        }
+    };
+
+    task_group group(default_thread_pool());
+    try
+    {
+        for (std::size_t w = 1; w < workers; ++w)
+        {
+            group.spawn([&worker] { worker(); });
+        }
+        worker();
+    }
+    catch (...)
+    {
+        group.cancel();
+        throw;
+    }
+    group.wait();
+}
+
+// for_each
+
+template <typename RandomIter, typename Function>
+void for_each(const policy &pol, RandomIter first, RandomIter last, Function f)
+{
+    require_random_access<RandomIter>();
+    std::size_t count = last - first;
+    std::size_t chunks = pol.chunk_count(count);
+    auto task = [&](std::size_t index) {
+        RandomIter cur = first + chunk_begin(count, chunks, index);
+        RandomIter end = first + chunk_begin(count, chunks, index + 1);
+        for (; cur != end; ++cur)
+        {
+            f(*cur);
+        }
+    };
+    run_tasks(pol, chunks, task);
+}
+
+template <typename RandomIter, typename Function>
+void for_each(RandomIter first, RandomIter last, Function f)
+{
+    parallel::for_each(policy(), first, last, f);
+}
+
+// transform
+
+template <typename RandomIter, typename OutputIter, typename UnaryOp>
+OutputIter transform(const policy &pol, RandomIter first, RandomIter last, OutputIter result,
+                     UnaryOp op)
+{
+    require_random_access<RandomIter>();
+    require_random_access<OutputIter>();
+    std::size_t count = last - first;
+    std::size_t chunks = pol.chunk_count(count);
+    auto task = [&](std::size_t index) {
+        std::size_t begin = chunk_begin(count, chunks, index);
+        RandomIter cur = first + begin;
+        RandomIter end = first + chunk_begin(count, chunks, index + 1);
+        for (OutputIter out = result + begin; cur != end; ++cur, ++out)
+        {
+            *out = op(*cur);
+        }
+    };
+    run_tasks(pol, chunks, task);
+    return result + count;
+}
+
+template <typename RandomIter1, typename RandomIter2, typename OutputIter, typename BinaryOp>
+OutputIter transform(const policy &pol, RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                     OutputIter result, BinaryOp op)
+{
+    require_random_access<RandomIter1>();
+    require_random_access<RandomIter2>();
+    require_random_access<OutputIter>();
+    std::size_t count = last1 - first1;
+    std::size_t chunks = pol.chunk_count(count);
+    auto task = [&](std::size_t index) {
+        std::size_t begin = chunk_begin(count, chunks, index);
+        RandomIter1 cur1 = first1 + begin;
+        RandomIter1 end1 = first1 + chunk_begin(count, chunks, index + 1);
+        RandomIter2 cur2 = first2 + begin;
+        for (OutputIter out = result + begin; cur1 != end1; ++cur1, ++cur2, ++out)
+        {
+            *out = op(*cur1, *cur2);
+        }
+    };
+    run_tasks(pol, chunks, task);
+    return result + count;
+}
+
+template <typename RandomIter, typename OutputIter, typename UnaryOp>
+OutputIter transform(RandomIter first, RandomIter last, OutputIter result, UnaryOp op)
+{
+    return parallel::transform(policy(), first, last, result, op);
+}
+
+template <typename RandomIter1, typename RandomIter2, typename OutputIter, typename BinaryOp>
+OutputIter transform(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, OutputIter result,
+                     BinaryOp op)
+{
+    return parallel::transform(policy(), first1, last1, first2, result, op);
+}
+
+// transform_reduce
+// 各块独立归约后按块顺序合并, 只要求 reduce_op 满足结合律, 结果与块数无关地确定
+
+template <typename RandomIter, typename T, typename BinaryOp, typename UnaryOp>
+T transform_reduce(const policy &pol, RandomIter first, RandomIter last, T init,
+                   BinaryOp reduce_op, UnaryOp transform_op)
+{
+    require_random_access<RandomIter>();
+    std::size_t count = last - first;
+    std::size_t chunks = pol.chunk_count(count);
+    if (chunks <= 1)
+    {
+        for (; first != last; ++first)
+        {
+            init = reduce_op(std::move(init), transform_op(*first));
+        }
+        return init;
+    }
+
+    vector<T> partials(chunks, init);
+    auto task = [&](std::size_t index) {
+        RandomIter cur = first + chunk_begin(count, chunks, index);
+        RandomIter end = first + chunk_begin(count, chunks, index + 1);
+        T acc = transform_op(*cur);
+        for (++cur; cur != end; ++cur)
+        {
+            acc = reduce_op(std::move(acc), transform_op(*cur));
+        }
+        partials[index] = std::move(acc);
+    };
+    run_tasks(pol, chunks, task);
+    for (std::size_t i = 0; i < chunks; ++i)
+    {
+        init = reduce_op(std::move(init), std::move(partials[i]));
+    }
+    return init;
+}
+
+template <typename RandomIter1, typename RandomIter2, typename T, typename BinaryOp1,
+          typename BinaryOp2>
+T transform_reduce(const policy &pol, RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                   T init, BinaryOp1 reduce_op, BinaryOp2 transform_op)
+{
+    require_random_access<RandomIter1>();
+    require_random_access<RandomIter2>();
+    std::size_t count = last1 - first1;
+    std::size_t chunks = pol.chunk_count(count);
+    if (chunks <= 1)
+    {
+        for (; first1 != last1; ++first1, ++first2)
+        {
+            init = reduce_op(std::move(init), transform_op(*first1, *first2));
+        }
+        return init;
+    }
+
+    vector<T> partials(chunks, init);
+    auto task = [&](std::size_t index) {
+        std::size_t begin = chunk_begin(count, chunks, index);
+        RandomIter1 cur1 = first1 + begin;
+        RandomIter1 end1 = first1 + chunk_begin(count, chunks, index + 1);
+        RandomIter2 cur2 = first2 + begin;
+        T acc = transform_op(*cur1, *cur2);
+        for (++cur1, ++cur2; cur1 != end1; ++cur1, ++cur2)
+        {
+            acc = reduce_op(std::move(acc), transform_op(*cur1, *cur2));
+        }
+        partials[index] = std::move(acc);
+    };
+    run_tasks(pol, chunks, task);
+    for (std::size_t i = 0; i < chunks; ++i)
+    {
+        init = reduce_op(std::move(init), std::move(partials[i]));
+    }
+    return init;
+}
+
+template <typename RandomIter1, typename RandomIter2, typename T>
+T transform_reduce(const policy &pol, RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                   T init)
+{
+    return parallel::transform_reduce(pol, first1, last1, first2, std::move(init), plus_op(),
+                                      multiplies_op());
+}
+
+template <typename RandomIter, typename T, typename BinaryOp, typename UnaryOp>
+T transform_reduce(RandomIter first, RandomIter last, T init, BinaryOp reduce_op,
+                   UnaryOp transform_op)
+{
+    return parallel::transform_reduce(policy(), first, last, std::move(init), reduce_op,
+                                      transform_op);
+}
+
+template <typename RandomIter1, typename RandomIter2, typename T, typename BinaryOp1,
+          typename BinaryOp2>
+T transform_reduce(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, T init,
+                   BinaryOp1 reduce_op, BinaryOp2 transform_op)
+{
+    return parallel::transform_reduce(policy(), first1, last1, first2, std::move(init), reduce_op,
+                                      transform_op);
+}
+
+template <typename RandomIter1, typename RandomIter2, typename T>
+T transform_reduce(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, T init)
+{
+    return parallel::transform_reduce(policy(), first1, last1, first2, std::move(init));
+}
+
+// reduce
+
+struct identity_op
+{
+    template <typename T> T &&operator()(T &&val) const
+    {
+        return std::forward<T>(val);
+    }
+};
+
+template <typename RandomIter, typename T, typename BinaryOp>
+T reduce(const policy &pol, RandomIter first, RandomIter last, T init, BinaryOp op)
+{
+    return parallel::transform_reduce(pol, first, last, std::move(init), op, identity_op());
+}
+
+template <typename RandomIter, typename T>
+T reduce(const policy &pol, RandomIter first, RandomIter last, T init)
+{
+    return parallel::reduce(pol, first, last, std::move(init), plus_op());
+}
+
+template <typename RandomIter, typename T, typename BinaryOp>
+T reduce(RandomIter first, RandomIter last, T init, BinaryOp op)
+{
+    return parallel::reduce(policy(), first, last, std::move(init), op);
+}
+
+template <typename RandomIter, typename T> T reduce(RandomIter first, RandomIter last, T init)
+{
+    return parallel::reduce(policy(), first, last, std::move(init), plus_op());
+}
+
+// inclusive_scan / exclusive_scan
+// 两遍扫描: 先并行求各块之和, 串行得到每块的前缀, 再并行写出各块结果
+
+template <typename RandomIter, typename OutputIter, typename BinaryOp, typename T>
+OutputIter scan_aux(const policy &pol, RandomIter first, RandomIter last, OutputIter result,
+                    BinaryOp op, T init, bool inclusive)
+{
+    require_random_access<RandomIter>();
+    require_random_access<OutputIter>();
+    std::size_t count = last - first;
+    std::size_t chunks = pol.chunk_count(count);
+    if (chunks == 0)
+    {
+        return result;
+    }
+
+    vector<T> carries(chunks, init);
+    auto sum_task = [&](std::size_t index) {
+        RandomIter cur = first + chunk_begin(count, chunks, index);
+        RandomIter end = first + chunk_begin(count, chunks, index + 1);
+        T acc = *cur;
+        for (++cur; cur != end; ++cur)
+        {
+            acc = op(std::move(acc), *cur);
+        }
+        carries[index + 1] = std::move(acc);
+    };
+    run_tasks(pol, chunks - 1, sum_task);
+    for (std::size_t i = 1; i < chunks; ++i)
+    {
+        carries[i] = op(carries[i - 1], std::move(carries[i]));
+    }
+
+    auto scan_task = [&](std::size_t index) {
+        std::size_t begin = chunk_begin(count, chunks, index);
+        RandomIter cur = first + begin;
+        RandomIter end = first + chunk_begin(count, chunks, index + 1);
+        T acc = std::move(carries[index]);
+        for (OutputIter out = result + begin; cur != end; ++cur, ++out)
+        {
+            if (inclusive)
+            {
+                acc = op(std::move(acc), *cur);
+                *out = acc;
+            }
+            else
+            {
+                // 先读后写, 允许 result == first 的原地扫描
+                T next = op(acc, *cur);
+                *out = std::move(acc);
+                acc = std::move(next);
+            }
+        }
+    };
+    run_tasks(pol, chunks, scan_task);
+    return result + count;
+}
+
+template <typename RandomIter, typename OutputIter, typename BinaryOp, typename T>
+OutputIter inclusive_scan(const policy &pol, RandomIter first, RandomIter last, OutputIter result,
+                          BinaryOp op, T init)
+{
+    return parallel::scan_aux(pol, first, last, result, op, std::move(init), true);
+}
+
+template <typename RandomIter, typename OutputIter, typename BinaryOp>
+OutputIter inclusive_scan(const policy &pol, RandomIter first, RandomIter last, OutputIter result,
+                          BinaryOp op)
+{
+    if (first == last)
+    {
+        return result;
+    }
+    // 首元素作为初值, 其余元素照常扫描
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    value_type init = *first;
+    *result = init;
+    return parallel::scan_aux(pol, first + 1, last, result + 1, op, std::move(init), true);
+}
+
+template <typename RandomIter, typename OutputIter>
+OutputIter inclusive_scan(const policy &pol, RandomIter first, RandomIter last, OutputIter result)
+{
+    return parallel::inclusive_scan(pol, first, last, result, plus_op());
+}
+
+template <typename RandomIter, typename OutputIter, typename T, typename BinaryOp>
+OutputIter exclusive_scan(const policy &pol, RandomIter first, RandomIter last, OutputIter result,
+                          T init, BinaryOp op)
+{
+    return parallel::scan_aux(pol, first, last, result, op, std::move(init), false);
+}
+
+template <typename RandomIter, typename OutputIter, typename T>
+OutputIter exclusive_scan(const policy &pol, RandomIter first, RandomIter last, OutputIter result,
+                          T init)
+{
+    return parallel::exclusive_scan(pol, first, last, result, std::move(init), plus_op());
+}
+
+template <typename RandomIter, typename OutputIter, typename BinaryOp, typename T>
+OutputIter inclusive_scan(RandomIter first, RandomIter last, OutputIter result, BinaryOp op,
+                          T init)
+{
+    return parallel::inclusive_scan(policy(), first, last, result, op, std::move(init));
+}
+
+template <typename RandomIter, typename OutputIter, typename BinaryOp>
+OutputIter inclusive_scan(RandomIter first, RandomIter last, OutputIter result, BinaryOp op)
+{
+    return parallel::inclusive_scan(policy(), first, last, result, op);
+}
+
+template <typename RandomIter, typename OutputIter>
+OutputIter inclusive_scan(RandomIter first, RandomIter last, OutputIter result)
+{
+    return parallel::inclusive_scan(policy(), first, last, result, plus_op());
+}
+
+template <typename RandomIter, typename OutputIter, typename T, typename BinaryOp>
+OutputIter exclusive_scan(RandomIter first, RandomIter last, OutputIter result, T init,
+                          BinaryOp op)
+{
+    return parallel::exclusive_scan(policy(), first, last, result, std::move(init), op);
+}
+
+template <typename RandomIter, typename OutputIter, typename T>
+OutputIter exclusive_scan(RandomIter first, RandomIter last, OutputIter result, T init)
+{
+    return parallel::exclusive_scan(policy(), first, last, result, std::move(init), plus_op());
+}
+
+// sort / stable_sort
+// 先并行排序各块, 再逐轮两两归并; 每次归并按输出位置二分切分, 使最后一轮也能并行
+
+// 合并结果前 diag 个元素中来自左区间的个数, 相等元素左区间优先以保持稳定
+template <typename Iter, typename Compare>
+std::size_t merge_split(Iter left, std::size_t left_size, Iter right, std::size_t right_size,
+                        std::size_t diag, Compare &comp)
+{
+    std::size_t lo = diag > right_size ? diag - right_size : 0;
+    std::size_t hi = diag < left_size ? diag : left_size;
+    while (lo < hi)
+    {
+        std::size_t mid = lo + (hi - lo) / 2;
+        if (!comp(right[diag - mid - 1], left[mid]))
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+template <typename InputIter, typename OutputIter, typename Compare>
+void move_merge(InputIter first1, InputIter last1, InputIter first2, InputIter last2,
+                OutputIter result, Compare &comp)
+{
+    while (first1 != last1 && first2 != last2)
+    {
+        if (comp(*first2, *first1))
+        {
+            *result = std::move(*first2);
+            ++first2;
+        }
+        else
+        {
+            *result = std::move(*first1);
+            ++first1;
+        }
+        ++result;
+    }
+    result = std::move(first1, last1, result);
+    std::move(first2, last2, result);
+}
+
+// 将 src 中宽度为 width 块的相邻两段归并到 dst, bounds 为各块边界
+template <typename SrcIter, typename DstIter, typename Compare>
+void merge_round(const policy &pol, SrcIter src, DstIter dst, const vector<std::size_t> &bounds,
+                 std::size_t width, Compare &comp)
+{
+    std::size_t chunks = bounds.size() - 1;
+    vector<std::size_t> pieces; // 每对归并的任务数前缀和
+    pieces.push_back(0);
+    for (std::size_t i = 0; i < chunks; i += 2 * width)
+    {
+        std::size_t length = bounds[std::min(i + 2 * width, chunks)] - bounds[i];
+        pieces.push_back(pieces.back() + std::max<std::size_t>(pol.chunk_count(length), 1));
+    }
+
+    // 第 index 个任务所属的归并对及其区间 [lo, mid), [mid, hi)
+    struct piece_range
+    {
+        std::size_t piece, piece_count, lo, mid, hi;
+    };
+    auto locate = [&](std::size_t index) {
+        std::size_t pair =
+            std::upper_bound(pieces.begin(), pieces.end(), index) - pieces.begin() - 1;
+        std::size_t first_chunk = pair * 2 * width;
+        return piece_range{index - pieces[pair], pieces[pair + 1] - pieces[pair],
+                           bounds[first_chunk], bounds[std::min(first_chunk + width, chunks)],
+                           bounds[std::min(first_chunk + 2 * width, chunks)]};
+    };
+
+    // 先求出全部切分点再移动元素, 移动会改写源元素, 不能与其他任务的二分查找并发
+    vector<std::size_t> splits(pieces.back(), 0);
+    auto split_task = [&](std::size_t index) {
+        piece_range r = locate(index);
+        std::size_t diag = chunk_begin(r.hi - r.lo, r.piece_count, r.piece);
+        splits[index] =
+            merge_split(src + r.lo, r.mid - r.lo, src + r.mid, r.hi - r.mid, diag, comp);
+    };
+    run_tasks(pol, pieces.back(), split_task);
+
+    auto merge_task = [&](std::size_t index) {
+        piece_range r = locate(index);
+        std::size_t diag_first = chunk_begin(r.hi - r.lo, r.piece_count, r.piece);
+        std::size_t diag_last = chunk_begin(r.hi - r.lo, r.piece_count, r.piece + 1);
+        std::size_t left_first = splits[index];
+        std::size_t left_last = r.piece + 1 == r.piece_count ? r.mid - r.lo : splits[index + 1];
+        move_merge(src + r.lo + left_first, src + r.lo + left_last,
+                   src + r.mid + (diag_first - left_first), src + r.mid + (diag_last - left_last),
+                   dst + r.lo + diag_first, comp);
+    };
+    run_tasks(pol, pieces.back(), merge_task);
+}
+
+template <typename RandomIter, typename Compare, typename LeafSort>
+void sort_aux(const policy &pol, RandomIter first, RandomIter last, Compare comp, LeafSort leaf)
+{
+    require_random_access<RandomIter>();
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    std::size_t count = last - first;
+    std::size_t chunks = std::min(pol.chunk_count(count), pol.concurrency());
+    if (chunks <= 1)
+    {
+        leaf(first, last, comp);
+        return;
+    }
+
+    vector<std::size_t> bounds;
+    for (std::size_t i = 0; i <= chunks; ++i)
+    {
+        bounds.push_back(chunk_begin(count, chunks, i));
+    }
+    auto sort_task = [&](std::size_t index) {
+        leaf(first + bounds[index], first + bounds[index + 1], comp);
+    };
+    run_tasks(pol, chunks, sort_task);
+
+    // 辅助缓冲区由调用线程分配, 元素以移动构造填入
+    using buffer_alloc = simple_alloc<value_type, alloc>;
+    value_type *buffer = buffer_alloc::allocate(count);
+    try
+    {
+        TS::uninitialized_copy(std::make_move_iterator(first), std::make_move_iterator(last),
+                               buffer);
+    }
+    catch (...)
+    {
+        buffer_alloc::deallocate(buffer, count);
+        throw;
+    }
+
+    struct buffer_guard
+    {
+        value_type *_buffer;
+        std::size_t _count;
+        ~buffer_guard()
+        {
+            for (std::size_t i = 0; i < _count; ++i)
+            {
+                TS::destroy(_buffer + i);
+            }
+            buffer_alloc::deallocate(_buffer, _count);
+        }
+    } guard = {buffer, count};
+
+    bool in_buffer = true;
+    for (std::size_t width = 1; width < chunks; width *= 2, in_buffer = !in_buffer)
+    {
+        if (in_buffer)
+        {
+            merge_round(pol, buffer, first, bounds, width, comp);
+        }
+        else
+        {
+            merge_round(pol, first, buffer, bounds, width, comp);
+        }
+    }
+    if (in_buffer)
+    {
+        auto move_task = [&](std::size_t index) {
+            std::move(buffer + bounds[index], buffer + bounds[index + 1], first + bounds[index]);
+        };
+        run_tasks(pol, chunks, move_task);
+    }
+}
+
+struct sort_leaf
+{
+    template <typename RandomIter, typename Compare>
+    void operator()(RandomIter first, RandomIter last, Compare &comp) const
+    {
+        TS::sort(first, last, comp);
+    }
+};
+
+struct stable_sort_leaf
+{
+    template <typename RandomIter, typename Compare>
+    void operator()(RandomIter first, RandomIter last, Compare &comp) const
+    {
+        std::stable_sort(first, last, comp);
+    }
+};
+
+template <typename RandomIter, typename Compare>
+void sort(const policy &pol, RandomIter first, RandomIter last, Compare comp)
+{
+    parallel::sort_aux(pol, first, last, comp, sort_leaf());
+}
+
+template <typename RandomIter> void sort(const policy &pol, RandomIter first, RandomIter last)
+{
+    parallel::sort_aux(pol, first, last, less_op(), sort_leaf());
+}
+
+template <typename RandomIter, typename Compare>
+void stable_sort(const policy &pol, RandomIter first, RandomIter last, Compare comp)
+{
+    parallel::sort_aux(pol, first, last, comp, stable_sort_leaf());
+}
+
+template <typename RandomIter>
+void stable_sort(const policy &pol, RandomIter first, RandomIter last)
+{
+    parallel::sort_aux(pol, first, last, less_op(), stable_sort_leaf());
+}
+
+template <typename RandomIter, typename Compare>
+void sort(RandomIter first, RandomIter last, Compare comp)
+{
+    parallel::sort_aux(policy(), first, last, comp, sort_leaf());
+}
+
+template <typename RandomIter> void sort(RandomIter first, RandomIter last)
+{
+    parallel::sort_aux(policy(), first, last, less_op(), sort_leaf());
+}
+
+template <typename RandomIter, typename Compare>
+void stable_sort(RandomIter first, RandomIter last, Compare comp)
+{
+    parallel::sort_aux(policy(), first, last, comp, stable_sort_leaf());
+}
+
+template <typename RandomIter> void stable_sort(RandomIter first, RandomIter last)
+{
+    parallel::sort_aux(policy(), first, last, less_op(), stable_sort_leaf());
+}
+
+} // namespace parallel
+} // namespace TS
+
+#endif
@@ -0,0 +1,532 @@
+#ifndef TS_PRIORITY_QUEUE_HPP
+#define TS_PRIORITY_QUEUE_HPP
+
+#include "ts_alloc.hpp"
+#include "ts_iterator.hpp"
+#include "ts_vector.hpp"
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+namespace TS
+{
+// d 叉堆: 结点 i 的子结点为 d*i+1 .. d*i+d
+// 4 叉堆的层数是二叉堆的一半, 同一结点的子结点相邻, 下沉时每层比较更多但缓存缺失更少
+// 上浮与下沉都先把元素移出形成空位, 沿路径移动其他元素, 最后放回, 每层只移动一次
+// place(first, i, value) 负责把 value 放到位置 i, 带索引的堆借此同步位置表
+template <std::size_t Arity> struct Dary_heap
+{
+    static_assert(Arity >= 2, "heap arity must be at least 2");
+
+    static std::size_t parent(std::size_t i) noexcept
+    {
+        return (i - 1) / Arity;
+    }
+
+    static std::size_t first_child(std::size_t i) noexcept
+    {
+        return Arity * i + 1;
+    }
+
+    template <typename T, typename Compare, typename Place>
+    static void sift_up(T *first, std::size_t hole, Compare &comp, Place place)
+    {
+        T value = std::move(first[hole]);
+        while (hole > 0)
+        {
+            std::size_t p = parent(hole);
+            if (!comp(first[p], value))
+            {
+                break;
+            }
+            place(first, hole, std::move(first[p]));
+            hole = p;
+        }
+        place(first, hole, std::move(value));
+    }
+
+    template <typename T, typename Compare, typename Place>
+    static void sift_down(T *first, std::size_t hole, std::size_t len, Compare &comp, Place place)
+    {
+        T value = std::move(first[hole]);
+        while (true)
+        {
+            std::size_t child = first_child(hole);
+            if (child >= len)
+            {
+                break;
+            }
+            std::size_t best = best_child(first, child, len, comp);
+            if (!comp(value, first[best]))
+            {
+                break;
+            }
+            place(first, hole, std::move(first[best]));
+            hole = best;
+        }
+        place(first, hole, std::move(value));
+    }
+
+    // 弹出堆顶时放入的元素通常来自底层, 最终位置接近叶子:
+    // 先不与 value 比较, 把空位沿较大的子结点一路移到叶子, 再让 value 从叶子上浮, 比较次数约减半
+    template <typename T, typename Compare, typename Place>
+    static void sift_down_to_leaf(T *first, std::size_t hole, std::size_t len, Compare &comp,
+                                  Place place)
+    {
+        T value = std::move(first[hole]);
+        std::size_t top = hole;
+        std::size_t child = first_child(hole);
+        while (child < len)
+        {
+            std::size_t best = best_child(first, child, len, comp);
+            place(first, hole, std::move(first[best]));
+            hole = best;
+            child = first_child(hole);
+        }
+        while (hole > top)
+        {
+            std::size_t p = parent(hole);
+            if (!comp(first[p], value))
+            {
+                break;
+            }
+            place(first, hole, std::move(first[p]));
+            hole = p;
+        }
+        place(first, hole, std::move(value));
+    }
+
+    // [child, child + Arity) 中最大者; 条件赋值便于编译为无分支的 cmov
+    template <typename T, typename Compare>
+    static std::size_t best_child(T *first, std::size_t child, std::size_t len, Compare &comp)
+    {
+        std::size_t last = child + Arity < len ? child + Arity : len;
+        std::size_t best = child;
+        for (std::size_t c = child + 1; c < last; ++c)
+        {
+            best = comp(first[best], first[c]) ? c : best;
+        }
+        return best;
+    }
+
+    // 自底向上建堆, O(n)
+    template <typename T, typename Compare, typename Place>
+    static void make_heap(T *first, std::size_t len, Compare &comp, Place place)
+    {
+        if (len < 2)
+        {
+            return;
+        }
+        for (std::size_t i = parent(len - 1) + 1; i-- > 0;)
+        {
+            sift_down(first, i, len, comp, place);
+        }
+    }
+};
+
+struct Heap_move_place
+{
+    template <typename T> void operator()(T *first, std::size_t i, T &&value) const
+    {
+        first[i] = std::move(value);
+    }
+};
+
+// 基于 TS::vector 的堆; 与 std::priority_queue 一样 top 为 Compare 意义下的最大元素
+template <typename T, typename Compare = std::less<T>, std::size_t Arity = 2,
+          typename Alloc = alloc>
+class priority_queue
+{
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using value_compare = Compare;
+    using container_type = vector<T, Alloc>;
+
+  protected:
+    using heap = Dary_heap<Arity>;
+    using self = priority_queue<T, Compare, Arity, Alloc>;
+
+  public:
+    priority_queue() = default;
+
+    explicit priority_queue(const Compare &comp) : _comp(comp)
+    {
+    }
+
+    // 接管已有的元素后建堆
+    explicit priority_queue(container_type &&cont, const Compare &comp = Compare())
+        : _c(std::move(cont)), _comp(comp)
+    {
+        heapify();
+    }
+
+    template <typename InputIter, typename = enable_if_not_integral<InputIter>>
+    priority_queue(InputIter first, InputIter last, const Compare &comp = Compare())
+        : _comp(comp)
+    {
+        push_range(first, last);
+    }
+
+    priority_queue(std::initializer_list<T> init, const Compare &comp = Compare())
+        : priority_queue(init.begin(), init.end(), comp)
+    {
+    }
+
+    const_reference top() const
+    {
+        if (empty())
+        {
+            throw std::range_error("empty priority_queue");
+        }
+        return _c.front();
+    }
+
+    bool empty() const
+    {
+        return _c.empty();
+    }
+
+    size_type size() const
+    {
+        return _c.size();
+    }
+
+    void reserve(size_type count)
+    {
+        _c.reserve(count);
+    }
+
+    void clear()
+    {
+        _c.clear();
+    }
+
+    void push(const T &val)
+    {
+        _c.push_back(val);
+        heap::sift_up(_c.data(), _c.size() - 1, _comp, Heap_move_place());
+    }
+
+    void push(T &&val)
+    {
+        _c.push_back(std::move(val));
+        heap::sift_up(_c.data(), _c.size() - 1, _comp, Heap_move_place());
+    }
+
+    template <typename... Args> void emplace(Args &&...args)
+    {
+        _c.emplace_back(std::forward<Args>(args)...);
+        heap::sift_up(_c.data(), _c.size() - 1, _comp, Heap_move_place());
+    }
+
+    // 先追加全部元素; 追加量与原有规模相当时整体重新建堆 (O(n)), 否则逐个上浮
+    template <typename InputIter, typename = enable_if_not_integral<InputIter>>
+    void push_range(InputIter first, InputIter last)
+    {
+        size_type old_size = _c.size();
+        for (; first != last; ++first)
+        {
+            _c.push_back(*first);
+        }
+        size_type added = _c.size() - old_size;
+        if (added > old_size / 2)
+        {
+            heapify();
+        }
+        else
+        {
+            for (size_type i = old_size; i < _c.size(); ++i)
+            {
+                heap::sift_up(_c.data(), i, _comp, Heap_move_place());
+            }
+        }
+    }
+
+    void pop()
+    {
+        if (empty())
+        {
+            throw std::range_error("empty priority_queue");
+        }
+        if (_c.size() > 1)
+        {
+            _c.front() = std::move(_c.back());
+            _c.pop_back();
+            heap::sift_down_to_leaf(_c.data(), 0, _c.size(), _comp, Heap_move_place());
+        }
+        else
+        {
+            _c.pop_back();
+        }
+    }
+
+    // 相当于 pop 后 push, 但只下沉一次; 空队列时等同于 push
+    void pop_push(const T &val)
+    {
+        pop_push_aux(val);
+    }
+
+    void pop_push(T &&val)
+    {
+        pop_push_aux(std::move(val));
+    }
+
+    // 取出堆顶的值并弹出
+    T take_top()
+    {
+        if (empty())
+        {
+            throw std::range_error("empty priority_queue");
+        }
+        T result = std::move(_c.front());
+        pop();
+        return result;
+    }
+
+    // 按堆序 (不是有序) 访问底层元素
+    const container_type &container() const noexcept
+    {
+        return _c;
+    }
+
+    void swap(self &other) noexcept
+    {
+        _c.swap(other._c);
+        std::swap(_comp, other._comp);
+    }
+
+  protected:
+    void heapify()
+    {
+        heap::make_heap(_c.data(), _c.size(), _comp, Heap_move_place());
+    }
+
+    template <typename U> void pop_push_aux(U &&val)
+    {
+        if (empty())
+        {
+            push(std::forward<U>(val));
+            return;
+        }
+        _c.front() = std::forward<U>(val);
+        heap::sift_down_to_leaf(_c.data(), 0, _c.size(), _comp, Heap_move_place());
+    }
+
+  protected:
+    container_type _c;
+    Compare _comp;
+};
+
+// 带索引的堆: 每个元素有一个 [0, n) 中的编号, 可按编号修改优先级或删除, 用于 Dijkstra 与定时器
+// 堆中存放 (键, 编号), 比较时不需要间接访问; _pos 记录每个编号在堆中的位置
+template <typename T, typename Compare = std::less<T>, std::size_t Arity = 2,
+          typename Alloc = alloc>
+class indexed_priority_queue
+{
+  public:
+    using key_type = T;
+    using size_type = std::size_t;
+    using value_compare = Compare;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+  protected:
+    struct Entry
+    {
+        T _key;
+        size_type _id;
+    };
+
+    struct entry_compare
+    {
+        bool operator()(const Entry &lhs, const Entry &rhs)
+        {
+            return comp(lhs._key, rhs._key);
+        }
+
+        Compare comp;
+    };
+
+    // 移动元素的同时更新其编号的位置
+    struct entry_place
+    {
+        void operator()(Entry *first, size_type i, Entry &&entry) const
+        {
+            (*pos)[entry._id] = i;
+            first[i] = std::move(entry);
+        }
+
+        vector<size_type, Alloc> *pos;
+    };
+
+    using heap = Dary_heap<Arity>;
+
+  public:
+    indexed_priority_queue() = default;
+
+    explicit indexed_priority_queue(const Compare &comp) : _comp{comp}
+    {
+    }
+
+    bool empty() const
+    {
+        return _heap.empty();
+    }
+
+    size_type size() const
+    {
+        return _heap.size();
+    }
+
+    // 预留编号 [0, count) 的位置表
+    void reserve(size_type count)
+    {
+        _heap.reserve(count);
+        if (_pos.size() < count)
+        {
+            _pos.resize(count, npos);
+        }
+    }
+
+    bool contains(size_type id) const
+    {
+        return id < _pos.size() && _pos[id] != npos;
+    }
+
+    const T &key(size_type id) const
+    {
+        if (!contains(id))
+        {
+            throw std::out_of_range("indexed_priority_queue: id not present");
+        }
+        return _heap[_pos[id]]._key;
+    }
+
+    const T &top() const
+    {
+        if (empty())
+        {
+            throw std::range_error("empty priority_queue");
+        }
+        return _heap.front()._key;
+    }
+
+    size_type top_id() const
+    {
+        if (empty())
+        {
+            throw std::range_error("empty priority_queue");
+        }
+        return _heap.front()._id;
+    }
+
+    // 编号已存在时抛出 logic_error
+    void push(size_type id, const T &key)
+    {
+        if (contains(id))
+        {
+            throw std::logic_error("indexed_priority_queue: id already present");
+        }
+        if (id >= _pos.size())
+        {
+            _pos.resize(id + 1, npos);
+        }
+        _heap.push_back(Entry{key, id});
+        _pos[id] = _heap.size() - 1;
+        heap::sift_up(_heap.data(), _heap.size() - 1, _comp, entry_place{&_pos});
+    }
+
+    void pop()
+    {
+        erase(top_id());
+    }
+
+    // 修改已有编号的键, 按新键的方向上浮或下沉
+    // 对以 std::greater 组织的最小堆, 键变小即 decrease-key
+    void update(size_type id, const T &key)
+    {
+        if (!contains(id))
+        {
+            throw std::out_of_range("indexed_priority_queue: id not present");
+        }
+        size_type i = _pos[id];
+        bool up = _comp.comp(_heap[i]._key, key);
+        _heap[i]._key = key;
+        if (up)
+        {
+            heap::sift_up(_heap.data(), i, _comp, entry_place{&_pos});
+        }
+        else
+        {
+            heap::sift_down(_heap.data(), i, _heap.size(), _comp, entry_place{&_pos});
+        }
+    }
+
+    // 不存在则插入, 否则修改
+    void push_or_update(size_type id, const T &key)
+    {
+        if (contains(id))
+        {
+            update(id, key);
+        }
+        else
+        {
+            push(id, key);
+        }
+    }
+
+    // 删除编号 id; 不存在时返回 false
+    bool erase(size_type id)
+    {
+        if (!contains(id))
+        {
+            return false;
+        }
+        size_type i = _pos[id];
+        size_type last = _heap.size() - 1;
+        _pos[id] = npos;
+        if (i != last)
+        {
+            bool up = _comp(_heap[i], _heap[last]);
+            _heap[i] = std::move(_heap[last]);
+            _heap.pop_back();
+            _pos[_heap[i]._id] = i;
+            if (up)
+            {
+                heap::sift_up(_heap.data(), i, _comp, entry_place{&_pos});
+            }
+            else
+            {
+                heap::sift_down(_heap.data(), i, _heap.size(), _comp, entry_place{&_pos});
+            }
+        }
+        else
+        {
+            _heap.pop_back();
+        }
+        return true;
+    }
+
+    void clear()
+    {
+        for (const Entry &entry : _heap)
+        {
+            _pos[entry._id] = npos;
+        }
+        _heap.clear();
+    }
+
+  protected:
+    vector<Entry, Alloc> _heap;
+    vector<size_type, Alloc> _pos;
+    entry_compare _comp;
+};
+
+} // namespace TS
+
+#endif
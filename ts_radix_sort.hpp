@@ -0,0 +1,728 @@
+#ifndef TS_RADIX_SORT_HPP
+#define TS_RADIX_SORT_HPP
+
+#include "ts_alloc.hpp"
+#include "ts_iterator.hpp"
+#include "ts_parallel.hpp"
+#include "ts_uninitialized.hpp"
+#include "ts_vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// 基数排序, 不做比较, 时间与元素数成线性
+// 数值键 (整数, float, double, 或由 key(value) 取出的数值): LSD, 按字节分 8 位一趟, 稳定
+//   一次读遍历求出所有字节的直方图; 某字节在全部元素中都相同时跳过该趟
+// 字符串 (std::string, TS::string 等有 data()/size() 的单字节字符序列): MSD, 按无符号字节序, 稳定
+// 辅助缓冲区由 simple_alloc 分配; key 不应抛出异常
+
+namespace TS
+{
+const std::size_t RADIX_BUCKETS = 256;
+// 不超过该长度的区间改用插入排序
+const std::size_t RADIX_SMALL_SORT = 64;
+
+// 键到无符号整数的保序映射: 映射后按无符号比较的顺序与原键的顺序一致
+template <typename K, typename = void> struct radix_key_traits;
+
+template <typename K>
+struct radix_key_traits<K, typename std::enable_if<std::is_integral<K>::value &&
+                                                   std::is_unsigned<K>::value>::type>
+{
+    using bits_type = K;
+
+    static bits_type to_bits(K key) noexcept
+    {
+        return key;
+    }
+};
+
+// 有符号整数翻转符号位
+template <typename K>
+struct radix_key_traits<K, typename std::enable_if<std::is_integral<K>::value &&
+                                                   std::is_signed<K>::value>::type>
+{
+    using bits_type = typename std::make_unsigned<K>::type;
+
+    static bits_type to_bits(K key) noexcept
+    {
+        return bits_type(key) ^ (bits_type(1) << (sizeof(K) * 8 - 1));
+    }
+};
+
+// 浮点数: 正数翻转符号位, 负数翻转全部位; -0.0 排在 +0.0 前, NaN 按符号排在两端
+template <typename K, typename Bits> struct radix_float_traits
+{
+    static_assert(sizeof(K) == sizeof(Bits), "floating point layout mismatch");
+
+    using bits_type = Bits;
+
+    static bits_type to_bits(K key) noexcept
+    {
+        bits_type bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        bits_type sign = bits_type(1) << (sizeof(Bits) * 8 - 1);
+        return bits ^ ((bits & sign) != 0 ? bits_type(~bits_type(0)) : sign);
+    }
+};
+
+template <> struct radix_key_traits<float> : radix_float_traits<float, std::uint32_t>
+{
+};
+
+template <> struct radix_key_traits<double> : radix_float_traits<double, std::uint64_t>
+{
+};
+
+struct radix_identity
+{
+    template <typename T> const T &operator()(const T &val) const noexcept
+    {
+        return val;
+    }
+};
+
+// 有 data() 与 size() 且字符为单字节的类型按字符串处理
+template <typename T, typename = void> struct is_radix_string : std::false_type
+{
+};
+
+template <typename T>
+struct is_radix_string<T, std::void_t<decltype(std::declval<const T &>().data()),
+                                      decltype(std::declval<const T &>().size())>>
+    : std::integral_constant<bool, sizeof(*std::declval<const T &>().data()) == 1>
+{
+};
+
+// 缓冲区, 元素的构造方式:
+// 平凡可复制: 不构造, 直接作为原始内存写入
+// 移动构造不抛异常: 第一次写入缓冲区时以移动构造填入, 之后赋值
+// 其他: 先复制构造一份, 写入过程中抛出异常时原区间仍保留全部元素
+template <typename T> class radix_buffer
+{
+  protected:
+    using buffer_allocator = simple_alloc<T, alloc>;
+    using trivial = std::is_trivially_copyable<T>;
+    using deferred = std::integral_constant<bool, std::is_trivially_copyable<T>::value ||
+                                                      std::is_nothrow_move_constructible<T>::value>;
+
+  public:
+    template <typename RandomIter>
+    radix_buffer(RandomIter first, std::size_t count)
+        : _data(buffer_allocator::allocate(count)), _count(count), _constructed(false)
+    {
+        init(first, deferred());
+    }
+
+    radix_buffer(const radix_buffer &) = delete;
+    radix_buffer &operator=(const radix_buffer &) = delete;
+
+    ~radix_buffer()
+    {
+        if (_constructed)
+        {
+            release(trivial());
+        }
+        buffer_allocator::deallocate(_data, _count);
+    }
+
+    T *data() const noexcept
+    {
+        return _data;
+    }
+
+    // 下一次写入缓冲区时是否需要构造元素
+    bool raw() const noexcept
+    {
+        return !trivial::value && !_constructed;
+    }
+
+    void mark_constructed() noexcept
+    {
+        _constructed = true;
+    }
+
+  protected:
+    template <typename RandomIter> void init(RandomIter, std::true_type) noexcept
+    {
+    }
+
+    template <typename RandomIter> void init(RandomIter first, std::false_type)
+    {
+        try
+        {
+            TS::uninitialized_copy(first, first + _count, _data);
+        }
+        catch (...)
+        {
+            buffer_allocator::deallocate(_data, _count);
+            throw;
+        }
+        _constructed = true;
+    }
+
+    void release(std::true_type) noexcept
+    {
+    }
+
+    void release(std::false_type) noexcept
+    {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+            TS::destroy(_data + i);
+        }
+    }
+
+  protected:
+    T *_data;
+    std::size_t _count;
+    bool _constructed;
+};
+
+// 写入缓冲区的原始内存时构造, 否则赋值
+template <typename T, typename U> inline void radix_place(T *dst, U &&val, std::true_type)
+{
+    construct(dst, std::forward<U>(val));
+}
+
+template <typename Iter, typename U> inline void radix_place(Iter dst, U &&val, std::false_type)
+{
+    *dst = std::forward<U>(val);
+}
+
+// ---------------------------------------------------------------------------------------------
+// LSD
+
+template <typename KeyFunc, typename T> struct radix_key_of
+{
+    using key_type = typename std::decay<decltype(std::declval<KeyFunc &>()(
+        std::declval<const T &>()))>::type;
+    using traits = radix_key_traits<key_type>;
+    using bits_type = typename traits::bits_type;
+
+    static const std::size_t passes = sizeof(bits_type);
+};
+
+template <typename RandomIter, typename KeyFunc>
+using radix_bits_of =
+    radix_key_of<KeyFunc, typename iterator_traits<RandomIter>::value_type>;
+
+// 按映射后的键插入排序, 与基数排序的顺序一致且稳定
+template <typename RandomIter, typename KeyFunc>
+void radix_insertion_sort(RandomIter first, RandomIter last, KeyFunc &key)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    using traits = typename radix_bits_of<RandomIter, KeyFunc>::traits;
+    if (first == last)
+    {
+        return;
+    }
+    for (RandomIter i = first + 1; i != last; ++i)
+    {
+        auto bits = traits::to_bits(key(*i));
+        if (!(bits < traits::to_bits(key(*(i - 1)))))
+        {
+            continue;
+        }
+        value_type val = std::move(*i);
+        RandomIter j = i;
+        do
+        {
+            *j = std::move(*(j - 1));
+            --j;
+        } while (j != first && bits < traits::to_bits(key(*(j - 1))));
+        *j = std::move(val);
+    }
+}
+
+// counts[p * RADIX_BUCKETS + d] 累加 [first, last) 中第 p 个字节为 d 的个数
+template <typename RandomIter, typename KeyFunc>
+void radix_histogram(RandomIter first, RandomIter last, KeyFunc &key, std::size_t *counts)
+{
+    using bits = radix_bits_of<RandomIter, KeyFunc>;
+    for (; first != last; ++first)
+    {
+        typename bits::bits_type b = bits::traits::to_bits(key(*first));
+        for (std::size_t p = 0; p < bits::passes; ++p)
+        {
+            ++counts[p * RADIX_BUCKETS + ((b >> (8 * p)) & 0xff)];
+        }
+    }
+}
+
+// 只统计一个字节
+template <typename RandomIter, typename KeyFunc>
+void radix_digit_histogram(RandomIter first, RandomIter last, KeyFunc &key, std::size_t shift,
+                           std::size_t *counts)
+{
+    using bits = radix_bits_of<RandomIter, KeyFunc>;
+    for (; first != last; ++first)
+    {
+        ++counts[(bits::traits::to_bits(key(*first)) >> shift) & 0xff];
+    }
+}
+
+// 按第 shift 位起的字节把 [first, last) 分配到 dst, offsets 为各桶的写入位置
+template <typename SrcIter, typename DstIter, typename KeyFunc, typename Construct>
+void radix_scatter(SrcIter first, SrcIter last, DstIter dst, KeyFunc &key, std::size_t shift,
+                   std::size_t *offsets, Construct construct)
+{
+    using bits = radix_bits_of<SrcIter, KeyFunc>;
+    for (; first != last; ++first)
+    {
+        std::size_t digit = (bits::traits::to_bits(key(*first)) >> shift) & 0xff;
+        radix_place(dst + offsets[digit]++, std::move(*first), construct);
+    }
+}
+
+// 某趟所有元素的字节相同时不必分配
+inline bool radix_pass_needed(const std::size_t *counts, std::size_t count) noexcept
+{
+    for (std::size_t d = 0; d < RADIX_BUCKETS; ++d)
+    {
+        if (counts[d] != 0)
+        {
+            return counts[d] != count;
+        }
+    }
+    return false;
+}
+
+template <typename RandomIter, typename KeyFunc>
+void radix_sort_lsd(RandomIter first, RandomIter last, KeyFunc key)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    using bits = radix_bits_of<RandomIter, KeyFunc>;
+    std::size_t count = last - first;
+    if (count <= RADIX_SMALL_SORT)
+    {
+        radix_insertion_sort(first, last, key);
+        return;
+    }
+
+    std::size_t counts[bits::passes * RADIX_BUCKETS] = {};
+    radix_histogram(first, last, key, counts);
+    std::size_t active[bits::passes];
+    std::size_t active_count = 0;
+    for (std::size_t p = 0; p < bits::passes; ++p)
+    {
+        if (radix_pass_needed(counts + p * RADIX_BUCKETS, count))
+        {
+            active[active_count++] = p;
+        }
+    }
+    if (active_count == 0)
+    {
+        return;
+    }
+
+    radix_buffer<value_type> buffer(first, count);
+    value_type *scratch = buffer.data();
+    bool in_buffer = false;
+    for (std::size_t a = 0; a < active_count; ++a, in_buffer = !in_buffer)
+    {
+        std::size_t p = active[a];
+        std::size_t offsets[RADIX_BUCKETS];
+        std::size_t sum = 0;
+        for (std::size_t d = 0; d < RADIX_BUCKETS; ++d)
+        {
+            offsets[d] = sum;
+            sum += counts[p * RADIX_BUCKETS + d];
+        }
+        if (in_buffer)
+        {
+            radix_scatter(scratch, scratch + count, first, key, 8 * p, offsets, std::false_type());
+        }
+        else if (buffer.raw())
+        {
+            radix_scatter(first, last, scratch, key, 8 * p, offsets, std::true_type());
+            buffer.mark_constructed();
+        }
+        else
+        {
+            radix_scatter(first, last, scratch, key, 8 * p, offsets, std::false_type());
+        }
+    }
+    if (in_buffer)
+    {
+        std::move(scratch, scratch + count, first);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------
+// MSD
+
+// 第 depth 个字节加一, 已结束的字符串为 0, 使短串排在以它为前缀的长串之前
+template <typename Str> inline std::size_t radix_string_digit(const Str &s, std::size_t depth)
+{
+    return depth < s.size() ? std::size_t(static_cast<unsigned char>(s.data()[depth])) + 1 : 0;
+}
+
+// 已知前 depth 个字节相同, 比较其后部分
+template <typename Str> inline bool radix_string_less(const Str &a, const Str &b, std::size_t depth)
+{
+    std::size_t len_a = a.size() - depth;
+    std::size_t len_b = b.size() - depth;
+    int cmp = std::memcmp(a.data() + depth, b.data() + depth, len_a < len_b ? len_a : len_b);
+    return cmp < 0 || (cmp == 0 && len_a < len_b);
+}
+
+template <typename RandomIter>
+void radix_string_insertion_sort(RandomIter first, RandomIter last, std::size_t depth)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    if (first == last)
+    {
+        return;
+    }
+    for (RandomIter i = first + 1; i != last; ++i)
+    {
+        if (!radix_string_less(*i, *(i - 1), depth))
+        {
+            continue;
+        }
+        value_type val = std::move(*i);
+        RandomIter j = i;
+        do
+        {
+            *j = std::move(*(j - 1));
+            --j;
+        } while (j != first && radix_string_less(val, *(j - 1), depth));
+        *j = std::move(val);
+    }
+}
+
+// 按第 depth 个字节把 [first, first + count) 分桶, 经 scratch 写回原处; bounds 得到 258 个桶边界
+template <typename RandomIter, typename T, typename Construct>
+void radix_string_partition(RandomIter first, std::size_t count, T *scratch, std::size_t depth,
+                            std::size_t *bounds, Construct construct)
+{
+    const std::size_t buckets = RADIX_BUCKETS + 1;
+    std::size_t counts[buckets] = {};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ++counts[radix_string_digit(first[i], depth)];
+    }
+    std::size_t offsets[buckets];
+    std::size_t sum = 0;
+    for (std::size_t d = 0; d < buckets; ++d)
+    {
+        bounds[d] = offsets[d] = sum;
+        sum += counts[d];
+    }
+    bounds[buckets] = sum;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        radix_place(scratch + offsets[radix_string_digit(first[i], depth)]++, std::move(first[i]),
+                    construct);
+    }
+    std::move(scratch, scratch + count, first);
+}
+
+// 显式栈代替递归, 公共前缀很长时也不会栈溢出; scratch 中对应 [first, last) 的元素须已构造
+template <typename RandomIter, typename T>
+void radix_sort_msd_from(RandomIter first, RandomIter last, T *scratch, std::size_t depth)
+{
+    struct range
+    {
+        std::size_t lo, hi, depth;
+    };
+    vector<range> stack;
+    stack.push_back(range{0, std::size_t(last - first), depth});
+    std::size_t bounds[RADIX_BUCKETS + 2];
+    while (!stack.empty())
+    {
+        range r = stack.back();
+        stack.pop_back();
+        std::size_t count = r.hi - r.lo;
+        if (count <= RADIX_SMALL_SORT)
+        {
+            radix_string_insertion_sort(first + r.lo, first + r.hi, r.depth);
+            continue;
+        }
+        radix_string_partition(first + r.lo, count, scratch + r.lo, r.depth, bounds,
+                               std::false_type());
+        // 桶 0 中的字符串已经结束, 彼此相等
+        for (std::size_t d = 1; d <= RADIX_BUCKETS; ++d)
+        {
+            if (bounds[d + 1] - bounds[d] > 1)
+            {
+                stack.push_back(range{r.lo + bounds[d], r.lo + bounds[d + 1], r.depth + 1});
+            }
+        }
+    }
+}
+
+// 按首字节分桶, 同时构造缓冲区中的元素
+template <typename RandomIter, typename T>
+void radix_string_partition_first(RandomIter first, std::size_t count, radix_buffer<T> &buffer,
+                                  std::size_t *bounds)
+{
+    if (buffer.raw())
+    {
+        radix_string_partition(first, count, buffer.data(), 0, bounds, std::true_type());
+        buffer.mark_constructed();
+    }
+    else
+    {
+        radix_string_partition(first, count, buffer.data(), 0, bounds, std::false_type());
+    }
+}
+
+template <typename RandomIter> void radix_sort_msd(RandomIter first, RandomIter last)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    std::size_t count = last - first;
+    if (count <= RADIX_SMALL_SORT)
+    {
+        radix_string_insertion_sort(first, last, 0);
+        return;
+    }
+    radix_buffer<value_type> buffer(first, count);
+    std::size_t bounds[RADIX_BUCKETS + 2];
+    radix_string_partition_first(first, count, buffer, bounds);
+    for (std::size_t d = 1; d <= RADIX_BUCKETS; ++d)
+    {
+        if (bounds[d + 1] - bounds[d] > 1)
+        {
+            radix_sort_msd_from(first + bounds[d], first + bounds[d + 1],
+                                buffer.data() + bounds[d], 1);
+        }
+    }
+}
+
+template <typename RandomIter>
+void radix_sort_aux(RandomIter first, RandomIter last, std::true_type)
+{
+    radix_sort_msd(first, last);
+}
+
+template <typename RandomIter>
+void radix_sort_aux(RandomIter first, RandomIter last, std::false_type)
+{
+    radix_sort_lsd(first, last, radix_identity());
+}
+
+// 数值按升序, 字符串按无符号字节的字典序; 稳定
+template <typename RandomIter> void radix_sort(RandomIter first, RandomIter last)
+{
+    parallel::require_random_access<RandomIter>();
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    radix_sort_aux(first, last, is_radix_string<value_type>());
+}
+
+// 按 key(value) 返回的数值升序排列, 用于结构体; key 会对每个元素调用多次, 应当廉价
+template <typename RandomIter, typename KeyFunc>
+void radix_sort(RandomIter first, RandomIter last, KeyFunc key)
+{
+    parallel::require_random_access<RandomIter>();
+    radix_sort_lsd(first, last, key);
+}
+
+namespace parallel
+{
+// 并行 LSD: 每趟先由各块并行统计本块该字节的直方图, 按 (字节, 块) 顺序求前缀得到各块的写入位置,
+// 再由各块并行分配, 块内保持原顺序, 因此仍然稳定
+template <typename RandomIter, typename KeyFunc>
+void radix_sort_lsd(const policy &pol, RandomIter first, RandomIter last, KeyFunc key)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    using bits = radix_bits_of<RandomIter, KeyFunc>;
+    std::size_t count = last - first;
+    std::size_t chunks = std::min(pol.chunk_count(count), pol.concurrency());
+    if (chunks <= 1)
+    {
+        TS::radix_sort_lsd(first, last, key);
+        return;
+    }
+
+    vector<std::size_t> bounds;
+    for (std::size_t i = 0; i <= chunks; ++i)
+    {
+        bounds.push_back(chunk_begin(count, chunks, i));
+    }
+
+    // 第一次统计全部字节, 既用于判断可跳过的趟, 也是第一趟的各块直方图
+    const std::size_t all_digits = bits::passes * RADIX_BUCKETS;
+    vector<std::size_t> counts(chunks * all_digits, 0);
+    auto histogram_task = [&](std::size_t c) {
+        radix_histogram(first + bounds[c], first + bounds[c + 1], key, &counts[c * all_digits]);
+    };
+    run_tasks(pol, chunks, histogram_task);
+
+    std::size_t active[bits::passes];
+    std::size_t active_count = 0;
+    for (std::size_t p = 0; p < bits::passes; ++p)
+    {
+        std::size_t total[RADIX_BUCKETS] = {};
+        for (std::size_t c = 0; c < chunks; ++c)
+        {
+            for (std::size_t d = 0; d < RADIX_BUCKETS; ++d)
+            {
+                total[d] += counts[c * all_digits + p * RADIX_BUCKETS + d];
+            }
+        }
+        if (radix_pass_needed(total, count))
+        {
+            active[active_count++] = p;
+        }
+    }
+    if (active_count == 0)
+    {
+        return;
+    }
+
+    radix_buffer<value_type> buffer(first, count);
+    value_type *scratch = buffer.data();
+    // 每趟每块一行, 先存直方图, 再原地改为写入位置
+    vector<std::size_t> offsets(chunks * RADIX_BUCKETS, 0);
+    bool in_buffer = false;
+    for (std::size_t a = 0; a < active_count; ++a, in_buffer = !in_buffer)
+    {
+        std::size_t p = active[a];
+        std::size_t shift = 8 * p;
+        if (a == 0)
+        {
+            for (std::size_t c = 0; c < chunks; ++c)
+            {
+                const std::size_t *row = counts.data() + c * all_digits + p * RADIX_BUCKETS;
+                std::copy(row, row + RADIX_BUCKETS, offsets.data() + c * RADIX_BUCKETS);
+            }
+        }
+        else
+        {
+            // 上一趟之后元素已移动, 各块的直方图需要重新统计
+            std::fill(offsets.begin(), offsets.end(), std::size_t(0));
+            auto digit_task = [&](std::size_t c) {
+                std::size_t *row = &offsets[c * RADIX_BUCKETS];
+                if (in_buffer)
+                {
+                    radix_digit_histogram(scratch + bounds[c], scratch + bounds[c + 1], key, shift,
+                                          row);
+                }
+                else
+                {
+                    radix_digit_histogram(first + bounds[c], first + bounds[c + 1], key, shift,
+                                          row);
+                }
+            };
+            run_tasks(pol, chunks, digit_task);
+        }
+
+        std::size_t sum = 0;
+        for (std::size_t d = 0; d < RADIX_BUCKETS; ++d)
+        {
+            for (std::size_t c = 0; c < chunks; ++c)
+            {
+                std::size_t n = offsets[c * RADIX_BUCKETS + d];
+                offsets[c * RADIX_BUCKETS + d] = sum;
+                sum += n;
+            }
+        }
+
+        bool raw = !in_buffer && buffer.raw();
+        auto scatter_task = [&](std::size_t c) {
+            std::size_t *row = &offsets[c * RADIX_BUCKETS];
+            if (in_buffer)
+            {
+                radix_scatter(scratch + bounds[c], scratch + bounds[c + 1], first, key, shift,
+                              row, std::false_type());
+            }
+            else if (raw)
+            {
+                radix_scatter(first + bounds[c], first + bounds[c + 1], scratch, key, shift,
+                              row, std::true_type());
+            }
+            else
+            {
+                radix_scatter(first + bounds[c], first + bounds[c + 1], scratch, key, shift,
+                              row, std::false_type());
+            }
+        };
+        run_tasks(pol, chunks, scatter_task);
+        if (raw)
+        {
+            buffer.mark_constructed();
+        }
+    }
+    if (in_buffer)
+    {
+        auto move_task = [&](std::size_t c) {
+            std::move(scratch + bounds[c], scratch + bounds[c + 1], first + bounds[c]);
+        };
+        run_tasks(pol, chunks, move_task);
+    }
+}
+
+// 并行 MSD: 首字节分桶后各桶独立排序
+template <typename RandomIter>
+void radix_sort_msd(const policy &pol, RandomIter first, RandomIter last)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    std::size_t count = last - first;
+    if (pol.concurrency() <= 1 || count <= pol.grain())
+    {
+        TS::radix_sort_msd(first, last);
+        return;
+    }
+    radix_buffer<value_type> buffer(first, count);
+    value_type *scratch = buffer.data();
+    std::size_t bounds[RADIX_BUCKETS + 2];
+    radix_string_partition_first(first, count, buffer, bounds);
+    auto bucket_task = [&](std::size_t d) {
+        std::size_t lo = bounds[d + 1];
+        std::size_t hi = bounds[d + 2];
+        if (hi - lo > 1)
+        {
+            radix_sort_msd_from(first + lo, first + hi, scratch + lo, 1);
+        }
+    };
+    run_tasks(pol, RADIX_BUCKETS, bucket_task);
+}
+
+template <typename RandomIter>
+void radix_sort_aux(const policy &pol, RandomIter first, RandomIter last, std::true_type)
+{
+    parallel::radix_sort_msd(pol, first, last);
+}
+
+template <typename RandomIter>
+void radix_sort_aux(const policy &pol, RandomIter first, RandomIter last, std::false_type)
+{
+    parallel::radix_sort_lsd(pol, first, last, radix_identity());
+}
+
+template <typename RandomIter>
+void radix_sort(const policy &pol, RandomIter first, RandomIter last)
+{
+    require_random_access<RandomIter>();
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    parallel::radix_sort_aux(pol, first, last, is_radix_string<value_type>());
+}
+
+template <typename RandomIter, typename KeyFunc>
+void radix_sort(const policy &pol, RandomIter first, RandomIter last, KeyFunc key)
+{
+    require_random_access<RandomIter>();
+    parallel::radix_sort_lsd(pol, first, last, key);
+}
+
+template <typename RandomIter> void radix_sort(RandomIter first, RandomIter last)
+{
+    parallel::radix_sort(policy(), first, last);
+}
+
+template <typename RandomIter, typename KeyFunc>
+void radix_sort(RandomIter first, RandomIter last, KeyFunc key)
+{
+    parallel::radix_sort(policy(), first, last, key);
+}
+
+} // namespace parallel
+} // namespace TS
+
+#endif
@@ -0,0 +1,437 @@
+#ifndef TS_RECLAIM_HPP
+#define TS_RECLAIM_HPP
+
+#include "ts_alloc.hpp"
+#include "ts_vector.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+// 无锁容器的安全内存回收: 从结构中摘下的节点不能立即释放, 因为其他线程可能仍在读取
+// epoch_domain: 基于纪元, 读端只需进出临界区, 开销最低, 但一个停滞的读者会阻止所有回收
+// hazard_domain: 基于风险指针, 读端逐个发布正在访问的指针, 开销较高, 未回收对象数有上界
+
+namespace TS
+{
+// 待回收的对象及其回收函数
+struct retired_ptr
+{
+    void *ptr;
+    void (*reclaim)(void *);
+};
+
+// 默认回收函数: 析构对象并把内存还给 simple_alloc<T, Alloc>
+template <typename T, typename Alloc> void reclaim_object(void *p)
+{
+    T *obj = static_cast<T *>(p);
+    destroy(obj);
+    simple_alloc<T, Alloc>::deallocate(obj);
+}
+
+inline void reclaim_all(vector<retired_ptr> &list)
+{
+    for (retired_ptr &r : list)
+    {
+        r.reclaim(r.ptr);
+    }
+    list.clear();
+}
+
+// 线程记录的注册表: 记录只增不减, 域析构时统一释放; 线程用完后归还, 可被其他线程复用
+// Record 须含 std::atomic<bool> _in_use 与 Record *_next
+template <typename Record> class reclaim_registry
+{
+  protected:
+    using record_allocator = simple_alloc<Record, alloc>;
+
+    // 每个线程缓存上次使用的记录, 以域编号识别; 编号不复用, 域析构后缓存自然失效
+    struct thread_cache
+    {
+        std::uint64_t id;
+        Record *record;
+    };
+
+  public:
+    reclaim_registry() : _head(nullptr), _count(0), _id(next_id())
+    {
+    }
+
+    reclaim_registry(const reclaim_registry &) = delete;
+    reclaim_registry &operator=(const reclaim_registry &) = delete;
+
+    ~reclaim_registry()
+    {
+        Record *rec = _head.load(std::memory_order_relaxed);
+        while (rec != nullptr)
+        {
+            Record *next = rec->_next;
+            destroy(rec);
+            record_allocator::deallocate(rec);
+            rec = next;
+        }
+    }
+
+    Record *acquire()
+    {
+        thread_cache &cache = local_cache();
+        if (cache.id == _id && try_acquire(cache.record))
+        {
+            return cache.record;
+        }
+        Record *rec = _head.load(std::memory_order_acquire);
+        for (; rec != nullptr; rec = rec->_next)
+        {
+            if (try_acquire(rec))
+            {
+                break;
+            }
+        }
+        if (rec == nullptr)
+        {
+            rec = record_allocator::allocate();
+            construct(rec);
+            rec->_in_use.store(true, std::memory_order_relaxed);
+            rec->_next = _head.load(std::memory_order_relaxed);
+            while (!_head.compare_exchange_weak(rec->_next, rec, std::memory_order_release,
+                                                std::memory_order_relaxed))
+            {
+            }
+            _count.fetch_add(1, std::memory_order_relaxed);
+        }
+        cache.id = _id;
+        cache.record = rec;
+        return rec;
+    }
+
+    void release(Record *rec) noexcept
+    {
+        rec->_in_use.store(false, std::memory_order_release);
+    }
+
+    // 遍历全部记录, 包括未被占用的
+    template <typename Func> void for_each(Func func) const
+    {
+        for (Record *rec = _head.load(std::memory_order_acquire); rec != nullptr;
+             rec = rec->_next)
+        {
+            func(*rec);
+        }
+    }
+
+    std::size_t size() const noexcept
+    {
+        return _count.load(std::memory_order_relaxed);
+    }
+
+  protected:
+    static bool try_acquire(Record *rec) noexcept
+    {
+        return !rec->_in_use.load(std::memory_order_relaxed) &&
+               !rec->_in_use.exchange(true, std::memory_order_acquire);
+    }
+
+    static thread_cache &local_cache() noexcept
+    {
+        static thread_local thread_cache cache = {0, nullptr};
+        return cache;
+    }
+
+    static std::uint64_t next_id() noexcept
+    {
+        static std::atomic<std::uint64_t> counter(0);
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+  protected:
+    std::atomic<Record *> _head;
+    std::atomic<std::size_t> _count;
+    std::uint64_t _id;
+};
+
+// ---------------------------------------------------------------------------------------------
+// 基于纪元的回收
+
+// 每个线程记录的待回收对象达到该数量时尝试推进纪元并回收
+const std::size_t EPOCH_RETIRE_BATCH = 64;
+
+struct epoch_record
+{
+    epoch_record() : _epoch(0), _in_use(false), _next(nullptr), _bag_epoch{0, 0, 0}, _retired(0)
+    {
+    }
+
+    ~epoch_record()
+    {
+        for (vector<retired_ptr> &bag : _bags)
+        {
+            reclaim_all(bag);
+        }
+    }
+
+    std::atomic<std::uint64_t> _epoch; // 在临界区内为 (纪元 << 1) | 1, 否则为 0
+    std::atomic<bool> _in_use;
+    epoch_record *_next;
+    std::uint64_t _bag_epoch[3]; // 各袋中对象被摘下时的全局纪元
+    vector<retired_ptr> _bags[3];
+    std::size_t _retired;
+};
+
+class epoch_guard;
+
+// 全局纪元只有在所有临界区内的线程都已进入当前纪元时才能推进;
+// 在纪元 e 摘下的对象, 在全局纪元到达 e + 2 后不再被任何线程引用
+class epoch_domain
+{
+    friend class epoch_guard;
+
+  public:
+    epoch_domain() : _epoch(2)
+    {
+    }
+
+    // 析构时不能有线程处于临界区, 剩余对象全部回收
+    ~epoch_domain() = default;
+
+    std::uint64_t epoch() const noexcept
+    {
+        return _epoch.load(std::memory_order_acquire);
+    }
+
+    // 所有临界区内的线程都已进入当前纪元时推进一次
+    bool try_advance() noexcept
+    {
+        std::uint64_t current = _epoch.load(std::memory_order_seq_cst);
+        bool ready = true;
+        _records.for_each([current, &ready](const epoch_record &rec) {
+            std::uint64_t local = rec._epoch.load(std::memory_order_seq_cst);
+            if ((local & 1) != 0 && (local >> 1) != current)
+            {
+                ready = false;
+            }
+        });
+        return ready && _epoch.compare_exchange_strong(current, current + 1,
+                                                       std::memory_order_seq_cst);
+    }
+
+  protected:
+    // 回收 rec 中已经安全的袋
+    void collect(epoch_record &rec) noexcept
+    {
+        std::uint64_t current = _epoch.load(std::memory_order_acquire);
+        for (int i = 0; i < 3; ++i)
+        {
+            if (!rec._bags[i].empty() && rec._bag_epoch[i] + 2 <= current)
+            {
+                rec._retired -= rec._bags[i].size();
+                reclaim_all(rec._bags[i]);
+            }
+        }
+    }
+
+  protected:
+    alignas(64) std::atomic<std::uint64_t> _epoch;
+    reclaim_registry<epoch_record> _records;
+};
+
+// 临界区: 存活期间通过该域读取的节点不会被回收; 同一线程可以嵌套, 但应尽量短
+class epoch_guard
+{
+  public:
+    explicit epoch_guard(epoch_domain &domain) : _domain(domain), _rec(domain._records.acquire())
+    {
+        std::uint64_t current = _domain._epoch.load(std::memory_order_relaxed);
+        // 读写型原子操作兼作全屏障: 之后对共享结构的读取不会提前到发布纪元之前
+        _rec->_epoch.exchange((current << 1) | 1, std::memory_order_seq_cst);
+    }
+
+    epoch_guard(const epoch_guard &) = delete;
+    epoch_guard &operator=(const epoch_guard &) = delete;
+
+    ~epoch_guard()
+    {
+        _rec->_epoch.store(0, std::memory_order_release);
+        _domain._records.release(_rec);
+    }
+
+    // p 须已从共享结构中摘下
+    void retire(void *p, void (*reclaim)(void *))
+    {
+        std::uint64_t current = _domain._epoch.load(std::memory_order_seq_cst);
+        std::size_t index = current % 3;
+        if (_rec->_bag_epoch[index] != current)
+        {
+            // 袋中是 current - 3 或更早的对象, 已经安全
+            _rec->_retired -= _rec->_bags[index].size();
+            reclaim_all(_rec->_bags[index]);
+            _rec->_bag_epoch[index] = current;
+        }
+        _rec->_bags[index].push_back(retired_ptr{p, reclaim});
+        if (++_rec->_retired >= EPOCH_RETIRE_BATCH)
+        {
+            _domain.try_advance();
+            _domain.collect(*_rec);
+        }
+    }
+
+    template <typename T, typename Alloc = alloc> void retire(T *p)
+    {
+        retire(p, &reclaim_object<T, Alloc>);
+    }
+
+  protected:
+    epoch_domain &_domain;
+    epoch_record *_rec;
+};
+
+// ---------------------------------------------------------------------------------------------
+// 风险指针
+
+// 每个线程记录同时可发布的风险指针个数
+const std::size_t HAZARD_SLOTS = 4;
+// 待回收对象的扫描阈值下限; 实际阈值随记录数增长, 保证每次扫描能回收一批对象
+const std::size_t HAZARD_RETIRE_BATCH = 64;
+
+struct hazard_record
+{
+    hazard_record() : _in_use(false), _next(nullptr)
+    {
+        for (std::atomic<const void *> &slot : _slots)
+        {
+            slot.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~hazard_record()
+    {
+        reclaim_all(_retired);
+    }
+
+    std::atomic<const void *> _slots[HAZARD_SLOTS];
+    std::atomic<bool> _in_use;
+    hazard_record *_next;
+    vector<retired_ptr> _retired;
+};
+
+class hazard_guard;
+
+// 对象被摘下后, 只要没有任何线程的风险指针指向它即可回收
+class hazard_domain
+{
+    friend class hazard_guard;
+
+  public:
+    hazard_domain() = default;
+
+    // 析构时不能有线程持有 hazard_guard, 剩余对象全部回收
+    ~hazard_domain() = default;
+
+  protected:
+    // 回收 rec 中不被任何风险指针引用的对象
+    void scan(hazard_record &rec)
+    {
+        vector<const void *> hazards;
+        _records.for_each([&hazards](const hazard_record &other) {
+            for (const std::atomic<const void *> &slot : other._slots)
+            {
+                const void *p = slot.load(std::memory_order_seq_cst);
+                if (p != nullptr)
+                {
+                    hazards.push_back(p);
+                }
+            }
+        });
+        std::sort(hazards.begin(), hazards.end());
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < rec._retired.size(); ++i)
+        {
+            retired_ptr r = rec._retired[i];
+            if (std::binary_search(hazards.begin(), hazards.end(),
+                                   static_cast<const void *>(r.ptr)))
+            {
+                rec._retired[kept++] = r;
+            }
+            else
+            {
+                r.reclaim(r.ptr);
+            }
+        }
+        rec._retired.erase(rec._retired.begin() + kept, rec._retired.end());
+    }
+
+    std::size_t scan_threshold() const noexcept
+    {
+        return std::max(HAZARD_RETIRE_BATCH, 2 * HAZARD_SLOTS * _records.size());
+    }
+
+  protected:
+    reclaim_registry<hazard_record> _records;
+};
+
+// 持有一个线程记录; 通过 protect 发布正在访问的指针
+class hazard_guard
+{
+  public:
+    explicit hazard_guard(hazard_domain &domain) : _domain(domain), _rec(domain._records.acquire())
+    {
+    }
+
+    hazard_guard(const hazard_guard &) = delete;
+    hazard_guard &operator=(const hazard_guard &) = delete;
+
+    ~hazard_guard()
+    {
+        for (std::atomic<const void *> &slot : _rec->_slots)
+        {
+            slot.store(nullptr, std::memory_order_release);
+        }
+        _domain._records.release(_rec);
+    }
+
+    // 读取 src 并发布到第 slot 个风险指针; 返回后直到 clear 或再次 protect 该槽位, 对象不会被回收
+    template <typename T> T *protect(std::size_t slot, const std::atomic<T *> &src) noexcept
+    {
+        assert(slot < HAZARD_SLOTS);
+        T *p = src.load(std::memory_order_relaxed);
+        while (true)
+        {
+            _rec->_slots[slot].store(p, std::memory_order_seq_cst);
+            T *q = src.load(std::memory_order_seq_cst);
+            if (q == p)
+            {
+                return p;
+            }
+            p = q;
+        }
+    }
+
+    void clear(std::size_t slot) noexcept
+    {
+        _rec->_slots[slot].store(nullptr, std::memory_order_release);
+    }
+
+    // p 须已从共享结构中摘下
+    void retire(void *p, void (*reclaim)(void *))
+    {
+        _rec->_retired.push_back(retired_ptr{p, reclaim});
+        if (_rec->_retired.size() >= _domain.scan_threshold())
+        {
+            _domain.scan(*_rec);
+        }
+    }
+
+    template <typename T, typename Alloc = alloc> void retire(T *p)
+    {
+        retire(p, &reclaim_object<T, Alloc>);
+    }
+
+  protected:
+    hazard_domain &_domain;
+    hazard_record *_rec;
+};
+
+} // namespace TS
+
+#endif
@@ -0,0 +1,1517 @@
+#ifndef TS_SIMD_HPP
+#define TS_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+// x86 上由 GCC/Clang 按函数启用 SSE2/SSE4.1/AVX2/AVX-512 编译内核, 运行时根据 CPUID 选择;
+// 其他平台与编译器只使用标量实现
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TS_SIMD_X86 1
+#include <immintrin.h>
+#define TS_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define TS_SIMD_X86 0
+#endif
+
+namespace TS
+{
+namespace simd
+{
+// 指令集级别, 后者包含前者
+enum class isa
+{
+    scalar,
+    sse2,
+    sse4,
+    avx2,
+    avx512
+};
+
+inline const char *isa_name(isa level)
+{
+    static const char *const names[] = {"scalar", "sse2", "sse4", "avx2", "avx512"};
+    return names[int(level)];
+}
+
+// 按名称解析级别, 名称即 isa_name 的返回值
+inline bool parse_isa(const char *name, isa &level)
+{
+    for (int i = 0; i <= int(isa::avx512); ++i)
+    {
+        if (std::strcmp(name, isa_name(isa(i))) == 0)
+        {
+            level = isa(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// CPU 与操作系统实际支持的最高级别
+inline isa cpu_isa()
+{
+#if TS_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return isa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+        return isa::sse4;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return isa::sse2;
+    }
+#endif
+    return isa::scalar;
+}
+
+// 环境变量 TS_FORCE_ISA 可把级别降到指定值 (用于基准对比), 但不会超过 CPU 支持的级别;
+// 无法识别的值被忽略
+inline isa detect_isa()
+{
+    isa level = cpu_isa();
+    isa forced;
+    const char *name = std::getenv("TS_FORCE_ISA");
+    if (name != nullptr && parse_isa(name, forced) && forced < level)
+    {
+        level = forced;
+    }
+    return level;
+}
+
+// 只在首次调用时检测
+inline isa active_isa()
+{
+    static const isa level = detect_isa();
+    return level;
+}
+
+// 内核族: 提供函数指针表类型 table 与工厂 make(isa);
+// 首次调用时按 active_isa() 构造该族的表, 之后每次调用只是一次间接跳转
+template <typename Family> inline const typename Family::table &dispatch()
+{
+    static const typename Family::table result = Family::make(active_isa());
+    return result;
+}
+
+// 有查找内核的元素类型
+template <typename T>
+struct is_vectorizable
+    : std::integral_constant<bool, std::is_same<T, std::int32_t>::value ||
+                                       std::is_same<T, float>::value>
+{
+};
+
+// 可按位模式填充的元素类型: 4 或 8 字节的标量, 赋值即复制其对象表示
+template <typename T>
+struct is_pattern_fillable
+    : std::integral_constant<bool, std::is_scalar<T>::value && !std::is_const<T>::value &&
+                                       !std::is_volatile<T>::value &&
+                                       (sizeof(T) == 4 || sizeof(T) == 8)>
+{
+};
+
+template <typename Iter> struct is_fill_vectorizable : std::false_type
+{
+};
+
+template <typename T> struct is_fill_vectorizable<T *> : is_pattern_fillable<T>
+{
+};
+
+// 通道下标为 32 位, 更长的区间分块处理
+const std::size_t SIMD_MAX_BLOCK = std::size_t(1) << 30;
+
+// 短于此长度的 fill 直接逐个赋值, 省去间接调用
+const std::size_t SIMD_FILL_MIN = 16;
+
+// 短于此字数的位图运算与计数直接逐字处理, 省去间接调用
+const std::size_t SIMD_BITWISE_MIN = 16;
+
+// 64 位字的置位计数与末尾零个数; ctz64 的参数不得为 0
+// GCC/Clang 的 ctz 生成 rep bsf, 在支持 BMI1 的 CPU 上即 tzcnt
+inline unsigned popcount64(std::uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return unsigned(__builtin_popcountll(x));
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return unsigned((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+inline unsigned ctz64(std::uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return unsigned(__builtin_ctzll(x));
+#else
+    unsigned n = 0;
+    for (; (x & 1) == 0; x >>= 1)
+    {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// 位图的逐字运算 dst = apply(dst, src), 各指令集的向量类型各有一个重载
+struct bit_and_op
+{
+    static std::uint64_t apply(std::uint64_t a, std::uint64_t b)
+    {
+        return a & b;
+    }
+#if TS_SIMD_X86
+    TS_SIMD_TARGET("sse2") static __m128i apply(__m128i a, __m128i b)
+    {
+        return _mm_and_si128(a, b);
+    }
+    TS_SIMD_TARGET("avx2") static __m256i apply(__m256i a, __m256i b)
+    {
+        return _mm256_and_si256(a, b);
+    }
+    TS_SIMD_TARGET("avx512f") static __m512i apply(__m512i a, __m512i b)
+    {
+        return _mm512_and_si512(a, b);
+    }
+#endif
+};
+
+struct bit_or_op
+{
+    static std::uint64_t apply(std::uint64_t a, std::uint64_t b)
+    {
+        return a | b;
+    }
+#if TS_SIMD_X86
+    TS_SIMD_TARGET("sse2") static __m128i apply(__m128i a, __m128i b)
+    {
+        return _mm_or_si128(a, b);
+    }
+    TS_SIMD_TARGET("avx2") static __m256i apply(__m256i a, __m256i b)
+    {
+        return _mm256_or_si256(a, b);
+    }
+    TS_SIMD_TARGET("avx512f") static __m512i apply(__m512i a, __m512i b)
+    {
+        return _mm512_or_si512(a, b);
+    }
+#endif
+};
+
+struct bit_xor_op
+{
+    static std::uint64_t apply(std::uint64_t a, std::uint64_t b)
+    {
+        return a ^ b;
+    }
+#if TS_SIMD_X86
+    TS_SIMD_TARGET("sse2") static __m128i apply(__m128i a, __m128i b)
+    {
+        return _mm_xor_si128(a, b);
+    }
+    TS_SIMD_TARGET("avx2") static __m256i apply(__m256i a, __m256i b)
+    {
+        return _mm256_xor_si256(a, b);
+    }
+    TS_SIMD_TARGET("avx512f") static __m512i apply(__m512i a, __m512i b)
+    {
+        return _mm512_xor_si512(a, b);
+    }
+#endif
+};
+
+// a & ~b; andnot 指令对第一个操作数取反
+struct bit_andnot_op
+{
+    static std::uint64_t apply(std::uint64_t a, std::uint64_t b)
+    {
+        return a & ~b;
+    }
+#if TS_SIMD_X86
+    TS_SIMD_TARGET("sse2") static __m128i apply(__m128i a, __m128i b)
+    {
+        return _mm_andnot_si128(b, a);
+    }
+    TS_SIMD_TARGET("avx2") static __m256i apply(__m256i a, __m256i b)
+    {
+        return _mm256_andnot_si256(b, a);
+    }
+    // GCC 12 的 _mm512_andnot_si512/_epi64 以未初始化的向量作直通值, -Wall 下误报
+    // -Wmaybe-uninitialized; 全掩码的 maskz 形式结果相同, 仍编译为 vpandnq
+    TS_SIMD_TARGET("avx512f") static __m512i apply(__m512i a, __m512i b)
+    {
+        return _mm512_maskz_andnot_epi64(__mmask8(-1), b, a);
+    }
+#endif
+};
+
+// 极值内核的结果下标; 遇到 NaN 时 ok 为 false, 由调用方改用逐元素比较
+struct extrema
+{
+    std::size_t min;
+    std::size_t max;
+    bool ok;
+};
+
+// 按 std::min_element/max_element/minmax_element 的规则合并通道结果:
+// 最小值取最先出现者, 最大值按 LastMax 取最先或最后出现者
+template <bool LastMax, typename T>
+inline void merge_lanes(const T *min_vals, const std::int32_t *min_idx, const T *max_vals,
+                        const std::int32_t *max_idx, std::size_t lanes, extrema &result)
+{
+    T min_val = min_vals[0];
+    T max_val = max_vals[0];
+    result.min = std::size_t(min_idx[0]);
+    result.max = std::size_t(max_idx[0]);
+    for (std::size_t i = 1; i < lanes; ++i)
+    {
+        std::size_t index = std::size_t(min_idx[i]);
+        if (min_vals[i] < min_val || (!(min_val < min_vals[i]) && index < result.min))
+        {
+            min_val = min_vals[i];
+            result.min = index;
+        }
+        index = std::size_t(max_idx[i]);
+        bool later = LastMax ? index > result.max : index < result.max;
+        if (max_val < max_vals[i] || (!(max_vals[i] < max_val) && later))
+        {
+            max_val = max_vals[i];
+            result.max = index;
+        }
+    }
+}
+
+// 在通道结果之后逐个处理尾部元素
+template <bool LastMax, typename T>
+inline void scan_tail(const T *p, std::size_t from, std::size_t n, extrema &result)
+{
+    for (std::size_t i = from; i < n; ++i)
+    {
+        if (p[i] < p[result.min])
+        {
+            result.min = i;
+        }
+        if (LastMax ? !(p[i] < p[result.max]) : p[result.max] < p[i])
+        {
+            result.max = i;
+        }
+    }
+}
+
+// 标量实现, 也是各内核的回退路径
+namespace scalar
+{
+template <typename T> inline std::size_t find(const T *p, std::size_t n, T val)
+{
+    std::size_t i = 0;
+    for (; i < n && !(p[i] == val); ++i)
+    {
+    }
+    return i;
+}
+
+template <typename T> inline std::size_t count(const T *p, std::size_t n, T val)
+{
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        result += p[i] == val;
+    }
+    return result;
+}
+
+// n 须大于 0
+template <bool Min, bool Max, bool LastMax, typename T>
+inline extrema find_extrema(const T *p, std::size_t n)
+{
+    extrema result = {0, 0, true};
+    scan_tail<LastMax>(p, 1, n, result);
+    return result;
+}
+
+// 按位模式写入, 不经过元素类型的指针访问
+template <typename T> inline void fill(void *p, std::size_t n, T pattern)
+{
+    char *out = static_cast<char *>(p);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        std::memcpy(out + i * sizeof(T), &pattern, sizeof(T));
+    }
+}
+
+template <typename Op>
+inline void bitwise(std::uint64_t *dst, const std::uint64_t *src, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        dst[i] = Op::apply(dst[i], src[i]);
+    }
+}
+
+inline std::size_t popcount(const std::uint64_t *p, std::size_t n)
+{
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        result += popcount64(p[i]);
+    }
+    return result;
+}
+} // namespace scalar
+
+#if TS_SIMD_X86
+namespace sse2
+{
+const std::size_t LANES = 4;
+
+TS_SIMD_TARGET("sse2") inline __m128i load(const std::int32_t *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+TS_SIMD_TARGET("sse2") inline __m128 load(const float *p)
+{
+    return _mm_loadu_ps(p);
+}
+
+TS_SIMD_TARGET("sse2") inline __m128i splat(std::int32_t val)
+{
+    return _mm_set1_epi32(val);
+}
+
+TS_SIMD_TARGET("sse2") inline __m128 splat(float val)
+{
+    return _mm_set1_ps(val);
+}
+
+TS_SIMD_TARGET("sse2") inline __m128i splat(std::uint32_t val)
+{
+    return _mm_set1_epi32(int(val));
+}
+
+TS_SIMD_TARGET("sse2") inline __m128i splat(std::uint64_t val)
+{
+    return _mm_set1_epi64x((long long)val);
+}
+
+// 以下比较返回每通道全 1 或全 0 的整数掩码
+TS_SIMD_TARGET("sse2") inline __m128i eq(__m128i a, __m128i b)
+{
+    return _mm_cmpeq_epi32(a, b);
+}
+
+TS_SIMD_TARGET("sse2") inline __m128i eq(__m128 a, __m128 b)
+{
+    return _mm_castps_si128(_mm_cmpeq_ps(a, b));
+}
+
+TS_SIMD_TARGET("sse2") inline __m128i lt(__m128i a, __m128i b)
+{
+    return _mm_cmpgt_epi32(b, a);
+}
+
+TS_SIMD_TARGET("sse2") inline __m128i lt(__m128 a, __m128 b)
+{
+    return _mm_castps_si128(_mm_cmplt_ps(a, b));
+}
+
+TS_SIMD_TARGET("sse2") inline __m128i le(__m128i a, __m128i b)
+{
+    return _mm_xor_si128(_mm_cmpgt_epi32(a, b), _mm_set1_epi32(-1));
+}
+
+TS_SIMD_TARGET("sse2") inline __m128i le(__m128 a, __m128 b)
+{
+    return _mm_castps_si128(_mm_cmple_ps(a, b));
+}
+
+TS_SIMD_TARGET("sse2") inline __m128i unordered(__m128i)
+{
+    return _mm_setzero_si128();
+}
+
+TS_SIMD_TARGET("sse2") inline __m128i unordered(__m128 v)
+{
+    return _mm_castps_si128(_mm_cmpunord_ps(v, v));
+}
+
+TS_SIMD_TARGET("sse2") inline unsigned bits(__m128i mask)
+{
+    return unsigned(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+}
+
+TS_SIMD_TARGET("sse2") inline void store(std::int32_t *p, __m128i v)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+}
+
+TS_SIMD_TARGET("sse2") inline void store(float *p, __m128 v)
+{
+    _mm_storeu_ps(p, v);
+}
+
+template <typename T>
+TS_SIMD_TARGET("sse2")
+inline std::size_t find(const T *p, std::size_t n, T val)
+{
+    const auto needle = splat(val);
+    std::size_t i = 0;
+    for (; i + 4 * LANES <= n; i += 4 * LANES)
+    {
+        unsigned mask = bits(eq(load(p + i), needle)) |
+                        bits(eq(load(p + i + LANES), needle)) << LANES |
+                        bits(eq(load(p + i + 2 * LANES), needle)) << 2 * LANES |
+                        bits(eq(load(p + i + 3 * LANES), needle)) << 3 * LANES;
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + scalar::find(p + i, n - i, val);
+}
+
+// n 不超过 SIMD_MAX_BLOCK
+template <typename T>
+TS_SIMD_TARGET("sse2")
+inline std::size_t count(const T *p, std::size_t n, T val)
+{
+    const auto needle = splat(val);
+    __m128i acc = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        acc = _mm_sub_epi32(acc, eq(load(p + i), needle)); // 掩码为 -1
+    }
+    std::int32_t lanes[LANES];
+    store(lanes, acc);
+    std::size_t result = 0;
+    for (std::size_t k = 0; k < LANES; ++k)
+    {
+        result += std::size_t(lanes[k]);
+    }
+    return result + scalar::count(p + i, n - i, val);
+}
+
+// T 为 uint32_t 或 uint64_t
+template <typename T>
+TS_SIMD_TARGET("sse2")
+inline void fill(void *p, std::size_t n, T pattern)
+{
+    const std::size_t PER_VECTOR = 16 / sizeof(T);
+    const __m128i v = splat(pattern);
+    __m128i *out = static_cast<__m128i *>(p);
+    std::size_t i = 0;
+    for (; i + 4 * PER_VECTOR <= n; i += 4 * PER_VECTOR, out += 4)
+    {
+        _mm_storeu_si128(out, v);
+        _mm_storeu_si128(out + 1, v);
+        _mm_storeu_si128(out + 2, v);
+        _mm_storeu_si128(out + 3, v);
+    }
+    for (; i + PER_VECTOR <= n; i += PER_VECTOR)
+    {
+        _mm_storeu_si128(out++, v);
+    }
+    scalar::fill(out, n - i, pattern);
+}
+
+template <typename Op>
+TS_SIMD_TARGET("sse2")
+inline void bitwise(std::uint64_t *dst, const std::uint64_t *src, std::size_t n)
+{
+    __m128i *out = reinterpret_cast<__m128i *>(dst);
+    const __m128i *in = reinterpret_cast<const __m128i *>(src);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8, out += 4, in += 4)
+    {
+        _mm_storeu_si128(out, Op::apply(_mm_loadu_si128(out), _mm_loadu_si128(in)));
+        _mm_storeu_si128(out + 1, Op::apply(_mm_loadu_si128(out + 1), _mm_loadu_si128(in + 1)));
+        _mm_storeu_si128(out + 2, Op::apply(_mm_loadu_si128(out + 2), _mm_loadu_si128(in + 2)));
+        _mm_storeu_si128(out + 3, Op::apply(_mm_loadu_si128(out + 3), _mm_loadu_si128(in + 3)));
+    }
+    for (; i + 2 <= n; i += 2)
+    {
+        _mm_storeu_si128(out, Op::apply(_mm_loadu_si128(out), _mm_loadu_si128(in)));
+        ++out;
+        ++in;
+    }
+    scalar::bitwise<Op>(dst + i, src + i, n - i);
+}
+} // namespace sse2
+
+// 查找与计数只需 SSE2, 这里只补充依赖 blendv 的极值内核
+namespace sse4
+{
+const std::size_t LANES = sse2::LANES;
+using sse2::le;
+using sse2::load;
+using sse2::lt;
+using sse2::store;
+using sse2::unordered;
+
+TS_SIMD_TARGET("sse4.1") inline __m128i blend(__m128i a, __m128i b, __m128i mask)
+{
+    return _mm_blendv_epi8(a, b, mask);
+}
+
+TS_SIMD_TARGET("sse4.1") inline __m128 blend(__m128 a, __m128 b, __m128i mask)
+{
+    return _mm_blendv_ps(a, b, _mm_castsi128_ps(mask));
+}
+
+// 每个通道记录各自的最值及下标, 最后合并; n 不小于 LANES 且不超过 SIMD_MAX_BLOCK
+template <bool Min, bool Max, bool LastMax, typename T>
+TS_SIMD_TARGET("sse4.1")
+inline extrema find_extrema(const T *p, std::size_t n)
+{
+    const __m128i step = _mm_set1_epi32(LANES);
+    __m128i idx = _mm_setr_epi32(0, 1, 2, 3);
+    auto min_v = load(p);
+    auto max_v = min_v;
+    __m128i min_i = idx;
+    __m128i max_i = idx;
+    __m128i nan = unordered(min_v);
+    std::size_t i = LANES;
+    for (; i + LANES <= n; i += LANES)
+    {
+        auto v = load(p + i);
+        idx = _mm_add_epi32(idx, step);
+        nan = _mm_or_si128(nan, unordered(v));
+        if (Min)
+        {
+            __m128i mask = lt(v, min_v);
+            min_v = blend(min_v, v, mask);
+            min_i = blend(min_i, idx, mask);
+        }
+        if (Max)
+        {
+            __m128i mask = LastMax ? le(max_v, v) : lt(max_v, v);
+            max_v = blend(max_v, v, mask);
+            max_i = blend(max_i, idx, mask);
+        }
+    }
+
+    extrema result = {0, 0, _mm_testz_si128(nan, nan) != 0};
+    T min_vals[LANES], max_vals[LANES];
+    std::int32_t min_idx[LANES], max_idx[LANES];
+    store(min_vals, min_v);
+    store(max_vals, max_v);
+    store(min_idx, min_i);
+    store(max_idx, max_i);
+    merge_lanes<LastMax>(min_vals, min_idx, max_vals, max_idx, LANES, result);
+    scan_tail<LastMax>(p, i, n, result);
+    return result;
+}
+
+// POPCNT 与 SSE4.1 是不同的 CPUID 位, 由调用方另行检查
+TS_SIMD_TARGET("popcnt") inline std::size_t popcount(const std::uint64_t *p, std::size_t n)
+{
+    // 四个累加器互不依赖, 避开 popcnt 对目标寄存器的假依赖
+    std::size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        c0 += std::size_t(__builtin_popcountll(p[i]));
+        c1 += std::size_t(__builtin_popcountll(p[i + 1]));
+        c2 += std::size_t(__builtin_popcountll(p[i + 2]));
+        c3 += std::size_t(__builtin_popcountll(p[i + 3]));
+    }
+    for (; i < n; ++i)
+    {
+        c0 += std::size_t(__builtin_popcountll(p[i]));
+    }
+    return c0 + c1 + c2 + c3;
+}
+} // namespace sse4
+
+namespace avx2
+{
+const std::size_t LANES = 8;
+
+TS_SIMD_TARGET("avx2") inline __m256i load(const std::int32_t *p)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+TS_SIMD_TARGET("avx2") inline __m256 load(const float *p)
+{
+    return _mm256_loadu_ps(p);
+}
+
+TS_SIMD_TARGET("avx2") inline __m256i splat(std::int32_t val)
+{
+    return _mm256_set1_epi32(val);
+}
+
+TS_SIMD_TARGET("avx2") inline __m256 splat(float val)
+{
+    return _mm256_set1_ps(val);
+}
+
+TS_SIMD_TARGET("avx2") inline __m256i splat(std::uint32_t val)
+{
+    return _mm256_set1_epi32(int(val));
+}
+
+TS_SIMD_TARGET("avx2") inline __m256i splat(std::uint64_t val)
+{
+    return _mm256_set1_epi64x((long long)val);
+}
+
+TS_SIMD_TARGET("avx2") inline __m256i eq(__m256i a, __m256i b)
+{
+    return _mm256_cmpeq_epi32(a, b);
+}
+
+TS_SIMD_TARGET("avx2") inline __m256i eq(__m256 a, __m256 b)
+{
+    return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+}
+
+TS_SIMD_TARGET("avx2") inline __m256i lt(__m256i a, __m256i b)
+{
+    return _mm256_cmpgt_epi32(b, a);
+}
+
+TS_SIMD_TARGET("avx2") inline __m256i lt(__m256 a, __m256 b)
+{
+    return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ));
+}
+
+TS_SIMD_TARGET("avx2") inline __m256i le(__m256i a, __m256i b)
+{
+    return _mm256_xor_si256(_mm256_cmpgt_epi32(a, b), _mm256_set1_epi32(-1));
+}
+
+TS_SIMD_TARGET("avx2") inline __m256i le(__m256 a, __m256 b)
+{
+    return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LE_OQ));
+}
+
+TS_SIMD_TARGET("avx2") inline __m256i unordered(__m256i)
+{
+    return _mm256_setzero_si256();
+}
+
+TS_SIMD_TARGET("avx2") inline __m256i unordered(__m256 v)
+{
+    return _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+}
+
+TS_SIMD_TARGET("avx2") inline __m256i blend(__m256i a, __m256i b, __m256i mask)
+{
+    return _mm256_blendv_epi8(a, b, mask);
+}
+
+TS_SIMD_TARGET("avx2") inline __m256 blend(__m256 a, __m256 b, __m256i mask)
+{
+    return _mm256_blendv_ps(a, b, _mm256_castsi256_ps(mask));
+}
+
+TS_SIMD_TARGET("avx2") inline unsigned bits(__m256i mask)
+{
+    return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+}
+
+TS_SIMD_TARGET("avx2") inline void store(std::int32_t *p, __m256i v)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+}
+
+TS_SIMD_TARGET("avx2") inline void store(float *p, __m256 v)
+{
+    _mm256_storeu_ps(p, v);
+}
+
+template <typename T>
+TS_SIMD_TARGET("avx2")
+inline std::size_t find(const T *p, std::size_t n, T val)
+{
+    const auto needle = splat(val);
+    std::size_t i = 0;
+    for (; i + 4 * LANES <= n; i += 4 * LANES)
+    {
+        unsigned mask = bits(eq(load(p + i), needle)) |
+                        bits(eq(load(p + i + LANES), needle)) << LANES |
+                        bits(eq(load(p + i + 2 * LANES), needle)) << 2 * LANES |
+                        bits(eq(load(p + i + 3 * LANES), needle)) << 3 * LANES;
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i + LANES <= n; i += LANES)
+    {
+        unsigned mask = bits(eq(load(p + i), needle));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + scalar::find(p + i, n - i, val);
+}
+
+template <typename T>
+TS_SIMD_TARGET("avx2")
+inline std::size_t count(const T *p, std::size_t n, T val)
+{
+    const auto needle = splat(val);
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 2 * LANES <= n; i += 2 * LANES)
+    {
+        acc0 = _mm256_sub_epi32(acc0, eq(load(p + i), needle));
+        acc1 = _mm256_sub_epi32(acc1, eq(load(p + i + LANES), needle));
+    }
+    std::int32_t lanes[LANES];
+    store(lanes, _mm256_add_epi32(acc0, acc1));
+    std::size_t result = 0;
+    for (std::size_t k = 0; k < LANES; ++k)
+    {
+        result += std::size_t(lanes[k]);
+    }
+    return result + scalar::count(p + i, n - i, val);
+}
+
+template <bool Min, bool Max, bool LastMax, typename V>
+TS_SIMD_TARGET("avx2")
+inline void update(V v, __m256i idx, V &min_v, __m256i &min_i, V &max_v, __m256i &max_i)
+{
+    if (Min)
+    {
+        __m256i mask = lt(v, min_v);
+        min_v = blend(min_v, v, mask);
+        min_i = blend(min_i, idx, mask);
+    }
+    if (Max)
+    {
+        __m256i mask = LastMax ? le(max_v, v) : lt(max_v, v);
+        max_v = blend(max_v, v, mask);
+        max_i = blend(max_i, idx, mask);
+    }
+}
+
+// 两组互不依赖的通道交替处理, 缩短 blend 的依赖链; n 不小于 2 * LANES
+template <bool Min, bool Max, bool LastMax, typename T>
+TS_SIMD_TARGET("avx2")
+inline extrema find_extrema(const T *p, std::size_t n)
+{
+    const __m256i step = _mm256_set1_epi32(2 * LANES);
+    __m256i idx0 = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i idx1 = _mm256_setr_epi32(8, 9, 10, 11, 12, 13, 14, 15);
+    auto min_v0 = load(p);
+    auto min_v1 = load(p + LANES);
+    auto max_v0 = min_v0;
+    auto max_v1 = min_v1;
+    __m256i min_i0 = idx0, max_i0 = idx0;
+    __m256i min_i1 = idx1, max_i1 = idx1;
+    __m256i nan = _mm256_or_si256(unordered(min_v0), unordered(min_v1));
+    std::size_t i = 2 * LANES;
+    for (; i + 2 * LANES <= n; i += 2 * LANES)
+    {
+        auto v0 = load(p + i);
+        auto v1 = load(p + i + LANES);
+        idx0 = _mm256_add_epi32(idx0, step);
+        idx1 = _mm256_add_epi32(idx1, step);
+        nan = _mm256_or_si256(nan, _mm256_or_si256(unordered(v0), unordered(v1)));
+        update<Min, Max, LastMax>(v0, idx0, min_v0, min_i0, max_v0, max_i0);
+        update<Min, Max, LastMax>(v1, idx1, min_v1, min_i1, max_v1, max_i1);
+    }
+
+    extrema result = {0, 0, _mm256_testz_si256(nan, nan) != 0};
+    T min_vals[2 * LANES], max_vals[2 * LANES];
+    std::int32_t min_idx[2 * LANES], max_idx[2 * LANES];
+    store(min_vals, min_v0);
+    store(min_vals + LANES, min_v1);
+    store(max_vals, max_v0);
+    store(max_vals + LANES, max_v1);
+    store(min_idx, min_i0);
+    store(min_idx + LANES, min_i1);
+    store(max_idx, max_i0);
+    store(max_idx + LANES, max_i1);
+    merge_lanes<LastMax>(min_vals, min_idx, max_vals, max_idx, 2 * LANES, result);
+    scan_tail<LastMax>(p, i, n, result);
+    return result;
+}
+
+template <typename T>
+TS_SIMD_TARGET("avx2")
+inline void fill(void *p, std::size_t n, T pattern)
+{
+    const std::size_t PER_VECTOR = 32 / sizeof(T);
+    const __m256i v = splat(pattern);
+    __m256i *out = static_cast<__m256i *>(p);
+    std::size_t i = 0;
+    for (; i + 4 * PER_VECTOR <= n; i += 4 * PER_VECTOR, out += 4)
+    {
+        _mm256_storeu_si256(out, v);
+        _mm256_storeu_si256(out + 1, v);
+        _mm256_storeu_si256(out + 2, v);
+        _mm256_storeu_si256(out + 3, v);
+    }
+    for (; i + PER_VECTOR <= n; i += PER_VECTOR)
+    {
+        _mm256_storeu_si256(out++, v);
+    }
+    scalar::fill(out, n - i, pattern);
+}
+
+template <typename Op>
+TS_SIMD_TARGET("avx2")
+inline void bitwise(std::uint64_t *dst, const std::uint64_t *src, std::size_t n)
+{
+    __m256i *out = reinterpret_cast<__m256i *>(dst);
+    const __m256i *in = reinterpret_cast<const __m256i *>(src);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16, out += 4, in += 4)
+    {
+        __m256i r0 = Op::apply(_mm256_loadu_si256(out), _mm256_loadu_si256(in));
+        __m256i r1 = Op::apply(_mm256_loadu_si256(out + 1), _mm256_loadu_si256(in + 1));
+        __m256i r2 = Op::apply(_mm256_loadu_si256(out + 2), _mm256_loadu_si256(in + 2));
+        __m256i r3 = Op::apply(_mm256_loadu_si256(out + 3), _mm256_loadu_si256(in + 3));
+        _mm256_storeu_si256(out, r0);
+        _mm256_storeu_si256(out + 1, r1);
+        _mm256_storeu_si256(out + 2, r2);
+        _mm256_storeu_si256(out + 3, r3);
+    }
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm256_storeu_si256(out, Op::apply(_mm256_loadu_si256(out), _mm256_loadu_si256(in)));
+        ++out;
+        ++in;
+    }
+    scalar::bitwise<Op>(dst + i, src + i, n - i);
+}
+
+// 每字节的置位数: 高低半字节分别查 16 项的表 (pshufb)
+TS_SIMD_TARGET("avx2") inline __m256i popcount_bytes(__m256i v)
+{
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1,
+                                           1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(v, low);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(table, lo), _mm256_shuffle_epi8(table, hi));
+}
+
+// 四个向量的字节计数 (每字节不超过 32) 相加后再用 sad 横向累加到 64 位通道
+TS_SIMD_TARGET("avx2,popcnt")
+inline std::size_t popcount(const std::uint64_t *p, std::size_t n)
+{
+    const __m256i *in = reinterpret_cast<const __m256i *>(p);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16, in += 4)
+    {
+        __m256i bytes = _mm256_add_epi8(popcount_bytes(_mm256_loadu_si256(in)),
+                                        popcount_bytes(_mm256_loadu_si256(in + 1)));
+        bytes = _mm256_add_epi8(bytes, popcount_bytes(_mm256_loadu_si256(in + 2)));
+        bytes = _mm256_add_epi8(bytes, popcount_bytes(_mm256_loadu_si256(in + 3)));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, zero));
+    }
+    for (; i + 4 <= n; i += 4, ++in)
+    {
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(popcount_bytes(_mm256_loadu_si256(in)), zero));
+    }
+    std::uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), acc);
+    std::size_t result = std::size_t(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    for (; i < n; ++i)
+    {
+        result += std::size_t(__builtin_popcountll(p[i]));
+    }
+    return result;
+}
+} // namespace avx2
+
+// AVX-512 的比较结果直接是位掩码寄存器, 不需要 movemask 与 blendv
+namespace avx512
+{
+const std::size_t LANES = 16;
+
+TS_SIMD_TARGET("avx512f") inline __m512i load(const std::int32_t *p)
+{
+    return _mm512_loadu_si512(p);
+}
+
+TS_SIMD_TARGET("avx512f") inline __m512 load(const float *p)
+{
+    return _mm512_loadu_ps(p);
+}
+
+TS_SIMD_TARGET("avx512f") inline __m512i splat(std::int32_t val)
+{
+    return _mm512_set1_epi32(val);
+}
+
+TS_SIMD_TARGET("avx512f") inline __m512 splat(float val)
+{
+    return _mm512_set1_ps(val);
+}
+
+TS_SIMD_TARGET("avx512f") inline __m512i splat(std::uint32_t val)
+{
+    return _mm512_set1_epi32(int(val));
+}
+
+TS_SIMD_TARGET("avx512f") inline __m512i splat(std::uint64_t val)
+{
+    return _mm512_set1_epi64((long long)val);
+}
+
+TS_SIMD_TARGET("avx512f") inline __mmask16 eq(__m512i a, __m512i b)
+{
+    return _mm512_cmpeq_epi32_mask(a, b);
+}
+
+TS_SIMD_TARGET("avx512f") inline __mmask16 eq(__m512 a, __m512 b)
+{
+    return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+}
+
+TS_SIMD_TARGET("avx512f") inline __mmask16 lt(__m512i a, __m512i b)
+{
+    return _mm512_cmplt_epi32_mask(a, b);
+}
+
+TS_SIMD_TARGET("avx512f") inline __mmask16 lt(__m512 a, __m512 b)
+{
+    return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+}
+
+TS_SIMD_TARGET("avx512f") inline __mmask16 le(__m512i a, __m512i b)
+{
+    return _mm512_cmple_epi32_mask(a, b);
+}
+
+TS_SIMD_TARGET("avx512f") inline __mmask16 le(__m512 a, __m512 b)
+{
+    return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ);
+}
+
+TS_SIMD_TARGET("avx512f") inline __mmask16 unordered(__m512i)
+{
+    return 0;
+}
+
+TS_SIMD_TARGET("avx512f") inline __mmask16 unordered(__m512 v)
+{
+    return _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q);
+}
+
+TS_SIMD_TARGET("avx512f") inline __m512i blend(__m512i a, __m512i b, __mmask16 mask)
+{
+    return _mm512_mask_blend_epi32(mask, a, b);
+}
+
+TS_SIMD_TARGET("avx512f") inline __m512 blend(__m512 a, __m512 b, __mmask16 mask)
+{
+    return _mm512_mask_blend_ps(mask, a, b);
+}
+
+TS_SIMD_TARGET("avx512f") inline void store(std::int32_t *p, __m512i v)
+{
+    _mm512_storeu_si512(p, v);
+}
+
+TS_SIMD_TARGET("avx512f") inline void store(float *p, __m512 v)
+{
+    _mm512_storeu_ps(p, v);
+}
+
+template <typename T>
+TS_SIMD_TARGET("avx512f")
+inline std::size_t find(const T *p, std::size_t n, T val)
+{
+    const auto needle = splat(val);
+    std::size_t i = 0;
+    for (; i + 4 * LANES <= n; i += 4 * LANES)
+    {
+        std::uint64_t mask = std::uint64_t(eq(load(p + i), needle)) |
+                             std::uint64_t(eq(load(p + i + LANES), needle)) << LANES |
+                             std::uint64_t(eq(load(p + i + 2 * LANES), needle)) << 2 * LANES |
+                             std::uint64_t(eq(load(p + i + 3 * LANES), needle)) << 3 * LANES;
+        if (mask != 0)
+        {
+            return i + __builtin_ctzll(mask);
+        }
+    }
+    for (; i + LANES <= n; i += LANES)
+    {
+        unsigned mask = eq(load(p + i), needle);
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + scalar::find(p + i, n - i, val);
+}
+
+template <typename T>
+TS_SIMD_TARGET("avx512f")
+inline std::size_t count(const T *p, std::size_t n, T val)
+{
+    const auto needle = splat(val);
+    const __m512i one = _mm512_set1_epi32(1);
+    __m512i acc0 = _mm512_setzero_si512();
+    __m512i acc1 = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for (; i + 2 * LANES <= n; i += 2 * LANES)
+    {
+        acc0 = _mm512_mask_add_epi32(acc0, eq(load(p + i), needle), acc0, one);
+        acc1 = _mm512_mask_add_epi32(acc1, eq(load(p + i + LANES), needle), acc1, one);
+    }
+    std::int32_t lanes[LANES];
+    store(lanes, _mm512_add_epi32(acc0, acc1));
+    std::size_t result = 0;
+    for (std::size_t k = 0; k < LANES; ++k)
+    {
+        result += std::size_t(lanes[k]);
+    }
+    return result + scalar::count(p + i, n - i, val);
+}
+
+template <bool Min, bool Max, bool LastMax, typename V>
+TS_SIMD_TARGET("avx512f")
+inline void update(V v, __m512i idx, V &min_v, __m512i &min_i, V &max_v, __m512i &max_i)
+{
+    if (Min)
+    {
+        __mmask16 mask = lt(v, min_v);
+        min_v = blend(min_v, v, mask);
+        min_i = blend(min_i, idx, mask);
+    }
+    if (Max)
+    {
+        __mmask16 mask = LastMax ? le(max_v, v) : lt(max_v, v);
+        max_v = blend(max_v, v, mask);
+        max_i = blend(max_i, idx, mask);
+    }
+}
+
+// 与 AVX2 版本相同的两组交替通道; n 不小于 2 * LANES
+template <bool Min, bool Max, bool LastMax, typename T>
+TS_SIMD_TARGET("avx512f")
+inline extrema find_extrema(const T *p, std::size_t n)
+{
+    const __m512i step = _mm512_set1_epi32(2 * LANES);
+    __m512i idx0 = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i idx1 = _mm512_add_epi32(idx0, _mm512_set1_epi32(LANES));
+    auto min_v0 = load(p);
+    auto min_v1 = load(p + LANES);
+    auto max_v0 = min_v0;
+    auto max_v1 = min_v1;
+    __m512i min_i0 = idx0, max_i0 = idx0;
+    __m512i min_i1 = idx1, max_i1 = idx1;
+    __mmask16 nan = unordered(min_v0) | unordered(min_v1);
+    std::size_t i = 2 * LANES;
+    for (; i + 2 * LANES <= n; i += 2 * LANES)
+    {
+        auto v0 = load(p + i);
+        auto v1 = load(p + i + LANES);
+        idx0 = _mm512_add_epi32(idx0, step);
+        idx1 = _mm512_add_epi32(idx1, step);
+        nan |= unordered(v0) | unordered(v1);
+        update<Min, Max, LastMax>(v0, idx0, min_v0, min_i0, max_v0, max_i0);
+        update<Min, Max, LastMax>(v1, idx1, min_v1, min_i1, max_v1, max_i1);
+    }
+
+    extrema result = {0, 0, nan == 0};
+    T min_vals[2 * LANES], max_vals[2 * LANES];
+    std::int32_t min_idx[2 * LANES], max_idx[2 * LANES];
+    store(min_vals, min_v0);
+    store(min_vals + LANES, min_v1);
+    store(max_vals, max_v0);
+    store(max_vals + LANES, max_v1);
+    store(min_idx, min_i0);
+    store(min_idx + LANES, min_i1);
+    store(max_idx, max_i0);
+    store(max_idx + LANES, max_i1);
+    merge_lanes<LastMax>(min_vals, min_idx, max_vals, max_idx, 2 * LANES, result);
+    scan_tail<LastMax>(p, i, n, result);
+    return result;
+}
+
+template <typename T>
+TS_SIMD_TARGET("avx512f")
+inline void fill(void *p, std::size_t n, T pattern)
+{
+    const std::size_t PER_VECTOR = 64 / sizeof(T);
+    const __m512i v = splat(pattern);
+    char *out = static_cast<char *>(p);
+    std::size_t i = 0;
+    for (; i + 4 * PER_VECTOR <= n; i += 4 * PER_VECTOR, out += 256)
+    {
+        _mm512_storeu_si512(out, v);
+        _mm512_storeu_si512(out + 64, v);
+        _mm512_storeu_si512(out + 128, v);
+        _mm512_storeu_si512(out + 192, v);
+    }
+    for (; i + PER_VECTOR <= n; i += PER_VECTOR, out += 64)
+    {
+        _mm512_storeu_si512(out, v);
+    }
+    scalar::fill(out, n - i, pattern);
+}
+
+// 按位运算只需 AVX-512F; 计数需要的 VPOPCNTDQ/BW 不在检测范围内, 沿用 AVX2 内核
+template <typename Op>
+TS_SIMD_TARGET("avx512f")
+inline void bitwise(std::uint64_t *dst, const std::uint64_t *src, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m512i r0 = Op::apply(_mm512_loadu_si512(dst + i), _mm512_loadu_si512(src + i));
+        __m512i r1 = Op::apply(_mm512_loadu_si512(dst + i + 8), _mm512_loadu_si512(src + i + 8));
+        __m512i r2 =
+            Op::apply(_mm512_loadu_si512(dst + i + 16), _mm512_loadu_si512(src + i + 16));
+        __m512i r3 =
+            Op::apply(_mm512_loadu_si512(dst + i + 24), _mm512_loadu_si512(src + i + 24));
+        _mm512_storeu_si512(dst + i, r0);
+        _mm512_storeu_si512(dst + i + 8, r1);
+        _mm512_storeu_si512(dst + i + 16, r2);
+        _mm512_storeu_si512(dst + i + 24, r3);
+    }
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm512_storeu_si512(dst + i,
+                            Op::apply(_mm512_loadu_si512(dst + i), _mm512_loadu_si512(src + i)));
+    }
+    scalar::bitwise<Op>(dst + i, src + i, n - i);
+}
+} // namespace avx512
+#endif
+
+// 区间过短或含 NaN 时, 向量极值内核改用标量实现, 使表中的每一项对任意非空区间都可用
+template <bool Min, bool Max, bool LastMax, typename T, extrema (*Kernel)(const T *, std::size_t),
+          std::size_t MinLength>
+inline extrema checked_extrema(const T *p, std::size_t n)
+{
+    if (n >= MinLength)
+    {
+        extrema result = Kernel(p, n);
+        if (result.ok)
+        {
+            return result;
+        }
+    }
+    return scalar::find_extrema<Min, Max, LastMax>(p, n);
+}
+
+// 查找族: T 须满足 is_vectorizable; count 与极值项的 n 不超过 SIMD_MAX_BLOCK
+template <typename T> struct search_kernels
+{
+    using extrema_kernel = extrema (*)(const T *, std::size_t);
+
+    struct table
+    {
+        isa level; // 实际使用的级别, 可能低于请求的级别
+        std::size_t (*find)(const T *, std::size_t, T);
+        std::size_t (*count)(const T *, std::size_t, T);
+        extrema_kernel min;    // min_element 规则
+        extrema_kernel max;    // max_element 规则
+        extrema_kernel minmax; // minmax_element 规则
+    };
+
+    // level 不得超过 cpu_isa()
+    static table make(isa level)
+    {
+#if TS_SIMD_X86
+        switch (level)
+        {
+        case isa::avx512:
+            return {level, avx512::find<T>, avx512::count<T>,
+                    checked_extrema<true, false, false, T,
+                                    avx512::find_extrema<true, false, false, T>,
+                                    2 * avx512::LANES>,
+                    checked_extrema<false, true, false, T,
+                                    avx512::find_extrema<false, true, false, T>,
+                                    2 * avx512::LANES>,
+                    checked_extrema<true, true, true, T, avx512::find_extrema<true, true, true, T>,
+                                    2 * avx512::LANES>};
+        case isa::avx2:
+            return {level, avx2::find<T>, avx2::count<T>,
+                    checked_extrema<true, false, false, T,
+                                    avx2::find_extrema<true, false, false, T>, 2 * avx2::LANES>,
+                    checked_extrema<false, true, false, T,
+                                    avx2::find_extrema<false, true, false, T>, 2 * avx2::LANES>,
+                    checked_extrema<true, true, true, T, avx2::find_extrema<true, true, true, T>,
+                                    2 * avx2::LANES>};
+        case isa::sse4:
+            return {level, sse2::find<T>, sse2::count<T>,
+                    checked_extrema<true, false, false, T,
+                                    sse4::find_extrema<true, false, false, T>, sse4::LANES>,
+                    checked_extrema<false, true, false, T,
+                                    sse4::find_extrema<false, true, false, T>, sse4::LANES>,
+                    checked_extrema<true, true, true, T, sse4::find_extrema<true, true, true, T>,
+                                    sse4::LANES>};
+        case isa::sse2:
+            return {level,
+                    sse2::find<T>,
+                    sse2::count<T>,
+                    scalar::find_extrema<true, false, false, T>,
+                    scalar::find_extrema<false, true, false, T>,
+                    scalar::find_extrema<true, true, true, T>};
+        default:
+            break;
+        }
+#endif
+        return {isa::scalar,
+                scalar::find<T>,
+                scalar::count<T>,
+                scalar::find_extrema<true, false, false, T>,
+                scalar::find_extrema<false, true, false, T>,
+                scalar::find_extrema<true, true, true, T>};
+    }
+};
+
+// 填充族: T 为 uint32_t 或 uint64_t, 即元素的位模式
+template <typename T> struct fill_kernels
+{
+    struct table
+    {
+        isa level;
+        void (*fill)(void *, std::size_t, T);
+    };
+
+    // level 不得超过 cpu_isa()
+    static table make(isa level)
+    {
+#if TS_SIMD_X86
+        switch (level)
+        {
+        case isa::avx512:
+            return {level, avx512::fill<T>};
+        case isa::avx2:
+            return {level, avx2::fill<T>};
+        case isa::sse4:
+        case isa::sse2:
+            return {level, sse2::fill<T>};
+        default:
+            break;
+        }
+#endif
+        return {isa::scalar, scalar::fill<T>};
+    }
+};
+
+// 位图族: 64 位字数组上的逐字运算与置位计数
+struct bit_kernels
+{
+    using bitwise_kernel = void (*)(std::uint64_t *, const std::uint64_t *, std::size_t);
+    using popcount_kernel = std::size_t (*)(const std::uint64_t *, std::size_t);
+
+    struct table
+    {
+        isa level;
+        bitwise_kernel and_;
+        bitwise_kernel or_;
+        bitwise_kernel xor_;
+        bitwise_kernel andnot;
+        popcount_kernel popcount;
+    };
+
+#if TS_SIMD_X86
+    // POPCNT 有独立的 CPUID 位, 不随 SSE4.1/AVX2 保证存在; GCC 的 avx2 目标又隐含 popcnt,
+    // 向量内核的尾部也会用到它, 因此各级别都先检查再选用
+    static popcount_kernel popcount_for(isa level)
+    {
+        if (!__builtin_cpu_supports("popcnt"))
+        {
+            return scalar::popcount;
+        }
+        if (level == isa::avx2 || level == isa::avx512)
+        {
+            return avx2::popcount;
+        }
+        return level == isa::sse4 ? sse4::popcount : scalar::popcount;
+    }
+#endif
+
+    // level 不得超过 cpu_isa()
+    static table make(isa level)
+    {
+#if TS_SIMD_X86
+        switch (level)
+        {
+        case isa::avx512:
+            return {level,
+                    avx512::bitwise<bit_and_op>,
+                    avx512::bitwise<bit_or_op>,
+                    avx512::bitwise<bit_xor_op>,
+                    avx512::bitwise<bit_andnot_op>,
+                    popcount_for(level)};
+        case isa::avx2:
+            return {level,
+                    avx2::bitwise<bit_and_op>,
+                    avx2::bitwise<bit_or_op>,
+                    avx2::bitwise<bit_xor_op>,
+                    avx2::bitwise<bit_andnot_op>,
+                    popcount_for(level)};
+        case isa::sse4:
+        case isa::sse2:
+            return {level,
+                    sse2::bitwise<bit_and_op>,
+                    sse2::bitwise<bit_or_op>,
+                    sse2::bitwise<bit_xor_op>,
+                    sse2::bitwise<bit_andnot_op>,
+                    popcount_for(level)};
+        default:
+            break;
+        }
+#endif
+        return {isa::scalar,
+                scalar::bitwise<bit_and_op>,
+                scalar::bitwise<bit_or_op>,
+                scalar::bitwise<bit_xor_op>,
+                scalar::bitwise<bit_andnot_op>,
+                scalar::popcount};
+    }
+};
+
+// 对外接口: 经 dispatch() 选择的内核完成, T 须满足 is_vectorizable
+
+template <typename T> inline const T *find(const T *first, const T *last, T val)
+{
+    return first + dispatch<search_kernels<T>>().find(first, last - first, val);
+}
+
+template <typename T> inline std::size_t count(const T *first, const T *last, T val)
+{
+    const typename search_kernels<T>::table &kernels = dispatch<search_kernels<T>>();
+    std::size_t result = 0;
+    while (first != last)
+    {
+        std::size_t n = std::size_t(last - first) < SIMD_MAX_BLOCK ? last - first : SIMD_MAX_BLOCK;
+        result += kernels.count(first, n, val);
+        first += n;
+    }
+    return result;
+}
+
+// 只支持 min_element, max_element 与 minmax_element 三种规则
+template <bool Min, bool Max, bool LastMax, typename T>
+inline typename search_kernels<T>::extrema_kernel extrema_entry()
+{
+    static_assert(Min || Max, "at least one of Min and Max");
+    static_assert(LastMax == (Min && Max), "LastMax is used by minmax_element only");
+    const typename search_kernels<T>::table &kernels = dispatch<search_kernels<T>>();
+    return Min ? (Max ? kernels.minmax : kernels.min) : kernels.max;
+}
+
+// 返回最小与最大元素的下标, 规则同 minmax_element (LastMax 为 true) 或
+// min_element/max_element (LastMax 为 false); n 须大于 0
+template <bool Min, bool Max, bool LastMax, typename T>
+inline extrema find_extrema(const T *p, std::size_t n)
+{
+    typename search_kernels<T>::extrema_kernel kernel = extrema_entry<Min, Max, LastMax, T>();
+    std::size_t first_len = n < SIMD_MAX_BLOCK ? n : SIMD_MAX_BLOCK;
+    extrema result = kernel(p, first_len);
+    for (std::size_t base = SIMD_MAX_BLOCK; base < n; base += SIMD_MAX_BLOCK)
+    {
+        std::size_t len = n - base < SIMD_MAX_BLOCK ? n - base : SIMD_MAX_BLOCK;
+        extrema block = kernel(p + base, len);
+        if (p[base + block.min] < p[result.min])
+        {
+            result.min = base + block.min;
+        }
+        if (LastMax ? !(p[base + block.max] < p[result.max]) : p[result.max] < p[base + block.max])
+        {
+            result.max = base + block.max;
+        }
+    }
+    return result;
+}
+
+// 位图运算: dst[i] = dst[i] op src[i], i < n
+
+inline void bit_and(std::uint64_t *dst, const std::uint64_t *src, std::size_t n)
+{
+    if (n < SIMD_BITWISE_MIN)
+    {
+        scalar::bitwise<bit_and_op>(dst, src, n);
+        return;
+    }
+    dispatch<bit_kernels>().and_(dst, src, n);
+}
+
+inline void bit_or(std::uint64_t *dst, const std::uint64_t *src, std::size_t n)
+{
+    if (n < SIMD_BITWISE_MIN)
+    {
+        scalar::bitwise<bit_or_op>(dst, src, n);
+        return;
+    }
+    dispatch<bit_kernels>().or_(dst, src, n);
+}
+
+inline void bit_xor(std::uint64_t *dst, const std::uint64_t *src, std::size_t n)
+{
+    if (n < SIMD_BITWISE_MIN)
+    {
+        scalar::bitwise<bit_xor_op>(dst, src, n);
+        return;
+    }
+    dispatch<bit_kernels>().xor_(dst, src, n);
+}
+
+// dst[i] &= ~src[i]
+inline void bit_andnot(std::uint64_t *dst, const std::uint64_t *src, std::size_t n)
+{
+    if (n < SIMD_BITWISE_MIN)
+    {
+        scalar::bitwise<bit_andnot_op>(dst, src, n);
+        return;
+    }
+    dispatch<bit_kernels>().andnot(dst, src, n);
+}
+
+// p[0, n) 中置位的总数
+inline std::size_t popcount(const std::uint64_t *p, std::size_t n)
+{
+    if (n < SIMD_BITWISE_MIN)
+    {
+        return scalar::popcount(p, n);
+    }
+    return dispatch<bit_kernels>().popcount(p, n);
+}
+
+// [first, last) 每个元素赋为 val; T 须满足 is_pattern_fillable
+template <typename T> inline void fill(T *first, T *last, T val)
+{
+    using pattern_type = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    std::size_t n = last - first;
+    if (n < SIMD_FILL_MIN)
+    {
+        for (; first != last; ++first)
+        {
+            *first = val;
+        }
+        return;
+    }
+    pattern_type pattern;
+    std::memcpy(&pattern, &val, sizeof(T));
+    dispatch<fill_kernels<pattern_type>>().fill(first, n, pattern);
+}
+
+} // namespace simd
+} // namespace TS
+
+#endif
@@ -0,0 +1,603 @@
+#ifndef TS_SORT_HPP
+#define TS_SORT_HPP
+
+#include "ts_algorithm.hpp"
+#include "ts_iterator.hpp"
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// 不稳定排序: pattern-defeating quicksort (pdqsort)
+// - 小区间插入排序; 非最左区间的插入排序以左侧的主元为哨兵, 省去边界检查
+// - 主元取三数中值, 大区间取 ninther
+// - 划分后两侧都没有移动元素时试探性地插入排序, 已有序或接近有序的输入为线性时间
+// - 主元与左侧相邻元素相等时, 把等于主元的元素全部划到左侧, 重复值多的输入为线性时间
+// - 划分严重不均时打乱若干元素破坏构造的坏输入, 次数超过 log2(n) 时改用堆排序, 最坏 O(n log n)
+// 连续存储 (指针) 上的算术类型且使用默认比较时, 按块记录需交换元素的偏移再批量交换,
+// 划分循环中没有依赖比较结果的分支
+
+namespace TS
+{
+// 短于该长度的区间使用插入排序
+const std::ptrdiff_t SORT_INSERTION_THRESHOLD = 24;
+// 长于该长度的区间以 ninther 取主元
+const std::ptrdiff_t SORT_NINTHER_THRESHOLD = 128;
+// 试探性插入排序允许移动的元素总数, 超过即放弃
+const std::size_t SORT_PARTIAL_INSERTION_LIMIT = 8;
+// 块划分每块的元素数, 偏移量以 unsigned char 存储
+const std::size_t SORT_BLOCK_SIZE = 64;
+
+// less_op, std::less, std::greater 对算术类型的比较不会抛出异常, 也没有副作用
+template <typename Compare, typename T> struct is_default_compare : std::false_type
+{
+};
+
+template <typename T> struct is_default_compare<less_op, T> : std::true_type
+{
+};
+
+template <typename T> struct is_default_compare<std::less<T>, T> : std::true_type
+{
+};
+
+template <typename T> struct is_default_compare<std::less<>, T> : std::true_type
+{
+};
+
+template <typename T> struct is_default_compare<std::greater<T>, T> : std::true_type
+{
+};
+
+template <typename T> struct is_default_compare<std::greater<>, T> : std::true_type
+{
+};
+
+template <typename RandomIter, typename Compare>
+struct is_branchless_sortable
+    : std::integral_constant<
+          bool, std::is_pointer<RandomIter>::value &&
+                    std::is_arithmetic<typename iterator_traits<RandomIter>::value_type>::value &&
+                    is_default_compare<Compare,
+                                       typename iterator_traits<RandomIter>::value_type>::value>
+{
+};
+
+template <typename RandomIter> inline void sort_iter_swap(RandomIter a, RandomIter b)
+{
+    using std::swap;
+    swap(*a, *b);
+}
+
+template <typename RandomIter, typename Compare>
+inline void sort2(RandomIter a, RandomIter b, Compare &comp)
+{
+    if (comp(*b, *a))
+    {
+        sort_iter_swap(a, b);
+    }
+}
+
+template <typename RandomIter, typename Compare>
+inline void sort3(RandomIter a, RandomIter b, RandomIter c, Compare &comp)
+{
+    sort2(a, b, comp);
+    sort2(b, c, comp);
+    sort2(a, b, comp);
+}
+
+template <typename RandomIter, typename Compare>
+void sort_insertion(RandomIter first, RandomIter last, Compare &comp)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    if (first == last)
+    {
+        return;
+    }
+    for (RandomIter cur = first + 1; cur != last; ++cur)
+    {
+        RandomIter hole = cur;
+        RandomIter prev = cur - 1;
+        if (comp(*hole, *prev))
+        {
+            value_type tmp = std::move(*hole);
+            do
+            {
+                *hole-- = std::move(*prev);
+            } while (hole != first && comp(tmp, *--prev));
+            *hole = std::move(tmp);
+        }
+    }
+}
+
+// 要求 first 之前的元素不大于区间内任何元素, 以它为哨兵
+template <typename RandomIter, typename Compare>
+void sort_unguarded_insertion(RandomIter first, RandomIter last, Compare &comp)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    if (first == last)
+    {
+        return;
+    }
+    for (RandomIter cur = first + 1; cur != last; ++cur)
+    {
+        RandomIter hole = cur;
+        RandomIter prev = cur - 1;
+        if (comp(*hole, *prev))
+        {
+            value_type tmp = std::move(*hole);
+            do
+            {
+                *hole-- = std::move(*prev);
+            } while (comp(tmp, *--prev));
+            *hole = std::move(tmp);
+        }
+    }
+}
+
+// 移动的元素总数超过 SORT_PARTIAL_INSERTION_LIMIT 时放弃并返回 false, 此时区间只是部分有序
+template <typename RandomIter, typename Compare>
+bool sort_partial_insertion(RandomIter first, RandomIter last, Compare &comp)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    if (first == last)
+    {
+        return true;
+    }
+    std::size_t moved = 0;
+    for (RandomIter cur = first + 1; cur != last; ++cur)
+    {
+        RandomIter hole = cur;
+        RandomIter prev = cur - 1;
+        if (comp(*hole, *prev))
+        {
+            value_type tmp = std::move(*hole);
+            do
+            {
+                *hole-- = std::move(*prev);
+            } while (hole != first && comp(tmp, *--prev));
+            *hole = std::move(tmp);
+            moved += cur - hole;
+        }
+        if (moved > SORT_PARTIAL_INSERTION_LIMIT)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 堆排序, 划分反复失衡时的后备
+
+template <typename RandomIter, typename Distance, typename T, typename Compare>
+void sort_sift_down(RandomIter first, Distance hole, Distance len, T value, Compare &comp)
+{
+    Distance child;
+    while ((child = 2 * hole + 1) < len)
+    {
+        if (child + 1 < len && comp(first[child], first[child + 1]))
+        {
+            ++child;
+        }
+        if (!comp(value, first[child]))
+        {
+            break;
+        }
+        first[hole] = std::move(first[child]);
+        hole = child;
+    }
+    first[hole] = std::move(value);
+}
+
+template <typename RandomIter, typename Compare>
+void sort_heap_fallback(RandomIter first, RandomIter last, Compare &comp)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    using difference_type = typename iterator_traits<RandomIter>::difference_type;
+    difference_type len = last - first;
+    for (difference_type hole = len / 2; hole-- > 0;)
+    {
+        value_type tmp = std::move(first[hole]);
+        sort_sift_down(first, hole, len, std::move(tmp), comp);
+    }
+    while (len > 1)
+    {
+        --len;
+        value_type tmp = std::move(first[len]);
+        first[len] = std::move(*first);
+        sort_sift_down(first, difference_type(0), len, std::move(tmp), comp);
+    }
+}
+
+// 划分
+
+// 以 *first 为主元, 小于主元的元素放在左侧, 其余放在右侧; 返回主元的最终位置,
+// 以及划分前区间是否本已划分好 (没有交换任何元素)
+// 要求区间中至少有一个元素不小于主元 (三数取中保证)
+template <typename RandomIter, typename Compare>
+std::pair<RandomIter, bool> sort_partition_right(RandomIter first, RandomIter last,
+                                                 Compare &comp)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    RandomIter begin = first;
+    value_type pivot = std::move(*first);
+
+    while (comp(*++first, pivot))
+    {
+    }
+    // 左侧没有元素时右侧的扫描需检查边界
+    if (first - 1 == begin)
+    {
+        while (first < last && !comp(*--last, pivot))
+        {
+        }
+    }
+    else
+    {
+        while (!comp(*--last, pivot))
+        {
+        }
+    }
+
+    bool already_partitioned = first >= last;
+    while (first < last)
+    {
+        sort_iter_swap(first, last);
+        while (comp(*++first, pivot))
+        {
+        }
+        while (!comp(*--last, pivot))
+        {
+        }
+    }
+
+    RandomIter pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return std::pair<RandomIter, bool>(pivot_pos, already_partitioned);
+}
+
+// 按 offsets_l / offsets_r 成对交换 num 个元素; 两侧个数相同时逐对交换,
+// 否则沿一条环移动, 每个元素只移动一次
+template <typename RandomIter>
+void sort_swap_offsets(RandomIter first, RandomIter last, const unsigned char *offsets_l,
+                       const unsigned char *offsets_r, std::size_t num, bool use_swaps)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    if (use_swaps)
+    {
+        for (std::size_t i = 0; i < num; ++i)
+        {
+            sort_iter_swap(first + offsets_l[i], last - offsets_r[i]);
+        }
+    }
+    else if (num > 0)
+    {
+        RandomIter l = first + offsets_l[0];
+        RandomIter r = last - offsets_r[0];
+        value_type tmp(std::move(*l));
+        *l = std::move(*r);
+        for (std::size_t i = 1; i < num; ++i)
+        {
+            l = first + offsets_l[i];
+            *r = std::move(*l);
+            r = last - offsets_r[i];
+            *l = std::move(*r);
+        }
+        *r = std::move(tmp);
+    }
+}
+
+// 与 sort_partition_right 相同, 但两端各按块比较并记录错位元素的偏移, 再成批交换
+// 比较结果只用于累加计数, 不产生分支, 避免随机数据上的分支预测失败
+template <typename RandomIter, typename Compare>
+std::pair<RandomIter, bool> sort_partition_right_branchless(RandomIter first, RandomIter last,
+                                                            Compare &comp)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    RandomIter begin = first;
+    value_type pivot = std::move(*first);
+
+    while (comp(*++first, pivot))
+    {
+    }
+    if (first - 1 == begin)
+    {
+        while (first < last && !comp(*--last, pivot))
+        {
+        }
+    }
+    else
+    {
+        while (!comp(*--last, pivot))
+        {
+        }
+    }
+
+    bool already_partitioned = first >= last;
+    if (!already_partitioned)
+    {
+        sort_iter_swap(first, last);
+        ++first;
+
+        alignas(64) unsigned char offsets_l[SORT_BLOCK_SIZE];
+        alignas(64) unsigned char offsets_r[SORT_BLOCK_SIZE];
+        RandomIter offsets_l_base = first;
+        RandomIter offsets_r_base = last;
+        std::size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        while (first < last)
+        {
+            // 有一侧的偏移用完时才填充该侧; 剩余元素不足两块时两侧平分
+            std::size_t num_unknown = last - first;
+            std::size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+            std::size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+            std::size_t left_count = left_split < SORT_BLOCK_SIZE ? left_split : SORT_BLOCK_SIZE;
+            std::size_t right_count =
+                right_split < SORT_BLOCK_SIZE ? right_split : SORT_BLOCK_SIZE;
+
+            for (std::size_t i = 0; i < left_count; ++i)
+            {
+                offsets_l[num_l] = static_cast<unsigned char>(i);
+                num_l += !comp(*first, pivot);
+                ++first;
+            }
+            for (std::size_t i = 0; i < right_count;)
+            {
+                offsets_r[num_r] = static_cast<unsigned char>(++i);
+                num_r += comp(*--last, pivot);
+            }
+
+            std::size_t num = num_l < num_r ? num_l : num_r;
+            sort_swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l,
+                              offsets_r + start_r, num, num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+            if (num_l == 0)
+            {
+                start_l = 0;
+                offsets_l_base = first;
+            }
+            if (num_r == 0)
+            {
+                start_r = 0;
+                offsets_r_base = last;
+            }
+        }
+
+        // 一侧还有剩余的错位元素时, 逐个换到分界处
+        if (num_l)
+        {
+            while (num_l--)
+            {
+                sort_iter_swap(offsets_l_base + offsets_l[start_l + num_l], --last);
+            }
+            first = last;
+        }
+        if (num_r)
+        {
+            while (num_r--)
+            {
+                sort_iter_swap(offsets_r_base - offsets_r[start_r + num_r], first);
+                ++first;
+            }
+            last = first;
+        }
+    }
+
+    RandomIter pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return std::pair<RandomIter, bool>(pivot_pos, already_partitioned);
+}
+
+// 等于主元的元素放在左侧, 大于主元的放在右侧; 返回主元的最终位置
+// 用于主元等于左侧相邻元素 (即已知的区间下界) 时, 左侧部分全部等于主元, 无需再排序
+template <typename RandomIter, typename Compare>
+RandomIter sort_partition_left(RandomIter first, RandomIter last, Compare &comp)
+{
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    RandomIter begin = first;
+    RandomIter end = last;
+    value_type pivot = std::move(*first);
+
+    while (comp(pivot, *--last))
+    {
+    }
+    if (last + 1 == end)
+    {
+        while (first < last && !comp(pivot, *++first))
+        {
+        }
+    }
+    else
+    {
+        while (!comp(pivot, *++first))
+        {
+        }
+    }
+
+    while (first < last)
+    {
+        sort_iter_swap(first, last);
+        while (comp(pivot, *--last))
+        {
+        }
+        while (!comp(pivot, *++first))
+        {
+        }
+    }
+
+    *begin = std::move(*last);
+    *last = std::move(pivot);
+    return last;
+}
+
+template <typename RandomIter, typename Compare>
+inline std::pair<RandomIter, bool> sort_partition(RandomIter first, RandomIter last,
+                                                  Compare &comp, std::false_type)
+{
+    return sort_partition_right(first, last, comp);
+}
+
+template <typename RandomIter, typename Compare>
+inline std::pair<RandomIter, bool> sort_partition(RandomIter first, RandomIter last,
+                                                  Compare &comp, std::true_type)
+{
+    return sort_partition_right_branchless(first, last, comp);
+}
+
+// 打乱 pivot_pos 左右两侧的若干元素, 使下一次取到的主元偏离构造的坏模式
+template <typename RandomIter>
+void sort_break_patterns(RandomIter first, RandomIter pivot_pos, RandomIter last)
+{
+    std::ptrdiff_t l_size = pivot_pos - first;
+    std::ptrdiff_t r_size = last - (pivot_pos + 1);
+    if (l_size >= SORT_INSERTION_THRESHOLD)
+    {
+        sort_iter_swap(first, first + l_size / 4);
+        sort_iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+        if (l_size > SORT_NINTHER_THRESHOLD)
+        {
+            sort_iter_swap(first + 1, first + (l_size / 4 + 1));
+            sort_iter_swap(first + 2, first + (l_size / 4 + 2));
+            sort_iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+            sort_iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+        }
+    }
+    if (r_size >= SORT_INSERTION_THRESHOLD)
+    {
+        sort_iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+        sort_iter_swap(last - 1, last - r_size / 4);
+        if (r_size > SORT_NINTHER_THRESHOLD)
+        {
+            sort_iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+            sort_iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+            sort_iter_swap(last - 2, last - (1 + r_size / 4));
+            sort_iter_swap(last - 3, last - (2 + r_size / 4));
+        }
+    }
+}
+
+// bad_allowed: 还允许出现多少次严重失衡的划分
+// leftmost: 区间是否在整个序列的最左端, 否则 *(first - 1) 不大于区间内的任何元素
+template <typename RandomIter, typename Compare, typename Branchless>
+void sort_loop(RandomIter first, RandomIter last, Compare &comp, int bad_allowed, bool leftmost,
+               Branchless branchless)
+{
+    while (true)
+    {
+        std::ptrdiff_t size = last - first;
+        if (size < SORT_INSERTION_THRESHOLD)
+        {
+            if (leftmost)
+            {
+                sort_insertion(first, last, comp);
+            }
+            else
+            {
+                sort_unguarded_insertion(first, last, comp);
+            }
+            return;
+        }
+
+        // 主元换到 first
+        std::ptrdiff_t half = size / 2;
+        if (size > SORT_NINTHER_THRESHOLD)
+        {
+            sort3(first, first + half, last - 1, comp);
+            sort3(first + 1, first + (half - 1), last - 2, comp);
+            sort3(first + 2, first + (half + 1), last - 3, comp);
+            sort3(first + (half - 1), first + half, first + (half + 1), comp);
+            sort_iter_swap(first, first + half);
+        }
+        else
+        {
+            sort3(first + half, first, last - 1, comp);
+        }
+
+        // 主元等于左侧的下界: 区间中有大量重复值, 把等于主元的元素一次划走
+        if (!leftmost && !comp(*(first - 1), *first))
+        {
+            first = sort_partition_left(first, last, comp) + 1;
+            continue;
+        }
+
+        std::pair<RandomIter, bool> part = sort_partition(first, last, comp, branchless);
+        RandomIter pivot_pos = part.first;
+        std::ptrdiff_t l_size = pivot_pos - first;
+        std::ptrdiff_t r_size = last - (pivot_pos + 1);
+
+        if (l_size < size / 8 || r_size < size / 8)
+        {
+            if (--bad_allowed == 0)
+            {
+                sort_heap_fallback(first, last, comp);
+                return;
+            }
+            sort_break_patterns(first, pivot_pos, last);
+        }
+        else if (part.second && sort_partial_insertion(first, pivot_pos, comp) &&
+                 sort_partial_insertion(pivot_pos + 1, last, comp))
+        {
+            // 本已划分好且两侧都接近有序, 试探性插入排序已完成排序
+            return;
+        }
+
+        // 递归处理左侧, 循环处理右侧
+        sort_loop(first, pivot_pos, comp, bad_allowed, leftmost, branchless);
+        first = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+template <typename RandomIter, typename Compare>
+inline void sort(RandomIter first, RandomIter last, Compare comp)
+{
+    static_assert(std::is_base_of<random_access_iterator_tag,
+                                  typename iterator_traits<RandomIter>::iterator_category>::value,
+                  "TS::sort requires random access iterators");
+    if (last - first < 2)
+    {
+        return;
+    }
+    int bad_allowed = 1;
+    for (std::size_t n = last - first; n >>= 1;)
+    {
+        ++bad_allowed;
+    }
+    sort_loop(first, last, comp, bad_allowed, true, is_branchless_sortable<RandomIter, Compare>());
+}
+
+template <typename RandomIter> inline void sort(RandomIter first, RandomIter last)
+{
+    TS::sort(first, last, less_op());
+}
+
+template <typename ForwardIter, typename Compare>
+inline bool is_sorted(ForwardIter first, ForwardIter last, Compare comp)
+{
+    if (first == last)
+    {
+        return true;
+    }
+    for (ForwardIter next = first; ++next != last; first = next)
+    {
+        if (comp(*next, *first))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename ForwardIter> inline bool is_sorted(ForwardIter first, ForwardIter last)
+{
+    return TS::is_sorted(first, last, less_op());
+}
+
+} // namespace TS
+
+#endif
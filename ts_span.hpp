@@ -0,0 +1,321 @@
+#ifndef TS_SPAN_HPP
+#define TS_SPAN_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace TS
+{
+template <typename T, std::size_t N, std::size_t Align> class array;
+template <typename T, typename Alloc> class vector;
+
+const std::size_t dynamic_extent = std::numeric_limits<std::size_t>::max();
+
+template <typename T, std::size_t Extent = dynamic_extent> class span;
+
+template <typename T> struct is_span : std::false_type
+{
+};
+
+template <typename T, std::size_t Extent> struct is_span<span<T, Extent>> : std::true_type
+{
+};
+
+// U 的数组可按 T 的数组访问 (仅允许增加 const 限定)
+template <typename U, typename T>
+using is_span_convertible = std::is_convertible<U (*)[], T (*)[]>;
+
+template <std::size_t N, std::size_t Extent>
+using is_extent_compatible = std::integral_constant<bool, Extent == dynamic_extent || N == Extent>;
+
+template <std::size_t Extent, std::size_t Offset, std::size_t Count>
+using subspan_extent = std::integral_constant<
+    std::size_t, Count != dynamic_extent
+                     ? Count
+                     : (Extent != dynamic_extent ? Extent - Offset : dynamic_extent)>;
+
+// 具有 data()/size() 且元素指针可转换为 T* 的连续容器 (vector, string 等)
+template <typename Container, typename T, typename = void>
+struct is_span_compatible_container : std::false_type
+{
+};
+
+template <typename Container, typename T>
+struct is_span_compatible_container<
+    Container, T,
+    typename std::enable_if<
+        !is_span<typename std::remove_cv<Container>::type>::value &&
+        is_span_convertible<
+            typename std::remove_pointer<decltype(std::declval<Container &>().data())>::type,
+            T>::value &&
+        std::is_integral<decltype(std::declval<Container &>().size())>::value>::type>
+    : std::true_type
+{
+};
+
+// 静态长度只保存指针, 动态长度额外保存元素个数
+template <typename T, std::size_t Extent> class span_storage
+{
+  public:
+    constexpr span_storage(T *data, std::size_t) noexcept : _data(data)
+    {
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        return Extent;
+    }
+
+  protected:
+    T *_data;
+};
+
+template <typename T> class span_storage<T, dynamic_extent>
+{
+  public:
+    constexpr span_storage(T *data, std::size_t count) noexcept : _data(data), _size(count)
+    {
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        return _size;
+    }
+
+  protected:
+    T *_data;
+    std::size_t _size;
+};
+
+// 非拥有的连续区间视图, 拷贝只复制指针与长度
+template <typename T, std::size_t Extent> class span : public span_storage<T, Extent>
+{
+  public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = element_type &;
+    using const_reference = const element_type &;
+    using pointer = element_type *;
+    using const_pointer = const element_type *;
+    using iterator = element_type *;
+
+    static constexpr size_type extent = Extent;
+
+  protected:
+    using base = span_storage<T, Extent>;
+    using self = span<T, Extent>;
+
+    using base::_data;
+
+  public:
+    template <std::size_t E = Extent,
+              typename = typename std::enable_if<E == 0 || E == dynamic_extent>::type>
+    constexpr span() noexcept : base(nullptr, 0)
+    {
+    }
+
+    constexpr span(pointer first, size_type count) : base(first, count)
+    {
+        assert(Extent == dynamic_extent || count == Extent);
+    }
+
+    constexpr span(pointer first, pointer last) : base(first, last - first)
+    {
+        assert(Extent == dynamic_extent || size_type(last - first) == Extent);
+    }
+
+    template <std::size_t N,
+              typename = typename std::enable_if<is_extent_compatible<N, Extent>::value>::type>
+    constexpr span(element_type (&arr)[N]) noexcept : base(arr, N)
+    {
+    }
+
+    template <typename U, std::size_t N, std::size_t A,
+              typename = typename std::enable_if<is_extent_compatible<N, Extent>::value &&
+                                                 is_span_convertible<U, T>::value>::type>
+    constexpr span(array<U, N, A> &arr) noexcept : base(arr.data(), N)
+    {
+    }
+
+    template <typename U, std::size_t N, std::size_t A,
+              typename = typename std::enable_if<is_extent_compatible<N, Extent>::value &&
+                                                 is_span_convertible<const U, T>::value>::type>
+    constexpr span(const array<U, N, A> &arr) noexcept : base(arr.data(), N)
+    {
+    }
+
+    // 动态长度可从任意连续容器隐式构造
+    template <typename Container,
+              typename = typename std::enable_if<
+                  Extent == dynamic_extent &&
+                  is_span_compatible_container<Container, T>::value>::type>
+    constexpr span(Container &cont) : base(cont.data(), cont.size())
+    {
+    }
+
+    template <typename Container,
+              typename = typename std::enable_if<
+                  Extent == dynamic_extent &&
+                  is_span_compatible_container<const Container, T>::value>::type>
+    constexpr span(const Container &cont) : base(cont.data(), cont.size())
+    {
+    }
+
+    template <typename U, std::size_t N,
+              typename = typename std::enable_if<is_extent_compatible<N, Extent>::value &&
+                                                 is_span_convertible<U, T>::value>::type>
+    constexpr span(const span<U, N> &other) noexcept : base(other.data(), other.size())
+    {
+    }
+
+    constexpr span(const self &other) noexcept = default;
+
+    self &operator=(const self &other) noexcept = default;
+
+    // element access
+
+    constexpr reference operator[](size_type pos) const
+    {
+        assert(pos < size());
+        return _data[pos];
+    }
+
+    reference at(size_type pos) const
+    {
+        if (pos >= size())
+        {
+            throw std::out_of_range("span::at - index out of range");
+        }
+        return _data[pos];
+    }
+
+    constexpr reference front() const
+    {
+        assert(!empty());
+        return _data[0];
+    }
+
+    constexpr reference back() const
+    {
+        assert(!empty());
+        return _data[size() - 1];
+    }
+
+    constexpr pointer data() const noexcept
+    {
+        return _data;
+    }
+
+    // iterators
+
+    constexpr iterator begin() const noexcept
+    {
+        return _data;
+    }
+
+    constexpr iterator end() const noexcept
+    {
+        return _data + size();
+    }
+
+    // observers
+
+    using base::size;
+
+    constexpr size_type size_bytes() const noexcept
+    {
+        return size() * sizeof(element_type);
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    // subviews
+
+    template <std::size_t Count> constexpr span<element_type, Count> first() const
+    {
+        static_assert(Extent == dynamic_extent || Count <= Extent, "span::first out of range");
+        assert(Count <= size());
+        return span<element_type, Count>(_data, Count);
+    }
+
+    template <std::size_t Count> constexpr span<element_type, Count> last() const
+    {
+        static_assert(Extent == dynamic_extent || Count <= Extent, "span::last out of range");
+        assert(Count <= size());
+        return span<element_type, Count>(_data + (size() - Count), Count);
+    }
+
+    template <std::size_t Offset, std::size_t Count = dynamic_extent>
+    constexpr span<element_type, subspan_extent<Extent, Offset, Count>::value> subspan() const
+    {
+        static_assert(Extent == dynamic_extent || Offset <= Extent, "span::subspan out of range");
+        static_assert(Extent == dynamic_extent || Count == dynamic_extent ||
+                          Count <= Extent - Offset,
+                      "span::subspan out of range");
+        assert(Offset <= size());
+        assert(Count == dynamic_extent || Count <= size() - Offset);
+        using result = span<element_type, subspan_extent<Extent, Offset, Count>::value>;
+        return result(_data + Offset, Count == dynamic_extent ? size() - Offset : Count);
+    }
+
+    constexpr span<element_type> first(size_type count) const
+    {
+        assert(count <= size());
+        return span<element_type>(_data, count);
+    }
+
+    constexpr span<element_type> last(size_type count) const
+    {
+        assert(count <= size());
+        return span<element_type>(_data + (size() - count), count);
+    }
+
+    constexpr span<element_type> subspan(size_type offset, size_type count = dynamic_extent) const
+    {
+        assert(offset <= size());
+        assert(count == dynamic_extent || count <= size() - offset);
+        return span<element_type>(_data + offset,
+                                  count == dynamic_extent ? size() - offset : count);
+    }
+};
+
+template <typename T, std::size_t Extent> constexpr std::size_t span<T, Extent>::extent;
+
+// deduction guides
+template <typename T, std::size_t N> span(T (&)[N]) -> span<T, N>;
+template <typename T, std::size_t N, std::size_t A> span(array<T, N, A> &) -> span<T, N>;
+template <typename T, std::size_t N, std::size_t A>
+span(const array<T, N, A> &) -> span<const T, N>;
+template <typename T, typename Alloc> span(vector<T, Alloc> &) -> span<T>;
+template <typename T, typename Alloc> span(const vector<T, Alloc> &) -> span<const T>;
+
+template <typename T, std::size_t Extent>
+span<const unsigned char, Extent == dynamic_extent ? dynamic_extent : sizeof(T) * Extent>
+as_bytes(span<T, Extent> s) noexcept
+{
+    using result =
+        span<const unsigned char, Extent == dynamic_extent ? dynamic_extent : sizeof(T) * Extent>;
+    return result(reinterpret_cast<const unsigned char *>(s.data()), s.size_bytes());
+}
+
+template <typename T, std::size_t Extent,
+          typename = typename std::enable_if<!std::is_const<T>::value>::type>
+span<unsigned char, Extent == dynamic_extent ? dynamic_extent : sizeof(T) * Extent>
+as_writable_bytes(span<T, Extent> s) noexcept
+{
+    using result =
+        span<unsigned char, Extent == dynamic_extent ? dynamic_extent : sizeof(T) * Extent>;
+    return result(reinterpret_cast<unsigned char *>(s.data()), s.size_bytes());
+}
+
+} // namespace TS
+
+#endif
@@ -0,0 +1,883 @@
+#ifndef TS_STRING_HPP
+#define TS_STRING_HPP
+
+#include "ts_alloc.hpp"
+#include "ts_string_view.hpp"
+#include "ts_uninitialized.hpp"
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace TS
+{
+// 短字符串直接存放在对象内部 (SSO), 不含自指针, 因此可平凡重定位
+// char 在 64 位平台上可内联 23 个字符
+template <typename CharT, typename Alloc = alloc> class basic_string
+{
+  public:
+    using traits_type = std::char_traits<CharT>;
+    using value_type = CharT;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using iterator = value_type *;
+    using const_iterator = const value_type *;
+    using view_type = basic_string_view<CharT>;
+
+    static const size_type npos = static_cast<size_type>(-1);
+
+  protected:
+    using data_allocator = simple_alloc<CharT, Alloc>;
+    using self = basic_string<CharT, Alloc>;
+
+    struct long_rep
+    {
+        pointer _ptr;
+        size_type _size;
+        size_type _cap;
+    };
+
+    static constexpr size_type LOCAL_CAPACITY = sizeof(long_rep) / sizeof(CharT) - 1;
+    static constexpr unsigned char HEAP_FLAG = 0xFF;
+
+    static_assert(LOCAL_CAPACITY < HEAP_FLAG, "local capacity must fit in the size byte");
+
+  public:
+    ~basic_string()
+    {
+        release();
+    }
+
+    basic_string() noexcept
+    {
+        set_local_empty();
+    }
+
+    basic_string(const CharT *s)
+    {
+        initialize(s, traits_type::length(s));
+    }
+
+    basic_string(const CharT *s, size_type count)
+    {
+        initialize(s, count);
+    }
+
+    basic_string(size_type count, CharT ch)
+    {
+        set_local_empty();
+        append(count, ch);
+    }
+
+    template <typename InputIter, typename = typename std::iterator_traits<InputIter>::value_type>
+    basic_string(InputIter first, InputIter last)
+    {
+        set_local_empty();
+        for (; first != last; ++first)
+        {
+            push_back(*first);
+        }
+    }
+
+    basic_string(const self &other)
+    {
+        initialize(other.data(), other.size());
+    }
+
+    basic_string(const self &other, size_type pos, size_type count = npos)
+    {
+        if (pos > other.size())
+        {
+            throw std::out_of_range("basic_string - position out of range");
+        }
+        initialize(other.data() + pos, clamp(count, other.size() - pos));
+    }
+
+    basic_string(self &&other) noexcept : _rep(other._rep), _local_size(other._local_size)
+    {
+        other.set_local_empty();
+    }
+
+    basic_string(std::initializer_list<CharT> init)
+    {
+        initialize(init.begin(), init.size());
+    }
+
+    explicit basic_string(view_type sv)
+    {
+        initialize(sv.data(), sv.size());
+    }
+
+    self &operator=(const self &other)
+    {
+        if (this != &other)
+        {
+            assign(other.data(), other.size());
+        }
+        return *this;
+    }
+
+    self &operator=(self &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            _rep = other._rep;
+            _local_size = other._local_size;
+            other.set_local_empty();
+        }
+        return *this;
+    }
+
+    self &operator=(const CharT *s)
+    {
+        return assign(s, traits_type::length(s));
+    }
+
+    self &operator=(CharT ch)
+    {
+        return assign(&ch, 1);
+    }
+
+    self &operator=(std::initializer_list<CharT> init)
+    {
+        return assign(init.begin(), init.size());
+    }
+
+    self &assign(const self &other)
+    {
+        return operator=(other);
+    }
+
+    self &assign(const CharT *s)
+    {
+        return assign(s, traits_type::length(s));
+    }
+
+    self &assign(const CharT *s, size_type count)
+    {
+        if (count <= capacity())
+        {
+            traits_type::move(get_pointer(), s, count);
+            set_size(count);
+        }
+        else
+        {
+            pointer p = data_allocator::allocate(count + 1);
+            traits_type::copy(p, s, count);
+            release();
+            set_heap(p, count, count);
+        }
+        return *this;
+    }
+
+    self &assign(size_type count, CharT ch)
+    {
+        clear();
+        return append(count, ch);
+    }
+
+    // element access
+
+    reference at(size_type pos)
+    {
+        return const_cast<reference>(static_cast<const self *>(this)->at(pos));
+    }
+
+    const_reference at(size_type pos) const
+    {
+        if (pos >= size())
+        {
+            throw std::out_of_range("basic_string::at - index out of range");
+        }
+        return operator[](pos);
+    }
+
+    reference operator[](size_type pos)
+    {
+        return const_cast<reference>(static_cast<const self *>(this)->operator[](pos));
+    }
+
+    const_reference operator[](size_type pos) const
+    {
+        return data()[pos];
+    }
+
+    reference front()
+    {
+        return const_cast<reference>(static_cast<const self *>(this)->front());
+    }
+
+    const_reference front() const
+    {
+        if (empty())
+        {
+            throw std::logic_error("empty string");
+        }
+        return data()[0];
+    }
+
+    reference back()
+    {
+        return const_cast<reference>(static_cast<const self *>(this)->back());
+    }
+
+    const_reference back() const
+    {
+        if (empty())
+        {
+            throw std::logic_error("empty string");
+        }
+        return data()[size() - 1];
+    }
+
+    pointer data() noexcept
+    {
+        return get_pointer();
+    }
+
+    const_pointer data() const noexcept
+    {
+        return get_pointer();
+    }
+
+    const_pointer c_str() const noexcept
+    {
+        return get_pointer();
+    }
+
+    // iterators
+
+    iterator begin() noexcept
+    {
+        return get_pointer();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return get_pointer();
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return get_pointer();
+    }
+
+    iterator end() noexcept
+    {
+        return get_pointer() + size();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return get_pointer() + size();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return get_pointer() + size();
+    }
+
+    // capacity
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    size_type size() const noexcept
+    {
+        return is_local() ? _local_size : _rep._heap._size;
+    }
+
+    size_type length() const noexcept
+    {
+        return size();
+    }
+
+    size_type capacity() const noexcept
+    {
+        return is_local() ? LOCAL_CAPACITY : _rep._heap._cap;
+    }
+
+    constexpr size_type max_size() const
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(CharT) - 1;
+    }
+
+    void reserve(size_type count)
+    {
+        if (count > capacity())
+        {
+            reallocate(count);
+        }
+    }
+
+    void shrink_to_fit()
+    {
+        if (is_local())
+        {
+            return;
+        }
+        size_type count = size();
+        if (count <= LOCAL_CAPACITY)
+        {
+            pointer p = _rep._heap._ptr;
+            size_type cap = _rep._heap._cap;
+            traits_type::copy(_rep._local, p, count);
+            _local_size = static_cast<unsigned char>(count);
+            _rep._local[count] = CharT();
+            data_allocator::deallocate(p, cap + 1);
+        }
+        else if (count < capacity())
+        {
+            reallocate(count);
+        }
+    }
+
+    // modifier
+
+    void clear() noexcept
+    {
+        set_size(0);
+    }
+
+    void push_back(CharT ch)
+    {
+        size_type count = size();
+        if (count == capacity())
+        {
+            reallocate(recommend(count + 1));
+        }
+        get_pointer()[count] = ch;
+        set_size(count + 1);
+    }
+
+    void pop_back()
+    {
+        if (empty())
+        {
+            throw std::logic_error("empty string");
+        }
+        set_size(size() - 1);
+    }
+
+    self &append(const self &other)
+    {
+        return append(other.data(), other.size());
+    }
+
+    self &append(const CharT *s)
+    {
+        return append(s, traits_type::length(s));
+    }
+
+    self &append(view_type sv)
+    {
+        return append(sv.data(), sv.size());
+    }
+
+    // s 可能指向自身, 扩容时先拷入新空间再释放旧空间
+    self &append(const CharT *s, size_type count)
+    {
+        size_type old_size = size();
+        if (count > capacity() - old_size)
+        {
+            size_type new_capacity = recommend(old_size + count);
+            pointer p = data_allocator::allocate(new_capacity + 1);
+            traits_type::copy(p, get_pointer(), old_size);
+            traits_type::copy(p + old_size, s, count);
+            release();
+            set_heap(p, old_size + count, new_capacity);
+        }
+        else
+        {
+            traits_type::move(get_pointer() + old_size, s, count);
+            set_size(old_size + count);
+        }
+        return *this;
+    }
+
+    self &append(size_type count, CharT ch)
+    {
+        size_type old_size = size();
+        if (count > capacity() - old_size)
+        {
+            reallocate(recommend(old_size + count));
+        }
+        traits_type::assign(get_pointer() + old_size, count, ch);
+        set_size(old_size + count);
+        return *this;
+    }
+
+    self &operator+=(const self &other)
+    {
+        return append(other.data(), other.size());
+    }
+
+    self &operator+=(const CharT *s)
+    {
+        return append(s, traits_type::length(s));
+    }
+
+    self &operator+=(CharT ch)
+    {
+        push_back(ch);
+        return *this;
+    }
+
+    self &insert(size_type pos, const self &other)
+    {
+        return insert(pos, other.data(), other.size());
+    }
+
+    self &insert(size_type pos, const CharT *s)
+    {
+        return insert(pos, s, traits_type::length(s));
+    }
+
+    self &insert(size_type pos, const CharT *s, size_type count)
+    {
+        size_type old_size = size();
+        if (pos > old_size)
+        {
+            throw std::out_of_range("basic_string::insert - position out of range");
+        }
+        if (s >= get_pointer() && s <= get_pointer() + old_size)
+        {
+            self tmp(s, count);
+            return insert(pos, tmp.data(), count);
+        }
+        if (count > capacity() - old_size)
+        {
+            reallocate(recommend(old_size + count));
+        }
+        pointer p = get_pointer();
+        traits_type::move(p + pos + count, p + pos, old_size - pos);
+        traits_type::copy(p + pos, s, count);
+        set_size(old_size + count);
+        return *this;
+    }
+
+    self &insert(size_type pos, size_type count, CharT ch)
+    {
+        size_type old_size = size();
+        if (pos > old_size)
+        {
+            throw std::out_of_range("basic_string::insert - position out of range");
+        }
+        if (count > capacity() - old_size)
+        {
+            reallocate(recommend(old_size + count));
+        }
+        pointer p = get_pointer();
+        traits_type::move(p + pos + count, p + pos, old_size - pos);
+        traits_type::assign(p + pos, count, ch);
+        set_size(old_size + count);
+        return *this;
+    }
+
+    iterator insert(const_iterator pos, CharT ch)
+    {
+        size_type index = pos - begin();
+        insert(index, 1, ch);
+        return begin() + index;
+    }
+
+    self &erase(size_type pos = 0, size_type count = npos)
+    {
+        size_type old_size = size();
+        if (pos > old_size)
+        {
+            throw std::out_of_range("basic_string::erase - position out of range");
+        }
+        count = clamp(count, old_size - pos);
+        pointer p = get_pointer();
+        traits_type::move(p + pos, p + pos + count, old_size - pos - count);
+        set_size(old_size - count);
+        return *this;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        size_type index = pos - begin();
+        erase(index, 1);
+        return begin() + index;
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        size_type index = first - begin();
+        erase(index, last - first);
+        return begin() + index;
+    }
+
+    void resize(size_type count)
+    {
+        resize(count, CharT());
+    }
+
+    void resize(size_type count, CharT ch)
+    {
+        size_type old_size = size();
+        if (count > old_size)
+        {
+            append(count - old_size, ch);
+        }
+        else
+        {
+            set_size(count);
+        }
+    }
+
+    void swap(self &other) noexcept
+    {
+        rep tmp_rep = _rep;
+        unsigned char tmp_local_size = _local_size;
+        _rep = other._rep;
+        _local_size = other._local_size;
+        other._rep = tmp_rep;
+        other._local_size = tmp_local_size;
+    }
+
+    // operations
+
+    self substr(size_type pos = 0, size_type count = npos) const
+    {
+        return self(*this, pos, count);
+    }
+
+    int compare(const self &other) const noexcept
+    {
+        return view().compare(other.view());
+    }
+
+    int compare(view_type other) const noexcept
+    {
+        return view().compare(other);
+    }
+
+    int compare(const CharT *s) const
+    {
+        return view().compare(view_type(s));
+    }
+
+    size_type find(const self &other, size_type pos = 0) const noexcept
+    {
+        return view().find(other.view(), pos);
+    }
+
+    size_type find(view_type needle, size_type pos = 0) const noexcept
+    {
+        return view().find(needle, pos);
+    }
+
+    size_type find(const CharT *s, size_type pos = 0) const
+    {
+        return view().find(view_type(s), pos);
+    }
+
+    size_type find(const CharT *s, size_type pos, size_type count) const noexcept
+    {
+        return view().find(view_type(s, count), pos);
+    }
+
+    size_type find(CharT ch, size_type pos = 0) const noexcept
+    {
+        return view().find(ch, pos);
+    }
+
+    size_type rfind(view_type needle, size_type pos = npos) const noexcept
+    {
+        return view().rfind(needle, pos);
+    }
+
+    size_type rfind(CharT ch, size_type pos = npos) const noexcept
+    {
+        return view().rfind(ch, pos);
+    }
+
+    bool starts_with(view_type prefix) const noexcept
+    {
+        return view().starts_with(prefix);
+    }
+
+    bool ends_with(view_type suffix) const noexcept
+    {
+        return view().ends_with(suffix);
+    }
+
+    view_type view() const noexcept
+    {
+        return view_type(data(), size());
+    }
+
+    operator view_type() const noexcept
+    {
+        return view();
+    }
+
+  protected:
+    static size_type clamp(size_type count, size_type limit)
+    {
+        return count < limit ? count : limit;
+    }
+
+    // 与 != HEAP_FLAG 等价; 写成上界比较, 编译器在内联分支上能看出下标不越界
+    bool is_local() const noexcept
+    {
+        return _local_size <= LOCAL_CAPACITY;
+    }
+
+    pointer get_pointer() noexcept
+    {
+        return is_local() ? _rep._local : _rep._heap._ptr;
+    }
+
+    const_pointer get_pointer() const noexcept
+    {
+        return is_local() ? _rep._local : _rep._heap._ptr;
+    }
+
+    void set_local_empty() noexcept
+    {
+        _local_size = 0;
+        _rep._local[0] = CharT();
+    }
+
+    void set_heap(pointer p, size_type count, size_type cap) noexcept
+    {
+        _rep._heap._ptr = p;
+        _rep._heap._size = count;
+        _rep._heap._cap = cap;
+        _local_size = HEAP_FLAG;
+        p[count] = CharT();
+    }
+
+    // 结束符经已选定的存储指针写入, 不以堆上长度下标访问内联缓冲区
+    void set_size(size_type count) noexcept
+    {
+        pointer p = get_pointer();
+        if (is_local())
+        {
+            _local_size = static_cast<unsigned char>(count);
+        }
+        else
+        {
+            _rep._heap._size = count;
+        }
+        p[count] = CharT();
+    }
+
+    void initialize(const CharT *s, size_type count)
+    {
+        if (count <= LOCAL_CAPACITY)
+        {
+            traits_type::copy(_rep._local, s, count);
+            _local_size = static_cast<unsigned char>(count);
+            _rep._local[count] = CharT();
+        }
+        else
+        {
+            pointer p = data_allocator::allocate(count + 1);
+            traits_type::copy(p, s, count);
+            set_heap(p, count, count);
+        }
+    }
+
+    void release() noexcept
+    {
+        if (!is_local())
+        {
+            data_allocator::deallocate(_rep._heap._ptr, _rep._heap._cap + 1);
+        }
+    }
+
+    // 与 vector 相同的倍增策略
+    size_type recommend(size_type required) const
+    {
+        if (required > max_size())
+        {
+            throw std::length_error("basic_string - length exceeds max_size");
+        }
+        size_type doubled = capacity() * 2 + 1;
+        return required > doubled ? required : doubled;
+    }
+
+    void reallocate(size_type new_capacity)
+    {
+        size_type count = size();
+        pointer p = data_allocator::allocate(new_capacity + 1);
+        traits_type::copy(p, get_pointer(), count);
+        release();
+        set_heap(p, count, new_capacity);
+    }
+
+  protected:
+    union rep {
+        long_rep _heap;
+        CharT _local[LOCAL_CAPACITY + 1];
+    } _rep;
+    unsigned char _local_size; // 短字符串长度, HEAP_FLAG 表示位于堆上
+};
+
+template <typename CharT, typename Alloc>
+const typename basic_string<CharT, Alloc>::size_type basic_string<CharT, Alloc>::npos;
+
+template <typename CharT, typename Alloc>
+struct is_trivially_relocatable<basic_string<CharT, Alloc>> : std::true_type
+{
+};
+
+using string = basic_string<char>;
+using wstring = basic_string<wchar_t>;
+
+// non-member function(s)
+
+template <typename CharT, typename Alloc>
+basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc> &lhs,
+                                     const basic_string<CharT, Alloc> &rhs)
+{
+    basic_string<CharT, Alloc> result;
+    result.reserve(lhs.size() + rhs.size());
+    result.append(lhs);
+    result.append(rhs);
+    return result;
+}
+
+template <typename CharT, typename Alloc>
+basic_string<CharT, Alloc> operator+(basic_string<CharT, Alloc> &&lhs,
+                                     const basic_string<CharT, Alloc> &rhs)
+{
+    lhs.append(rhs);
+    return std::move(lhs);
+}
+
+template <typename CharT, typename Alloc>
+basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc> &lhs, const CharT *rhs)
+{
+    basic_string<CharT, Alloc> result(lhs);
+    result.append(rhs);
+    return result;
+}
+
+template <typename CharT, typename Alloc>
+basic_string<CharT, Alloc> operator+(basic_string<CharT, Alloc> &&lhs, const CharT *rhs)
+{
+    lhs.append(rhs);
+    return std::move(lhs);
+}
+
+template <typename CharT, typename Alloc>
+basic_string<CharT, Alloc> operator+(const CharT *lhs, const basic_string<CharT, Alloc> &rhs)
+{
+    basic_string<CharT, Alloc> result(lhs);
+    result.append(rhs);
+    return result;
+}
+
+template <typename CharT, typename Alloc>
+basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc> &lhs, CharT rhs)
+{
+    basic_string<CharT, Alloc> result(lhs);
+    result.push_back(rhs);
+    return result;
+}
+
+template <typename CharT, typename Alloc>
+bool operator==(const basic_string<CharT, Alloc> &lhs, const basic_string<CharT, Alloc> &rhs)
+{
+    return lhs.size() == rhs.size() &&
+           std::char_traits<CharT>::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+template <typename CharT, typename Alloc>
+bool operator==(const basic_string<CharT, Alloc> &lhs, const CharT *rhs)
+{
+    return lhs.compare(rhs) == 0;
+}
+
+template <typename CharT, typename Alloc>
+bool operator==(const CharT *lhs, const basic_string<CharT, Alloc> &rhs)
+{
+    return rhs.compare(lhs) == 0;
+}
+
+template <typename CharT, typename Alloc>
+bool operator!=(const basic_string<CharT, Alloc> &lhs, const basic_string<CharT, Alloc> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename CharT, typename Alloc>
+bool operator!=(const basic_string<CharT, Alloc> &lhs, const CharT *rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename CharT, typename Alloc>
+bool operator!=(const CharT *lhs, const basic_string<CharT, Alloc> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename CharT, typename Alloc>
+bool operator<(const basic_string<CharT, Alloc> &lhs, const basic_string<CharT, Alloc> &rhs)
+{
+    return lhs.compare(rhs) < 0;
+}
+
+template <typename CharT, typename Alloc>
+bool operator<=(const basic_string<CharT, Alloc> &lhs, const basic_string<CharT, Alloc> &rhs)
+{
+    return lhs.compare(rhs) <= 0;
+}
+
+template <typename CharT, typename Alloc>
+bool operator>(const basic_string<CharT, Alloc> &lhs, const basic_string<CharT, Alloc> &rhs)
+{
+    return lhs.compare(rhs) > 0;
+}
+
+template <typename CharT, typename Alloc>
+bool operator>=(const basic_string<CharT, Alloc> &lhs, const basic_string<CharT, Alloc> &rhs)
+{
+    return lhs.compare(rhs) >= 0;
+}
+
+template <typename CharT, typename Alloc>
+std::basic_ostream<CharT> &operator<<(std::basic_ostream<CharT> &os,
+                                      const basic_string<CharT, Alloc> &str)
+{
+    return os.write(str.data(), str.size());
+}
+
+template <typename CharT, typename Alloc>
+void swap(basic_string<CharT, Alloc> &lhs, basic_string<CharT, Alloc> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace TS
+
+namespace std
+{
+template <typename CharT, typename Alloc> struct hash<TS::basic_string<CharT, Alloc>>
+{
+    std::size_t operator()(const TS::basic_string<CharT, Alloc> &str) const noexcept
+    {
+        return TS::hash_bytes(str.data(), str.size());
+    }
+};
+} // namespace std
+
+#endif
@@ -0,0 +1,411 @@
+#ifndef TS_STRING_VIEW_HPP
+#define TS_STRING_VIEW_HPP
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+namespace TS
+{
+// 非拥有的字符区间视图, 查找与比较基于 char_traits (memchr/memcmp)
+template <typename CharT> class basic_string_view
+{
+  public:
+    using traits_type = std::char_traits<CharT>;
+    using value_type = CharT;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using iterator = const value_type *;
+    using const_iterator = const value_type *;
+
+    static const size_type npos = static_cast<size_type>(-1);
+
+  protected:
+    using self = basic_string_view<CharT>;
+
+  public:
+    constexpr basic_string_view() noexcept : _data(nullptr), _size(0)
+    {
+    }
+
+    constexpr basic_string_view(const CharT *s) : _data(s), _size(traits_type::length(s))
+    {
+    }
+
+    constexpr basic_string_view(const CharT *s, size_type count) noexcept : _data(s), _size(count)
+    {
+    }
+
+    template <typename Traits, typename Allocator>
+    basic_string_view(const std::basic_string<CharT, Traits, Allocator> &str) noexcept
+        : _data(str.data()), _size(str.size())
+    {
+    }
+
+    constexpr basic_string_view(const self &other) noexcept = default;
+
+    self &operator=(const self &other) noexcept = default;
+
+    // element access
+
+    constexpr const_reference operator[](size_type pos) const
+    {
+        return _data[pos];
+    }
+
+    const_reference at(size_type pos) const
+    {
+        if (pos >= _size)
+        {
+            throw std::out_of_range("string_view::at - index out of range");
+        }
+        return _data[pos];
+    }
+
+    const_reference front() const
+    {
+        if (empty())
+        {
+            throw std::logic_error("empty string_view");
+        }
+        return _data[0];
+    }
+
+    const_reference back() const
+    {
+        if (empty())
+        {
+            throw std::logic_error("empty string_view");
+        }
+        return _data[_size - 1];
+    }
+
+    constexpr const_pointer data() const noexcept
+    {
+        return _data;
+    }
+
+    // iterators
+
+    constexpr const_iterator begin() const noexcept
+    {
+        return _data;
+    }
+
+    constexpr const_iterator cbegin() const noexcept
+    {
+        return _data;
+    }
+
+    constexpr const_iterator end() const noexcept
+    {
+        return _data + _size;
+    }
+
+    constexpr const_iterator cend() const noexcept
+    {
+        return _data + _size;
+    }
+
+    // capacity
+
+    constexpr bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    constexpr size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    constexpr size_type length() const noexcept
+    {
+        return _size;
+    }
+
+    constexpr size_type max_size() const noexcept
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(CharT);
+    }
+
+    // modifier
+
+    void remove_prefix(size_type count)
+    {
+        if (count > _size)
+        {
+            throw std::out_of_range("string_view::remove_prefix - count out of range");
+        }
+        _data += count;
+        _size -= count;
+    }
+
+    void remove_suffix(size_type count)
+    {
+        if (count > _size)
+        {
+            throw std::out_of_range("string_view::remove_suffix - count out of range");
+        }
+        _size -= count;
+    }
+
+    void swap(self &other) noexcept
+    {
+        const_pointer tmp_data = other._data;
+        size_type tmp_size = other._size;
+        other._data = _data;
+        other._size = _size;
+        _data = tmp_data;
+        _size = tmp_size;
+    }
+
+    // operations
+
+    self substr(size_type pos = 0, size_type count = npos) const
+    {
+        if (pos > _size)
+        {
+            throw std::out_of_range("string_view::substr - position out of range");
+        }
+        size_type rest = _size - pos;
+        return self(_data + pos, count < rest ? count : rest);
+    }
+
+    // 公共前缀交给 char_traits::compare (memcmp), 再按长度区分
+    int compare(self other) const noexcept
+    {
+        size_type count = _size < other._size ? _size : other._size;
+        int result = traits_type::compare(_data, other._data, count);
+        if (result != 0)
+        {
+            return result;
+        }
+        return _size < other._size ? -1 : (_size > other._size ? 1 : 0);
+    }
+
+    bool starts_with(self prefix) const noexcept
+    {
+        return prefix._size <= _size &&
+               traits_type::compare(_data, prefix._data, prefix._size) == 0;
+    }
+
+    bool starts_with(CharT ch) const noexcept
+    {
+        return !empty() && traits_type::eq(_data[0], ch);
+    }
+
+    bool ends_with(self suffix) const noexcept
+    {
+        return suffix._size <= _size &&
+               traits_type::compare(_data + _size - suffix._size, suffix._data, suffix._size) == 0;
+    }
+
+    bool ends_with(CharT ch) const noexcept
+    {
+        return !empty() && traits_type::eq(_data[_size - 1], ch);
+    }
+
+    // 用 char_traits::find (memchr) 定位首字符, 再比较剩余部分
+    size_type find(self needle, size_type pos = 0) const noexcept
+    {
+        size_type count = needle._size;
+        if (count == 0)
+        {
+            return pos <= _size ? pos : npos;
+        }
+        if (pos >= _size || count > _size - pos)
+        {
+            return npos;
+        }
+        const_pointer cur = _data + pos;
+        const_pointer last = _data + _size - count + 1;
+        while (cur < last)
+        {
+            cur = traits_type::find(cur, last - cur, needle._data[0]);
+            if (cur == nullptr)
+            {
+                return npos;
+            }
+            if (traits_type::compare(cur + 1, needle._data + 1, count - 1) == 0)
+            {
+                return cur - _data;
+            }
+            ++cur;
+        }
+        return npos;
+    }
+
+    size_type find(CharT ch, size_type pos = 0) const noexcept
+    {
+        if (pos >= _size)
+        {
+            return npos;
+        }
+        const_pointer found = traits_type::find(_data + pos, _size - pos, ch);
+        return found == nullptr ? npos : size_type(found - _data);
+    }
+
+    size_type rfind(self needle, size_type pos = npos) const noexcept
+    {
+        size_type count = needle._size;
+        if (count > _size)
+        {
+            return npos;
+        }
+        size_type cur = _size - count < pos ? _size - count : pos;
+        for (++cur; cur-- > 0;)
+        {
+            if (traits_type::compare(_data + cur, needle._data, count) == 0)
+            {
+                return cur;
+            }
+        }
+        return npos;
+    }
+
+    size_type rfind(CharT ch, size_type pos = npos) const noexcept
+    {
+        if (_size == 0)
+        {
+            return npos;
+        }
+        size_type cur = pos < _size ? pos : _size - 1;
+        for (++cur; cur-- > 0;)
+        {
+            if (traits_type::eq(_data[cur], ch))
+            {
+                return cur;
+            }
+        }
+        return npos;
+    }
+
+  protected:
+    const_pointer _data;
+    size_type _size;
+};
+
+template <typename CharT>
+const typename basic_string_view<CharT>::size_type basic_string_view<CharT>::npos;
+
+using string_view = basic_string_view<char>;
+using wstring_view = basic_string_view<wchar_t>;
+
+// non-member function(s)
+// 一侧参数放入非推导语境, 使 const CharT* 与 basic_string
+// 可隐式转换后参与比较
+
+template <typename T> struct type_identity
+{
+    using type = T;
+};
+
+template <typename CharT>
+bool operator==(basic_string_view<CharT> lhs, basic_string_view<CharT> rhs) noexcept
+{
+    return lhs.size() == rhs.size() &&
+           std::char_traits<CharT>::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+template <typename CharT>
+bool operator==(basic_string_view<CharT> lhs,
+                typename type_identity<basic_string_view<CharT>>::type rhs) noexcept
+{
+    return lhs.size() == rhs.size() &&
+           std::char_traits<CharT>::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+template <typename CharT>
+bool operator==(typename type_identity<basic_string_view<CharT>>::type lhs,
+                basic_string_view<CharT> rhs) noexcept
+{
+    return lhs.size() == rhs.size() &&
+           std::char_traits<CharT>::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+template <typename CharT>
+bool operator!=(basic_string_view<CharT> lhs, basic_string_view<CharT> rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+template <typename CharT>
+bool operator!=(basic_string_view<CharT> lhs,
+                typename type_identity<basic_string_view<CharT>>::type rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+template <typename CharT>
+bool operator!=(typename type_identity<basic_string_view<CharT>>::type lhs,
+                basic_string_view<CharT> rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+template <typename CharT>
+bool operator<(basic_string_view<CharT> lhs, basic_string_view<CharT> rhs) noexcept
+{
+    return lhs.compare(rhs) < 0;
+}
+
+template <typename CharT>
+bool operator<=(basic_string_view<CharT> lhs, basic_string_view<CharT> rhs) noexcept
+{
+    return lhs.compare(rhs) <= 0;
+}
+
+template <typename CharT>
+bool operator>(basic_string_view<CharT> lhs, basic_string_view<CharT> rhs) noexcept
+{
+    return lhs.compare(rhs) > 0;
+}
+
+template <typename CharT>
+bool operator>=(basic_string_view<CharT> lhs, basic_string_view<CharT> rhs) noexcept
+{
+    return lhs.compare(rhs) >= 0;
+}
+
+template <typename CharT>
+std::basic_ostream<CharT> &operator<<(std::basic_ostream<CharT> &os, basic_string_view<CharT> sv)
+{
+    return os.write(sv.data(), sv.size());
+}
+
+// FNV-1a, 与 basic_string 的哈希保持一致
+template <typename CharT> inline std::size_t hash_bytes(const CharT *data, std::size_t count)
+{
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(data);
+    std::size_t bytes = count * sizeof(CharT);
+    std::size_t result = static_cast<std::size_t>(14695981039346656037ULL);
+    for (std::size_t i = 0; i < bytes; ++i)
+    {
+        result ^= p[i];
+        result *= static_cast<std::size_t>(1099511628211ULL);
+    }
+    return result;
+}
+
+} // namespace TS
+
+namespace std
+{
+template <typename CharT> struct hash<TS::basic_string_view<CharT>>
+{
+    std::size_t operator()(TS::basic_string_view<CharT> sv) const noexcept
+    {
+        return TS::hash_bytes(sv.data(), sv.size());
+    }
+};
+} // namespace std
+
+#endif
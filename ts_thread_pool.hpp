@@ -0,0 +1,622 @@
+#ifndef TS_THREAD_POOL_HPP
+#define TS_THREAD_POOL_HPP
+
+#include "ts_alloc.hpp"
+#include "ts_deque.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace TS
+{
+class thread_pool;
+class task_group;
+template <typename Function> class task;
+
+// Chase-Lev 双端队列: 所有者在底部 push/pop, 其他线程从顶部 steal
+// 扩容时旧的环形缓冲区可能仍被窃取者读取, 保留到队列析构时统一释放
+template <typename T> class work_stealing_deque
+{
+    static_assert(std::is_trivially_copyable<T>::value, "work_stealing_deque holds plain values");
+
+  protected:
+    struct ring
+    {
+        std::ptrdiff_t capacity;
+        std::atomic<T> *slots;
+        ring *retired; // 更早的缓冲区
+
+        T get(std::ptrdiff_t index) const
+        {
+            return slots[index & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(std::ptrdiff_t index, T val)
+        {
+            slots[index & (capacity - 1)].store(val, std::memory_order_relaxed);
+        }
+    };
+
+    using ring_allocator = simple_alloc<ring, alloc>;
+    using slot_allocator = simple_alloc<std::atomic<T>, alloc>;
+
+  public:
+    explicit work_stealing_deque(std::ptrdiff_t capacity = 64)
+        : _top(0), _bottom(0), _ring(create_ring(capacity, nullptr))
+    {
+    }
+
+    work_stealing_deque(const work_stealing_deque &) = delete;
+    work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+
+    ~work_stealing_deque()
+    {
+        ring *cur = _ring.load(std::memory_order_relaxed);
+        while (cur != nullptr)
+        {
+            ring *retired = cur->retired;
+            destroy_ring(cur);
+            cur = retired;
+        }
+    }
+
+    // 仅所有者线程调用
+    void push(T val)
+    {
+        std::ptrdiff_t bottom = _bottom.load(std::memory_order_relaxed);
+        std::ptrdiff_t top = _top.load(std::memory_order_acquire);
+        ring *cur = _ring.load(std::memory_order_relaxed);
+        if (bottom - top > cur->capacity - 1)
+        {
+            cur = grow(cur, top, bottom);
+        }
+        cur->put(bottom, val);
+        // release 发布槽位, 与 steal 中对 _bottom 的 acquire 配对
+        _bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    // 仅所有者线程调用, 与窃取者竞争最后一个元素
+    bool pop(T &result)
+    {
+        std::ptrdiff_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        ring *cur = _ring.load(std::memory_order_relaxed);
+        // 先写 bottom 再读 top, 与 steal 中的顺序构成 seq_cst 全序, 不依赖独立栅栏
+        _bottom.store(bottom, std::memory_order_seq_cst);
+        std::ptrdiff_t top = _top.load(std::memory_order_seq_cst);
+        if (top > bottom)
+        {
+            _bottom.store(bottom + 1, std::memory_order_release);
+            return false;
+        }
+        result = cur->get(bottom);
+        if (top == bottom)
+        {
+            bool won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed);
+            _bottom.store(bottom + 1, std::memory_order_release);
+            return won;
+        }
+        return true;
+    }
+
+    // 任意线程调用; 与其他窃取者或所有者冲突时返回 false
+    bool steal(T &result)
+    {
+        std::ptrdiff_t top = _top.load(std::memory_order_seq_cst);
+        // _bottom 的每次写入都是 release, 读到任一值都能看到对应槽位及其指向的数据
+        std::ptrdiff_t bottom = _bottom.load(std::memory_order_seq_cst);
+        if (top >= bottom)
+        {
+            return false;
+        }
+        ring *cur = _ring.load(std::memory_order_acquire);
+        result = cur->get(top);
+        return _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    }
+
+    bool empty() const
+    {
+        std::ptrdiff_t bottom = _bottom.load(std::memory_order_relaxed);
+        std::ptrdiff_t top = _top.load(std::memory_order_relaxed);
+        return bottom <= top;
+    }
+
+  protected:
+    static ring *create_ring(std::ptrdiff_t capacity, ring *retired)
+    {
+        ring *result = ring_allocator::allocate();
+        result->capacity = capacity;
+        result->retired = retired;
+        result->slots = slot_allocator::allocate(capacity);
+        for (std::ptrdiff_t i = 0; i < capacity; ++i)
+        {
+            construct(result->slots + i);
+        }
+        return result;
+    }
+
+    static void destroy_ring(ring *r)
+    {
+        slot_allocator::deallocate(r->slots, r->capacity);
+        ring_allocator::deallocate(r);
+    }
+
+    ring *grow(ring *old, std::ptrdiff_t top, std::ptrdiff_t bottom)
+    {
+        ring *result = create_ring(old->capacity * 2, old);
+        for (std::ptrdiff_t i = top; i < bottom; ++i)
+        {
+            result->put(i, old->get(i));
+        }
+        _ring.store(result, std::memory_order_release);
+        return result;
+    }
+
+  protected:
+    std::atomic<std::ptrdiff_t> _top;
+    std::atomic<std::ptrdiff_t> _bottom;
+    std::atomic<ring *> _ring;
+};
+
+// 任务对象由 alloc 分配, 执行后自行析构并归还
+class task_base
+{
+  public:
+    virtual void run() = 0;
+
+  protected:
+    ~task_base() = default;
+};
+
+// 工作线程: 优先执行自己队列底部的任务, 空闲时随机选择其他队列窃取,
+// 都没有任务时在条件变量上休眠, 由 spawn 唤醒
+class thread_pool
+{
+  public:
+    explicit thread_pool(std::size_t workers = default_worker_count())
+        : _count(workers), _queues(new work_stealing_deque<task_base *>[workers]),
+          _threads(new std::thread[workers]), _injected(0), _sleepers(0), _stop(false)
+    {
+        std::size_t started = 0;
+        try
+        {
+            for (; started < workers; ++started)
+            {
+                _threads[started] = std::thread([this, started] { worker_loop(started); });
+            }
+        }
+        catch (...)
+        {
+            shutdown(started);
+            throw;
+        }
+    }
+
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    ~thread_pool()
+    {
+        shutdown(_count);
+    }
+
+    // 工作线程数 (不含调用 wait 时协助执行的线程)
+    std::size_t size() const
+    {
+        return _count;
+    }
+
+    // 调用线程也会在 wait 中执行任务, 因此默认比硬件线程数少一个工作线程
+    static std::size_t default_worker_count()
+    {
+        std::size_t hardware = std::thread::hardware_concurrency();
+        return hardware > 2 ? hardware - 1 : 1;
+    }
+
+    // 当前线程若是本线程池的工作线程, 返回其编号, 否则返回 size()
+    std::size_t current_index() const
+    {
+        const context &ctx = current_context();
+        return ctx.pool == this ? ctx.index : _count;
+    }
+
+    // 工作线程压入自己的队列, 外部线程放入共享注入队列
+    void submit(task_base *t)
+    {
+        std::size_t index = current_index();
+        if (index < _count)
+        {
+            _queues[index].push(t);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(_inject_mutex);
+            _inject_queue.push_back(t);
+            _injected.fetch_add(1, std::memory_order_relaxed);
+        }
+        // 以 _sleepers 上的读改写代替栅栏: 与 worker_loop 的登记按修改顺序排先后,
+        // 后发生的一方必然看到另一方 (看到休眠者, 或看到新任务)
+        if (_sleepers.fetch_add(0, std::memory_order_release) > 0)
+        {
+            std::lock_guard<std::mutex> lock(_idle_mutex);
+            _idle_cv.notify_one();
+        }
+    }
+
+    // 取出一个可执行的任务: 自己的队列, 注入队列, 然后随机窃取
+    bool find_task(task_base *&result)
+    {
+        std::size_t index = current_index();
+        if (index < _count && _queues[index].pop(result))
+        {
+            return true;
+        }
+        if (_injected.load(std::memory_order_relaxed) > 0)
+        {
+            std::lock_guard<std::mutex> lock(_inject_mutex);
+            if (!_inject_queue.empty())
+            {
+                result = _inject_queue.front();
+                _inject_queue.pop_front();
+                _injected.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        std::size_t start = _count == 0 ? 0 : next_random() % _count;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+            std::size_t victim = (start + i) % _count;
+            if (victim != index && _queues[victim].steal(result))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+  protected:
+    struct context
+    {
+        const thread_pool *pool;
+        std::size_t index;
+        unsigned rng;
+    };
+
+    static context &current_context()
+    {
+        static thread_local context ctx = {nullptr, 0, 0};
+        return ctx;
+    }
+
+    // 每线程 xorshift, 用于选择窃取对象
+    static unsigned next_random()
+    {
+        context &ctx = current_context();
+        if (ctx.rng == 0)
+        {
+            ctx.rng = unsigned(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+        }
+        ctx.rng ^= ctx.rng << 13;
+        ctx.rng ^= ctx.rng >> 17;
+        ctx.rng ^= ctx.rng << 5;
+        return ctx.rng;
+    }
+
+    void shutdown(std::size_t started)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_idle_mutex);
+            _stop.store(true, std::memory_order_seq_cst);
+        }
+        _idle_cv.notify_all();
+        for (std::size_t i = 0; i < started; ++i)
+        {
+            _threads[i].join();
+        }
+    }
+
+    bool has_work() const
+    {
+        if (_injected.load(std::memory_order_relaxed) > 0)
+        {
+            return true;
+        }
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+            if (!_queues[i].empty())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker_loop(std::size_t index)
+    {
+        context &ctx = current_context();
+        ctx.pool = this;
+        ctx.index = index;
+
+        const int SPIN_ROUNDS = 64;
+        int idle = 0;
+        while (true)
+        {
+            task_base *t = nullptr;
+            if (find_task(t))
+            {
+                t->run();
+                idle = 0;
+                continue;
+            }
+            if (++idle < SPIN_ROUNDS)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // 先登记为休眠者再复查, 与 submit 中对 _sleepers 的读改写配合避免丢失唤醒
+            std::unique_lock<std::mutex> lock(_idle_mutex);
+            _sleepers.fetch_add(1, std::memory_order_acq_rel);
+            if (has_work())
+            {
+                _sleepers.fetch_sub(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (_stop.load(std::memory_order_relaxed))
+            {
+                _sleepers.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            _idle_cv.wait(lock);
+            _sleepers.fetch_sub(1, std::memory_order_relaxed);
+            idle = 0;
+        }
+    }
+
+  protected:
+    std::size_t _count;
+    std::unique_ptr<work_stealing_deque<task_base *>[]> _queues;
+    std::unique_ptr<std::thread[]> _threads;
+
+    std::mutex _inject_mutex;
+    deque<task_base *> _inject_queue;
+    std::atomic<std::size_t> _injected;
+
+    std::mutex _idle_mutex;
+    std::condition_variable _idle_cv;
+    std::atomic<std::size_t> _sleepers;
+    std::atomic<bool> _stop;
+};
+
+inline thread_pool &default_thread_pool()
+{
+    static thread_pool pool;
+    return pool;
+}
+
+// fork/join: spawn 派生任务, wait 在等待期间协助执行任务直到全部完成,
+// 然后重新抛出首个异常; 出现异常后尚未开始的任务被跳过
+class task_group
+{
+  public:
+    explicit task_group(thread_pool &pool = default_thread_pool())
+        : _pool(pool), _pending(0), _cancelled(false)
+    {
+    }
+
+    task_group(const task_group &) = delete;
+    task_group &operator=(const task_group &) = delete;
+
+    ~task_group()
+    {
+        join();
+    }
+
+    template <typename Function> void spawn(Function &&f);
+
+    void wait()
+    {
+        join();
+        if (_error)
+        {
+            std::exception_ptr error = _error;
+            _error = nullptr;
+            _cancelled.store(false, std::memory_order_relaxed);
+            std::rethrow_exception(error);
+        }
+    }
+
+    bool cancelled() const
+    {
+        return _cancelled.load(std::memory_order_relaxed);
+    }
+
+    // 跳过尚未开始的任务, 已在执行的任务不受影响
+    void cancel()
+    {
+        _cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    thread_pool &pool() const
+    {
+        return _pool;
+    }
+
+  protected:
+    template <typename Function> friend class task;
+
+    void join()
+    {
+        while (_pending.load(std::memory_order_acquire) != 0)
+        {
+            task_base *t = nullptr;
+            if (_pool.find_task(t))
+            {
+                t->run();
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void fail(std::exception_ptr error)
+    {
+        std::lock_guard<std::mutex> lock(_error_mutex);
+        if (!_error)
+        {
+            _error = error;
+        }
+        _cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    void finish()
+    {
+        _pending.fetch_sub(1, std::memory_order_release);
+    }
+
+  protected:
+    thread_pool &_pool;
+    std::atomic<std::size_t> _pending;
+    std::atomic<bool> _cancelled;
+    std::mutex _error_mutex;
+    std::exception_ptr _error;
+};
+
+template <typename Function> class task : public task_base
+{
+  protected:
+    using task_allocator = simple_alloc<task<Function>, alloc>;
+
+  public:
+    template <typename F> static task *create(F &&f, task_group &group)
+    {
+        task *result = task_allocator::allocate();
+        try
+        {
+            construct(result, std::forward<F>(f), group);
+        }
+        catch (...)
+        {
+            task_allocator::deallocate(result);
+            throw;
+        }
+        return result;
+    }
+
+    template <typename F> task(F &&f, task_group &group) : _func(std::forward<F>(f)), _group(group)
+    {
+    }
+
+    static void destroy(task *t)
+    {
+        t->~task();
+        task_allocator::deallocate(t);
+    }
+
+    void run() override
+    {
+        task_group &group = _group;
+        if (!group.cancelled())
+        {
+            try
+            {
+                _func();
+            }
+            catch (...)
+            {
+                group.fail(std::current_exception());
+            }
+        }
+        destroy(this);
+        // 最后才递减计数, 之后 group 可能随时被销毁
+        group.finish();
+    }
+
+  protected:
+    Function _func;
+    task_group &_group;
+};
+
+template <typename Function> void task_group::spawn(Function &&f)
+{
+    using task_type = task<typename std::decay<Function>::type>;
+    task_type *t = task_type::create(std::forward<Function>(f), *this);
+    // 先计数再提交, 否则嵌套派生的子任务可能先完成而使计数暂时归零
+    _pending.fetch_add(1, std::memory_order_relaxed);
+    try
+    {
+        _pool.submit(t);
+    }
+    catch (...)
+    {
+        _pending.fetch_sub(1, std::memory_order_relaxed);
+        task_type::destroy(t);
+        throw;
+    }
+}
+
+// 并行执行两个函数, 当前线程执行 f, g 交给线程池
+template <typename F, typename G> void parallel_invoke(thread_pool &pool, F &&f, G &&g)
+{
+    task_group group(pool);
+    group.spawn(std::forward<G>(g));
+    try
+    {
+        f();
+    }
+    catch (...)
+    {
+        group.cancel();
+        throw;
+    }
+    group.wait();
+}
+
+template <typename F, typename G> void parallel_invoke(F &&f, G &&g)
+{
+    parallel_invoke(default_thread_pool(), std::forward<F>(f), std::forward<G>(g));
+}
+
+// 对 [first, last) 递归二分, 每段不超过 grain 时直接执行 func(i)
+template <typename Function>
+void parallel_for(thread_pool &pool, std::size_t first, std::size_t last, std::size_t grain,
+                  Function &func)
+{
+    task_group group(pool);
+    grain = grain == 0 ? 1 : grain;
+    try
+    {
+        while (last - first > grain)
+        {
+            std::size_t mid = first + (last - first) / 2;
+            group.spawn([&pool, mid, last, grain, &func] {
+                parallel_for(pool, mid, last, grain, func);
+            });
+            last = mid;
+        }
+        for (; first < last; ++first)
+        {
+            func(first);
+        }
+    }
+    catch (...)
+    {
+        group.cancel();
+        throw;
+    }
+    group.wait();
+}
+
+} // namespace TS
+
+#endif
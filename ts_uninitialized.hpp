@@ -2,7 +2,11 @@
 #define TS_UNINITIALIZED_HPP
 
 #include "ts_alloc.hpp"
+#include "ts_simd.hpp"
 #include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 
 namespace TS
 {
@@ -91,7 +95,7 @@ inline ForwardIter uninitialized_copy_backward_n(InputIter first, Size count, Fo
         ForwardIter result_last = result + count;
         for (ForwardIter it = result; it != result_last; ++it)
         {
-            detroy(&*it);
+            destroy(&*it);
         }
         throw;
     }
@@ -100,45 +104,151 @@ inline ForwardIter uninitialized_copy_backward_n(InputIter first, Size count, Fo
 
 // uninitialized_fill
 template <typename ForwardIter, typename T>
-inline void uninitialized_fill(ForwardIter first, ForwardIter last, const T &val)
+inline void uninitialized_fill_aux(ForwardIter first, ForwardIter last, const T &val,
+                                   std::false_type)
 {
+    ForwardIter cur = first;
     try
     {
-        for (ForwardIter cur = first; cur != last; ++cur)
+        for (; cur != last; ++cur)
         {
             construct(&*cur, val);
         }
     }
     catch (...)
     {
-        for (ForwardIter it = first; it != last; ++it)
+        for (ForwardIter it = first; it != cur; ++it)
         {
-            detroy(&*it);
+            destroy(&*it);
         }
         throw;
     }
 }
 
+// 4 或 8 字节的标量构造不会抛出, 直接按位模式填充
+template <typename U, typename T>
+inline void uninitialized_fill_aux(U *first, U *last, const T &val, std::true_type)
+{
+    simd::fill(first, last, static_cast<U>(val));
+}
+
+template <typename ForwardIter, typename T>
+inline void uninitialized_fill(ForwardIter first, ForwardIter last, const T &val)
+{
+    uninitialized_fill_aux(first, last, val, simd::is_fill_vectorizable<ForwardIter>());
+}
+
 template <typename ForwardIter, typename Size, typename T>
-inline void uninitialized_fill_n(ForwardIter first, Size count, const T &val)
+inline void uninitialized_fill_n_aux(ForwardIter first, Size count, const T &val, std::false_type)
 {
-    ForwardIter last = first + count;
+    ForwardIter cur = first;
     try
     {
-        for (ForwardIter cur = first; cur != last; ++cur)
+        for (; count > 0; --count, ++cur)
         {
             construct(&*cur, val);
         }
     }
     catch (...)
     {
-        for (ForwardIter it = first; it != last; ++it)
+        for (ForwardIter it = first; it != cur; ++it)
         {
             destroy(&*it);
         }
+        throw;
+    }
+}
+
+template <typename U, typename Size, typename T>
+inline void uninitialized_fill_n_aux(U *first, Size count, const T &val, std::true_type)
+{
+    if (count > 0)
+    {
+        simd::fill(first, first + count, static_cast<U>(val));
     }
 }
 
+template <typename ForwardIter, typename Size, typename T>
+inline void uninitialized_fill_n(ForwardIter first, Size count, const T &val)
+{
+    uninitialized_fill_n_aux(first, count, val, simd::is_fill_vectorizable<ForwardIter>());
+}
+
+// uninitialized_relocate
+// 可平凡重定位: 按字节搬到新地址后, 原对象无需析构即视为已结束生命期
+// 不含自指针的类型 (如 basic_string) 可特化为 true_type
+template <typename T> struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{
+};
+
+template <typename T>
+inline T *uninitialized_relocate_aux(T *first, T *last, T *result, std::true_type)
+{
+    std::size_t count = last - first;
+    if (count > 0)
+    {
+        std::memmove(static_cast<void *>(result), static_cast<const void *>(first),
+                     count * sizeof(T));
+    }
+    return result + count;
+}
+
+template <typename T>
+inline T *uninitialized_relocate_aux(T *first, T *last, T *result, std::false_type)
+{
+    for (; first != last; ++first, ++result)
+    {
+        construct(result, std::move(*first));
+        destroy(first);
+    }
+    return result;
+}
+
+// 将 [first, last) 移至未初始化的 result, 完成后源区间不再持有对象
+// 目标区间可与源区间重叠, 但 result 不能位于 (first, last) 之内
+template <typename T> inline T *uninitialized_relocate(T *first, T *last, T *result)
+{
+    return uninitialized_relocate_aux(first, last, result, is_trivially_relocatable<T>());
+}
+
+template <typename T>
+inline T *uninitialized_relocate_backward_aux(T *first, T *last, T *result_last, std::true_type)
+{
+    std::size_t count = last - first;
+    if (count > 0)
+    {
+        std::memmove(static_cast<void *>(result_last - count), static_cast<const void *>(first),
+                     count * sizeof(T));
+    }
+    return result_last - count;
+}
+
+template <typename T>
+inline T *uninitialized_relocate_backward_aux(T *first, T *last, T *result_last, std::false_type)
+{
+    while (last != first)
+    {
+        --last;
+        --result_last;
+        construct(result_last, std::move(*last));
+        destroy(last);
+    }
+    return result_last;
+}
+
+// 从尾部开始搬移, 使 [first, last) 结束于 result_last, 用于向后平移重叠区间; 返回新起点
+template <typename T> inline T *uninitialized_relocate_backward(T *first, T *last, T *result_last)
+{
+    return uninitialized_relocate_backward_aux(first, last, result_last,
+                                               is_trivially_relocatable<T>());
+}
+
+template <typename T, typename Size>
+inline T *uninitialized_relocate_n(T *first, Size count, T *result)
+{
+    return uninitialized_relocate(first, first + count, result);
+}
+
 // template <typename ForwardIter> inline void uninitialized_break(ForwardIter first, ForwardIter last) noexcept
 // {
 //     for (; first != last; ++first)
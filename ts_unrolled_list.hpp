@@ -0,0 +1,723 @@
+#ifndef TS_UNROLLED_LIST_HPP
+#define TS_UNROLLED_LIST_HPP
+
+#include "ts_algorithm.hpp"
+#include "ts_alloc.hpp"
+#include "ts_iterator.hpp"
+#include "ts_uninitialized.hpp"
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace TS
+{
+// 默认节点大小: 两条缓存行, 恰为 alloc 内存池的最大块
+const std::size_t UNROLLED_NODE_BYTES = 128;
+
+// 节点链接部分; 哨兵只有这一部分, 不含元素存储
+template <typename T> struct Unrolled_link
+{
+    Unrolled_link *_prev;
+    Unrolled_link *_next;
+    T *_data;           // 元素存储的首地址, 哨兵为 nullptr
+    std::size_t _count; // 已构造的元素个数, 哨兵为 0; 其他节点不为 0
+};
+
+// 每个节点容纳的元素个数, 元素过大时每个节点只放一个
+constexpr std::size_t unrolled_node_capacity(std::size_t bytes, std::size_t size)
+{
+    return bytes >= sizeof(Unrolled_link<char>) + 2 * size
+               ? (bytes - sizeof(Unrolled_link<char>)) / size
+               : 1;
+}
+
+template <typename T, std::size_t Capacity> struct Unrolled_node : public Unrolled_link<T>
+{
+    alignas(T) unsigned char _storage[Capacity * sizeof(T)];
+};
+
+// 迭代器保存当前元素地址与所在节点, 只在跨节点时访问链接
+template <typename T, typename Ref, typename Ptr>
+struct Unrolled_iterator : public _iterator<bidirectional_iterator_tag, T, std::ptrdiff_t, Ptr, Ref>
+{
+  public:
+    using base_iterator = _iterator<bidirectional_iterator_tag, T, std::ptrdiff_t, Ptr, Ref>;
+    using iterator = Unrolled_iterator<T, T &, T *>;
+    using const_iterator = Unrolled_iterator<T, const T &, const T *>;
+    using self = Unrolled_iterator<T, Ref, Ptr>;
+
+    using typename base_iterator::difference_type;
+    using typename base_iterator::iterator_category;
+    using typename base_iterator::pointer;
+    using typename base_iterator::reference;
+    using typename base_iterator::value_type;
+
+    using link_type = Unrolled_link<T>;
+
+  public:
+    Unrolled_iterator() noexcept : _cur(nullptr), _node(nullptr)
+    {
+    }
+
+    Unrolled_iterator(T *cur, link_type *node) : _cur(cur), _node(node)
+    {
+    }
+
+    Unrolled_iterator(const iterator &other) : _cur(other._cur), _node(other._node)
+    {
+    }
+
+    self &operator=(const iterator &other)
+    {
+        _cur = other._cur;
+        _node = other._node;
+        return *this;
+    }
+
+    reference operator*() const
+    {
+        return *_cur;
+    }
+
+    pointer operator->() const
+    {
+        return _cur;
+    }
+
+    self &operator++()
+    {
+        if (++_cur == _node->_data + _node->_count)
+        {
+            _node = _node->_next;
+            _cur = _node->_data;
+        }
+        return *this;
+    }
+
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    self &operator--()
+    {
+        if (_cur == _node->_data)
+        {
+            _node = _node->_prev;
+            _cur = _node->_data + _node->_count;
+        }
+        --_cur;
+        return *this;
+    }
+
+    self operator--(int)
+    {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    // 每个元素地址唯一, end() 的地址为 nullptr
+    template <typename OtherRef, typename OtherPtr>
+    bool operator==(const Unrolled_iterator<T, OtherRef, OtherPtr> &other) const
+    {
+        return _cur == other._cur;
+    }
+
+    template <typename OtherRef, typename OtherPtr>
+    bool operator!=(const Unrolled_iterator<T, OtherRef, OtherPtr> &other) const
+    {
+        return _cur != other._cur;
+    }
+
+  public:
+    T *_cur;
+    link_type *_node;
+};
+
+// 分段迭代器的段: 沿链接前进的节点指针
+template <typename T> struct Unrolled_segment
+{
+    Unrolled_link<T> *_node;
+
+    Unrolled_segment &operator++()
+    {
+        _node = _node->_next;
+        return *this;
+    }
+
+    bool operator==(const Unrolled_segment &other) const
+    {
+        return _node == other._node;
+    }
+
+    bool operator!=(const Unrolled_segment &other) const
+    {
+        return _node != other._node;
+    }
+};
+
+// 每个节点的元素为一段连续存储
+template <typename T, typename Ref, typename Ptr>
+struct segmented_iterator_traits<Unrolled_iterator<T, Ref, Ptr>>
+{
+    using is_segmented_iterator = std::true_type;
+    using iterator = Unrolled_iterator<T, Ref, Ptr>;
+    using segment_iterator = Unrolled_segment<T>;
+    using local_iterator = Ptr;
+
+    static segment_iterator segment(const iterator &it)
+    {
+        return segment_iterator{it._node};
+    }
+
+    static local_iterator local(const iterator &it)
+    {
+        return it._cur;
+    }
+
+    static local_iterator begin(segment_iterator seg)
+    {
+        return seg._node->_data;
+    }
+
+    static local_iterator end(segment_iterator seg)
+    {
+        return seg._node->_data + seg._node->_count;
+    }
+
+    // 落在节点尾时转到下一节点首, 与迭代器自增的规则一致
+    static iterator compose(segment_iterator seg, local_iterator cur)
+    {
+        if (cur == end(seg) && seg._node->_data != nullptr)
+        {
+            ++seg;
+            cur = begin(seg);
+        }
+        return iterator(const_cast<T *>(cur), seg._node);
+    }
+};
+
+// 展开链表: 每个节点保存一小段连续元素, 遍历时每个缓存行可取到多个元素
+// 插入到已满节点时对半分裂, 删除后与相邻的稀疏节点合并; 两者都只搬动一个节点内的元素
+// 插入与删除使所在节点 (及分裂, 合并涉及的节点) 上的迭代器失效
+template <typename T, typename Alloc = alloc, std::size_t NodeBytes = UNROLLED_NODE_BYTES>
+class unrolled_list
+{
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using iterator = Unrolled_iterator<T, T &, T *>;
+    using const_iterator = Unrolled_iterator<T, const T &, const T *>;
+
+    static constexpr size_type node_capacity = unrolled_node_capacity(NodeBytes, sizeof(T));
+
+  protected:
+    using link_type = Unrolled_link<T>;
+    using Node = Unrolled_node<T, node_capacity>;
+    using node_allocator = simple_alloc<Node, Alloc>;
+    using self = unrolled_list<T, Alloc, NodeBytes>;
+
+  public:
+    ~unrolled_list()
+    {
+        clear();
+    }
+
+    unrolled_list() : _size(0)
+    {
+        reset();
+    }
+
+    unrolled_list(size_type count, const T &val) : unrolled_list()
+    {
+        while (count-- > 0)
+        {
+            push_back(val);
+        }
+    }
+
+    template <typename InputIter, typename = enable_if_not_integral<InputIter>>
+    unrolled_list(InputIter first, InputIter last) : unrolled_list()
+    {
+        for (; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+    }
+
+    unrolled_list(std::initializer_list<T> init) : unrolled_list(init.begin(), init.end())
+    {
+    }
+
+    unrolled_list(const self &other) : unrolled_list(other.begin(), other.end())
+    {
+    }
+
+    unrolled_list(self &&other) noexcept : unrolled_list()
+    {
+        steal(other);
+    }
+
+    self &operator=(const self &other)
+    {
+        if (this != &other)
+        {
+            self tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    self &operator=(self &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            steal(other);
+        }
+        return *this;
+    }
+
+    self &operator=(std::initializer_list<T> init)
+    {
+        self tmp(init);
+        swap(tmp);
+        return *this;
+    }
+
+    reference front()
+    {
+        return const_cast<reference>(static_cast<const self *>(this)->front());
+    }
+
+    const_reference front() const
+    {
+        if (empty())
+        {
+            throw std::range_error("empty unrolled_list");
+        }
+        return *_head._next->_data;
+    }
+
+    reference back()
+    {
+        return const_cast<reference>(static_cast<const self *>(this)->back());
+    }
+
+    const_reference back() const
+    {
+        if (empty())
+        {
+            throw std::range_error("empty unrolled_list");
+        }
+        return _head._prev->_data[_head._prev->_count - 1];
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator(_head._next->_data, _head._next);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(_head._next->_data, _head._next);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(nullptr, &_head);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(nullptr, const_cast<link_type *>(&_head));
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(T);
+    }
+
+    // 当前节点个数, 用于观察填充率
+    size_type node_count() const noexcept
+    {
+        size_type result = 0;
+        for (const link_type *node = _head._next; node != &_head; node = node->_next)
+        {
+            ++result;
+        }
+        return result;
+    }
+
+    void clear() noexcept
+    {
+        link_type *node = _head._next;
+        while (node != &_head)
+        {
+            link_type *next = node->_next;
+            destroy_elements(node->_data, node->_data + node->_count);
+            node_allocator::deallocate(static_cast<Node *>(node));
+            node = next;
+        }
+        reset();
+    }
+
+    // 插入到 pos 之前; 位于节点尾部且节点未满时直接就地构造, 否则先构造临时对象再腾出空位,
+    // 以免参数引用的元素在搬移中失效
+    template <typename... Args> iterator emplace(const_iterator pos, Args &&...args)
+    {
+        link_type *node = pos._node;
+        size_type index = pos._cur - node->_data;
+        if (index == 0)
+        {
+            // 节点首部 (含 end()) 优先追加到前一节点尾部, 否则在 pos 之前新建节点
+            link_type *prev = node->_prev;
+            if (prev != &_head && prev->_count < node_capacity)
+            {
+                node = prev;
+                index = prev->_count;
+            }
+            else if (node == &_head || node->_count == node_capacity)
+            {
+                node = create_node(node);
+            }
+        }
+        if (index == node->_count && node->_count < node_capacity)
+        {
+            T *slot = node->_data + index;
+            try
+            {
+                construct(slot, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                if (node->_count == 0)
+                {
+                    destroy_node(node);
+                }
+                throw;
+            }
+            ++node->_count;
+            ++_size;
+            return iterator(slot, node);
+        }
+        T tmp(std::forward<Args>(args)...);
+        return insert_relocating(node, index, tmp);
+    }
+
+    iterator insert(const_iterator pos, const T &val)
+    {
+        return emplace(pos, val);
+    }
+
+    iterator insert(const_iterator pos, T &&val)
+    {
+        return emplace(pos, std::move(val));
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        link_type *node = pos._node;
+        size_type index = pos._cur - node->_data;
+        T *slot = node->_data + index;
+        destroy(slot);
+        uninitialized_relocate(slot + 1, node->_data + node->_count, slot);
+        --node->_count;
+        --_size;
+        if (node->_count == 0)
+        {
+            link_type *next = node->_next;
+            destroy_node(node);
+            return iterator(next->_data, next);
+        }
+        return rebalance(node, index);
+    }
+
+    // 每个节点内的元素只搬移一次
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        if (first == last)
+        {
+            return iterator(first._cur, first._node);
+        }
+        link_type *node = first._node;
+        T *from = first._cur;
+        while (node != last._node)
+        {
+            link_type *next = node->_next;
+            size_type index = from - node->_data;
+            destroy_elements(from, node->_data + node->_count);
+            _size -= node->_count - index;
+            node->_count = index;
+            if (index == 0)
+            {
+                destroy_node(node);
+            }
+            node = next;
+            from = node->_data;
+        }
+        if (node == &_head)
+        {
+            return end();
+        }
+        size_type index = from - node->_data;
+        T *to = last._cur;
+        // last 位于节点开头时本节点无需删除, 也不能把元素搬到自身所在位置
+        if (to != from)
+        {
+            destroy_elements(from, to);
+            uninitialized_relocate(to, node->_data + node->_count, from);
+            node->_count -= to - from;
+            _size -= to - from;
+        }
+        return rebalance(node, index);
+    }
+
+    void push_back(const T &val)
+    {
+        emplace(end(), val);
+    }
+
+    void push_back(T &&val)
+    {
+        emplace(end(), std::move(val));
+    }
+
+    template <typename... Args> reference emplace_back(Args &&...args)
+    {
+        return *emplace(end(), std::forward<Args>(args)...);
+    }
+
+    void push_front(const T &val)
+    {
+        emplace(begin(), val);
+    }
+
+    void push_front(T &&val)
+    {
+        emplace(begin(), std::move(val));
+    }
+
+    template <typename... Args> reference emplace_front(Args &&...args)
+    {
+        return *emplace(begin(), std::forward<Args>(args)...);
+    }
+
+    void pop_back()
+    {
+        if (empty())
+        {
+            throw std::range_error("empty unrolled_list");
+        }
+        erase(--end());
+    }
+
+    void pop_front()
+    {
+        if (empty())
+        {
+            throw std::range_error("empty unrolled_list");
+        }
+        erase(begin());
+    }
+
+    void swap(self &other) noexcept
+    {
+        self tmp(std::move(other));
+        other.steal(*this);
+        steal(tmp);
+    }
+
+  protected:
+    void reset() noexcept
+    {
+        _head._prev = &_head;
+        _head._next = &_head;
+        _head._data = nullptr;
+        _head._count = 0;
+        _size = 0;
+    }
+
+    // 接管 other 的全部节点, *this 须为空
+    void steal(self &other) noexcept
+    {
+        if (other.empty())
+        {
+            return;
+        }
+        _head._next = other._head._next;
+        _head._prev = other._head._prev;
+        _head._next->_prev = &_head;
+        _head._prev->_next = &_head;
+        _size = other._size;
+        other.reset();
+    }
+
+    static void destroy_elements(T *first, T *last) noexcept
+    {
+        for (; first != last; ++first)
+        {
+            destroy(first);
+        }
+    }
+
+    // 在 pos 之前链入一个空节点
+    link_type *create_node(link_type *pos)
+    {
+        Node *node = node_allocator::allocate();
+        node->_data = reinterpret_cast<T *>(node->_storage);
+        node->_count = 0;
+        node->_prev = pos->_prev;
+        node->_next = pos;
+        pos->_prev->_next = node;
+        pos->_prev = node;
+        return node;
+    }
+
+    // 摘下并释放节点, 其元素须已析构或搬走
+    void destroy_node(link_type *node) noexcept
+    {
+        node->_prev->_next = node->_next;
+        node->_next->_prev = node->_prev;
+        node_allocator::deallocate(static_cast<Node *>(node));
+    }
+
+    // 下标等于元素个数时指向下一节点首
+    iterator make_iterator(link_type *node, size_type index) noexcept
+    {
+        if (index == node->_count)
+        {
+            node = node->_next;
+            index = 0;
+        }
+        return iterator(node->_data + index, node);
+    }
+
+    // 在 node 的 index 处腾出空位后移入 val; 节点已满时先把后一半搬到新节点
+    iterator insert_relocating(link_type *node, size_type index, T &val)
+    {
+        if (node->_count == node_capacity)
+        {
+            link_type *upper = create_node(node->_next);
+            size_type keep = node->_count - node->_count / 2;
+            uninitialized_relocate(node->_data + keep, node->_data + node->_count, upper->_data);
+            upper->_count = node->_count - keep;
+            node->_count = keep;
+            if (index > keep)
+            {
+                index -= keep;
+                node = upper;
+            }
+        }
+        T *slot = node->_data + index;
+        T *last = node->_data + node->_count;
+        uninitialized_relocate_backward(slot, last, last + 1);
+        try
+        {
+            construct(slot, std::move(val));
+        }
+        catch (...)
+        {
+            uninitialized_relocate(slot + 1, last + 1, slot);
+            throw;
+        }
+        ++node->_count;
+        ++_size;
+        return iterator(slot, node);
+    }
+
+    // 相邻两节点的元素合计不超过容量的 3/4 时合并; 分裂产生的两半合计超过容量, 不会立即合并
+    bool mergeable(const link_type *a, const link_type *b) const noexcept
+    {
+        return a != &_head && b != &_head && (a->_count + b->_count) * 4 <= node_capacity * 3;
+    }
+
+    // 把 node 之后的节点并入 node
+    void merge_next(link_type *node) noexcept
+    {
+        link_type *next = node->_next;
+        uninitialized_relocate(next->_data, next->_data + next->_count,
+                               node->_data + node->_count);
+        node->_count += next->_count;
+        destroy_node(next);
+    }
+
+    // 删除后与稀疏的邻居合并, 返回原 index 处元素的迭代器
+    iterator rebalance(link_type *node, size_type index) noexcept
+    {
+        link_type *prev = node->_prev;
+        if (mergeable(prev, node))
+        {
+            index += prev->_count;
+            merge_next(prev);
+            node = prev;
+        }
+        if (mergeable(node, node->_next))
+        {
+            merge_next(node);
+        }
+        return make_iterator(node, index);
+    }
+
+  protected:
+    link_type _head;
+    size_type _size;
+};
+
+template <typename T, typename Alloc, std::size_t NodeBytes>
+constexpr std::size_t unrolled_list<T, Alloc, NodeBytes>::node_capacity;
+
+template <typename T, typename Alloc, std::size_t NodeBytes>
+bool operator==(const unrolled_list<T, Alloc, NodeBytes> &lhs,
+                const unrolled_list<T, Alloc, NodeBytes> &rhs)
+{
+    return lhs.size() == rhs.size() && TS::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename Alloc, std::size_t NodeBytes>
+bool operator!=(const unrolled_list<T, Alloc, NodeBytes> &lhs,
+                const unrolled_list<T, Alloc, NodeBytes> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Alloc, std::size_t NodeBytes>
+void swap(unrolled_list<T, Alloc, NodeBytes> &lhs, unrolled_list<T, Alloc, NodeBytes> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace TS
+
+#endif
@@ -1,7 +1,9 @@
 #ifndef TS_VECTOR_HPP
 #define TS_VECTOR_HPP
 
+#include "ts_algorithm.hpp"
 #include "ts_alloc.hpp"
+#include "ts_iterator.hpp"
 #include "ts_uninitialized.hpp"
 #include <cassert>
 #include <cstddef>
@@ -60,15 +62,12 @@ template <typename T, typename Alloc = alloc> class vector
         fill_initialize(count, val);
     }
 
-    // template <typename InputIter> vector(InputIter first, InputIter last) : vector()
-    // {
-    //     size_type count = (size_type)(last - first);
-    //     initialize(count);
-    //     for (iterator cur = _start; first != last; ++first, ++cur)
-    //     {
-    //         construct(&*cur, *first);
-    //     }
-    // }
+    template <typename InputIter, typename = enable_if_not_integral<InputIter>>
+    vector(InputIter first, InputIter last)
+        : _start(nullptr), _finish(nullptr), _end_of_storage(nullptr)
+    {
+        range_initialize(first, last, iterator_category(first));
+    }
 
     vector(const self &other)
     {
@@ -105,23 +104,7 @@ template <typename T, typename Alloc = alloc> class vector
         {
             return *this;
         }
-
-        size_type count = other.size();
-        iterator first = other._start;
-        iterator last = other._finish;
-
-        if (capacity() > count)
-        {
-            clear(_start, _start + count);
-        }
-        else
-        {
-            zero_capacity();
-            reserve(count);
-        }
-        _finish = uninitialized_copy(first, last, _start);
-
-        return *this;
+        return assign(other.begin(), other.end());
     }
 
     vector &operator=(self &&other) noexcept
@@ -148,6 +131,41 @@ template <typename T, typename Alloc = alloc> class vector
         return *this;
     }
 
+    vector &assign(size_type count, const T &val)
+    {
+        if (count > capacity())
+        {
+            self tmp(count, val);
+            swap(tmp);
+        }
+        else if (count > size())
+        {
+            TS::fill(_start, _finish, val);
+            uninitialized_fill_n(_finish, count - size(), val);
+            _finish = _start + count;
+        }
+        else
+        {
+            TS::fill(_start, _start + count, val);
+            clear(_start + count, _finish);
+            _finish = _start + count;
+        }
+        return *this;
+    }
+
+    // 前向迭代器先求出长度, 至多重新分配一次; 输入迭代器逐个追加
+    template <typename InputIter, typename = enable_if_not_integral<InputIter>>
+    vector &assign(InputIter first, InputIter last)
+    {
+        range_assign(first, last, iterator_category(first));
+        return *this;
+    }
+
+    vector &assign(std::initializer_list<T> init)
+    {
+        return assign(init.begin(), init.end());
+    }
+
     // element access
 
     reference at(difference_type n)
@@ -282,8 +300,7 @@ template <typename T, typename Alloc = alloc> class vector
         size_type old_count = size();
         size_type old_capacity = capacity();
         initialize(count);
-        _finish = uninitialized_copy_n(old_first, old_count, _start);
-        clear(old_first, old_first + old_count);
+        _finish = uninitialized_relocate_n(old_first, old_count, _start);
         data_allocator::deallocate(&*old_first, old_capacity);
     }
 
@@ -295,8 +312,7 @@ template <typename T, typename Alloc = alloc> class vector
         size_type old_capacity = capacity();
         size_type old_count = size();
         initialize(count);
-        _finish = uninitialized_copy_n(old_first, old_count, _start);
-        clear(old_first, old_first + old_count);
+        _finish = uninitialized_relocate_n(old_first, old_count, _start);
         data_allocator::deallocate(&*old_first, old_capacity);
     }
 
@@ -347,66 +363,89 @@ template <typename T, typename Alloc = alloc> class vector
         return emplace(pos, std::move(val));
     }
 
-    // iterator insert(const_iterator pos, std::initializer_list<T> init)
-    // {
-    //     if (pos < begin() || pos > end())
-    //     {
-    //         throw std::range_error("out of range");
-    //     }
-    //     difference_type index = pos - _start;
-    //     if (_finish + init.size() - 1 >= _end_of_storage)
-    //     {
-    //         iterator old_start = _start;
-    //         iterator old_finish = _finish;
-    //         initialize(size() + init.size());
-
-    //         iterator new_pos = _start + index;
-
-    //         // uninitialized_copy(old_start, old_finish, _start);
-    //         uninitialized_copy(old_start, const_cast<iterator>(pos), _start);
-    //         _finish =
-    //             uninitialized_copy(const_cast<iterator>(pos), old_finish, new_pos + init.size());
-    //         clear(old_start, old_finish);
-    //         uninitialized_copy(init.begin(), init.end(), new_pos);
-    //     }
-    //     else
-    //     {
-    //         iterator non_const_pos = const_cast<iterator>(pos);
-    //         _finish =
-    //             uninitialized_copy_backward(non_const_pos, _finish, non_const_pos + init.size());
-    //         uninitialized_copy(init.begin(), init.end(), non_const_pos);
-    //     }
-    //     return _start + index;
-    // }
-
-    template <typename... Args> iterator emplace(const_iterator pos, Args &&...args)
+    iterator insert(const_iterator pos, size_type count, const T &val)
     {
-        if (pos < begin() || pos > end())
+        difference_type index = check_position(pos);
+        if (count == 0)
         {
-            throw std::range_error("out of range");
+            return _start + index;
+        }
+        // val 可能引用本容器中将被移动的元素
+        value_type copy(val);
+        iterator gap = make_gap(index, count);
+        try
+        {
+            uninitialized_fill_n(gap, count, copy);
         }
-        difference_type index = pos - _start;
+        catch (...)
+        {
+            close_gap(index, count);
+            throw;
+        }
+        return gap;
+    }
+
+    // 前向迭代器: 先求出插入个数, 至多一次重新分配和一次整体后移
+    template <typename InputIter, typename = enable_if_not_integral<InputIter>>
+    iterator insert(const_iterator pos, InputIter first, InputIter last)
+    {
+        return range_insert(pos, first, last, iterator_category(first));
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<T> init)
+    {
+        return insert(pos, init.begin(), init.end());
+    }
+
+    template <typename... Args> iterator emplace(const_iterator pos, Args &&...args)
+    {
+        difference_type index = check_position(pos);
         if (_finish == _end_of_storage)
         {
             iterator old_start = _start;
             iterator old_finish = _finish;
+            iterator old_pos = const_cast<iterator>(pos);
             size_type old_capacity = capacity();
             expand();
 
             iterator new_pos = _start + index;
 
-            // uninitialized_copy(old_start, old_finish, _start);
-            uninitialized_copy(old_start, const_cast<iterator>(pos), _start);
-            _finish = uninitialized_copy(const_cast<iterator>(pos), old_finish, new_pos + 1);
-            clear(old_start, old_finish);
+            // 先构造新元素, args 可能引用旧空间中的元素
+            try
+            {
+                construct(&*new_pos, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                data_allocator::deallocate(&*_start, capacity());
+                _start = old_start;
+                _finish = old_finish;
+                _end_of_storage = old_start + old_capacity;
+                throw;
+            }
+            uninitialized_relocate(old_start, old_pos, _start);
+            _finish = uninitialized_relocate(old_pos, old_finish, new_pos + 1);
             data_allocator::deallocate(&*old_start, old_capacity);
-            construct(&*new_pos, std::forward<Args>(args)...);
+        }
+        else if (pos == _finish)
+        {
+            construct(&*_finish, std::forward<Args>(args)...);
+            ++_finish;
         }
         else
         {
-            iterator non_const_pos = const_cast<iterator>(pos);
-            _finish = uninitialized_copy_backward(non_const_pos, _finish, non_const_pos + 1);
-            construct(&*non_const_pos, std::forward<Args>(args)...);
+            // args 可能引用将被后移的元素, 先构造出新值
+            value_type val(std::forward<Args>(args)...);
+            iterator gap = make_gap(index, 1);
+            try
+            {
+                construct(&*gap, std::move(val));
+            }
+            catch (...)
+            {
+                close_gap(index, 1);
+                throw;
+            }
         }
         return _start + index;
     }
@@ -450,10 +489,9 @@ template <typename T, typename Alloc = alloc> class vector
 
         iterator non_const_first = const_cast<iterator>(first);
         iterator non_const_last = const_cast<iterator>(last);
-        iterator old_finish = _finish;
 
-        _finish = uninitialized_copy(non_const_last, _finish, non_const_first);
-        clear(_finish, old_finish);
+        clear(non_const_first, non_const_last);
+        _finish = uninitialized_relocate(non_const_last, _finish, non_const_first);
         return non_const_first;
     }
 
@@ -569,6 +607,175 @@ template <typename T, typename Alloc = alloc> class vector
         initialize(count);
     }
 
+    // 容纳额外 count 个元素所需的新容量, 与 expand 相同按两倍增长
+    size_type grow_capacity(size_type count) const
+    {
+        size_type doubled = size() * 2 + 1;
+        return size() + count > doubled ? size() + count : doubled;
+    }
+
+    difference_type check_position(const_iterator pos) const
+    {
+        if (pos < begin() || pos > end())
+        {
+            throw std::range_error("out of range");
+        }
+        return pos - _start;
+    }
+
+    // 在容量足够时把 index 之后的元素整体后移 count 个位置, 返回未初始化的空位
+    iterator make_gap(difference_type index, size_type count)
+    {
+        if (size_type(_end_of_storage - _finish) < count)
+        {
+            size_type new_capacity = grow_capacity(count);
+            iterator old_start = _start;
+            iterator old_finish = _finish;
+            size_type old_capacity = capacity();
+            initialize(new_capacity);
+            uninitialized_relocate(old_start, old_start + index, _start);
+            uninitialized_relocate(old_start + index, old_finish, _start + index + count);
+            data_allocator::deallocate(&*old_start, old_capacity);
+            _finish = _start + (old_finish - old_start);
+        }
+        else
+        {
+            uninitialized_relocate_backward(_start + index, _finish, _finish + count);
+        }
+        _finish += count;
+        return _start + index;
+    }
+
+    // 填充空位失败时撤销 make_gap, 保留已重新分配的空间
+    void close_gap(difference_type index, size_type count)
+    {
+        iterator gap = _start + index;
+        _finish = uninitialized_relocate(gap + count, _finish, gap);
+    }
+
+    template <typename InputIter>
+    void range_initialize(InputIter first, InputIter last, input_iterator_tag)
+    {
+        initialize(VECTOR_INIT_SIZE);
+        try
+        {
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+        catch (...)
+        {
+            zero_capacity();
+            throw;
+        }
+    }
+
+    template <typename ForwardIter>
+    void range_initialize(ForwardIter first, ForwardIter last, forward_iterator_tag)
+    {
+        size_type count = TS::distance(first, last);
+        initialize(count);
+        try
+        {
+            _finish = TS::uninitialized_copy(first, last, _start);
+        }
+        catch (...)
+        {
+            data_allocator::deallocate(&*_start, count);
+            throw;
+        }
+    }
+
+    template <typename InputIter>
+    void range_assign(InputIter first, InputIter last, input_iterator_tag)
+    {
+        iterator cur = _start;
+        for (; first != last && cur != _finish; ++first, ++cur)
+        {
+            *cur = *first;
+        }
+        if (first == last)
+        {
+            clear(cur, _finish);
+            _finish = cur;
+        }
+        else
+        {
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+    }
+
+    template <typename ForwardIter>
+    void range_assign(ForwardIter first, ForwardIter last, forward_iterator_tag)
+    {
+        size_type count = TS::distance(first, last);
+        if (count > capacity())
+        {
+            self tmp(first, last);
+            swap(tmp);
+        }
+        else if (count > size())
+        {
+            ForwardIter mid = first;
+            TS::advance(mid, size());
+            TS::copy(first, mid, _start);
+            _finish = TS::uninitialized_copy(mid, last, _finish);
+        }
+        else
+        {
+            iterator new_finish = TS::copy(first, last, _start);
+            clear(new_finish, _finish);
+            _finish = new_finish;
+        }
+    }
+
+    // 输入迭代器只能遍历一次: 在尾部逐个追加, 否则先收集到临时 vector 再整体插入
+    template <typename InputIter>
+    iterator range_insert(const_iterator pos, InputIter first, InputIter last, input_iterator_tag)
+    {
+        difference_type index = check_position(pos);
+        if (pos == _finish)
+        {
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+        else
+        {
+            self tmp(first, last);
+            insert(pos, std::make_move_iterator(tmp._start), std::make_move_iterator(tmp._finish));
+        }
+        return _start + index;
+    }
+
+    template <typename ForwardIter>
+    iterator range_insert(const_iterator pos, ForwardIter first, ForwardIter last,
+                          forward_iterator_tag)
+    {
+        difference_type index = check_position(pos);
+        size_type count = TS::distance(first, last);
+        if (count == 0)
+        {
+            return _start + index;
+        }
+        iterator gap = make_gap(index, count);
+        try
+        {
+            TS::uninitialized_copy(first, last, gap);
+        }
+        catch (...)
+        {
+            close_gap(index, count);
+            throw;
+        }
+        return gap;
+    }
+
     void zero_capacity()
     {
         clear(_start, _finish);
@@ -597,19 +804,44 @@ template <typename T, typename Alloc = alloc> class vector
 template <typename T, typename Alloc>
 bool operator==(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
 {
-    if (lhs.size() != rhs.size())
-    {
-        return false;
-    }
+    return lhs.size() == rhs.size() && TS::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
 
-    for (typename vector<T, Alloc>::size_type i = 0; i < lhs.size(); ++i)
-    {
-        if (*(lhs.begin() + i) != *(rhs.begin() + i))
-        {
-            return false;
-        }
-    }
-    return true;
+template <typename T, typename Alloc>
+bool operator!=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Alloc>
+bool operator<(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+{
+    return TS::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, typename Alloc>
+bool operator>(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+{
+    return rhs < lhs;
+}
+
+template <typename T, typename Alloc>
+bool operator<=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <typename T, typename Alloc>
+bool operator>=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+{
+    return !(lhs < rhs);
+}
+
+// 三路比较: 返回负数, 0, 正数
+template <typename T, typename Alloc>
+int compare(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs)
+{
+    return TS::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
 } // namespace TS